@@ -15,6 +15,7 @@ Archive Get Command
 #include "command/archive/get/protocol.h"
 #include "command/command.h"
 #include "command/lock.h"
+#include "command/metrics.h"
 #include "common/debug.h"
 #include "common/log.h"
 #include "common/memContext.h"
@@ -83,6 +84,7 @@ typedef struct ArchiveGetFindCachePath
 {
     const String *path;                                             // Cached path in the archiveId
     const StringList *fileList;                                     // List of files in the cache path
+    bool index;                                                     // Was the file list loaded from the spool index?
 } ArchiveGetFindCachePath;
 
 typedef struct ArchiveGetFindCacheArchive
@@ -100,6 +102,99 @@ typedef struct ArchiveGetFindCacheRepo
     StringList *warnList;                                           // Track repo warnings so each is only reported once
 } ArchiveGetFindCacheRepo;
 
+/***********************************************************************************************************************************
+The async process is spawned many times while a standby replays WAL and each run would otherwise list the same repo paths again. To
+avoid this the list of files in each archive path is stored in the spool path and reused by later runs. The index is only used to
+locate files that were previously listed -- if the requested file is not in the index then the path is listed again and the index
+updated. Files removed from the repo (e.g. by expire) cause the get to fail, which removes the index so it will be rebuilt.
+***********************************************************************************************************************************/
+#define ARCHIVE_GET_INDEX_PATH                                      STORAGE_SPOOL_ARCHIVE "/index"
+
+static String *
+archiveGetIndexFile(const unsigned int repoIdx, const String *const archiveId, const String *const path)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(UINT, repoIdx);
+        FUNCTION_TEST_PARAM(STRING, archiveId);
+        FUNCTION_TEST_PARAM(STRING, path);
+    FUNCTION_TEST_END();
+
+    FUNCTION_TEST_RETURN(
+        STRING,
+        strNewFmt(
+            ARCHIVE_GET_INDEX_PATH "/repo%u/%s/%s", cfgOptionGroupIdxToKey(cfgOptGrpRepo, repoIdx), strZ(archiveId), strZ(path)));
+}
+
+// List an archive path in the repo and store the result in the index
+static StringList *
+archiveGetIndexList(const unsigned int repoIdx, const String *const archiveId, const String *const path)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(UINT, repoIdx);
+        FUNCTION_LOG_PARAM(STRING, archiveId);
+        FUNCTION_LOG_PARAM(STRING, path);
+    FUNCTION_LOG_END();
+
+    StringList *result = NULL;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        result = strLstMove(
+            storageListP(
+                storageRepoIdx(repoIdx), strNewFmt(STORAGE_REPO_ARCHIVE "/%s/%s", strZ(archiveId), strZ(path)),
+                .expression = strNewFmt("^%s[0-F]{8}-[0-f]{40}" COMPRESS_TYPE_REGEXP "{0,1}$", strZ(path))),
+            memContextPrior());
+
+        // The index is only an optimization so sync is not required and errors are ignored. An empty list is not stored since it
+        // could never be used to find a file.
+        TRY_BEGIN()
+        {
+            if (!strLstEmpty(result))
+            {
+                storagePutP(
+                    storageNewWriteP(
+                        storageSpoolWrite(), archiveGetIndexFile(repoIdx, archiveId, path), .noSyncFile = true,
+                        .noSyncPath = true),
+                    BUFSTR(strLstJoin(strLstSort(result, sortOrderAsc), "\n")));
+            }
+        }
+        CATCH_ANY()
+        {
+            LOG_DETAIL_FMT("unable to write archive index: %s", errorMessage());
+        }
+        TRY_END();
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN(STRING_LIST, result);
+}
+
+// Load the file list for an archive path from the index. NULL is returned when there is no index for the path.
+static StringList *
+archiveGetIndexLoad(const unsigned int repoIdx, const String *const archiveId, const String *const path)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(UINT, repoIdx);
+        FUNCTION_LOG_PARAM(STRING, archiveId);
+        FUNCTION_LOG_PARAM(STRING, path);
+    FUNCTION_LOG_END();
+
+    StringList *result = NULL;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        const Buffer *const index = storageGetP(
+            storageNewReadP(storageSpool(), archiveGetIndexFile(repoIdx, archiveId, path), .ignoreMissing = true));
+
+        if (index != NULL)
+            result = strLstMove(strLstNewSplitZ(strNewBuf(index), "\n"), memContextPrior());
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN(STRING_LIST, result);
+}
+
+/**********************************************************************************************************************************/
 static bool
 archiveGetFind(
     const String *const archiveFileRequest, ArchiveGetCheckResult *const getCheckResult, List *const cacheRepoList,
@@ -169,36 +264,60 @@ archiveGetFind(
                             // Partial files cannot be in a list with multiple requests
                             ASSERT(!walIsPartial(archiveFileRequest));
 
-                            // If the path does not exist in the cache then fetch it
-                            const ArchiveGetFindCachePath *cachePath = lstFind(cacheArchive->pathList, &path);
+                            // If the path does not exist in the cache then load it from the index or fetch it
+                            ArchiveGetFindCachePath *cachePath = lstFind(cacheArchive->pathList, &path);
 
                             if (cachePath == NULL)
                             {
                                 MEM_CONTEXT_BEGIN(lstMemContext(cacheArchive->pathList))
                                 {
-                                    const ArchiveGetFindCachePath archiveGetFindCachePath =
+                                    ArchiveGetFindCachePath archiveGetFindCachePath =
                                     {
                                         .path = strDup(path),
-                                        .fileList = storageListP(
-                                            storageRepoIdx(cacheRepo->repoIdx),
-                                            strNewFmt(STORAGE_REPO_ARCHIVE "/%s/%s", strZ(cacheArchive->archiveId), strZ(path)),
-                                            .expression = strNewFmt(
-                                                "^%s[0-F]{8}-[0-f]{40}" COMPRESS_TYPE_REGEXP "{0,1}$", strZ(path))),
+                                        .fileList = archiveGetIndexLoad(cacheRepo->repoIdx, cacheArchive->archiveId, path),
+                                        .index = true,
                                     };
 
+                                    if (archiveGetFindCachePath.fileList == NULL)
+                                    {
+                                        archiveGetFindCachePath.fileList = archiveGetIndexList(
+                                            cacheRepo->repoIdx, cacheArchive->archiveId, path);
+                                        archiveGetFindCachePath.index = false;
+                                    }
+
                                     cachePath = lstAdd(cacheArchive->pathList, &archiveGetFindCachePath);
                                 }
                                 MEM_CONTEXT_END();
                             }
 
-                            // Get a list of all WAL segments that match
+                            // Get a list of all WAL segments that match. If nothing matches in a list loaded from the index then
+                            // the file may have been pushed since the index was written so list the path again.
                             segmentList = strLstNew();
 
-                            for (unsigned int fileIdx = 0; fileIdx < strLstSize(cachePath->fileList); fileIdx++)
+                            do
                             {
-                                if (strBeginsWith(strLstGet(cachePath->fileList, fileIdx), archiveFileRequest))
-                                    strLstAdd(segmentList, strLstGet(cachePath->fileList, fileIdx));
+                                for (unsigned int fileIdx = 0; fileIdx < strLstSize(cachePath->fileList); fileIdx++)
+                                {
+                                    if (strBeginsWith(strLstGet(cachePath->fileList, fileIdx), archiveFileRequest))
+                                        strLstAdd(segmentList, strLstGet(cachePath->fileList, fileIdx));
+                                }
+
+                                if (strLstEmpty(segmentList) && cachePath->index)
+                                {
+                                    MEM_CONTEXT_BEGIN(lstMemContext(cacheArchive->pathList))
+                                    {
+                                        cachePath->fileList = archiveGetIndexList(
+                                            cacheRepo->repoIdx, cacheArchive->archiveId, path);
+                                        cachePath->index = false;
+                                    }
+                                    MEM_CONTEXT_END();
+
+                                    continue;
+                                }
+
+                                break;
                             }
+                            while (true);
                         }
 
                         // Add segments to match list
@@ -533,6 +652,28 @@ archiveGetCheck(const StringList *const archiveRequestList)
     FUNCTION_LOG_RETURN_STRUCT(result);
 }
 
+/***********************************************************************************************************************************
+Write the segment requested by PostgreSQL to the request file so a resident async process knows which segment is being replayed (see
+archiveGetAsyncResidentNext()). The request is only a hint so sync is not required.
+***********************************************************************************************************************************/
+#define ARCHIVE_GET_REQUEST_FILE                                    STORAGE_SPOOL_ARCHIVE "/get.request"
+
+static void
+archiveGetAsyncRequestWrite(const String *const walSegment)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STRING, walSegment);
+    FUNCTION_LOG_END();
+
+    ASSERT(walSegment != NULL);
+
+    storagePutP(
+        storageNewWriteP(storageSpoolWrite(), STRDEF(ARCHIVE_GET_REQUEST_FILE), .noSyncFile = true, .noSyncPath = true),
+        BUFSTR(walSegment));
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Clean the queue and prepare a list of WAL segments that the async process should get
 ***********************************************************************************************************************************/
@@ -656,6 +797,10 @@ cmdArchiveGet(void)
             bool queueFull = false;                                     // Is the queue half or more full?
             bool forked = false;                                        // Has the async process been forked yet?
 
+            // Let a resident async process know which segment is being replayed
+            if (cfgOptionUInt64(cfgOptArchiveGetResident) > 0)
+                archiveGetAsyncRequestWrite(walSegment);
+
             // Loop and wait for the WAL segment to be pushed
             Wait *const wait = waitNew(cfgOptionUInt64(cfgOptArchiveTimeout));
 
@@ -839,6 +984,9 @@ cmdArchiveGet(void)
                     FOUND_IN_REPO_ARCHIVE_MSG, strZ(walSegment), cfgOptionGroupName(cfgOptGrpRepo, file->repoIdx),
                     strZ(file->archiveId));
 
+                // Update metrics
+                cmdMetricsWriteP(.force = true, .fileComplete = 1, .fileTotal = 1);
+
                 result = 0;
             }
             // Else log that the file was not found
@@ -909,164 +1057,483 @@ archiveGetAsyncCallback(void *const data, const unsigned int clientIdx)
     FUNCTION_TEST_RETURN(PROTOCOL_PARALLEL_JOB, result);
 }
 
-FN_EXTERN void
-cmdArchiveGetAsync(void)
+/***********************************************************************************************************************************
+A resident async process stays running after a batch of WAL segments has been fetched and watches the segment requested by
+PostgreSQL (written to the request file by archive-get) to decide when to fetch more. The replay rate (how fast the requested
+segment advances) and the fetch rate are tracked so the number of segments queued ahead of the requested segment is just enough to
+stay ahead of replay. This keeps the local processes and their repo connections warm during catch-up without filling the spool path
+at steady state. The process exits when no new segment has been requested for archive-get-resident or when a segment outside the
+queue is requested, e.g. after a timeline switch, so archive-get can start a new async process with a new queue.
+***********************************************************************************************************************************/
+// Time to wait between checks of the request file
+#define ARCHIVE_GET_RESIDENT_POLL                                   100
+
+typedef struct ArchiveGetAsyncResident
 {
-    FUNCTION_LOG_VOID(logLevelDebug);
+    TimeMSec residentTime;                                          // Time to stay resident without a new request
+    size_t walSegmentSize;                                          // WAL segment size
+    unsigned int pgVersion;                                         // PostgreSQL version
+    unsigned int queueMax;                                          // Max segments in the queue
+
+    StringList *planList;                                           // Segments fetched from the request on
+    String *planLast;                                               // Last segment fetched
+    String *request;                                                // Segment last requested by PostgreSQL (NULL if none yet)
+    bool requestPlanned;                                            // Is the request the first segment in the plan?
+    TimeMSec requestTime;                                           // Time the request last changed
+    TimeMSec replayTime;                                            // Average time for PostgreSQL to replay a segment
+    TimeMSec fetchTime;                                             // Average time for a process to fetch a segment
+} ArchiveGetAsyncResident;
+
+// Moving average that favors recent samples. The first sample is used as is.
+static TimeMSec
+archiveGetAsyncAverage(const TimeMSec average, const TimeMSec sample)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(TIME_MSEC, average);
+        FUNCTION_TEST_PARAM(TIME_MSEC, sample);
+    FUNCTION_TEST_END();
+
+    FUNCTION_TEST_RETURN(TIME_MSEC, average == 0 ? sample : (average * 3 + sample) / 4);
+}
+
+// Number of segments that should be queued ahead of the segment requested by PostgreSQL. Enough segments are needed to cover replay
+// while a segment is fetched (doubled to absorb variation in both rates) plus one for each process so all processes stay busy.
+// Until the replay rate is known the queue is kept full.
+static unsigned int
+archiveGetAsyncLookahead(
+    const TimeMSec replayTime, const TimeMSec fetchTime, const unsigned int processMax, const unsigned int queueMax)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(TIME_MSEC, replayTime);
+        FUNCTION_TEST_PARAM(TIME_MSEC, fetchTime);
+        FUNCTION_TEST_PARAM(UINT, processMax);
+        FUNCTION_TEST_PARAM(UINT, queueMax);
+    FUNCTION_TEST_END();
+
+    ASSERT(queueMax >= 2);
+
+    uint64_t result = queueMax;
+
+    if (replayTime != 0)
+    {
+        result = (fetchTime * 2 + replayTime - 1) / replayTime + processMax;
+
+        if (result < 2)
+            result = 2;
+        else if (result > queueMax)
+            result = queueMax;
+    }
+
+    FUNCTION_TEST_RETURN(UINT, (unsigned int)result);
+}
+
+// Initialize resident state from the first batch
+static void
+archiveGetAsyncResidentInit(ArchiveGetAsyncResident *const resident, const StringList *const requestList)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM_P(VOID, resident);
+        FUNCTION_LOG_PARAM(STRING_LIST, requestList);
+    FUNCTION_LOG_END();
+
+    FUNCTION_AUDIT_HELPER();
+
+    ASSERT(resident != NULL);
+    ASSERT(requestList != NULL);
+    ASSERT(!strLstEmpty(requestList));
+
+    const PgControl pgControl = pgControlFromFile(storagePg(), cfgOptionStrNull(cfgOptPgVersionForce));
+
+    *resident = (ArchiveGetAsyncResident)
+    {
+        .residentTime = cfgOptionUInt64(cfgOptArchiveGetResident),
+        .walSegmentSize = pgControl.walSegmentSize,
+        .pgVersion = pgControl.version,
+        .queueMax = (unsigned int)(cfgOptionUInt64(cfgOptArchiveGetQueueMax) / pgControl.walSegmentSize),
+        .planList = strLstDup(requestList),
+        .planLast = strDup(strLstGet(requestList, strLstSize(requestList) - 1)),
+        .requestTime = timeMSec(),
+    };
+
+    // The queue must hold at least two segments (see queueNeed())
+    if (resident->queueMax < 2)
+        resident->queueMax = 2;
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+// Update the request from the request file. Returns false when the request is outside of the plan.
+static bool
+archiveGetAsyncResidentRequest(ArchiveGetAsyncResident *const resident)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM_P(VOID, resident);
+    FUNCTION_LOG_END();
+
+    FUNCTION_AUDIT_HELPER();
+
+    ASSERT(resident != NULL);
+
+    bool result = true;
 
     MEM_CONTEXT_TEMP_BEGIN()
     {
-        TRY_BEGIN()
+        const Buffer *const requestBuffer = storageGetP(
+            storageNewReadP(storageSpool(), STRDEF(ARCHIVE_GET_REQUEST_FILE), .ignoreMissing = true));
+        const String *const request = requestBuffer == NULL ? NULL : strNewBuf(requestBuffer);
+
+        if (request != NULL && !strEq(request, resident->request))
         {
-            // PostgreSQL must be local
-            pgIsLocalVerify();
+            // Find the request in the plan. The segment after the last segment fetched is also accepted since it is next.
+            unsigned int requestIdx = strLstFindIdxP(resident->planList, request);
 
-            // Check the parameters
-            if (strLstSize(cfgCommandParam()) < 1)
-                THROW(ParamInvalidError, "at least one wal segment is required");
+            if (requestIdx == LIST_NOT_FOUND &&
+                strEq(request, walSegmentNext(resident->planLast, resident->walSegmentSize, resident->pgVersion)))
+            {
+                requestIdx = strLstSize(resident->planList);
+            }
 
-            LOG_INFO_FMT(
-                "get %u WAL file(s) from archive: %s%s",
-                strLstSize(cfgCommandParam()), strZ(strLstGet(cfgCommandParam(), 0)),
-                strLstSize(cfgCommandParam()) == 1 ?
-                    "" : zNewFmt("...%s", strZ(strLstGet(cfgCommandParam(), strLstSize(cfgCommandParam()) - 1))));
+            // The first request may be before the plan since the first batch starts after a segment that was already found.
+            // Otherwise a request outside of the plan means the async process should exit so a new queue can be built.
+            if (requestIdx == LIST_NOT_FOUND)
+            {
+                if (resident->request != NULL)
+                {
+                    LOG_DETAIL_FMT("WAL file %s requested outside of the queue", strZ(request));
+                    result = false;
+                }
+            }
+            else
+            {
+                const TimeMSec timeNow = timeMSec();
 
-            // Check for archive files
-            const ArchiveGetCheckResult checkResult = archiveGetCheck(cfgCommandParam());
+                // Update the replay time when the prior request was also in the plan so the distance is known
+                if (resident->requestPlanned && requestIdx > 0)
+                {
+                    resident->replayTime = archiveGetAsyncAverage(
+                        resident->replayTime, (timeNow - resident->requestTime) / requestIdx);
+                }
 
-            // If any files are missing get the first one (used to construct the "unable to find" warning)
-            const String *archiveFileMissing = NULL;
+                // Remove segments before the request from the plan
+                MEM_CONTEXT_PRIOR_BEGIN()
+                {
+                    StringList *const planList = strLstNew();
 
-            if (lstSize(checkResult.archiveFileMapList) < strLstSize(cfgCommandParam()))
-                archiveFileMissing = strLstGet(cfgCommandParam(), lstSize(checkResult.archiveFileMapList));
+                    for (unsigned int planIdx = requestIdx; planIdx < strLstSize(resident->planList); planIdx++)
+                        strLstAdd(planList, strLstGet(resident->planList, planIdx));
 
-            // Get archive files that were found
-            if (!lstEmpty(checkResult.archiveFileMapList))
-            {
-                // Create the parallel executor
-                ArchiveGetAsyncData jobData = {.archiveFileMapList = checkResult.archiveFileMapList};
+                    strLstFree(resident->planList);
+                    resident->planList = planList;
+                }
+                MEM_CONTEXT_PRIOR_END();
 
-                ProtocolParallel *const parallelExec = protocolParallelNew(
-                    cfgOptionUInt64(cfgOptProtocolTimeout) / 2, archiveGetAsyncCallback, &jobData);
+                resident->requestPlanned = true;
+                resident->requestTime = timeNow;
+            }
 
-                for (unsigned int processIdx = 1; processIdx <= cfgOptionUInt(cfgOptProcessMax); processIdx++)
-                    protocolParallelClientAdd(parallelExec, protocolLocalGet(protocolStorageTypeRepo, 0, processIdx));
+            if (result)
+            {
+                strFree(resident->request);
 
-                // Process jobs
-                MEM_CONTEXT_TEMP_RESET_BEGIN()
+                MEM_CONTEXT_PRIOR_BEGIN()
                 {
-                    do
-                    {
-                        const unsigned int completed = protocolParallelProcess(parallelExec);
+                    resident->request = strDup(request);
+                }
+                MEM_CONTEXT_PRIOR_END();
+            }
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
 
-                        for (unsigned int jobIdx = 0; jobIdx < completed; jobIdx++)
-                        {
-                            // Get the job
-                            ProtocolParallelJob *const job = protocolParallelResult(parallelExec);
-                            const unsigned int processId = protocolParallelJobProcessId(job);
+    FUNCTION_LOG_RETURN(BOOL, result);
+}
 
-                            // Get wal segment name and archive file map
-                            const String *const walSegment = varStr(protocolParallelJobKey(job));
-                            const ArchiveFileMap *const fileMap = lstFind(checkResult.archiveFileMapList, &walSegment);
-                            ASSERT(fileMap != NULL);
+// Wait until more segments are needed and return them, or return NULL when the async process should exit
+static StringList *
+archiveGetAsyncResidentNext(ArchiveGetAsyncResident *const resident)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM_P(VOID, resident);
+    FUNCTION_LOG_END();
 
-                            // Build warnings for status file
-                            String *const warning = strNew();
+    FUNCTION_AUDIT_HELPER();
 
-                            if (!strLstEmpty(fileMap->warnList))
-                                strCatFmt(warning, "%s", strZ(strLstJoin(fileMap->warnList, "\n")));
+    ASSERT(resident != NULL);
 
-                            // The job was successful
-                            if (protocolParallelJobErrorCode(job) == 0)
-                            {
-                                // Get the actual file retrieved
-                                PackRead *const fileResult = protocolParallelJobResult(job);
-                                const ArchiveGetFile *const file = lstGet(fileMap->actualList, pckReadU32P(fileResult));
-                                ASSERT(file != NULL);
+    StringList *result = NULL;
 
-                                // Output file warnings
-                                const StringList *const fileWarnList = pckReadStrLstP(fileResult);
+    while (archiveGetAsyncResidentRequest(resident))
+    {
+        // Segments queued after the request
+        unsigned int ahead = strLstSize(resident->planList);
 
-                                for (unsigned int warnIdx = 0; warnIdx < strLstSize(fileWarnList); warnIdx++)
-                                    LOG_WARN_PID(processId, strZ(strLstGet(fileWarnList, warnIdx)));
+        if (resident->requestPlanned && ahead > 0)
+            ahead--;
 
-                                // Build file warnings for status file
-                                if (!strLstEmpty(fileWarnList))
-                                {
-                                    strCatFmt(
-                                        warning, "%s%s", strSize(warning) == 0 ? "" : "\n", strZ(strLstJoin(fileWarnList, "\n")));
-                                }
+        // Fetch more segments when there are not enough queued to stay ahead of replay
+        const unsigned int lookahead = archiveGetAsyncLookahead(
+            resident->replayTime, resident->fetchTime, cfgOptionUInt(cfgOptProcessMax), resident->queueMax);
 
-                                if (strSize(warning) != 0)
-                                    archiveAsyncStatusOkWrite(archiveModeGet, walSegment, warning);
-
-                                LOG_DETAIL_PID_FMT(
-                                    processId, FOUND_IN_REPO_ARCHIVE_MSG, strZ(walSegment),
-                                    cfgOptionGroupName(cfgOptGrpRepo, file->repoIdx), strZ(file->archiveId));
-
-                                // Rename temp WAL segment to actual name. This is done after the ok file is written so the ok file
-                                // is guaranteed to exist before the foreground process finds the WAL segment.
-                                storageMoveP(
-                                    storageSpoolWrite(),
-                                    storageNewReadP(
-                                        storageSpool(),
-                                        strNewFmt(STORAGE_SPOOL_ARCHIVE_IN "/%s." STORAGE_FILE_TEMP_EXT, strZ(walSegment))),
-                                    storageNewWriteP(
-                                        storageSpoolWrite(), strNewFmt(STORAGE_SPOOL_ARCHIVE_IN "/%s", strZ(walSegment))));
-                            }
-                            // Else the job errored
-                            else
+        if (ahead < lookahead)
+        {
+            result = walSegmentRange(
+                walSegmentNext(resident->planLast, resident->walSegmentSize, resident->pgVersion), resident->walSegmentSize,
+                resident->pgVersion, lookahead - ahead);
+
+            for (unsigned int resultIdx = 0; resultIdx < strLstSize(result); resultIdx++)
+                strLstAdd(resident->planList, strLstGet(result, resultIdx));
+
+            strFree(resident->planLast);
+            resident->planLast = strDup(strLstGet(result, strLstSize(result) - 1));
+
+            break;
+        }
+
+        // Exit when no new segment has been requested for the resident time
+        if (timeMSec() - resident->requestTime >= resident->residentTime)
+        {
+            LOG_DETAIL_FMT("no WAL requested for %" PRIu64 "ms", resident->residentTime);
+            break;
+        }
+
+        sleepMSec(ARCHIVE_GET_RESIDENT_POLL);
+    }
+
+    FUNCTION_LOG_RETURN(STRING_LIST, result);
+}
+
+/***********************************************************************************************************************************
+Get a batch of WAL segments. Returns true when all segments were found and fetched without error, in which case a resident async
+process may continue with the next batch.
+***********************************************************************************************************************************/
+static bool
+archiveGetAsyncBatch(const StringList *const requestList, const bool resident)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STRING_LIST, requestList);
+        FUNCTION_LOG_PARAM(BOOL, resident);
+    FUNCTION_LOG_END();
+
+    ASSERT(requestList != NULL);
+    ASSERT(!strLstEmpty(requestList));
+
+    bool result = true;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        LOG_INFO_FMT(
+            "get %u WAL file(s) from archive: %s%s",
+            strLstSize(requestList), strZ(strLstGet(requestList, 0)),
+            strLstSize(requestList) == 1 ?
+                "" : zNewFmt("...%s", strZ(strLstGet(requestList, strLstSize(requestList) - 1))));
+
+        // Check for archive files
+        const ArchiveGetCheckResult checkResult = archiveGetCheck(requestList);
+
+        // If any files are missing get the first one (used to construct the "unable to find" warning)
+        const String *archiveFileMissing = NULL;
+
+        if (lstSize(checkResult.archiveFileMapList) < strLstSize(requestList))
+            archiveFileMissing = strLstGet(requestList, lstSize(checkResult.archiveFileMapList));
+
+        // Get archive files that were found
+        if (!lstEmpty(checkResult.archiveFileMapList))
+        {
+            // Create the parallel executor
+            ArchiveGetAsyncData jobData = {.archiveFileMapList = checkResult.archiveFileMapList};
+
+            ProtocolParallel *const parallelExec = protocolParallelNew(
+                cfgOptionUInt64(cfgOptProtocolTimeout) / 2, archiveGetAsyncCallback, &jobData);
+
+            for (unsigned int processIdx = 1; processIdx <= cfgOptionUInt(cfgOptProcessMax); processIdx++)
+                protocolParallelClientAdd(parallelExec, protocolLocalGet(protocolStorageTypeRepo, 0, processIdx));
+
+            // Keep local processes running when resident so the next batch does not need to start them again
+            if (resident)
+                protocolParallelClientKeepSet(parallelExec);
+
+            // Process jobs
+            uint64_t fileComplete = 0;
+
+            MEM_CONTEXT_TEMP_RESET_BEGIN()
+            {
+                do
+                {
+                    const unsigned int completed = protocolParallelProcess(parallelExec);
+                    fileComplete += completed;
+
+                    for (unsigned int jobIdx = 0; jobIdx < completed; jobIdx++)
+                    {
+                        // Get the job
+                        ProtocolParallelJob *const job = protocolParallelResult(parallelExec);
+                        const unsigned int processId = protocolParallelJobProcessId(job);
+
+                        // Get wal segment name and archive file map
+                        const String *const walSegment = varStr(protocolParallelJobKey(job));
+                        const ArchiveFileMap *const fileMap = lstFind(checkResult.archiveFileMapList, &walSegment);
+                        ASSERT(fileMap != NULL);
+
+                        // Build warnings for status file
+                        String *const warning = strNew();
+
+                        if (!strLstEmpty(fileMap->warnList))
+                            strCatFmt(warning, "%s", strZ(strLstJoin(fileMap->warnList, "\n")));
+
+                        // The job was successful
+                        if (protocolParallelJobErrorCode(job) == 0)
+                        {
+                            // Get the actual file retrieved
+                            PackRead *const fileResult = protocolParallelJobResult(job);
+                            const ArchiveGetFile *const file = lstGet(fileMap->actualList, pckReadU32P(fileResult));
+                            ASSERT(file != NULL);
+
+                            // Output file warnings
+                            const StringList *const fileWarnList = pckReadStrLstP(fileResult);
+
+                            for (unsigned int warnIdx = 0; warnIdx < strLstSize(fileWarnList); warnIdx++)
+                                LOG_WARN_PID(processId, strZ(strLstGet(fileWarnList, warnIdx)));
+
+                            // Build file warnings for status file
+                            if (!strLstEmpty(fileWarnList))
                             {
-                                LOG_WARN_PID_FMT(
-                                    processId, "[%s] %s", errorTypeName(errorTypeFromCode(protocolParallelJobErrorCode(job))),
-                                    strZ(protocolParallelJobErrorMessage(job)));
-
-                                archiveAsyncStatusErrorWrite(
-                                    archiveModeGet, walSegment, protocolParallelJobErrorCode(job),
-                                    strNewFmt(
-                                        "%s%s", strZ(protocolParallelJobErrorMessage(job)),
-                                        strSize(warning) == 0 ? "" : zNewFmt("\n%s", strZ(warning))));
+                                strCatFmt(
+                                    warning, "%s%s", strSize(warning) == 0 ? "" : "\n", strZ(strLstJoin(fileWarnList, "\n")));
                             }
 
-                            protocolParallelJobFree(job);
+                            if (strSize(warning) != 0)
+                                archiveAsyncStatusOkWrite(archiveModeGet, walSegment, warning);
+
+                            LOG_DETAIL_PID_FMT(
+                                processId, FOUND_IN_REPO_ARCHIVE_MSG, strZ(walSegment),
+                                cfgOptionGroupName(cfgOptGrpRepo, file->repoIdx), strZ(file->archiveId));
+
+                            // Rename temp WAL segment to actual name. This is done after the ok file is written so the ok file
+                            // is guaranteed to exist before the foreground process finds the WAL segment.
+                            storageMoveP(
+                                storageSpoolWrite(),
+                                storageNewReadP(
+                                    storageSpool(),
+                                    strNewFmt(STORAGE_SPOOL_ARCHIVE_IN "/%s." STORAGE_FILE_TEMP_EXT, strZ(walSegment))),
+                                storageNewWriteP(
+                                    storageSpoolWrite(), strNewFmt(STORAGE_SPOOL_ARCHIVE_IN "/%s", strZ(walSegment))));
+                        }
+                        // Else the job errored
+                        else
+                        {
+                            LOG_WARN_PID_FMT(
+                                processId, "[%s] %s", errorTypeName(errorTypeFromCode(protocolParallelJobErrorCode(job))),
+                                strZ(protocolParallelJobErrorMessage(job)));
+
+                            archiveAsyncStatusErrorWrite(
+                                archiveModeGet, walSegment, protocolParallelJobErrorCode(job),
+                                strNewFmt(
+                                    "%s%s", strZ(protocolParallelJobErrorMessage(job)),
+                                    strSize(warning) == 0 ? "" : zNewFmt("\n%s", strZ(warning))));
+
+                            // The index may list files that are no longer in the repo so remove it to be rebuilt on the next run
+                            storagePathRemoveP(storageSpoolWrite(), STRDEF(ARCHIVE_GET_INDEX_PATH), .recurse = true);
+
+                            result = false;
                         }
 
-                        // Reset the memory context occasionally so we don't use too much memory or slow down processing
-                        MEM_CONTEXT_TEMP_RESET(1000);
+                        protocolParallelJobFree(job);
                     }
-                    while (!protocolParallelDone(parallelExec));
+
+                    // Update metrics
+                    cmdMetricsWriteP(
+                        .force = protocolParallelDone(parallelExec), .fileComplete = fileComplete,
+                        .fileTotal = lstSize(checkResult.archiveFileMapList));
+
+                    // Reset the memory context occasionally so we don't use too much memory or slow down processing
+                    MEM_CONTEXT_TEMP_RESET(1000);
                 }
-                MEM_CONTEXT_TEMP_END();
+                while (!protocolParallelDone(parallelExec));
             }
+            MEM_CONTEXT_TEMP_END();
+        }
 
-            // Log an error from archiveGetCheck() after any existing files have been fetched. This ordering is important because we
-            // need to fetch as many valid files as possible before throwing an error.
-            if (checkResult.errorType != NULL)
-            {
-                LOG_WARN_FMT("[%s] %s", errorTypeName(checkResult.errorType), strZ(checkResult.errorMessage));
+        // Log an error from archiveGetCheck() after any existing files have been fetched. This ordering is important because we
+        // need to fetch as many valid files as possible before throwing an error.
+        if (checkResult.errorType != NULL)
+        {
+            LOG_WARN_FMT("[%s] %s", errorTypeName(checkResult.errorType), strZ(checkResult.errorMessage));
 
-                String *const message = strCat(strNew(), checkResult.errorMessage);
+            String *const message = strCat(strNew(), checkResult.errorMessage);
 
-                if (!strLstEmpty(checkResult.warnList))
-                    strCatFmt(message, "\n%s", strZ(strLstJoin(checkResult.warnList, "\n")));
+            if (!strLstEmpty(checkResult.warnList))
+                strCatFmt(message, "\n%s", strZ(strLstJoin(checkResult.warnList, "\n")));
 
-                archiveAsyncStatusErrorWrite(
-                    archiveModeGet, checkResult.errorFile, errorTypeCode(checkResult.errorType), message);
-            }
-            // If any files were missing write an ok file for the first missing file and add any warnings. It is important that this
-            // happen right before the async process exits so the main process can immediately respawn the async process to retry
-            // missing files.
-            else if (archiveFileMissing != NULL)
+            archiveAsyncStatusErrorWrite(
+                archiveModeGet, checkResult.errorFile, errorTypeCode(checkResult.errorType), message);
+
+            result = false;
+        }
+        // If any files were missing write an ok file for the first missing file and add any warnings. It is important that this
+        // happen right before the async process exits so the main process can immediately respawn the async process to retry
+        // missing files.
+        else if (archiveFileMissing != NULL)
+        {
+            LOG_DETAIL_FMT(UNABLE_TO_FIND_IN_ARCHIVE_MSG, strZ(archiveFileMissing));
+
+            const String *message = NULL;
+
+            if (!strLstEmpty(checkResult.warnList))
+                message = strLstJoin(checkResult.warnList, "\n");
+
+            archiveAsyncStatusOkWrite(archiveModeGet, archiveFileMissing, message);
+
+            result = false;
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN(BOOL, result);
+}
+
+FN_EXTERN void
+cmdArchiveGetAsync(void)
+{
+    FUNCTION_LOG_VOID(logLevelDebug);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        TRY_BEGIN()
+        {
+            // PostgreSQL must be local
+            pgIsLocalVerify();
+
+            // Check the parameters
+            if (strLstSize(cfgCommandParam()) < 1)
+                THROW(ParamInvalidError, "at least one wal segment is required");
+
+            // Get the segments requested by archive-get. When resident, continue with more segments as long as PostgreSQL needs
+            // them and every segment is found.
+            const bool resident = cfgOptionUInt64(cfgOptArchiveGetResident) > 0;
+            ArchiveGetAsyncResident residentData;
+            StringList *requestList = strLstDup(cfgCommandParam());
+
+            if (resident)
+                archiveGetAsyncResidentInit(&residentData, requestList);
+
+            do
             {
-                LOG_DETAIL_FMT(UNABLE_TO_FIND_IN_ARCHIVE_MSG, strZ(archiveFileMissing));
+                const TimeMSec timeBegin = timeMSec();
+                const bool complete = archiveGetAsyncBatch(requestList, resident);
 
-                const String *message = NULL;
+                // Update the time for a process to fetch a segment
+                const unsigned int processTotal = cfgOptionUInt(cfgOptProcessMax) < strLstSize(requestList) ?
+                    cfgOptionUInt(cfgOptProcessMax) : strLstSize(requestList);
 
-                if (!strLstEmpty(checkResult.warnList))
-                    message = strLstJoin(checkResult.warnList, "\n");
+                if (resident)
+                {
+                    residentData.fetchTime = archiveGetAsyncAverage(
+                        residentData.fetchTime, (timeMSec() - timeBegin) * processTotal / strLstSize(requestList));
+                }
 
-                archiveAsyncStatusOkWrite(archiveModeGet, archiveFileMissing, message);
+                strLstFree(requestList);
+                requestList = resident && complete ? archiveGetAsyncResidentNext(&residentData) : NULL;
             }
+            while (requestList != NULL);
         }
         // On any global error write a single error file to cover all unprocessed files
         CATCH_ANY()
@@ -6,6 +6,7 @@ Archive Push File
 #include "command/archive/common.h"
 #include "command/archive/find.h"
 #include "command/archive/push/file.h"
+#include "command/archive/push/walCheck.h"
 #include "command/control/common.h"
 #include "common/crypto/cipherBlock.h"
 #include "common/crypto/hash.h"
@@ -95,13 +96,14 @@ archivePushFileIo(
 /**********************************************************************************************************************************/
 FN_EXTERN ArchivePushFileResult
 archivePushFile(
-    const String *const walSource, const bool headerCheck, const bool modeCheck, const unsigned int pgVersion,
-    const uint64_t pgSystemId, const String *const archiveFile, const CompressType compressType, const int compressLevel,
-    const List *const repoList, const StringList *const priorErrorList)
+    const String *const walSource, const bool headerCheck, const bool recordCheck, const bool modeCheck,
+    const unsigned int pgVersion, const uint64_t pgSystemId, const String *const archiveFile, const CompressType compressType,
+    const int compressLevel, const List *const repoList, const StringList *const priorErrorList)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(STRING, walSource);
         FUNCTION_LOG_PARAM(BOOL, headerCheck);
+        FUNCTION_LOG_PARAM(BOOL, recordCheck);
         FUNCTION_LOG_PARAM(BOOL, modeCheck);
         FUNCTION_LOG_PARAM(UINT, pgVersion);
         FUNCTION_LOG_PARAM(UINT64, pgSystemId);
@@ -163,6 +165,12 @@ archivePushFile(
             // Generate a sha1 checksum for the wal segment
             IoRead *const read = storageReadIo(storageNewReadP(storageLocal(), walSource));
             ioFilterGroupAdd(ioReadFilterGroup(read), cryptoHashNew(hashTypeSha1));
+
+            // Check the CRC of all records in the segment while it is being read. Partial segments are skipped since they end
+            // mid-segment without a switch record, which the check would report as an invalid record.
+            if (recordCheck && !walIsPartial(archiveFile))
+                ioFilterGroupAdd(ioReadFilterGroup(read), walCheckNew(pgVersion));
+
             ioReadDrain(read);
 
             const String *const walSegmentChecksum = strNewEncode(
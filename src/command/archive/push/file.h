@@ -31,7 +31,7 @@ typedef struct ArchivePushFileResult
 
 // Copy a file from the source to the archive
 FN_EXTERN ArchivePushFileResult archivePushFile(
-    const String *walSource, bool headerCheck, bool modeCheck, unsigned int pgVersion, uint64_t pgSystemId,
+    const String *walSource, bool headerCheck, bool recordCheck, bool modeCheck, unsigned int pgVersion, uint64_t pgSystemId,
     const String *archiveFile, CompressType compressType, int compressLevel, const List *repoList,
     const StringList *priorErrorList);
 
@@ -29,6 +29,7 @@ archivePushFileProtocol(PackRead *const param)
         // Read parameters
         const String *const walSource = pckReadStrP(param);
         const bool headerCheck = pckReadBoolP(param);
+        const bool recordCheck = pckReadBoolP(param);
         const bool modeCheck = pckReadBoolP(param);
         const unsigned int pgVersion = pckReadU32P(param);
         const uint64_t pgSystemId = pckReadU64P(param);
@@ -59,8 +60,8 @@ archivePushFileProtocol(PackRead *const param)
 
         // Push file
         const ArchivePushFileResult fileResult = archivePushFile(
-            walSource, headerCheck, modeCheck, pgVersion, pgSystemId, archiveFile, compressType, compressLevel, repoList,
-            priorErrorList);
+            walSource, headerCheck, recordCheck, modeCheck, pgVersion, pgSystemId, archiveFile, compressType, compressLevel,
+            repoList, priorErrorList);
 
         // Return result
         pckWriteStrLstP(protocolServerResultData(result), fileResult.warnList);
@@ -13,6 +13,7 @@ Archive Push Command
 #include "command/command.h"
 #include "command/control/common.h"
 #include "command/lock.h"
+#include "command/metrics.h"
 #include "common/compress/helper.h"
 #include "common/debug.h"
 #include "common/log.h"
@@ -188,6 +189,30 @@ archivePushProcessList(const String *const walPath)
     FUNCTION_LOG_RETURN(STRING_LIST, result);
 }
 
+/***********************************************************************************************************************************
+Get the modification time of a WAL segment so archive lag can be reported. Returns 0 if the segment is missing.
+***********************************************************************************************************************************/
+static time_t
+archivePushWalTime(const String *const walFile)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING, walFile);
+    FUNCTION_TEST_END();
+
+    time_t result = 0;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        const StorageInfo info = storageInfoP(storageLocal(), walFile, .ignoreMissing = true);
+
+        if (info.exists)
+            result = info.timeModified;
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN(TIME, result);
+}
+
 /***********************************************************************************************************************************
 Check that pg_control and archive.info match and get the archive id and archive cipher passphrase (if present)
 
@@ -413,9 +438,10 @@ cmdArchivePush(void)
 
                 // Push the file to the archive
                 const ArchivePushFileResult fileResult = archivePushFile(
-                    walFile, cfgOptionBool(cfgOptArchiveHeaderCheck), cfgOptionBool(cfgOptArchiveModeCheck), archiveInfo.pgVersion,
-                    archiveInfo.pgSystemId, archiveFile, compressTypeEnum(cfgOptionStrId(cfgOptCompressType)),
-                    cfgOptionInt(cfgOptCompressLevel), archiveInfo.repoList, archiveInfo.errorList);
+                    walFile, cfgOptionBool(cfgOptArchiveHeaderCheck), cfgOptionBool(cfgOptArchiveRecordCheck),
+                    cfgOptionBool(cfgOptArchiveModeCheck), archiveInfo.pgVersion, archiveInfo.pgSystemId, archiveFile,
+                    compressTypeEnum(cfgOptionStrId(cfgOptCompressType)), cfgOptionInt(cfgOptCompressLevel), archiveInfo.repoList,
+                    archiveInfo.errorList);
 
                 // If a warning was returned then log it
                 for (unsigned int warnIdx = 0; warnIdx < strLstSize(fileResult.warnList); warnIdx++)
@@ -423,6 +449,9 @@ cmdArchivePush(void)
 
                 // Log success
                 LOG_INFO_FMT("pushed WAL file '%s' to the archive", strZ(archiveFile));
+
+                // Update metrics
+                cmdMetricsWriteP(.force = true, .fileComplete = 1, .fileTotal = 1, .archiveTime = archivePushWalTime(walFile));
             }
         }
     }
@@ -469,6 +498,7 @@ archivePushAsyncCallback(void *const data, const unsigned int clientIdx)
 
             pckWriteStrP(param, strNewFmt("%s/%s", strZ(jobData->walPath), strZ(walFile)));
             pckWriteBoolP(param, cfgOptionBool(cfgOptArchiveHeaderCheck));
+            pckWriteBoolP(param, cfgOptionBool(cfgOptArchiveRecordCheck));
             pckWriteBoolP(param, cfgOptionBool(cfgOptArchiveModeCheck));
             pckWriteU32P(param, jobData->archiveInfo.pgVersion);
             pckWriteU64P(param, jobData->archiveInfo.pgSystemId);
@@ -574,6 +604,9 @@ cmdArchivePushAsync(void)
                     protocolParallelClientAdd(parallelExec, protocolLocalGet(protocolStorageTypeRepo, 0, processIdx));
 
                 // Process jobs
+                uint64_t fileComplete = 0;
+                time_t archiveTime = 0;
+
                 MEM_CONTEXT_TEMP_RESET_BEGIN()
                 {
                     do
@@ -604,6 +637,9 @@ cmdArchivePushAsync(void)
                                 // Write the status file
                                 archiveAsyncStatusOkWrite(
                                     archiveModePush, walFile, strLstEmpty(fileWarnList) ? NULL : strLstJoin(fileWarnList, "\n"));
+
+                                fileComplete++;
+                                archiveTime = archivePushWalTime(strNewFmt("%s/%s", strZ(jobData.walPath), strZ(walFile)));
                             }
                             // Else the job errored
                             else
@@ -621,6 +657,11 @@ cmdArchivePushAsync(void)
                             protocolParallelJobFree(job);
                         }
 
+                        // Update metrics
+                        cmdMetricsWriteP(
+                            .force = protocolParallelDone(parallelExec), .fileComplete = fileComplete,
+                            .fileTotal = strLstSize(jobData.walFileList), .archiveTime = archiveTime);
+
                         // Reset the memory context occasionally so we don't use too much memory or slow down processing
                         MEM_CONTEXT_TEMP_RESET(1000);
                     }
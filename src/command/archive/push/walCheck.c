@@ -0,0 +1,125 @@
+/***********************************************************************************************************************************
+WAL Record Check Filter
+***********************************************************************************************************************************/
+#include "build.auto.h"
+
+#include "command/archive/push/walCheck.h"
+#include "common/debug.h"
+#include "common/io/filter/filter.h"
+#include "common/log.h"
+#include "common/type/object.h"
+#include "common/type/pack.h"
+#include "postgres/walRecord.h"
+
+/***********************************************************************************************************************************
+Object type
+***********************************************************************************************************************************/
+typedef struct WalCheck
+{
+    PgWalRecordRead *read;                                          // Decodes records and checks the CRC
+    uint64_t recordTotal;                                           // Total records checked
+} WalCheck;
+
+/***********************************************************************************************************************************
+Macros for function logging
+***********************************************************************************************************************************/
+static void
+walCheckToLog(const WalCheck *const this, StringStatic *const debugLog)
+{
+    strStcFmt(debugLog, "{recordTotal: %" PRIu64 "}", this->recordTotal);
+}
+
+#define FUNCTION_LOG_WAL_CHECK_TYPE                                                                                                \
+    WalCheck *
+#define FUNCTION_LOG_WAL_CHECK_FORMAT(value, buffer, bufferSize)                                                                   \
+    FUNCTION_LOG_OBJECT_FORMAT(value, walCheckToLog, buffer, bufferSize)
+
+/***********************************************************************************************************************************
+Count records that passed the check
+***********************************************************************************************************************************/
+static void
+walCheckRecord(void *const data, const PgWalRecord *const record)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, data);
+        FUNCTION_TEST_PARAM_P(VOID, record);
+    FUNCTION_TEST_END();
+
+    ASSERT(data != NULL);
+    ASSERT(record != NULL);
+    (void)record;                                                   // Unused when asserts are disabled
+
+    ((WalCheck *)data)->recordTotal++;
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Check records in the input
+***********************************************************************************************************************************/
+static void
+walCheckProcess(THIS_VOID, const Buffer *const input)
+{
+    THIS(WalCheck);
+
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(WAL_CHECK, this);
+        FUNCTION_LOG_PARAM(BUFFER, input);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(input != NULL);
+
+    pgWalRecordReadProcess(this->read, input);
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Return the total records checked
+***********************************************************************************************************************************/
+static Pack *
+walCheckResult(THIS_VOID)
+{
+    THIS(WalCheck);
+
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(WAL_CHECK, this);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+
+    Pack *result = NULL;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        PackWrite *const packWrite = pckWriteNewP();
+
+        pckWriteU64P(packWrite, this->recordTotal);
+        pckWriteEndP(packWrite);
+
+        result = pckMove(pckWriteResult(packWrite), memContextPrior());
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN(PACK, result);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN IoFilter *
+walCheckNew(const unsigned int pgVersion)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(UINT, pgVersion);
+    FUNCTION_LOG_END();
+
+    OBJ_NEW_BEGIN(WalCheck, .childQty = MEM_CONTEXT_QTY_MAX)
+    {
+        *this = (WalCheck){0};
+        this->read = pgWalRecordReadNew(pgVersion, true, walCheckRecord, this);
+    }
+    OBJ_NEW_END();
+
+    FUNCTION_LOG_RETURN(
+        IO_FILTER, ioFilterNewP(WAL_CHECK_FILTER_TYPE, this, NULL, .in = walCheckProcess, .result = walCheckResult));
+}
@@ -0,0 +1,22 @@
+/***********************************************************************************************************************************
+WAL Record Check Filter
+
+Check the CRC of every record in a WAL segment as it passes through the filter. Records that start in the prior segment or continue
+into the next segment cannot be checked since only one segment is available. The filter result is the total records checked.
+***********************************************************************************************************************************/
+#ifndef COMMAND_ARCHIVE_PUSH_WAL_CHECK_H
+#define COMMAND_ARCHIVE_PUSH_WAL_CHECK_H
+
+#include "common/io/filter/filter.h"
+
+/***********************************************************************************************************************************
+Filter type constant
+***********************************************************************************************************************************/
+#define WAL_CHECK_FILTER_TYPE                                       STRID5("wal-chk", 0x2d03db0370)
+
+/***********************************************************************************************************************************
+Constructors
+***********************************************************************************************************************************/
+FN_EXTERN IoFilter *walCheckNew(unsigned int pgVersion);
+
+#endif
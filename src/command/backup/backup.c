@@ -10,17 +10,22 @@ Backup Command
 
 #include "command/archive/find.h"
 #include "command/backup/backup.h"
+#include "command/backup/bundle.h"
 #include "command/backup/common.h"
 #include "command/backup/file.h"
 #include "command/backup/protocol.h"
+#include "command/backup/walChange.h"
 #include "command/check/common.h"
 #include "command/control/common.h"
 #include "command/lock.h"
+#include "command/metrics.h"
 #include "command/stanza/common.h"
 #include "common/compress/helper.h"
 #include "common/crypto/cipherBlock.h"
+#include "common/crypto/hash.h"
 #include "common/debug.h"
 #include "common/io/filter/size.h"
+#include "common/io/io.h"
 #include "common/log.h"
 #include "common/regExp.h"
 #include "common/time.h"
@@ -148,6 +153,14 @@ Get the postgres database and storage objects
 #define FUNCTION_LOG_BACKUP_DATA_FORMAT(value, buffer, bufferSize)                                                                 \
     objNameToLog(value, "BackupData", buffer, bufferSize)
 
+typedef struct BackupStandby
+{
+    unsigned int pgIdx;                                             // cfgOptGrpPg index of the standby
+    Db *db;                                                         // Database connection to the standby
+    const Storage *storage;                                         // Storage object for the standby
+    const String *host;                                             // Host name of the standby
+} BackupStandby;
+
 typedef struct BackupData
 {
     unsigned int pgIdxPrimary;                                      // cfgOptGrpPg index of the primary
@@ -155,10 +168,7 @@ typedef struct BackupData
     const Storage *storagePrimary;                                  // Storage object for the primary
     const String *hostPrimary;                                      // Host name of the primary
 
-    unsigned int pgIdxStandby;                                      // cfgOptGrpPg index of the standby
-    Db *dbStandby;                                                  // Database connection to the standby
-    const Storage *storageStandby;                                  // Storage object for the standby
-    const String *hostStandby;                                      // Host name of the standby
+    List *standbyList;                                              // Standbys to copy files from (empty when not from standby)
 
     const InfoArchive *archiveInfo;                                 // Archive info
     const String *archiveId;                                        // Archive where backup WAL will be stored
@@ -167,6 +177,7 @@ typedef struct BackupData
     unsigned int version;                                           // PostgreSQL version
     unsigned int walSegmentSize;                                    // PostgreSQL wal segment size
     PgPageSize pageSize;                                            // PostgreSQL page size
+    unsigned int segmentBlockTotal;                                 // PostgreSQL blocks per relation segment
 } BackupData;
 
 static BackupData *
@@ -182,7 +193,7 @@ backupInit(const InfoBackup *const infoBackup)
 
     // Initialize for offline backup
     BackupData *const result = memNew(sizeof(BackupData));
-    *result = (BackupData){0};
+    *result = (BackupData){.standbyList = lstNewP(sizeof(BackupStandby))};
 
     // Don't allow backup from standby when offline
     StringId backupStandby = cfgOptionStrId(cfgOptBackupStandby);
@@ -200,7 +211,8 @@ backupInit(const InfoBackup *const infoBackup)
 
     if (cfgOptionBool(cfgOptOnline))
     {
-        const DbGetResult dbInfo = dbGet(backupStandby == CFGOPTVAL_BACKUP_STANDBY_N, true, backupStandby);
+        const DbGetResult dbInfo = dbGet(
+            backupStandby == CFGOPTVAL_BACKUP_STANDBY_N, true, backupStandby, backupStandby != CFGOPTVAL_BACKUP_STANDBY_N);
 
         // If no standby was found but using the primary is allowed then warn and proceed
         if (backupStandby == CFGOPTVAL_BACKUP_STANDBY_PREFER && dbInfo.standby == NULL)
@@ -209,14 +221,21 @@ backupInit(const InfoBackup *const infoBackup)
         result->pgIdxPrimary = dbInfo.primaryIdx;
         result->dbPrimary = dbInfo.primary;
 
+        // Copy files from all standbys found so the read load is spread across them
         if (dbInfo.standby != NULL)
         {
-            ASSERT(dbInfo.standby != NULL);
+            ASSERT(dbInfo.standbyList != NULL);
 
-            result->pgIdxStandby = dbInfo.standbyIdx;
-            result->dbStandby = dbInfo.standby;
-            result->storageStandby = storagePgIdx(result->pgIdxStandby);
-            result->hostStandby = cfgOptionIdxStrNull(cfgOptPgHost, result->pgIdxStandby);
+            for (unsigned int standbyIdx = 0; standbyIdx < lstSize(dbInfo.standbyList); standbyIdx++)
+            {
+                const DbGetResultStandby *const standby = lstGet(dbInfo.standbyList, standbyIdx);
+
+                lstAdd(
+                    result->standbyList,
+                    &(BackupStandby){
+                        .pgIdx = standby->idx, .db = standby->db, .storage = storagePgIdx(standby->idx),
+                        .host = cfgOptionIdxStrNull(cfgOptPgHost, standby->idx)});
+            }
         }
 
         // Get pg_control info from the primary
@@ -234,6 +253,7 @@ backupInit(const InfoBackup *const infoBackup)
     result->version = pgControl.version;
     result->walSegmentSize = pgControl.walSegmentSize;
     result->pageSize = pgControl.pageSize;
+    result->segmentBlockTotal = pgControl.segmentBlockTotal;
 
     // Validate pg_control info against the stanza
     if (result->version != infoPg.version || pgControl.systemId != infoPg.systemId)
@@ -655,18 +675,152 @@ backupBuildIncrPrior(const InfoBackup *const infoBackup)
     FUNCTION_LOG_RETURN(MANIFEST, result);
 }
 
+// Helper to find files that have not changed since the prior backup by decoding the WAL archived since the prior backup started.
+// Returns a sorted list of manifest file names or NULL when WAL cannot be used.
+static StringList *
+backupBuildIncrWalChange(
+    const BackupData *const backupData, const Manifest *const manifest, const Manifest *const manifestPrior,
+    const String *const lsnStart, const String *const archiveStart)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM_P(VOID, backupData);
+        FUNCTION_LOG_PARAM(MANIFEST, manifest);
+        FUNCTION_LOG_PARAM(MANIFEST, manifestPrior);
+        FUNCTION_LOG_PARAM(STRING, lsnStart);
+        FUNCTION_LOG_PARAM(STRING, archiveStart);
+    FUNCTION_LOG_END();
+
+    ASSERT(backupData != NULL);
+    ASSERT(manifest != NULL);
+    ASSERT(manifestPrior != NULL);
+
+    StringList *result = NULL;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        const ManifestData *const manifestPriorData = manifestData(manifestPrior);
+
+        // WAL can only be used when both backups are online on the same timeline. Hash indexes are not WAL-logged before
+        // PostgreSQL 10 so files that are not referenced by WAL may still have changed.
+        if (cfgOptionBool(cfgOptWalChange) && lsnStart != NULL && archiveStart != NULL && manifestPriorData->lsnStart != NULL &&
+            manifestPriorData->archiveStart != NULL &&
+            strEq(strSubN(archiveStart, 0, 8), strSubN(manifestPriorData->archiveStart, 0, 8)))
+        {
+            if (backupData->version < PG_VERSION_10)
+            {
+                LOG_WARN_FMT(
+                    "option '" CFGOPT_WAL_CHANGE "' is not supported for " PG_NAME " < %s", strZ(pgVersionToStr(PG_VERSION_10)));
+            }
+            else
+            {
+                TRY_BEGIN()
+                {
+                    // Decode WAL from the start of the prior backup through the segment containing the start of this backup
+                    const uint64_t lsnBegin = pgLsnFromStr(manifestPriorData->lsnStart);
+                    const uint64_t lsnEnd = pgLsnFromStr(lsnStart);
+
+                    LOG_INFO_FMT(
+                        "find changes in WAL segment(s) %s:%s",
+                        strZ(pgLsnToWalSegment(backupData->timeline, lsnBegin, backupData->walSegmentSize)),
+                        strZ(pgLsnToWalSegment(backupData->timeline, lsnEnd, backupData->walSegmentSize)));
+
+                    // Switch WAL so the last segment will be archived
+                    dbWalSwitch(backupData->dbPrimary);
+
+                    // Decode all segments in the range
+                    const StringList *const walSegmentList = pgLsnRangeToWalSegmentList(
+                        backupData->timeline, lsnBegin, lsnEnd, backupData->walSegmentSize);
+                    WalSegmentFind *const find = walSegmentFindNew(
+                        storageRepo(), backupData->archiveId, strLstSize(walSegmentList) == 1,
+                        cfgOptionUInt64(cfgOptArchiveTimeout));
+                    WalChange *const walChange = walChangeNew(backupData->version, backupData->segmentBlockTotal);
+                    Buffer *const buffer = bufNew(ioBufferSize());
+
+                    for (unsigned int walSegmentIdx = 0; walSegmentIdx < strLstSize(walSegmentList); walSegmentIdx++)
+                    {
+                        MEM_CONTEXT_TEMP_BEGIN()
+                        {
+                            const String *const archiveFile = walSegmentFind(find, strLstGet(walSegmentList, walSegmentIdx));
+
+                            StorageRead *const read = storageNewReadP(
+                                storageRepo(),
+                                strNewFmt(STORAGE_REPO_ARCHIVE "/%s/%s", strZ(backupData->archiveId), strZ(archiveFile)));
+                            IoFilterGroup *const filterGroup = ioReadFilterGroup(storageReadIo(read));
+
+                            // Decrypt with archive key if encrypted
+                            cipherBlockFilterGroupAdd(
+                                filterGroup, cfgOptionStrId(cfgOptRepoCipherType), cipherModeDecrypt,
+                                infoArchiveCipherPass(backupData->archiveInfo));
+
+                            // Decompress if compressed
+                            const CompressType compressType = compressTypeFromName(archiveFile);
+
+                            if (compressType != compressTypeNone)
+                                ioFilterGroupAdd(filterGroup, decompressFilterP(compressType));
+
+                            // Decode the segment
+                            ioReadOpen(storageReadIo(read));
+
+                            do
+                            {
+                                ioRead(storageReadIo(read), buffer);
+                                walChangeProcess(walChange, buffer);
+                                bufUsedZero(buffer);
+                            }
+                            while (!ioReadEof(storageReadIo(read)));
+
+                            ioReadClose(storageReadIo(read));
+                        }
+                        MEM_CONTEXT_TEMP_END();
+                    }
+
+                    // Build a list of files that exist in the prior backup and have not changed
+                    StringList *const fileSameList = strLstNew();
+
+                    for (unsigned int fileIdx = 0; fileIdx < manifestFileTotal(manifest); fileIdx++)
+                    {
+                        const String *const fileName = manifestFileNameGet(manifest, fileIdx);
+
+                        if (manifestFileExists(manifestPrior, fileName) && !walChangeFile(walChange, fileName))
+                            strLstAdd(fileSameList, fileName);
+                    }
+
+                    LOG_DETAIL_FMT(
+                        "%u relation segment(s) changed in WAL, %u file(s) unchanged since prior backup", walChangeSize(walChange),
+                        strLstSize(fileSameList));
+
+                    result = strLstMove(strLstSort(fileSameList, sortOrderAsc), memContextPrior());
+                }
+                CATCH_ANY()
+                {
+                    LOG_WARN_FMT(
+                        "unable to find changes in WAL since prior backup: [%s] %s", errorTypeName(errorType()), errorMessage());
+                }
+                TRY_END();
+            }
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN(STRING_LIST, result);
+}
+
 static bool
 backupBuildIncr(
-    const InfoBackup *const infoBackup, Manifest *const manifest, Manifest *const manifestPrior, const String *const archiveStart)
+    const InfoBackup *const infoBackup, const BackupData *const backupData, Manifest *const manifest, Manifest *const manifestPrior,
+    const String *const lsnStart, const String *const archiveStart)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(INFO_BACKUP, infoBackup);
+        FUNCTION_LOG_PARAM_P(VOID, backupData);
         FUNCTION_LOG_PARAM(MANIFEST, manifest);
         FUNCTION_LOG_PARAM(MANIFEST, manifestPrior);
+        FUNCTION_LOG_PARAM(STRING, lsnStart);
         FUNCTION_LOG_PARAM(STRING, archiveStart);
     FUNCTION_LOG_END();
 
     ASSERT(infoBackup != NULL);
+    ASSERT(backupData != NULL);
     ASSERT(manifest != NULL);
 
     bool result = false;
@@ -679,8 +833,12 @@ backupBuildIncr(
             // Move the manifest to this context so it will be freed when we are done
             manifestMove(manifestPrior, MEM_CONTEXT_TEMP());
 
+            // Find files that have not changed since the prior backup when enabled
+            const StringList *const fileSameList = backupBuildIncrWalChange(
+                backupData, manifest, manifestPrior, lsnStart, archiveStart);
+
             // Build incremental manifest
-            manifestBuildIncr(manifest, manifestPrior, (BackupType)cfgOptionStrId(cfgOptType), archiveStart);
+            manifestBuildIncr(manifest, manifestPrior, (BackupType)cfgOptionStrId(cfgOptType), archiveStart, fileSameList);
 
             // Set the cipher subpass from prior manifest since we want a single subpass for the entire backup set
             manifestCipherSubPassSet(manifest, manifestCipherSubPass(manifestPrior));
@@ -1036,6 +1194,112 @@ backupResume(Manifest *const manifest, const String *const cipherPassBackup)
     FUNCTION_LOG_RETURN(BOOL, result);
 }
 
+/***********************************************************************************************************************************
+Wait for replay on the standbys to reach the backup start lsn. All standbys are checked in the same wait loop so the wait is only as
+long as the slowest standby. The first standby is required, but the other standbys only spread the read load so a standby that
+cannot reach the lsn before the timeout (e.g. because replay is lagging) is dropped with a warning.
+***********************************************************************************************************************************/
+static void
+backupStandbyReplayWait(const BackupData *const backupData, const String *const lsn)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(BACKUP_DATA, backupData);
+        FUNCTION_LOG_PARAM(STRING, lsn);
+    FUNCTION_LOG_END();
+
+    ASSERT(backupData != NULL);
+    ASSERT(!lstEmpty(backupData->standbyList));
+    ASSERT(lsn != NULL);
+
+    LOG_INFO_FMT("wait for replay on the standby%s to reach %s", lstSize(backupData->standbyList) > 1 ? "s" : "", strZ(lsn));
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Replay waits in the same order as the standby list. A wait is set to NULL when replay on the standby is complete.
+        List *const replayWaitList = lstNewP(sizeof(DbReplayWait *));
+        bool begin = true;
+        volatile bool wait;
+
+        do
+        {
+            unsigned int standbyIdx = 0;
+            volatile bool sleep = true;
+
+            wait = false;
+
+            while (standbyIdx < lstSize(backupData->standbyList))
+            {
+                const BackupStandby *const standby = lstGet(backupData->standbyList, standbyIdx);
+                bool drop = false;
+
+                TRY_BEGIN()
+                {
+                    // Begin waiting on the first pass
+                    if (begin)
+                    {
+                        DbReplayWait *const replayWait = dbReplayWaitNew(
+                            standby->db, lsn, backupData->timeline, cfgOptionUInt64(cfgOptArchiveTimeout));
+
+                        lstAdd(replayWaitList, &replayWait);
+                    }
+
+                    DbReplayWait **const replayWait = lstGet(replayWaitList, standbyIdx);
+
+                    if (*replayWait != NULL)
+                    {
+                        // Wait before checking again but only sleep once per pass since all standbys are checked after the sleep
+                        if (!begin)
+                        {
+                            dbReplayWaitMore(*replayWait, sleep);
+                            sleep = false;
+                        }
+
+                        if (dbReplayWaitCheck(*replayWait))
+                            *replayWait = NULL;
+                        else
+                            wait = true;
+                    }
+                }
+                CATCH_ANY()
+                {
+                    // The first standby is required
+                    if (standbyIdx == 0)
+                        RETHROW();
+
+                    LOG_WARN_FMT(
+                        "unable to copy files from standby %s: [%s] %s", cfgOptionGroupName(cfgOptGrpPg, standby->pgIdx),
+                        errorTypeName(errorType()), errorMessage());
+
+                    drop = true;
+                }
+                TRY_END();
+
+                // Free the standby and remove it from the lists
+                if (drop)
+                {
+                    dbFree(standby->db);
+                    protocolHelperFree(protocolRemoteGet(protocolStorageTypePg, standby->pgIdx, false));
+
+                    if (standbyIdx < lstSize(replayWaitList))
+                        lstRemoveIdx(replayWaitList, standbyIdx);
+
+                    lstRemoveIdx(backupData->standbyList, standbyIdx);
+                }
+                else
+                    standbyIdx++;
+            }
+
+            begin = false;
+        }
+        while (wait);
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    LOG_INFO_FMT("replay on the standby%s reached %s", lstSize(backupData->standbyList) > 1 ? "s" : "", strZ(lsn));
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Start the backup
 ***********************************************************************************************************************************/
@@ -1108,12 +1372,8 @@ backupStart(const BackupData *const backupData)
             LOG_INFO_FMT("backup start archive = %s, lsn = %s", strZ(result.walSegmentName), strZ(result.lsn));
 
             // Wait for replay on the standby to catch up
-            if (backupData->dbStandby != NULL)
-            {
-                LOG_INFO_FMT("wait for replay on the standby to reach %s", strZ(result.lsn));
-                dbReplayWait(backupData->dbStandby, result.lsn, backupData->timeline, cfgOptionUInt64(cfgOptArchiveTimeout));
-                LOG_INFO_FMT("replay on the standby reached %s", strZ(result.lsn));
-            }
+            if (!lstEmpty(backupData->standbyList))
+                backupStandbyReplayWait(backupData, result.lsn);
 
             // Check that WAL segments are being archived. If archiving is not working then the backup will eventually fail so
             // better to catch it as early as possible. A segment to check may not be available on older versions of PostgreSQL or
@@ -1390,7 +1650,8 @@ static void
 backupJobResult(
     Manifest *const manifest, const String *const host, const Storage *const storagePg, StringList *const fileRemove,
     ProtocolParallelJob *const job, const bool bundle, const PgPageSize pageSize, const uint64_t sizeTotal,
-    uint64_t *const sizeProgress, unsigned int *const currentPercentComplete)
+    uint64_t *const sizeProgress, uint64_t *const sizeRepoProgress, uint64_t *const fileComplete,
+    unsigned int *const currentPercentComplete)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(MANIFEST, manifest);
@@ -1402,6 +1663,8 @@ backupJobResult(
         FUNCTION_LOG_PARAM(ENUM, pageSize);
         FUNCTION_LOG_PARAM(UINT64, sizeTotal);
         FUNCTION_LOG_PARAM_P(UINT64, sizeProgress);
+        FUNCTION_LOG_PARAM_P(UINT64, sizeRepoProgress);
+        FUNCTION_LOG_PARAM_P(UINT64, fileComplete);
         FUNCTION_LOG_PARAM_P(UINT, currentPercentComplete);
     FUNCTION_LOG_END();
 
@@ -1437,6 +1700,11 @@ backupJobResult(
                 // Increment backup copy progress. Use the original size since the size may have changed during the copy but for the
                 // purpose of reporting progress we need to increment by the original size used to generate the total size.
                 *sizeProgress += file.sizeOriginal;
+                (*fileComplete)++;
+
+                // Increment size written to the repo (used for metrics)
+                if (copyResult == backupCopyResultCopy || copyResult == backupCopyResultTruncate)
+                    *sizeRepoProgress += repoSize;
 
                 // Create log file name
                 const String *const fileName = storagePathP(storagePg, manifestPathPg(file.name));
@@ -1669,8 +1937,8 @@ backupDbPing(const BackupData *const backupData, const bool force)
     {
         dbPing(backupData->dbPrimary, force);
 
-        if (backupData->dbStandby != NULL)
-            dbPing(backupData->dbStandby, force);
+        for (unsigned int standbyIdx = 0; standbyIdx < lstSize(backupData->standbyList); standbyIdx++)
+            dbPing(((const BackupStandby *)lstGet(backupData->standbyList, standbyIdx))->db, force);
     }
 
     FUNCTION_LOG_RETURN_VOID();
@@ -1699,8 +1967,19 @@ typedef struct BackupJobData
     size_t blockIncrSizeSuper;                                      // Super block size
 
     List *queueList;                                                // List of processing queues
+    List *queueStatList;                                            // Size remaining and jobs running for each queue
+    unsigned int queueRunningMax;                                   // Preferred max jobs running from a single queue
+    List *clientQueueList;                                          // Queue the last job for each client was taken from
+    const ProtocolParallel *parallel;                               // Parallel executor running the jobs
 } BackupJobData;
 
+// Size remaining and jobs running for a processing queue
+typedef struct BackupJobQueueStat
+{
+    uint64_t size;                                                  // Size of files remaining in the queue
+    unsigned int running;                                           // Jobs running from the queue
+} BackupJobQueueStat;
+
 // Identify files that must be copied from the primary
 static bool
 backupProcessFilePrimary(RegExp *const standbyExp, const String *const name)
@@ -1733,9 +2012,9 @@ backupProcessQueueComparator(const void *const item1, const void *const item2)
     ASSERT(item1 != NULL);
     ASSERT(item2 != NULL);
 
-    // Unpack files
-    const ManifestFile file1 = manifestFileUnpack(backupProcessQueueComparatorManifest, *(const ManifestFilePack *const *)item1);
-    const ManifestFile file2 = manifestFileUnpack(backupProcessQueueComparatorManifest, *(const ManifestFilePack *const *)item2);
+    // Unpack file keys
+    const ManifestFileKey file1 = manifestFileUnpackKey(backupProcessQueueComparatorManifest, *(const ManifestFilePack *const *)item1);
+    const ManifestFileKey file2 = manifestFileUnpackKey(backupProcessQueueComparatorManifest, *(const ManifestFilePack *const *)item2);
 
     // If the size differs then that's enough to determine order
     if (!backupProcessQueueComparatorBundle || file1.size > backupProcessQueueComparatorBundleLimit ||
@@ -1780,6 +2059,7 @@ backupProcessQueue(const BackupData *const backupData, Manifest *const manifest,
     {
         // Create list of process queues (use void * instead of List * to avoid Coverity false positive)
         jobData->queueList = lstNewP(sizeof(void *));
+        jobData->queueStatList = lstNewP(sizeof(BackupJobQueueStat));
 
         // Generate the list of targets
         StringList *const targetList = strLstNew();
@@ -1802,6 +2082,7 @@ backupProcessQueue(const BackupData *const backupData, Manifest *const manifest,
             {
                 List *const queue = lstNewP(sizeof(ManifestFile *), .comparator = backupProcessQueueComparator);
                 lstAdd(jobData->queueList, &queue);
+                lstAdd(jobData->queueStatList, &(BackupJobQueueStat){0});
             }
         }
         MEM_CONTEXT_END();
@@ -1833,9 +2114,11 @@ backupProcessQueue(const BackupData *const backupData, Manifest *const manifest,
                 pgControlFound = true;
 
             // Files that must be copied from the primary are always put in queue 0 when backup from standby
+            unsigned int queueIdx = 0;
+
             if (jobData->backupStandby && backupProcessFilePrimary(jobData->standbyExp, file.name))
             {
-                lstAdd(*(List **)lstGet(jobData->queueList, 0), &filePack);
+                lstAdd(*(List **)lstGet(jobData->queueList, queueIdx), &filePack);
             }
             // Else find the correct queue by matching the file to a target
             else
@@ -1855,9 +2138,13 @@ backupProcessQueue(const BackupData *const backupData, Manifest *const manifest,
                 while (1);
 
                 // Add file to queue
-                lstAdd(*(List **)lstGet(jobData->queueList, targetIdx + queueOffset), &filePack);
+                queueIdx = targetIdx + queueOffset;
+                lstAdd(*(List **)lstGet(jobData->queueList, queueIdx), &filePack);
             }
 
+            // Add size to queue total
+            ((BackupJobQueueStat *)lstGet(jobData->queueStatList, queueIdx))->size += file.size;
+
             // Add size to total
             result += file.sizeOriginal;
 
@@ -1889,32 +2176,66 @@ backupProcessQueue(const BackupData *const backupData, Manifest *const manifest,
 
         // Move process queues to prior context
         lstMove(jobData->queueList, memContextPrior());
+        lstMove(jobData->queueStatList, memContextPrior());
     }
     MEM_CONTEXT_TEMP_END();
 
     FUNCTION_LOG_RETURN(UINT64, result);
 }
 
-// Helper to calculate the next queue to scan based on the client index
+// Helper to select the queue for the next job. The client's own queue is preferred so clients start spread across targets. When
+// that queue is empty or already has the preferred max jobs running then the client steals from the queue with the most data
+// remaining, preferring queues below the max so a single device is not thrashed. Since queues are sorted largest file first, the
+// largest files are started first and the small files left at the end balance out the finishing times of the clients. Returns -1
+// when there are no files left for the client.
 static int
-backupJobQueueNext(const unsigned int clientIdx, int queueIdx, const unsigned int queueTotal)
+backupJobQueueSelect(const BackupJobData *const jobData, const unsigned int clientIdx)
 {
     FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, jobData);
         FUNCTION_TEST_PARAM(UINT, clientIdx);
-        FUNCTION_TEST_PARAM(INT, queueIdx);
-        FUNCTION_TEST_PARAM(UINT, queueTotal);
     FUNCTION_TEST_END();
 
-    // Move (forward or back) to the next queue
-    queueIdx += clientIdx % 2 ? -1 : 1;
+    ASSERT(jobData != NULL);
+
+    // When copying from the primary during backup from standby only queue 0 will be used
+    if (jobData->backupStandby && clientIdx == 0)
+        FUNCTION_TEST_RETURN(INT, lstEmpty(*(List **)lstGet(jobData->queueList, 0)) ? -1 : 0);
+
+    const unsigned int queueOffset = jobData->backupStandby ? 1 : 0;
+    const unsigned int queueTotal = lstSize(jobData->queueList) - queueOffset;
+
+    // Use the client's own queue when it has files and has not reached the max
+    const unsigned int queueHome = clientIdx % queueTotal + queueOffset;
 
-    // Deal with wrapping on either end
-    if (queueIdx < 0)
-        FUNCTION_TEST_RETURN(INT, (int)queueTotal - 1);
-    else if (queueIdx == (int)queueTotal)
-        FUNCTION_TEST_RETURN(INT, 0);
+    if (!lstEmpty(*(List **)lstGet(jobData->queueList, queueHome)) &&
+        ((const BackupJobQueueStat *)lstGet(jobData->queueStatList, queueHome))->running < jobData->queueRunningMax)
+    {
+        FUNCTION_TEST_RETURN(INT, (int)queueHome);
+    }
+
+    // Else find the queue with the most data remaining
+    int result = -1;
+    bool resultFull = false;
+    uint64_t resultSize = 0;
+
+    for (unsigned int queueIdx = queueOffset; queueIdx < lstSize(jobData->queueList); queueIdx++)
+    {
+        if (lstEmpty(*(List **)lstGet(jobData->queueList, queueIdx)))
+            continue;
+
+        const BackupJobQueueStat *const queueStat = lstGet(jobData->queueStatList, queueIdx);
+        const bool full = queueStat->running >= jobData->queueRunningMax;
 
-    FUNCTION_TEST_RETURN(INT, queueIdx);
+        if (result == -1 || (resultFull && !full) || (resultFull == full && queueStat->size > resultSize))
+        {
+            result = (int)queueIdx;
+            resultFull = full;
+            resultSize = queueStat->size;
+        }
+    }
+
+    FUNCTION_TEST_RETURN(INT, result);
 }
 
 // Callback to fetch backup jobs for the parallel executor
@@ -1935,21 +2256,28 @@ backupJobCallback(void *const data, const unsigned int clientIdx)
         // Get a new job if there are any left
         BackupJobData *const jobData = data;
 
-        // Determine where to begin scanning the queue (we'll stop when we get back here). When copying from the primary during
-        // backup from standby only queue 0 will be used.
-        const unsigned int queueOffset = jobData->backupStandby && clientIdx > 0 ? 1 : 0;
-        int queueIdx =
-            jobData->backupStandby && clientIdx == 0 ? 0 : (int)(clientIdx % (lstSize(jobData->queueList) - queueOffset));
-        const int queueEnd = queueIdx;
+        // The client's prior job is complete so it is no longer running from the queue it was taken from
+        while (lstSize(jobData->clientQueueList) <= clientIdx)
+            lstAdd(jobData->clientQueueList, &(int){-1});
+
+        int *const clientQueueIdx = lstGet(jobData->clientQueueList, clientIdx);
+
+        if (*clientQueueIdx != -1)
+            ((BackupJobQueueStat *)lstGet(jobData->queueStatList, (unsigned int)*clientQueueIdx))->running--;
+
+        // Select the queue for the next job
+        const int queueIdx = backupJobQueueSelect(jobData, clientIdx);
+        *clientQueueIdx = queueIdx;
 
         // Create backup job
         PackWrite *param = NULL;
         uint64_t fileTotal = 0;
         uint64_t fileSize = 0;
 
-        do
+        if (queueIdx != -1)
         {
-            List *const queue = *(List **)lstGet(jobData->queueList, (unsigned int)queueIdx + queueOffset);
+            List *const queue = *(List **)lstGet(jobData->queueList, (unsigned int)queueIdx);
+            BackupJobQueueStat *const queueStat = lstGet(jobData->queueStatList, (unsigned int)queueIdx);
             unsigned int fileIdx = 0;
             bool bundle = jobData->bundle;
             const String *fileName = NULL;
@@ -2003,6 +2331,13 @@ backupJobCallback(void *const data, const unsigned int clientIdx)
                     pckWriteStrP(param, jobData->cipherSubPass);
                     pckWriteU32P(param, jobData->pageSize);
                     pckWriteStrP(param, cfgOptionStrNull(cfgOptPgVersionForce));
+
+                    // Share the rate limits among the clients that may be running jobs so the total stays under the limits when
+                    // processing is adaptive and not all clients are in use
+                    const unsigned int clientActive = protocolParallelClientActive(jobData->parallel);
+
+                    pckWriteU64P(param, backupRateLimit(cfgOptRateLimitPg, clientActive));
+                    pckWriteU64P(param, backupRateLimit(cfgOptRateLimitRepo, clientActive));
                 }
 
                 pckWriteStrP(param, manifestPathPg(file.name));
@@ -2048,39 +2383,70 @@ backupJobCallback(void *const data, const unsigned int clientIdx)
 
                 // Remove job from the queue
                 lstRemoveIdx(queue, fileIdx);
+                queueStat->size -= file.size;
 
                 // Break if not bundling or bundle size has been reached
                 if (!bundle || fileSize >= jobData->bundleSize)
                     break;
             }
 
-            if (fileTotal > 0)
-            {
-                // Assign job to result
-                MEM_CONTEXT_PRIOR_BEGIN()
-                {
-                    result = protocolParallelJobNew(
-                        bundle ? VARUINT64(jobData->bundleId) : VARSTR(fileName), PROTOCOL_COMMAND_BACKUP_FILE, param);
+            // A queue with files always yields a job since the first file is added regardless of size
+            ASSERT(fileTotal > 0);
+            queueStat->running++;
 
-                    if (bundle)
-                        jobData->bundleId++;
-                }
-                MEM_CONTEXT_PRIOR_END();
+            // Assign job to result
+            MEM_CONTEXT_PRIOR_BEGIN()
+            {
+                result = protocolParallelJobNew(
+                    bundle ? VARUINT64(jobData->bundleId) : VARSTR(fileName), PROTOCOL_COMMAND_BACKUP_FILE, param);
 
-                break;
+                if (bundle)
+                    jobData->bundleId++;
             }
-
-            // Don't get next queue when copying from primary during backup from standby since the primary only has one queue
-            if (!jobData->backupStandby || clientIdx > 0)
-                queueIdx = backupJobQueueNext(clientIdx, queueIdx, lstSize(jobData->queueList) - queueOffset);
+            MEM_CONTEXT_PRIOR_END();
         }
-        while (queueIdx != queueEnd);
     }
     MEM_CONTEXT_TEMP_END();
 
     FUNCTION_TEST_RETURN(PROTOCOL_PARALLEL_JOB, result);
 }
 
+/***********************************************************************************************************************************
+Get the standby (or NULL for the primary) that a local process copies files from. The first process always copies from the primary
+and the other processes are spread evenly across the standbys. Each process requests a new job as soon as it is free so the files
+are split between the standbys based on their throughput.
+***********************************************************************************************************************************/
+static const BackupStandby *
+backupProcessStandby(const BackupData *const backupData, const unsigned int processId)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(BACKUP_DATA, backupData);
+        FUNCTION_TEST_PARAM(UINT, processId);
+    FUNCTION_TEST_END();
+
+    ASSERT(backupData != NULL);
+    ASSERT(processId > 0);
+
+    if (processId == 1 || lstEmpty(backupData->standbyList))
+        FUNCTION_TEST_RETURN_TYPE_CONST_P(BackupStandby, NULL);
+
+    FUNCTION_TEST_RETURN_TYPE_CONST_P(
+        BackupStandby, lstGet(backupData->standbyList, (processId - 2) % lstSize(backupData->standbyList)));
+}
+
+static unsigned int
+backupProcessPgIdx(const BackupData *const backupData, const unsigned int processId)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(BACKUP_DATA, backupData);
+        FUNCTION_TEST_PARAM(UINT, processId);
+    FUNCTION_TEST_END();
+
+    const BackupStandby *const standby = backupProcessStandby(backupData, processId);
+
+    FUNCTION_TEST_RETURN(UINT, standby != NULL ? standby->pgIdx : backupData->pgIdxPrimary);
+}
+
 static void
 backupProcess(const BackupData *const backupData, Manifest *const manifest, const String *const cipherPassBackup)
 {
@@ -2101,13 +2467,13 @@ backupProcess(const BackupData *const backupData, Manifest *const manifest, cons
         const String *const backupLabel = manifestData(manifest)->backupLabel;
         const String *const backupPathExp = strNewFmt(STORAGE_REPO_BACKUP "/%s", strZ(backupLabel));
         const bool hardLink = cfgOptionBool(cfgOptRepoHardlink) && storageFeature(storageRepoWrite(), storageFeatureHardLink);
-        const bool backupStandby = backupData->dbStandby != NULL;
+        const bool backupStandby = !lstEmpty(backupData->standbyList);
 
         BackupJobData jobData =
         {
             .manifest = manifest,
             .backupLabel = backupLabel,
-            .backupStandby = backupData->dbStandby != NULL,
+            .backupStandby = backupStandby,
             .compressType = compressTypeEnum(cfgOptionStrId(cfgOptCompressType)),
             .compressLevel = cfgOptionInt(cfgOptCompressLevel),
             .cipherType = cfgOptionStrId(cfgOptRepoCipherType),
@@ -2183,17 +2549,31 @@ backupProcess(const BackupData *const backupData, Manifest *const manifest, cons
         // Create the parallel executor
         ProtocolParallel *const parallelExec = protocolParallelNew(
             cfgOptionUInt64(cfgOptProtocolTimeout) / 2, backupJobCallback, &jobData);
+        jobData.parallel = parallelExec;
 
         // First client is always on the primary
         protocolParallelClientAdd(parallelExec, protocolLocalGet(protocolStorageTypePg, backupData->pgIdxPrimary, 1));
 
-        // Create the rest of the clients on the primary or standby depending on the value of backup-standby. Note that standby
+        // Create the rest of the clients on the primary or standbys depending on the value of backup-standby. Note that standby
         // backups don't count the primary client in process-max.
         const unsigned int processMax = cfgOptionUInt(cfgOptProcessMax) + (jobData.backupStandby ? 1 : 0);
-        const unsigned int pgIdx = jobData.backupStandby ? backupData->pgIdxStandby : backupData->pgIdxPrimary;
 
         for (unsigned int processIdx = 2; processIdx <= processMax; processIdx++)
-            protocolParallelClientAdd(parallelExec, protocolLocalGet(protocolStorageTypePg, pgIdx, processIdx));
+        {
+            protocolParallelClientAdd(
+                parallelExec, protocolLocalGet(protocolStorageTypePg, backupProcessPgIdx(backupData, processIdx), processIdx));
+        }
+
+        // Spread clients evenly across the target queues so no single device runs more than its share of jobs while other queues
+        // still have files. The client copying from the primary during backup from standby only uses queue 0 so is not counted.
+        const unsigned int queueTotal = lstSize(jobData.queueList) - (jobData.backupStandby ? 1 : 0);
+
+        jobData.queueRunningMax = (processMax - (jobData.backupStandby ? 1 : 0) + queueTotal - 1) / queueTotal;
+        jobData.clientQueueList = lstNewP(sizeof(int));
+
+        // Adjust the number of processes running jobs based on throughput when requested
+        if (cfgOptionTest(cfgOptProcessMin))
+            protocolParallelClientMinSet(parallelExec, cfgOptionUInt(cfgOptProcessMin) + (jobData.backupStandby ? 1 : 0));
 
         // Maintain a list of files that need to be removed from the manifest when the backup is complete
         StringList *const fileRemove = strLstNew();
@@ -2207,6 +2587,12 @@ backupProcess(const BackupData *const backupData, Manifest *const manifest, cons
 
         // Process jobs
         uint64_t sizeProgress = 0;
+        uint64_t sizeRepoProgress = 0;
+        uint64_t fileComplete = 0;
+        uint64_t fileTotal = 0;
+
+        for (unsigned int queueIdx = 0; queueIdx < lstSize(jobData.queueList); queueIdx++)
+            fileTotal += lstSize(*(List **)lstGet(jobData.queueList, queueIdx));
 
         // Initialize percent complete and bytes completed/total
         unsigned int currentPercentComplete = 0;
@@ -2223,14 +2609,22 @@ backupProcess(const BackupData *const backupData, Manifest *const manifest, cons
                 for (unsigned int jobIdx = 0; jobIdx < completed; jobIdx++)
                 {
                     ProtocolParallelJob *const job = protocolParallelResult(parallelExec);
+                    const BackupStandby *const standby = backupProcessStandby(backupData, protocolParallelJobProcessId(job));
 
                     backupJobResult(
-                        manifest,
-                        backupStandby && protocolParallelJobProcessId(job) > 1 ? backupData->hostStandby : backupData->hostPrimary,
-                        protocolParallelJobProcessId(job) > 1 ? storagePgIdx(pgIdx) : backupData->storagePrimary,
-                        fileRemove, job, jobData.bundle, jobData.pageSize, sizeTotal, &sizeProgress, &currentPercentComplete);
+                        manifest, standby != NULL ? standby->host : backupData->hostPrimary,
+                        standby != NULL ? standby->storage : backupData->storagePrimary, fileRemove, job, jobData.bundle,
+                        jobData.pageSize, sizeTotal, &sizeProgress, &sizeRepoProgress, &fileComplete, &currentPercentComplete);
                 }
 
+                protocolParallelSizeCompleteSet(parallelExec, sizeProgress);
+
+                // Update metrics (always write when all files are complete so the final values are not lost)
+                cmdMetricsWriteP(
+                    .force = fileComplete == fileTotal, .sizeRead = sizeProgress, .sizeWrite = sizeRepoProgress,
+                    .sizeCompress = jobData.compressType != compressTypeNone ? sizeRepoProgress : 0, .fileComplete = fileComplete,
+                    .fileTotal = fileTotal, .queueList = jobData.queueList);
+
                 // A keep-alive is required here for the remote holding open the backup connection
                 protocolKeepAlive();
 
@@ -2372,7 +2766,7 @@ backupArchiveCheckCopy(const BackupData *const backupData, Manifest *const manif
 
                         // Open the archive file
                         StorageRead *const read = storageNewReadP(
-                            storageRepo(),
+                            storageRepoWrite(),
                             strNewFmt(STORAGE_REPO_ARCHIVE "/%s/%s", strZ(backupData->archiveId), strZ(archiveFile)));
                         IoFilterGroup *const filterGroup = ioReadFilterGroup(storageReadIo(read));
 
@@ -2398,20 +2792,20 @@ backupArchiveCheckCopy(const BackupData *const backupData, Manifest *const manif
                         cipherBlockFilterGroupAdd(
                             filterGroup, cfgOptionStrId(cfgOptRepoCipherType), cipherModeEncrypt, manifestCipherSubPass(manifest));
 
-                        // Add size filter last to calculate repo size
-                        ioFilterGroupAdd(filterGroup, ioSizeNew());
+                        // When the segment is not transformed it can be copied by the storage driver (e.g. a server-side copy on
+                        // object stores). Otherwise add size filter last to calculate repo size.
+                        const bool copyServer = ioFilterGroupSize(filterGroup) == 0 && storageCopyServer(storageRepoWrite());
+
+                        if (!copyServer)
+                            ioFilterGroupAdd(filterGroup, ioSizeNew());
 
                         // Copy the file
                         const String *const manifestName = strNewFmt(
                             MANIFEST_TARGET_PGDATA "/%s/%s", strZ(pgWalPath(manifestData(manifest)->pgVersion)), strZ(walSegment));
+                        const String *const repoFile = backupFileRepoPathP(
+                            manifestData(manifest)->backupLabel, manifestName, 0, backupCompressType, false);
 
-                        storageCopyP(
-                            read,
-                            storageNewWriteP(
-                                storageRepoWrite(),
-                                backupFileRepoPathP(
-                                    manifestData(manifest)->backupLabel, manifestName, 0,
-                                    compressTypeEnum(cfgOptionStrId(cfgOptCompressType)), false)));
+                        storageCopyP(read, storageNewWriteP(storageRepoWrite(), repoFile), .storage = storageRepoWrite());
 
                         // Add to manifest
                         ManifestFile file =
@@ -2422,7 +2816,10 @@ backupArchiveCheckCopy(const BackupData *const backupData, Manifest *const manif
                             .group = basePath->group,
                             .size = backupData->walSegmentSize,
                             .sizeOriginal = backupData->walSegmentSize,
-                            .sizeRepo = pckReadU64P(ioFilterGroupResultP(filterGroup, SIZE_FILTER_TYPE)),
+                            .sizeRepo =
+                                copyServer ?
+                                    storageInfoP(storageRepoWrite(), repoFile).size :
+                                    pckReadU64P(ioFilterGroupResultP(filterGroup, SIZE_FILTER_TYPE)),
                             .timestamp = manifestData(manifest)->backupTimestampStop,
                             .checksumSha1 = bufPtr(bufNewDecode(encodingHex, strSubN(archiveFile, 25, 40))),
                         };
@@ -2465,11 +2862,12 @@ backupComplete(InfoBackup *const infoBackup, Manifest *const manifest)
 
         backupManifestSaveCopy(manifest, infoPgCipherPass(infoBackupPg(infoBackup)), true);
 
-        storageCopy(
+        storageCopyP(
             storageNewReadP(
-                storageRepo(), strNewFmt(STORAGE_REPO_BACKUP "/%s/" BACKUP_MANIFEST_FILE INFO_COPY_EXT, strZ(backupLabel))),
+                storageRepoWrite(), strNewFmt(STORAGE_REPO_BACKUP "/%s/" BACKUP_MANIFEST_FILE INFO_COPY_EXT, strZ(backupLabel))),
             storageNewWriteP(
-                storageRepoWrite(), strNewFmt(STORAGE_REPO_BACKUP "/%s/" BACKUP_MANIFEST_FILE, strZ(backupLabel))));
+                storageRepoWrite(), strNewFmt(STORAGE_REPO_BACKUP "/%s/" BACKUP_MANIFEST_FILE, strZ(backupLabel))),
+            .storage = storageRepoWrite());
 
         // Copy a compressed version of the manifest to history. If the repo is encrypted then the passphrase to open the manifest
         // is required. We can't just do a straight copy since the destination needs to be compressed and that must happen before
@@ -2527,6 +2925,146 @@ backupComplete(InfoBackup *const infoBackup, Manifest *const manifest)
     FUNCTION_LOG_RETURN_VOID();
 }
 
+/***********************************************************************************************************************************
+Create a synthetic full backup from the latest backup and the backups it references. Files are copied within the repository without
+reading from the cluster, so the new backup is consistent at exactly the same point as the latest backup and retains its timestamps,
+LSNs, and WAL range.
+***********************************************************************************************************************************/
+static void
+backupSynthetic(InfoBackup *const infoBackup, const String *const cipherPassBackup)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(INFO_BACKUP, infoBackup);
+        FUNCTION_TEST_PARAM(STRING, cipherPassBackup);
+    FUNCTION_LOG_END();
+
+    ASSERT(infoBackup != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Find the latest backup, which must belong to the current cluster
+        if (infoBackupDataTotal(infoBackup) == 0)
+            THROW(BackupSetInvalidError, "no prior backup exists to create a synthetic full backup from");
+
+        const InfoBackupData backupLatest = infoBackupData(infoBackup, infoBackupDataTotal(infoBackup) - 1);
+
+        if (backupLatest.backupPgId != infoPgDataCurrent(infoBackupPg(infoBackup)).id)
+        {
+            THROW_FMT(
+                BackupSetInvalidError, "latest backup set %s does not belong to the current stanza version",
+                strZ(backupLatest.backupLabel));
+        }
+
+        // Load the manifest of the latest backup
+        Manifest *const manifest = manifestLoadFile(
+            storageRepo(), strNewFmt(STORAGE_REPO_BACKUP "/%s/" BACKUP_MANIFEST_FILE, strZ(backupLatest.backupLabel)),
+            cfgOptionStrId(cfgOptRepoCipherType), cipherPassBackup);
+        const ManifestData *const data = manifestData(manifest);
+
+        // Block maps reference blocks in prior backups by bundle offset so they cannot be relocated without rewriting the maps. A
+        // backup without block incremental may still reference block incremental files from a prior backup so check every file.
+        bool blockIncr = data->blockIncr;
+
+        for (unsigned int fileIdx = 0; !blockIncr && fileIdx < manifestFileTotal(manifest); fileIdx++)
+            blockIncr = manifestFile(manifest, fileIdx).blockIncrMapSize != 0;
+
+        if (blockIncr)
+        {
+            THROW_FMT(
+                BackupSetInvalidError, "synthetic full backup cannot be created from block incremental backup set %s",
+                strZ(backupLatest.backupLabel));
+        }
+
+        // Bundles are copied as-is so bundling must be enabled when the latest backup was bundled
+        if (data->bundle && !cfgOptionBool(cfgOptRepoBundle))
+        {
+            THROW_FMT(
+                OptionInvalidError, "option '%s' must be enabled to create a synthetic full backup from backup set %s",
+                cfgOptionName(cfgOptRepoBundle), strZ(backupLatest.backupLabel));
+        }
+
+        const String *const backupLabel = backupLabelCreate(backupTypeFull, NULL, time(NULL));
+
+        LOG_INFO_FMT("synthetic full backup from backup set %s", strZ(backupLatest.backupLabel));
+
+        // Copy files stored outside of bundles and collect bundled files so they can be copied into new bundles. Files are copied
+        // without decompressing or decrypting since compression type, bundle format, and cipher pass are the same for all backups
+        // in the set.
+        List *const bundleFileList = lstNewP(sizeof(BackupBundleFile), .comparator = backupBundleFileComparator);
+
+        for (unsigned int fileIdx = 0; fileIdx < manifestFileTotal(manifest); fileIdx++)
+        {
+            ManifestFile file = manifestFile(manifest, fileIdx);
+            const String *const reference = file.reference != NULL ? file.reference : backupLatest.backupLabel;
+
+            if (file.bundleId != 0)
+            {
+                lstAdd(
+                    bundleFileList,
+                    &(BackupBundleFile){
+                        .name = file.name, .reference = reference, .bundleId = file.bundleId, .bundleOffset = file.bundleOffset,
+                        .sizeRepo = file.sizeRepo});
+
+                continue;
+            }
+
+            // Zero-length files are not stored in the repository when bundling
+            if (file.size != 0 || !data->bundle)
+            {
+                StorageRead *const read = storageNewReadP(
+                    storageRepoWrite(),
+                    backupFileRepoPathP(reference, .manifestName = file.name, .compressType = data->backupOptionCompressType));
+
+                // Verify the file when it is read by the client. A copy by the storage driver (e.g. a server-side copy on object
+                // stores) never leaves the storage and no provider returns a SHA1 to compare, so verification is skipped.
+                const bool copyServer = storageCopyServer(storageRepoWrite());
+
+                if (!copyServer)
+                    ioFilterGroupAdd(ioReadFilterGroup(storageReadIo(read)), cryptoHashNew(hashTypeSha1));
+
+                storageCopyP(
+                    read,
+                    storageNewWriteP(
+                        storageRepoWrite(),
+                        backupFileRepoPathP(
+                            backupLabel, .manifestName = file.name, .compressType = data->backupOptionCompressType)),
+                    .storage = storageRepoWrite());
+
+                if (!copyServer && file.checksumRepoSha1 != NULL &&
+                    !bufEq(
+                        pckReadBinP(ioFilterGroupResultP(ioReadFilterGroup(storageReadIo(read)), CRYPTO_HASH_FILTER_TYPE)),
+                        BUF(file.checksumRepoSha1, HASH_TYPE_SHA1_SIZE)))
+                {
+                    THROW_FMT(ChecksumError, "invalid checksum for '%s' in backup set %s", strZ(file.name), strZ(reference));
+                }
+            }
+
+            file.reference = NULL;
+            manifestFileUpdate(manifest, &file);
+        }
+
+        // Copy bundled files into new bundles
+        uint64_t bundleId = 1;
+
+        lstSort(bundleFileList, sortOrderAsc);
+        backupBundleCopy(manifest, backupLabel, bundleFileList, cfgOptionUInt64(cfgOptRepoBundleSize), &bundleId);
+
+        // Complete the backup
+        manifestBackupFullSet(manifest, backupLabel, cfgOptionTest(cfgOptAnnotation) ? cfgOptionKv(cfgOptAnnotation) : NULL);
+
+        LOG_INFO_FMT("new backup label = %s", strZ(backupLabel));
+        backupComplete(infoBackup, manifest);
+
+        // Backup info
+        LOG_INFO_FMT(
+            "%s backup size = %s, file total = %u", strZ(strIdToStr(data->backupType)),
+            strZ(strSizeFormat(infoBackupDataByLabel(infoBackup, backupLabel)->backupInfoSizeDelta)), manifestFileTotal(manifest));
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN void
 cmdBackup(void)
@@ -2555,96 +3093,105 @@ cmdBackup(void)
         const InfoPgData infoPg = infoPgDataCurrent(infoBackupPg(infoBackup));
         const String *const cipherPassBackup = infoPgCipherPass(infoBackupPg(infoBackup));
 
-        // Get pg storage and database objects
-        BackupData *const backupData = backupInit(infoBackup);
+        // A synthetic full backup is built entirely from the repository so the cluster is not accessed
+        if (cfgOptionTest(cfgOptSynthetic) && cfgOptionBool(cfgOptSynthetic))
+            backupSynthetic(infoBackup, cipherPassBackup);
+        else
+        {
+            // Get pg storage and database objects
+            BackupData *const backupData = backupInit(infoBackup);
 
-        // Get the start timestamp which will later be written into the manifest to track total backup time
-        const time_t timestampStart = backupTime(backupData, false);
+            // Get the start timestamp which will later be written into the manifest to track total backup time
+            const time_t timestampStart = backupTime(backupData, false);
 
-        // Check if there is a prior manifest when backup type is diff/incr
-        Manifest *const manifestPrior = backupBuildIncrPrior(infoBackup);
+            // Check if there is a prior manifest when backup type is diff/incr
+            Manifest *const manifestPrior = backupBuildIncrPrior(infoBackup);
 
-        // Start the backup
-        const BackupStartResult backupStartResult = backupStart(backupData);
+            // Start the backup
+            const BackupStartResult backupStartResult = backupStart(backupData);
 
-        // Build the manifest
-        const ManifestBlockIncrMap blockIncrMap = backupBlockIncrMap();
+            // Build the manifest
+            const ManifestBlockIncrMap blockIncrMap = backupBlockIncrMap();
 
-        Manifest *const manifest = manifestNewBuild(
-            backupData->storagePrimary, infoPg.version, infoPg.catalogVersion, timestampStart, cfgOptionBool(cfgOptOnline),
-            cfgOptionBool(cfgOptChecksumPage), cfgOptionBool(cfgOptRepoBundle), cfgOptionBool(cfgOptRepoBlock), &blockIncrMap,
-            strLstNewVarLst(cfgOptionLst(cfgOptExclude)), backupStartResult.tablespaceList);
+            Manifest *const manifest = manifestNewBuild(
+                backupData->storagePrimary, infoPg.version, infoPg.catalogVersion, timestampStart, cfgOptionBool(cfgOptOnline),
+                cfgOptionBool(cfgOptChecksumPage), cfgOptionBool(cfgOptRepoBundle), cfgOptionBool(cfgOptRepoBlock), &blockIncrMap,
+                strLstNewVarLst(cfgOptionLst(cfgOptExclude)), backupStartResult.tablespaceList);
 
-        // Validate the manifest using the copy start time
-        manifestBuildValidate(
-            manifest, cfgOptionBool(cfgOptDelta), backupTime(backupData, true),
-            compressTypeEnum(cfgOptionStrId(cfgOptCompressType)));
+            // Validate the manifest using the copy start time
+            manifestBuildValidate(
+                manifest, cfgOptionBool(cfgOptDelta), backupTime(backupData, true),
+                compressTypeEnum(cfgOptionStrId(cfgOptCompressType)));
 
-        // Build an incremental backup if type is not full (manifestPrior will be freed in this call)
-        if (!backupBuildIncr(infoBackup, manifest, manifestPrior, backupStartResult.walSegmentName))
-            manifestCipherSubPassSet(manifest, cipherPassGen(cfgOptionStrId(cfgOptRepoCipherType)));
+            // Build an incremental backup if type is not full (manifestPrior will be freed in this call)
+            if (!backupBuildIncr(
+                    infoBackup, backupData, manifest, manifestPrior, backupStartResult.lsn, backupStartResult.walSegmentName))
+                manifestCipherSubPassSet(manifest, cipherPassGen(cfgOptionStrId(cfgOptRepoCipherType)));
 
-        // Set delta if it is not already set and the manifest requires it
-        if (!cfgOptionBool(cfgOptDelta) && varBool(manifestData(manifest)->backupOptionDelta))
-            cfgOptionSet(cfgOptDelta, cfgSourceParam, BOOL_TRUE_VAR);
+            // Set delta if it is not already set and the manifest requires it
+            if (!cfgOptionBool(cfgOptDelta) && varBool(manifestData(manifest)->backupOptionDelta))
+                cfgOptionSet(cfgOptDelta, cfgSourceParam, BOOL_TRUE_VAR);
 
-        // Resume a backup when possible
-        if (!backupResume(manifest, cipherPassBackup))
-        {
-            manifestBackupLabelSet(
-                manifest,
-                backupLabelCreate(
-                    (BackupType)cfgOptionStrId(cfgOptType), manifestData(manifest)->backupLabelPrior, timestampStart));
-        }
+            // Resume a backup when possible
+            if (!backupResume(manifest, cipherPassBackup))
+            {
+                manifestBackupLabelSet(
+                    manifest,
+                    backupLabelCreate(
+                        (BackupType)cfgOptionStrId(cfgOptType), manifestData(manifest)->backupLabelPrior, timestampStart));
+            }
+
+            // Save the manifest before processing starts
+            backupManifestSaveCopy(manifest, cipherPassBackup, false);
 
-        // Save the manifest before processing starts
-        backupManifestSaveCopy(manifest, cipherPassBackup, false);
+            // Process the backup manifest
+            backupProcess(backupData, manifest, cipherPassBackup);
 
-        // Process the backup manifest
-        backupProcess(backupData, manifest, cipherPassBackup);
+            // Check that the clusters are alive and correctly configured after the backup
+            backupDbPing(backupData, true);
 
-        // Check that the clusters are alive and correctly configured after the backup
-        backupDbPing(backupData, true);
+            // The standby db objects and protocols won't be used anymore so free them
+            for (unsigned int standbyIdx = 0; standbyIdx < lstSize(backupData->standbyList); standbyIdx++)
+            {
+                const BackupStandby *const standby = lstGet(backupData->standbyList, standbyIdx);
 
-        // The standby db object and protocol won't be used anymore so free them
-        if (backupData->dbStandby != NULL)
-        {
-            dbFree(backupData->dbStandby);
-            protocolHelperFree(protocolRemoteGet(protocolStorageTypePg, backupData->pgIdxStandby, false));
-        }
+                dbFree(standby->db);
+                protocolHelperFree(protocolRemoteGet(protocolStorageTypePg, standby->pgIdx, false));
+            }
 
-        // Stop the backup
-        const BackupStopResult backupStopResult = backupStop(backupData, manifest);
+            // Stop the backup
+            const BackupStopResult backupStopResult = backupStop(backupData, manifest);
 
-        // Complete manifest
-        manifestBuildComplete(
-            manifest, backupStartResult.lsn, backupStartResult.walSegmentName, backupStopResult.timestamp, backupStopResult.lsn,
-            backupStopResult.walSegmentName, infoPg.id, infoPg.systemId, backupStartResult.dbList,
-            cfgOptionBool(cfgOptArchiveCheck), cfgOptionBool(cfgOptArchiveCopy), cfgOptionUInt(cfgOptBufferSize),
-            cfgOptionUInt(cfgOptCompressLevel), cfgOptionUInt(cfgOptCompressLevelNetwork), cfgOptionBool(cfgOptRepoHardlink),
-            cfgOptionUInt(cfgOptProcessMax), backupData->dbStandby != NULL,
-            cfgOptionTest(cfgOptAnnotation) ? cfgOptionKv(cfgOptAnnotation) : NULL);
+            // Complete manifest
+            manifestBuildComplete(
+                manifest, backupStartResult.lsn, backupStartResult.walSegmentName, backupStopResult.timestamp, backupStopResult.lsn,
+                backupStopResult.walSegmentName, infoPg.id, infoPg.systemId, backupStartResult.dbList,
+                cfgOptionBool(cfgOptArchiveCheck), cfgOptionBool(cfgOptArchiveCopy), cfgOptionUInt(cfgOptBufferSize),
+                cfgOptionUInt(cfgOptCompressLevel), cfgOptionUInt(cfgOptCompressLevelNetwork), cfgOptionBool(cfgOptRepoHardlink),
+                cfgOptionUInt(cfgOptProcessMax), !lstEmpty(backupData->standbyList),
+                cfgOptionTest(cfgOptAnnotation) ? cfgOptionKv(cfgOptAnnotation) : NULL);
 
-        // The primary db object won't be used anymore so free it
-        dbFree(backupData->dbPrimary);
+            // The primary db object won't be used anymore so free it
+            dbFree(backupData->dbPrimary);
 
-        // Check and copy WAL segments required to make the backup consistent
-        backupArchiveCheckCopy(backupData, manifest, cipherPassBackup);
+            // Check and copy WAL segments required to make the backup consistent
+            backupArchiveCheckCopy(backupData, manifest, cipherPassBackup);
 
-        // The primary protocol connection won't be used anymore so free it. This needs to happen after backupArchiveCheckCopy() so
-        // the backup lock is held on the remote which allows conditional archiving based on the backup lock. Any further access to
-        // the primary storage object may result in an error (likely eof).
-        protocolHelperFree(protocolRemoteGet(protocolStorageTypePg, backupData->pgIdxPrimary, false));
+            // The primary protocol connection won't be used anymore so free it. This needs to happen after backupArchiveCheckCopy()
+            // so the backup lock is held on the remote which allows conditional archiving based on the backup lock. Any further
+            // access to the primary storage object may result in an error (likely eof).
+            protocolHelperFree(protocolRemoteGet(protocolStorageTypePg, backupData->pgIdxPrimary, false));
 
-        // Complete the backup
-        LOG_INFO_FMT("new backup label = %s", strZ(manifestData(manifest)->backupLabel));
-        backupComplete(infoBackup, manifest);
+            // Complete the backup
+            LOG_INFO_FMT("new backup label = %s", strZ(manifestData(manifest)->backupLabel));
+            backupComplete(infoBackup, manifest);
 
-        // Backup info
-        LOG_INFO_FMT(
-            "%s backup size = %s, file total = %u", strZ(strIdToStr(manifestData(manifest)->backupType)),
-            strZ(strSizeFormat(infoBackupDataByLabel(infoBackup, manifestData(manifest)->backupLabel)->backupInfoSizeDelta)),
-            manifestFileTotal(manifest));
+            // Backup info
+            LOG_INFO_FMT(
+                "%s backup size = %s, file total = %u", strZ(strIdToStr(manifestData(manifest)->backupType)),
+                strZ(strSizeFormat(infoBackupDataByLabel(infoBackup, manifestData(manifest)->backupLabel)->backupInfoSizeDelta)),
+                manifestFileTotal(manifest));
+        }
     }
     MEM_CONTEXT_TEMP_END();
 
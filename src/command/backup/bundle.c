@@ -0,0 +1,164 @@
+/***********************************************************************************************************************************
+Backup Bundle Copy
+***********************************************************************************************************************************/
+#include "build.auto.h"
+
+#include "command/backup/bundle.h"
+#include "command/backup/common.h"
+#include "common/crypto/hash.h"
+#include "common/debug.h"
+#include "common/io/io.h"
+#include "common/log.h"
+#include "storage/helper.h"
+
+/**********************************************************************************************************************************/
+FN_EXTERN int
+backupBundleFileComparator(const void *const item1, const void *const item2)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, item1);
+        FUNCTION_TEST_PARAM_P(VOID, item2);
+    FUNCTION_TEST_END();
+
+    ASSERT(item1 != NULL);
+    ASSERT(item2 != NULL);
+
+    const BackupBundleFile *const file1 = item1;
+    const BackupBundleFile *const file2 = item2;
+
+    int result = strCmp(file1->reference, file2->reference);
+
+    if (result == 0)
+    {
+        result = LST_COMPARATOR_CMP(file1->bundleId, file2->bundleId);
+
+        if (result == 0)
+            result = LST_COMPARATOR_CMP(file1->bundleOffset, file2->bundleOffset);
+    }
+
+    FUNCTION_TEST_RETURN(INT, result);
+}
+
+/***********************************************************************************************************************************
+Files that are contiguous in a bundle are read with a single request. Each file is verified against the repo checksum (when present)
+before it is written so corruption in an existing bundle is never propagated.
+***********************************************************************************************************************************/
+FN_EXTERN uint64_t
+backupBundleCopy(
+    Manifest *const manifest, const String *const backupLabel, const List *const fileList, const uint64_t bundleSize,
+    uint64_t *const bundleId)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(MANIFEST, manifest);
+        FUNCTION_LOG_PARAM(STRING, backupLabel);
+        FUNCTION_LOG_PARAM(LIST, fileList);
+        FUNCTION_LOG_PARAM(UINT64, bundleSize);
+        FUNCTION_LOG_PARAM_P(UINT64, bundleId);
+    FUNCTION_LOG_END();
+
+    ASSERT(manifest != NULL);
+    ASSERT(backupLabel != NULL);
+    ASSERT(fileList != NULL);
+    ASSERT(bundleSize > 0);
+    ASSERT(bundleId != NULL);
+
+    uint64_t result = 0;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        IoWrite *write = NULL;
+        uint64_t bundleOffset = 0;
+        unsigned int fileIdx = 0;
+
+        while (fileIdx < lstSize(fileList))
+        {
+            // Find the range of files that are contiguous in the bundle
+            const BackupBundleFile *const fileFirst = lstGet(fileList, fileIdx);
+            unsigned int fileIdxEnd = fileIdx + 1;
+            uint64_t rangeSize = fileFirst->sizeRepo;
+
+            while (fileIdxEnd < lstSize(fileList))
+            {
+                const BackupBundleFile *const file = lstGet(fileList, fileIdxEnd);
+
+                if (!strEq(file->reference, fileFirst->reference) || file->bundleId != fileFirst->bundleId ||
+                    file->bundleOffset != fileFirst->bundleOffset + rangeSize)
+                {
+                    break;
+                }
+
+                rangeSize += file->sizeRepo;
+                fileIdxEnd++;
+            }
+
+            // Open a new bundle when required
+            if (write == NULL)
+            {
+                write = storageWriteIo(
+                    storageNewWriteP(storageRepoWrite(), backupFileRepoPathP(backupLabel, .bundleId = *bundleId)));
+                ioWriteOpen(write);
+
+                bundleOffset = 0;
+            }
+
+            // Copy the range from the bundle
+            IoRead *const read = storageReadIo(
+                storageNewReadP(
+                    storageRepo(), backupFileRepoPathP(fileFirst->reference, .bundleId = fileFirst->bundleId),
+                    .offset = fileFirst->bundleOffset, .limit = VARUINT64(rangeSize)));
+            ioReadOpen(read);
+
+            for (; fileIdx < fileIdxEnd; fileIdx++)
+            {
+                const BackupBundleFile *const fileCopy = lstGet(fileList, fileIdx);
+                ManifestFile file = manifestFileFind(manifest, fileCopy->name);
+                Buffer *const buffer = bufNew((size_t)fileCopy->sizeRepo);
+
+                ioRead(read, buffer);
+
+                if (bufUsed(buffer) != fileCopy->sizeRepo ||
+                    (file.checksumRepoSha1 != NULL &&
+                     !bufEq(cryptoHashOne(hashTypeSha1, buffer), BUF(file.checksumRepoSha1, HASH_TYPE_SHA1_SIZE))))
+                {
+                    THROW_FMT(
+                        ChecksumError, "invalid checksum for '%s' in bundle %" PRIu64 " of backup set %s", strZ(file.name),
+                        fileCopy->bundleId, strZ(fileCopy->reference));
+                }
+
+                ioWrite(write, buffer);
+                bufFree(buffer);
+
+                // Update the file to point to the new bundle
+                file.reference = NULL;
+                file.bundleId = *bundleId;
+                file.bundleOffset = bundleOffset;
+
+                manifestFileUpdate(manifest, &file);
+
+                bundleOffset += fileCopy->sizeRepo;
+            }
+
+            ioReadClose(read);
+            result += rangeSize;
+
+            // Close the bundle when full
+            if (bundleOffset >= bundleSize)
+            {
+                ioWriteClose(write);
+                write = NULL;
+
+                (*bundleId)++;
+            }
+        }
+
+        // Close the last bundle
+        if (write != NULL)
+        {
+            ioWriteClose(write);
+            (*bundleId)++;
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN(UINT64, result);
+}
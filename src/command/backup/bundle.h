@@ -0,0 +1,37 @@
+/***********************************************************************************************************************************
+Backup Bundle Copy
+
+Copy files stored in existing bundles into new bundles in a backup without decompressing or decrypting them. This is valid because
+the compression type, raw bundle format, and cipher subpass are fixed for a backup set.
+***********************************************************************************************************************************/
+#ifndef COMMAND_BACKUP_BUNDLE_H
+#define COMMAND_BACKUP_BUNDLE_H
+
+#include "common/type/list.h"
+#include "common/type/string.h"
+#include "info/manifest.h"
+
+/***********************************************************************************************************************************
+File in an existing bundle to be copied into a new bundle
+***********************************************************************************************************************************/
+typedef struct BackupBundleFile
+{
+    const String *name;                                             // File name in manifest
+    const String *reference;                                        // Backup where the bundle is stored
+    uint64_t bundleId;                                              // Bundle id
+    uint64_t bundleOffset;                                          // Bundle offset
+    uint64_t sizeRepo;                                              // Size in repo
+} BackupBundleFile;
+
+/***********************************************************************************************************************************
+Functions
+***********************************************************************************************************************************/
+// Comparator to order files by reference, bundle id, and offset so each bundle is read sequentially
+FN_EXTERN int backupBundleFileComparator(const void *item1, const void *item2);
+
+// Copy files into new bundles in the backup, starting at the specified bundle id, and update the manifest. Bundles are closed once
+// they reach the bundle size. Returns the number of bytes copied and bundleId is set to the next unused bundle id.
+FN_EXTERN uint64_t backupBundleCopy(
+    Manifest *manifest, const String *backupLabel, const List *fileList, uint64_t bundleSize, uint64_t *bundleId);
+
+#endif
@@ -7,6 +7,7 @@ Common Functions and Definitions for Backup and Expire Commands
 
 #include "command/backup/common.h"
 #include "common/debug.h"
+#include "common/io/filter/rate.h"
 #include "common/log.h"
 #include "storage/helper.h"
 
@@ -171,3 +172,46 @@ backupLinkLatest(const String *const backupLabel, const unsigned int repoIdx)
 
     FUNCTION_TEST_RETURN_VOID();
 }
+
+/**********************************************************************************************************************************/
+FN_EXTERN uint64_t
+backupRateLimit(const ConfigOption optionId, const unsigned int processTotal)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(ENUM, optionId);
+        FUNCTION_LOG_PARAM(UINT, processTotal);
+    FUNCTION_LOG_END();
+
+    ASSERT(optionId == cfgOptRateLimitPg || optionId == cfgOptRateLimitRepo);
+    ASSERT(processTotal > 0);
+
+    uint64_t result = 0;
+
+    if (cfgOptionTest(optionId))
+    {
+        result = cfgOptionUInt64(optionId) / processTotal;
+
+        // The filter does not allow a zero rate
+        if (result == 0)
+            result = 1;
+    }
+
+    FUNCTION_LOG_RETURN(UINT64, result);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN IoFilterGroup *
+backupRateFilterGroupAdd(IoFilterGroup *const filterGroup, const uint64_t rateLimit)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(IO_FILTER_GROUP, filterGroup);
+        FUNCTION_LOG_PARAM(UINT64, rateLimit);
+    FUNCTION_LOG_END();
+
+    ASSERT(filterGroup != NULL);
+
+    if (rateLimit != 0)
+        ioFilterGroupAdd(filterGroup, ioRateNew(rateLimit));
+
+    FUNCTION_LOG_RETURN(IO_FILTER_GROUP, filterGroup);
+}
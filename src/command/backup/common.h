@@ -8,7 +8,9 @@ Common Functions and Definitions for Backup and Expire Commands
 #include <time.h>
 
 #include "common/compress/helper.h"
+#include "common/io/filter/group.h"
 #include "common/type/string.h"
+#include "config/config.h"
 #include "info/infoBackup.h"
 
 /***********************************************************************************************************************************
@@ -58,4 +60,11 @@ FN_EXTERN String *backupRegExp(BackupRegExpParam param);
 // Create a symlink to the specified backup (if symlinks are supported)
 FN_EXTERN void backupLinkLatest(const String *backupLabel, unsigned int repoIdx);
 
+// Rate limit for each process from a rate limit option (rate-limit-pg or rate-limit-repo). The limit is shared equally by the
+// processes that may be running jobs. Returns 0 when the option is not set.
+FN_EXTERN uint64_t backupRateLimit(ConfigOption optionId, unsigned int processTotal);
+
+// Add a rate filter to a filter group when the rate limit is not 0
+FN_EXTERN IoFilterGroup *backupRateFilterGroupAdd(IoFilterGroup *filterGroup, uint64_t rateLimit);
+
 #endif
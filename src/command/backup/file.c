@@ -6,6 +6,7 @@ Backup File
 #include <string.h>
 
 #include "command/backup/blockIncr.h"
+#include "command/backup/common.h"
 #include "command/backup/file.h"
 #include "command/backup/pageChecksum.h"
 #include "common/crypto/cipherBlock.h"
@@ -41,7 +42,8 @@ FN_EXTERN List *
 backupFile(
     const String *const repoFile, const uint64_t bundleId, const bool bundleRaw, const unsigned int blockIncrReference,
     const CompressType repoFileCompressType, const int repoFileCompressLevel, const CipherType cipherType,
-    const String *const cipherPass, const String *const pgVersionForce, const PgPageSize pageSize, const List *const fileList)
+    const String *const cipherPass, const String *const pgVersionForce, const PgPageSize pageSize, const uint64_t rateLimitPg,
+    const uint64_t rateLimitRepo, const List *const fileList)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(STRING, repoFile);                       // Repo file
@@ -54,6 +56,8 @@ backupFile(
         FUNCTION_TEST_PARAM(STRING, cipherPass);                    // Password to access the repo file if encrypted
         FUNCTION_LOG_PARAM(ENUM, pageSize);                         // Page size
         FUNCTION_LOG_PARAM(STRING, pgVersionForce);                 // Force pg version
+        FUNCTION_LOG_PARAM(UINT64, rateLimitPg);                    // Max bytes per second read from pg (0 for no limit)
+        FUNCTION_LOG_PARAM(UINT64, rateLimitRepo);                  // Max bytes per second written to the repo (0 for no limit)
         FUNCTION_LOG_PARAM(LIST, fileList);                         // List of files to backup
     FUNCTION_LOG_END();
 
@@ -211,6 +215,9 @@ backupFile(
                                 .limit = file->pgFileCopyExactSize ? VARUINT64(file->pgFileSizeOriginal) : NULL));
                     }
 
+                    // Limit the rate of reads from pg
+                    backupRateFilterGroupAdd(ioReadFilterGroup(readIo), rateLimitPg);
+
                     ioFilterGroupAdd(ioReadFilterGroup(readIo), cryptoHashNew(hashTypeSha1));
                     ioFilterGroupAdd(ioReadFilterGroup(readIo), ioSizeNew());
 
@@ -292,6 +299,9 @@ backupFile(
                     if (repoChecksum)
                         ioFilterGroupAdd(ioReadFilterGroup(readIo), cryptoHashNew(hashTypeSha1));
 
+                    // Limit the rate of writes to the repo
+                    backupRateFilterGroupAdd(ioReadFilterGroup(readIo), rateLimitRepo);
+
                     // Add size filter last to calculate repo size
                     ioFilterGroupAdd(ioReadFilterGroup(readIo), ioSizeNew());
 
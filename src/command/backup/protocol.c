@@ -39,6 +39,8 @@ backupFileProtocol(PackRead *const param)
         const String *const cipherPass = pckReadStrP(param);
         const PgPageSize pageSize = pckReadU32P(param);
         const String *const pgVersionForce = pckReadStrP(param);
+        const uint64_t rateLimitPg = pckReadU64P(param);
+        const uint64_t rateLimitRepo = pckReadU64P(param);
 
         // Build the file list
         List *const fileList = lstNewP(sizeof(BackupFile));
@@ -81,7 +83,7 @@ backupFileProtocol(PackRead *const param)
         // Backup file
         const List *const resultList = backupFile(
             repoFile, bundleId, bundleRaw, blockIncrReference, repoFileCompressType, repoFileCompressLevel, cipherType, cipherPass,
-            pgVersionForce, pageSize, fileList);
+            pgVersionForce, pageSize, rateLimitPg, rateLimitRepo, fileList);
 
         // Return result
         PackWrite *const data = protocolServerResultData(result);
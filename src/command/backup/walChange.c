@@ -0,0 +1,387 @@
+/***********************************************************************************************************************************
+Backup WAL Change
+***********************************************************************************************************************************/
+#include "build.auto.h"
+
+#include <limits.h>
+#include <string.h>
+
+#include "command/backup/walChange.h"
+#include "common/debug.h"
+#include "common/log.h"
+#include "common/type/list.h"
+#include "common/type/object.h"
+#include "postgres/walRecord.h"
+
+/***********************************************************************************************************************************
+Segments are appended to the list as records are decoded. The list is periodically sorted and compacted to keep it from growing too
+large since the same segments tend to be referenced repeatedly.
+***********************************************************************************************************************************/
+#define WAL_CHANGE_COMPACT_SIZE_MIN                                 65536
+
+// Segment value used to indicate that all segments of a relation have changed
+#define WAL_CHANGE_SEGMENT_ALL                                      UINT_MAX
+
+/***********************************************************************************************************************************
+Object type
+***********************************************************************************************************************************/
+struct WalChange
+{
+    PgWalRecordRead *read;                                          // WAL record reader
+    unsigned int segmentBlockTotal;                                 // Blocks per relation segment
+
+    List *segmentList;                                              // Relation segments referenced (WalChangeSegment)
+    unsigned int compactSize;                                       // Compact the segment list when it reaches this size
+    bool compact;                                                   // Is the segment list sorted with no duplicates?
+    List *dbList;                                                   // Databases created or dropped
+};
+
+// Relation segment
+typedef struct WalChangeSegment
+{
+    unsigned int tablespaceId;                                      // Tablespace oid
+    unsigned int dbId;                                              // Database oid
+    unsigned int relFileNode;                                       // Relation file node
+    unsigned int segmentNo;                                         // Segment number (or all segments)
+} WalChangeSegment;
+
+// Segment comparator
+static int
+lstComparatorWalChangeSegment(const void *const segment1, const void *const segment2)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, segment1);
+        FUNCTION_TEST_PARAM_P(VOID, segment2);
+    FUNCTION_TEST_END();
+
+    ASSERT(segment1 != NULL);
+    ASSERT(segment2 != NULL);
+
+    const WalChangeSegment *const item1 = segment1;
+    const WalChangeSegment *const item2 = segment2;
+    int result = LST_COMPARATOR_CMP(item1->tablespaceId, item2->tablespaceId);
+
+    if (result == 0)
+    {
+        result = LST_COMPARATOR_CMP(item1->dbId, item2->dbId);
+
+        if (result == 0)
+        {
+            result = LST_COMPARATOR_CMP(item1->relFileNode, item2->relFileNode);
+
+            if (result == 0)
+                result = LST_COMPARATOR_CMP(item1->segmentNo, item2->segmentNo);
+        }
+    }
+
+    FUNCTION_TEST_RETURN(INT, result);
+}
+
+/***********************************************************************************************************************************
+Sort the segment list and remove duplicates
+***********************************************************************************************************************************/
+static void
+walChangeCompact(WalChange *const this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(WAL_CHANGE, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    if (!this->compact)
+    {
+        lstSort(this->segmentList, sortOrderAsc);
+
+        MEM_CONTEXT_OBJ_BEGIN(this)
+        {
+            List *const segmentList = lstNewP(sizeof(WalChangeSegment), .comparator = lstComparatorWalChangeSegment);
+
+            for (unsigned int segmentIdx = 0; segmentIdx < lstSize(this->segmentList); segmentIdx++)
+            {
+                const WalChangeSegment *const segment = lstGet(this->segmentList, segmentIdx);
+
+                if (lstEmpty(segmentList) || lstComparatorWalChangeSegment(lstGetLast(segmentList), segment) != 0)
+                    lstAdd(segmentList, segment);
+            }
+
+            lstFree(this->segmentList);
+            this->segmentList = lstSort(segmentList, sortOrderAsc);
+        }
+        MEM_CONTEXT_OBJ_END();
+
+        // Allow the list to double before compacting again so the cost of compacting is amortized
+        this->compactSize = lstSize(this->segmentList) * 2;
+
+        if (this->compactSize < WAL_CHANGE_COMPACT_SIZE_MIN)
+            this->compactSize = WAL_CHANGE_COMPACT_SIZE_MIN;
+
+        this->compact = true;
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Add a relation segment to the list
+***********************************************************************************************************************************/
+static void
+walChangeSegmentAdd(WalChange *const this, const WalChangeSegment *const segment)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(WAL_CHANGE, this);
+        FUNCTION_TEST_PARAM_P(VOID, segment);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(segment != NULL);
+
+    // Records often reference the same segment as the prior record so skip duplicates of the last segment added
+    if (lstEmpty(this->segmentList) || lstComparatorWalChangeSegment(lstGetLast(this->segmentList), segment) != 0)
+    {
+        lstAdd(this->segmentList, segment);
+        this->compact = false;
+
+        if (lstSize(this->segmentList) >= this->compactSize)
+            walChangeCompact(this);
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Record callback
+***********************************************************************************************************************************/
+static void
+walChangeRecord(void *const data, const PgWalRecord *const record)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, data);
+        FUNCTION_TEST_PARAM_P(VOID, record);
+    FUNCTION_TEST_END();
+
+    ASSERT(data != NULL);
+    ASSERT(record != NULL);
+
+    WalChange *const this = data;
+
+    // Add the segment for each main fork block referenced
+    for (unsigned int blockIdx = 0; blockIdx < lstSize(record->blockList); blockIdx++)
+    {
+        const PgWalRecordBlock *const block = lstGet(record->blockList, blockIdx);
+
+        if (block->fork == PG_FORK_MAIN)
+        {
+            walChangeSegmentAdd(
+                this,
+                &(WalChangeSegment){
+                    .tablespaceId = block->tablespaceId, .dbId = block->dbId, .relFileNode = block->relFileNode,
+                    .segmentNo = block->blockNo / this->segmentBlockTotal});
+        }
+    }
+
+    switch (record->resourceManagerId)
+    {
+        // Relation created or truncated so all segments have changed. The relation is at the beginning of the create record and
+        // follows the block number in the truncate record.
+        case PG_WAL_RMGR_SMGR:
+        {
+            const uint8_t type = record->info & PG_WAL_INFO_TYPE_MASK;
+
+            if (type == PG_WAL_SMGR_CREATE || type == PG_WAL_SMGR_TRUNCATE)
+            {
+                const size_t offset = type == PG_WAL_SMGR_CREATE ? 0 : sizeof(uint32_t);
+                unsigned int relation[3];
+
+                CHECK_FMT(
+                    FormatError, record->mainDataSize >= offset + sizeof(relation), "smgr record at %X/%X is too short",
+                    (unsigned int)(record->lsn >> 32), (unsigned int)record->lsn);
+
+                memcpy(relation, record->mainData + offset, sizeof(relation));
+
+                walChangeSegmentAdd(
+                    this,
+                    &(WalChangeSegment){
+                        .tablespaceId = relation[0], .dbId = relation[1], .relFileNode = relation[2],
+                        .segmentNo = WAL_CHANGE_SEGMENT_ALL});
+            }
+
+            break;
+        }
+
+        // Database created or dropped so all relations in the database have changed. The database is at the beginning of all
+        // database records.
+        case PG_WAL_RMGR_DBASE:
+        {
+            unsigned int dbId;
+
+            CHECK_FMT(
+                FormatError, record->mainDataSize >= sizeof(dbId), "database record at %X/%X is too short",
+                (unsigned int)(record->lsn >> 32), (unsigned int)record->lsn);
+
+            memcpy(&dbId, record->mainData, sizeof(dbId));
+
+            if (!lstExists(this->dbList, &dbId))
+                lstAdd(this->dbList, &dbId);
+
+            break;
+        }
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN WalChange *
+walChangeNew(const unsigned int pgVersion, const unsigned int segmentBlockTotal)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(UINT, pgVersion);
+        FUNCTION_LOG_PARAM(UINT, segmentBlockTotal);
+    FUNCTION_LOG_END();
+
+    CHECK(FormatError, segmentBlockTotal != 0, "relation segment size is zero");
+
+    OBJ_NEW_BEGIN(WalChange, .childQty = MEM_CONTEXT_QTY_MAX)
+    {
+        *this = (WalChange)
+        {
+            .segmentBlockTotal = segmentBlockTotal,
+            .segmentList = lstNewP(sizeof(WalChangeSegment), .comparator = lstComparatorWalChangeSegment),
+            .compactSize = WAL_CHANGE_COMPACT_SIZE_MIN,
+            .compact = true,
+            .dbList = lstNewP(sizeof(unsigned int), .comparator = lstComparatorUInt),
+        };
+
+        this->read = pgWalRecordReadNew(pgVersion, false, walChangeRecord, this);
+    }
+    OBJ_NEW_END();
+
+    FUNCTION_LOG_RETURN(WAL_CHANGE, this);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN void
+walChangeProcess(WalChange *const this, const Buffer *const input)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(WAL_CHANGE, this);
+        FUNCTION_LOG_PARAM(BUFFER, input);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(input != NULL);
+
+    pgWalRecordReadProcess(this->read, input);
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Parse an oid from a file name and return a pointer to the next character, or NULL if there is no valid oid
+***********************************************************************************************************************************/
+static const char *
+walChangeOid(const char *const name, unsigned int *const oid)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRINGZ, name);
+        FUNCTION_TEST_PARAM_P(UINT, oid);
+    FUNCTION_TEST_END();
+
+    ASSERT(name != NULL);
+    ASSERT(oid != NULL);
+
+    const char *result = name;
+    uint64_t value = 0;
+
+    while (*result >= '0' && *result <= '9' && value <= UINT_MAX)
+    {
+        value = value * 10 + (uint64_t)(*result - '0');
+        result++;
+    }
+
+    if (result == name || value > UINT_MAX)
+        result = NULL;
+    else
+        *oid = (unsigned int)value;
+
+    FUNCTION_TEST_RETURN_CONST(STRINGZ, result);
+}
+
+/**********************************************************************************************************************************/
+#define WAL_CHANGE_PATH_GLOBAL                                      "pg_data/global/"
+#define WAL_CHANGE_PATH_BASE                                        "pg_data/base/"
+#define WAL_CHANGE_PATH_TABLESPACE                                  "pg_tblspc/"
+
+FN_EXTERN bool
+walChangeFile(WalChange *const this, const String *const fileName)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(WAL_CHANGE, this);
+        FUNCTION_LOG_PARAM(STRING, fileName);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(fileName != NULL);
+
+    bool result = true;
+    WalChangeSegment segment = {0};
+    const char *name = NULL;
+
+    // Parse the tablespace and database
+    if (strBeginsWithZ(fileName, WAL_CHANGE_PATH_GLOBAL))
+    {
+        segment.tablespaceId = PG_TABLESPACE_GLOBAL;
+        name = strZ(fileName) + sizeof(WAL_CHANGE_PATH_GLOBAL) - 1;
+    }
+    else if (strBeginsWithZ(fileName, WAL_CHANGE_PATH_BASE))
+    {
+        segment.tablespaceId = PG_TABLESPACE_DEFAULT;
+        name = walChangeOid(strZ(fileName) + sizeof(WAL_CHANGE_PATH_BASE) - 1, &segment.dbId);
+        name = name != NULL && *name == '/' ? name + 1 : NULL;
+    }
+    else if (strBeginsWithZ(fileName, WAL_CHANGE_PATH_TABLESPACE))
+    {
+        // Skip the version directory, e.g. PG_16_202307071
+        name = walChangeOid(strZ(fileName) + sizeof(WAL_CHANGE_PATH_TABLESPACE) - 1, &segment.tablespaceId);
+        name = name != NULL && *name == '/' ? strchr(name + 1, '/') : NULL;
+        name = name != NULL ? walChangeOid(name + 1, &segment.dbId) : NULL;
+        name = name != NULL && *name == '/' ? name + 1 : NULL;
+    }
+
+    // Parse the relation and segment. Any other files, including other forks, are not tracked.
+    if (name != NULL)
+        name = walChangeOid(name, &segment.relFileNode);
+
+    if (name != NULL && *name == '.')
+        name = walChangeOid(name + 1, &segment.segmentNo);
+
+    if (name != NULL && *name == '\0' && !lstExists(this->dbList, &segment.dbId))
+    {
+        walChangeCompact(this);
+
+        // The file has not changed when neither the segment nor the entire relation was referenced
+        if (!lstExists(this->segmentList, &segment))
+        {
+            segment.segmentNo = WAL_CHANGE_SEGMENT_ALL;
+            result = lstExists(this->segmentList, &segment);
+        }
+    }
+
+    FUNCTION_LOG_RETURN(BOOL, result);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN unsigned int
+walChangeSize(WalChange *const this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(WAL_CHANGE, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    walChangeCompact(this);
+
+    FUNCTION_TEST_RETURN(UINT, lstSize(this->segmentList));
+}
@@ -0,0 +1,63 @@
+/***********************************************************************************************************************************
+Backup WAL Change
+
+Find relation files that have changed since a prior backup by decoding the WAL written since the prior backup started. Every block
+modified by PostgreSQL is referenced by a WAL record (full page writes ensure this for hint bits when checksums or wal_log_hints
+are enabled, and otherwise hint bits are not required to be backed up since they will be set again as needed). So a relation segment
+of the same size as in the prior backup that is not referenced by any record since the prior backup started has not changed and
+does not need to be read.
+
+Only the main fork is tracked since free space map changes are not WAL-logged and visibility map bits are cleared as a side effect
+of heap records without being referenced. Records that change a relation without referencing blocks (create and truncate) mark all
+segments of the relation as changed and database records (create and drop) mark all relations in the database as changed.
+***********************************************************************************************************************************/
+#ifndef COMMAND_BACKUP_WAL_CHANGE_H
+#define COMMAND_BACKUP_WAL_CHANGE_H
+
+/***********************************************************************************************************************************
+Object type
+***********************************************************************************************************************************/
+typedef struct WalChange WalChange;
+
+#include "common/type/buffer.h"
+#include "common/type/string.h"
+#include "postgres/interface.h"
+
+/***********************************************************************************************************************************
+Constructors
+***********************************************************************************************************************************/
+// The segment block total is the number of blocks per relation segment from pg_control (relseg_size). This is not the default when
+// PostgreSQL was built with a non-default segment size.
+FN_EXTERN WalChange *walChangeNew(unsigned int pgVersion, unsigned int segmentBlockTotal);
+
+/***********************************************************************************************************************************
+Functions
+***********************************************************************************************************************************/
+// Process the next part of the WAL stream (see PgWalRecordRead for requirements)
+FN_EXTERN void walChangeProcess(WalChange *this, const Buffer *input);
+
+// Has the file changed? The name must be a manifest file name. Files that are not tracked (i.e. are not main fork relation files)
+// are always reported as changed.
+FN_EXTERN bool walChangeFile(WalChange *this, const String *fileName);
+
+// Number of relation segments referenced
+FN_EXTERN unsigned int walChangeSize(WalChange *this);
+
+/***********************************************************************************************************************************
+Destructor
+***********************************************************************************************************************************/
+FN_INLINE_ALWAYS void
+walChangeFree(WalChange *const this)
+{
+    objFree(this);
+}
+
+/***********************************************************************************************************************************
+Macros for function logging
+***********************************************************************************************************************************/
+#define FUNCTION_LOG_WAL_CHANGE_TYPE                                                                                               \
+    WalChange *
+#define FUNCTION_LOG_WAL_CHANGE_FORMAT(value, buffer, bufferSize)                                                                  \
+    objNameToLog(value, "WalChange", buffer, bufferSize)
+
+#endif
@@ -0,0 +1,224 @@
+/***********************************************************************************************************************************
+Compact Command
+
+Bundles written by a backup are never modified once the backup is complete, so over a long chain of incremental backups the files
+that a backup set references end up spread across many partially used bundles in prior backups. Compaction copies those files
+into new bundles in the backup set and updates the manifest to point at the new location.
+
+Since the prior bundles are not modified, both the old and the new manifest remain valid at every step. The new bundles are
+written before the manifest is saved and the manifest is saved (copy first, then main) before backup.info is updated, so an
+interruption at any point leaves a consistent backup set.
+***********************************************************************************************************************************/
+#include "build.auto.h"
+
+#include "command/backup/bundle.h"
+#include "command/backup/common.h"
+#include "command/compact/compact.h"
+#include "command/control/common.h"
+#include "common/crypto/cipherBlock.h"
+#include "common/debug.h"
+#include "common/log.h"
+#include "common/memContext.h"
+#include "common/regExp.h"
+#include "common/type/list.h"
+#include "config/config.h"
+#include "info/infoBackup.h"
+#include "info/manifest.h"
+#include "storage/helper.h"
+
+/***********************************************************************************************************************************
+Build the list of files to be copied. Files are only copied from prior bundles where the backup set references less than a full
+bundle, i.e. the bundle was either small to begin with or most of the files it contains have since been changed. Bundles that are
+still fully referenced are left alone since copying them would not reduce the number of bundles read during restore.
+***********************************************************************************************************************************/
+static List *
+compactFileList(const Manifest *const manifest, const uint64_t bundleSize, unsigned int *const bundleTotal)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(MANIFEST, manifest);
+        FUNCTION_LOG_PARAM(UINT64, bundleSize);
+        FUNCTION_LOG_PARAM_P(UINT, bundleTotal);
+    FUNCTION_LOG_END();
+
+    ASSERT(manifest != NULL);
+    ASSERT(bundleSize > 0);
+    ASSERT(bundleTotal != NULL);
+
+    List *const result = lstNewP(sizeof(BackupBundleFile), .comparator = backupBundleFileComparator);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Get bundled files stored in prior backups. Block incremental files are skipped because their maps reference blocks by
+        // bundle offset and files without a repo checksum are skipped because the copy cannot be verified.
+        List *const fileList = lstNewP(sizeof(BackupBundleFile), .comparator = backupBundleFileComparator);
+
+        for (unsigned int fileIdx = 0; fileIdx < manifestFileTotal(manifest); fileIdx++)
+        {
+            const ManifestFile file = manifestFile(manifest, fileIdx);
+
+            if (file.reference != NULL && file.bundleId != 0 && file.blockIncrMapSize == 0 && file.checksumRepoSha1 != NULL)
+            {
+                lstAdd(
+                    fileList,
+                    &(BackupBundleFile){
+                        .name = file.name, .reference = file.reference, .bundleId = file.bundleId,
+                        .bundleOffset = file.bundleOffset, .sizeRepo = file.sizeRepo});
+            }
+        }
+
+        lstSort(fileList, sortOrderAsc);
+
+        // Select files from bundles where the referenced size is less than the bundle size
+        unsigned int fileIdx = 0;
+
+        while (fileIdx < lstSize(fileList))
+        {
+            const BackupBundleFile *const fileFirst = lstGet(fileList, fileIdx);
+            unsigned int fileIdxEnd = fileIdx + 1;
+            uint64_t bundleSizeReferenced = fileFirst->sizeRepo;
+
+            while (fileIdxEnd < lstSize(fileList))
+            {
+                const BackupBundleFile *const file = lstGet(fileList, fileIdxEnd);
+
+                if (!strEq(file->reference, fileFirst->reference) || file->bundleId != fileFirst->bundleId)
+                    break;
+
+                bundleSizeReferenced += file->sizeRepo;
+                fileIdxEnd++;
+            }
+
+            if (bundleSizeReferenced < bundleSize)
+            {
+                MEM_CONTEXT_OBJ_BEGIN(result)
+                {
+                    for (unsigned int fileIdxCopy = fileIdx; fileIdxCopy < fileIdxEnd; fileIdxCopy++)
+                    {
+                        BackupBundleFile file = *(const BackupBundleFile *)lstGet(fileList, fileIdxCopy);
+
+                        file.name = strDup(file.name);
+                        file.reference = strDup(file.reference);
+
+                        lstAdd(result, &file);
+                    }
+                }
+                MEM_CONTEXT_OBJ_END();
+
+                (*bundleTotal)++;
+            }
+
+            fileIdx = fileIdxEnd;
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN(LIST, result);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN void
+cmdCompact(void)
+{
+    FUNCTION_LOG_VOID(logLevelDebug);
+
+    // Test for stop file
+    lockStopTest();
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        const unsigned int repoIdx = cfgOptionGroupIdxDefault(cfgOptGrpRepo);
+
+        // New bundles can only be written when bundling is enabled
+        if (!cfgOptionIdxBool(cfgOptRepoBundle, repoIdx))
+        {
+            THROW_FMT(
+                OptionInvalidError, CFGCMD_COMPACT " command requires option '%s' to be enabled",
+                cfgOptionIdxName(cfgOptRepoBundle, repoIdx));
+        }
+
+        const uint64_t bundleSize = cfgOptionIdxUInt64(cfgOptRepoBundleSize, repoIdx);
+
+        // Load backup.info
+        InfoBackup *const infoBackup = infoBackupLoadFile(
+            storageRepo(), INFO_BACKUP_PATH_FILE_STR, cfgOptionStrId(cfgOptRepoCipherType), cfgOptionStrNull(cfgOptRepoCipherPass));
+        const String *const cipherPass = infoPgCipherPass(infoBackupPg(infoBackup));
+
+        // Get the backup set to compact
+        const String *backupLabel = cfgOptionStr(cfgOptSet);
+
+        if (strEqZ(backupLabel, "latest"))
+        {
+            if (infoBackupDataTotal(infoBackup) == 0)
+                THROW(BackupSetInvalidError, "no backup set to compact found");
+
+            backupLabel = infoBackupData(infoBackup, infoBackupDataTotal(infoBackup) - 1).backupLabel;
+        }
+        else
+        {
+            if (!regExpMatchOne(backupRegExpP(.full = true, .differential = true, .incremental = true), backupLabel))
+                THROW_FMT(OptionInvalidValueError, "'%s' is not a valid backup label format", strZ(backupLabel));
+
+            if (!infoBackupLabelExists(infoBackup, backupLabel))
+                THROW_FMT(BackupSetInvalidError, "backup set %s is not valid", strZ(backupLabel));
+        }
+
+        // Load the manifest
+        const String *const manifestFileName = strNewFmt(STORAGE_REPO_BACKUP "/%s/" BACKUP_MANIFEST_FILE, strZ(backupLabel));
+
+        Manifest *const manifest = manifestLoadFile(
+            storageRepo(), manifestFileName, cfgOptionStrId(cfgOptRepoCipherType), cipherPass);
+
+        // Get files to copy. At least two prior bundles are required, otherwise there is nothing to consolidate.
+        unsigned int bundleTotal = 0;
+        const List *const fileList = compactFileList(manifest, bundleSize, &bundleTotal);
+
+        if (bundleTotal < 2)
+            LOG_INFO_FMT("backup set %s has no prior bundles to compact", strZ(backupLabel));
+        else
+        {
+            // New bundle ids must not conflict with bundles already in the backup set
+            uint64_t bundleId = 1;
+
+            for (unsigned int fileIdx = 0; fileIdx < manifestFileTotal(manifest); fileIdx++)
+            {
+                const ManifestFile file = manifestFile(manifest, fileIdx);
+
+                if (file.reference == NULL && file.bundleId >= bundleId)
+                    bundleId = file.bundleId + 1;
+            }
+
+            const uint64_t bundleIdFirst = bundleId;
+            const uint64_t sizeCopy = backupBundleCopy(manifest, backupLabel, fileList, bundleSize, &bundleId);
+
+            // Save the manifest copy and then the main manifest
+            IoWrite *const write = storageWriteIo(
+                storageNewWriteP(storageRepoWrite(), strNewFmt("%s" INFO_COPY_EXT, strZ(manifestFileName))));
+            cipherBlockFilterGroupAdd(ioWriteFilterGroup(write), cfgOptionStrId(cfgOptRepoCipherType), cipherModeEncrypt, cipherPass);
+
+            manifestSave(manifest, write);
+
+            storageCopyP(
+                storageNewReadP(storageRepoWrite(), strNewFmt("%s" INFO_COPY_EXT, strZ(manifestFileName))),
+                storageNewWriteP(storageRepoWrite(), manifestFileName), .storage = storageRepoWrite());
+
+            // Files that were previously referenced are now part of the backup set so the delta sizes must be updated
+            uint64_t sizeDelta = 0;
+
+            for (unsigned int fileIdx = 0; fileIdx < lstSize(fileList); fileIdx++)
+                sizeDelta += manifestFileFind(manifest, ((const BackupBundleFile *)lstGet(fileList, fileIdx))->name).size;
+
+            infoBackupDataDeltaAdd(infoBackup, backupLabel, sizeDelta, sizeCopy);
+
+            infoBackupSaveFile(
+                infoBackup, storageRepoWrite(), INFO_BACKUP_PATH_FILE_STR, cfgOptionStrId(cfgOptRepoCipherType),
+                cfgOptionStrNull(cfgOptRepoCipherPass));
+
+            LOG_INFO_FMT(
+                "backup set %s compacted %u file(s) from %u prior bundle(s) into %" PRIu64 " bundle(s) (%s)", strZ(backupLabel),
+                lstSize(fileList), bundleTotal, bundleId - bundleIdFirst, strZ(strSizeFormat(sizeCopy)));
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN_VOID();
+}
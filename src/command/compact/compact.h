@@ -0,0 +1,13 @@
+/***********************************************************************************************************************************
+Compact Command
+***********************************************************************************************************************************/
+#ifndef COMMAND_COMPACT_COMPACT_H
+#define COMMAND_COMPACT_COMPACT_H
+
+/***********************************************************************************************************************************
+Functions
+***********************************************************************************************************************************/
+// Copy files referenced from partially used bundles in prior backups into new bundles in the backup set
+FN_EXTERN void cmdCompact(void);
+
+#endif
@@ -19,6 +19,13 @@ Expire Command
 #include "storage/helper.h"
 
 #include <stdlib.h>
+#include <string.h>
+
+/***********************************************************************************************************************************
+Constants
+***********************************************************************************************************************************/
+// Max WAL paths to list concurrently when expiring individual WAL files
+#define EXPIRE_ARCHIVE_LIST_PARALLEL                                8
 
 /***********************************************************************************************************************************
 Helper functions and structures
@@ -377,6 +384,84 @@ logExpire(ArchiveExpired *const archiveExpire, const String *const archiveId, co
     }
 }
 
+/***********************************************************************************************************************************
+Sort and merge overlapping archive ranges so archive can be matched against the ranges in a single pass
+***********************************************************************************************************************************/
+static void
+archiveRangeMerge(List *const archiveRangeList)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(LIST, archiveRangeList);
+    FUNCTION_TEST_END();
+
+    ASSERT(archiveRangeList != NULL);
+
+    lstSort(archiveRangeList, sortOrderAsc);
+
+    if (!lstEmpty(archiveRangeList))
+    {
+        unsigned int mergeIdx = 0;
+
+        for (unsigned int rangeIdx = 1; rangeIdx < lstSize(archiveRangeList); rangeIdx++)
+        {
+            ArchiveRange *const merge = lstGet(archiveRangeList, mergeIdx);
+            const ArchiveRange *const range = lstGet(archiveRangeList, rangeIdx);
+
+            // If the range overlaps the merged range then extend the merged range if needed (a NULL stop has no end)
+            if (merge->stop == NULL || strCmp(range->start, merge->stop) <= 0)
+            {
+                if (merge->stop != NULL && (range->stop == NULL || strCmp(range->stop, merge->stop) > 0))
+                    merge->stop = range->stop;
+            }
+            // Else start a new merged range
+            else
+            {
+                mergeIdx++;
+                *(ArchiveRange *)lstGet(archiveRangeList, mergeIdx) = *range;
+            }
+        }
+
+        // Remove ranges that were merged
+        while (lstSize(archiveRangeList) > mergeIdx + 1)
+            lstRemoveLast(archiveRangeList);
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Determine if archive falls in a merged archive range. Only the first size characters of the archive and ranges are compared. Archive
+must be checked in ascending order since ranges that stop before the archive are skipped and will not be checked again.
+***********************************************************************************************************************************/
+static bool
+archiveRangeMatch(
+    const List *const archiveRangeList, unsigned int *const rangeIdx, const String *const archive, const size_t size)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(LIST, archiveRangeList);
+        FUNCTION_TEST_PARAM_P(UINT, rangeIdx);
+        FUNCTION_TEST_PARAM(STRING, archive);
+        FUNCTION_TEST_PARAM(SIZE, size);
+    FUNCTION_TEST_END();
+
+    ASSERT(archiveRangeList != NULL);
+    ASSERT(rangeIdx != NULL);
+    ASSERT(archive != NULL);
+
+    while (*rangeIdx < lstSize(archiveRangeList))
+    {
+        const ArchiveRange *const archiveRange = lstGet(archiveRangeList, *rangeIdx);
+
+        // If the range does not stop before the archive then this is the only range that can contain the archive
+        if (archiveRange->stop == NULL || strncmp(strZ(archive), strZ(archiveRange->stop), size) <= 0)
+            FUNCTION_TEST_RETURN(BOOL, strncmp(strZ(archive), strZ(archiveRange->start), size) >= 0);
+
+        (*rangeIdx)++;
+    }
+
+    FUNCTION_TEST_RETURN(BOOL, false);
+}
+
 /***********************************************************************************************************************************
 Process archive retention
 ***********************************************************************************************************************************/
@@ -603,7 +688,7 @@ removeExpiredArchive(const InfoBackup *const infoBackup, const bool timeBasedFul
                             // important to preserve archive that is required to make the older backups consistent even though they
                             // cannot be played any further forward with PITR.
                             const String *archiveExpireMax = NULL;
-                            List *const archiveRangeList = lstNewP(sizeof(ArchiveRange));
+                            List *const archiveRangeList = lstNewP(sizeof(ArchiveRange), .comparator = lstComparatorStr);
 
                             // From the full list of backups, loop through those associated with this archiveId
                             for (unsigned int backupListIdx = 0; backupListIdx < lstSize(archiveIdBackupList); backupListIdx++)
@@ -639,6 +724,16 @@ removeExpiredArchive(const InfoBackup *const infoBackup, const bool timeBasedFul
                                 }
                             }
 
+                            // Merge the ranges so sorted archive can be matched in a single pass
+                            archiveRangeMerge(archiveRangeList);
+
+                            unsigned int rangePathIdx = 0;
+                            unsigned int rangeFileIdx = 0;
+
+                            // Archive files to remove from major paths that are not removed entirely. These are removed in batches
+                            // at the end to reduce the number of requests to the repository.
+                            StringList *const archiveRemoveList = strLstNew();
+
                             // Get all major archive paths (timeline and first 32 bits of LSN)
                             const StringList *const walPathList =
                                 strLstSort(
@@ -647,23 +742,15 @@ removeExpiredArchive(const InfoBackup *const infoBackup, const bool timeBasedFul
                                         .expression = STRDEF(WAL_SEGMENT_DIR_REGEXP)),
                                     sortOrderAsc);
 
+                            // WAL file lists prefetched for the next major paths that will be scanned for individual files
+                            List *walSubPathListNext = NULL;
+
                             for (unsigned int walIdx = 0; walIdx < strLstSize(walPathList); walIdx++)
                             {
                                 const String *const walPath = strLstGet(walPathList, walIdx);
-                                removeArchive = true;
 
                                 // Keep the path if it falls in the range of any backup in retention
-                                for (unsigned int rangeIdx = 0; rangeIdx < lstSize(archiveRangeList); rangeIdx++)
-                                {
-                                    const ArchiveRange *const archiveRange = lstGet(archiveRangeList, rangeIdx);
-
-                                    if (strCmp(walPath, strSubN(archiveRange->start, 0, 16)) >= 0 &&
-                                        (archiveRange->stop == NULL || strCmp(walPath, strSubN(archiveRange->stop, 0, 16)) <= 0))
-                                    {
-                                        removeArchive = false;
-                                        break;
-                                    }
-                                }
+                                removeArchive = !archiveRangeMatch(archiveRangeList, &rangePathIdx, walPath, 16);
 
                                 // Remove the entire directory if all archive is expired
                                 if (removeArchive)
@@ -693,46 +780,50 @@ removeExpiredArchive(const InfoBackup *const infoBackup, const bool timeBasedFul
                                 // have anything to expire.
                                 else if (strCmp(walPath, strSubN(archiveExpireMax, 0, 16)) <= 0)
                                 {
-                                    // Look for files in the archive directory
-                                    const StringList *const walSubPathList =
-                                        strLstSort(
-                                            storageListP(
-                                                storageRepoIdx(repoIdx),
-                                                strNewFmt(STORAGE_REPO_ARCHIVE "/%s/%s", strZ(archiveId), strZ(walPath)),
-                                                .expression = STRDEF("^[0-F]{24}.*$")),
-                                            sortOrderAsc);
-
-                                    for (unsigned int subIdx = 0; subIdx < strLstSize(walSubPathList); subIdx++)
+                                    // Look for files in this and the next major paths that will be scanned concurrently. The
+                                    // paths are found by repeating the checks above on a copy of the range index, which is
+                                    // exact since ranges are matched in ascending order.
+                                    if (walSubPathListNext == NULL || lstEmpty(walSubPathListNext))
                                     {
-                                        removeArchive = true;
-                                        const String *const walSubPath = strLstGet(walSubPathList, subIdx);
+                                        StringList *const walSubPathPathList = strLstNew();
+                                        unsigned int rangePathIdxNext = rangePathIdx;
 
-                                        // Determine if the individual archive log is used in a backup
-                                        for (unsigned int rangeIdx = 0; rangeIdx < lstSize(archiveRangeList); rangeIdx++)
+                                        strLstAddFmt(
+                                            walSubPathPathList, STORAGE_REPO_ARCHIVE "/%s/%s", strZ(archiveId), strZ(walPath));
+
+                                        for (unsigned int walIdxNext = walIdx + 1;
+                                             walIdxNext < strLstSize(walPathList) &&
+                                             strLstSize(walSubPathPathList) < EXPIRE_ARCHIVE_LIST_PARALLEL;
+                                             walIdxNext++)
                                         {
-                                            const ArchiveRange *const archiveRange = lstGet(archiveRangeList, rangeIdx);
+                                            const String *const walPathNext = strLstGet(walPathList, walIdxNext);
 
-                                            if (strCmp(strSubN(walSubPath, 0, 24), archiveRange->start) >= 0 &&
-                                                (archiveRange->stop == NULL ||
-                                                 strCmp(strSubN(walSubPath, 0, 24), archiveRange->stop) <= 0))
+                                            if (archiveRangeMatch(archiveRangeList, &rangePathIdxNext, walPathNext, 16) &&
+                                                strCmp(walPathNext, strSubN(archiveExpireMax, 0, 16)) <= 0)
                                             {
-                                                removeArchive = false;
-                                                break;
+                                                strLstAddFmt(
+                                                    walSubPathPathList, STORAGE_REPO_ARCHIVE "/%s/%s", strZ(archiveId),
+                                                    strZ(walPathNext));
                                             }
                                         }
 
+                                        lstFree(walSubPathListNext);
+                                        walSubPathListNext = storageListMultiP(
+                                            storageRepoIdx(repoIdx), walSubPathPathList, .expression = STRDEF("^[0-F]{24}.*$"));
+                                    }
+
+                                    const StringList *const walSubPathList = strLstSort(
+                                        *(StringList **)lstGet(walSubPathListNext, 0), sortOrderAsc);
+                                    lstRemoveIdx(walSubPathListNext, 0);
+
+                                    for (unsigned int subIdx = 0; subIdx < strLstSize(walSubPathList); subIdx++)
+                                    {
+                                        const String *const walSubPath = strLstGet(walSubPathList, subIdx);
+
                                         // Remove archive log if it is not used in a backup
-                                        if (removeArchive)
+                                        if (!archiveRangeMatch(archiveRangeList, &rangeFileIdx, walSubPath, 24))
                                         {
-                                            // Execute the real expiration and deletion only if the dry-run mode is disabled
-                                            if (!cfgOptionValid(cfgOptDryRun) || !cfgOptionBool(cfgOptDryRun))
-                                            {
-                                                storageRemoveP(
-                                                    storageRepoIdxWrite(repoIdx),
-                                                    strNewFmt(
-                                                        STORAGE_REPO_ARCHIVE "/%s/%s/%s", strZ(archiveId), strZ(walPath),
-                                                        strZ(walSubPath)));
-                                            }
+                                            strLstAddFmt(archiveRemoveList, "%s/%s", strZ(walPath), strZ(walSubPath));
 
                                             // Track that this archive was removed
                                             archiveExpire.total++;
@@ -747,6 +838,14 @@ removeExpiredArchive(const InfoBackup *const infoBackup, const bool timeBasedFul
                                 }
                             }
 
+                            // Execute the real expiration and deletion only if the dry-run mode is disabled
+                            if (!cfgOptionValid(cfgOptDryRun) || !cfgOptionBool(cfgOptDryRun))
+                            {
+                                storageRemoveListP(
+                                    storageRepoIdxWrite(repoIdx), strNewFmt(STORAGE_REPO_ARCHIVE "/%s", strZ(archiveId)),
+                                    archiveRemoveList);
+                            }
+
                             // Log if no archive was expired
                             if (archiveExpire.total == 0)
                             {
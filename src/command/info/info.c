@@ -111,6 +111,9 @@ STRING_STATIC(INFO_STANZA_INVALID_STR,                              "[invalid]")
 #define INFO_STANZA_STATUS_MESSAGE_LOCK_BACKUP                      "backup/expire running"
 #define INFO_STANZA_STATUS_MESSAGE_LOCK_RESTORE                     "restore running"
 
+// Max WAL paths to list concurrently when searching for the archive min/max
+#define INFO_ARCHIVE_LIST_PARALLEL                                  8
+
 /***********************************************************************************************************************************
 Data types and structures
 ***********************************************************************************************************************************/
@@ -328,6 +331,74 @@ repoStanzaStatus(const int code, const Variant *const repoStanzaInfo, const Info
     FUNCTION_TEST_RETURN_VOID();
 }
 
+/***********************************************************************************************************************************
+Find the oldest (sortOrderAsc) or newest (sortOrderDesc) WAL segment in the archive. Not every WAL path has WAL segments so paths
+are checked in order until one is found. Paths are listed concurrently in batches that start with a single path, since the first
+path usually has WAL segments, and double up to the max.
+***********************************************************************************************************************************/
+static String *
+archiveDbWalFind(
+    const Storage *const storageRepo, const String *const archivePath, const StringList *const walPathList,
+    const SortOrder sortOrder)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE, storageRepo);
+        FUNCTION_TEST_PARAM(STRING, archivePath);
+        FUNCTION_TEST_PARAM(STRING_LIST, walPathList);
+        FUNCTION_TEST_PARAM(ENUM, sortOrder);
+    FUNCTION_TEST_END();
+
+    ASSERT(storageRepo != NULL);
+    ASSERT(archivePath != NULL);
+    ASSERT(walPathList != NULL);
+
+    String *result = NULL;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        const unsigned int walPathTotal = strLstSize(walPathList);
+        unsigned int walPathIdx = 0;
+        unsigned int batchSize = 1;
+
+        while (result == NULL && walPathIdx < walPathTotal)
+        {
+            // Get the next batch of paths in the requested order
+            StringList *const pathList = strLstNew();
+
+            for (; strLstSize(pathList) < batchSize && walPathIdx < walPathTotal; walPathIdx++)
+            {
+                strLstAddFmt(
+                    pathList, "%s/%s", strZ(archivePath),
+                    strZ(strLstGet(walPathList, sortOrder == sortOrderAsc ? walPathIdx : walPathTotal - walPathIdx - 1)));
+            }
+
+            // Get WAL segments in the first path that has any
+            const List *const listMulti = storageListMultiP(storageRepo, pathList, .expression = WAL_SEGMENT_FILE_REGEXP_STR);
+
+            for (unsigned int listIdx = 0; listIdx < lstSize(listMulti); listIdx++)
+            {
+                StringList *const list = *(StringList **)lstGet(listMulti, listIdx);
+
+                if (!strLstEmpty(list))
+                {
+                    MEM_CONTEXT_PRIOR_BEGIN()
+                    {
+                        result = strSubN(strLstGet(strLstSort(list, sortOrder), 0), 0, 24);
+                    }
+                    MEM_CONTEXT_PRIOR_END();
+
+                    break;
+                }
+            }
+
+            batchSize = batchSize * 2 < INFO_ARCHIVE_LIST_PARALLEL ? batchSize * 2 : INFO_ARCHIVE_LIST_PARALLEL;
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN(STRING, result);
+}
+
 /***********************************************************************************************************************************
 Set the data for the archive section of the stanza for the database info from the backup.info file
 ***********************************************************************************************************************************/
@@ -368,43 +439,9 @@ archiveDbList(
 
     if (!strLstEmpty(walDir))
     {
-        // Not every WAL dir has WAL files so check each
-        for (unsigned int idx = 0; idx < strLstSize(walDir); idx++)
-        {
-            // Get a list of all WAL in this WAL dir and sort the list from oldest to newest to get the oldest starting WAL archived
-            // for this db
-            const StringList *const list = strLstSort(
-                storageListP(
-                    storageRepo, strNewFmt("%s/%s", strZ(archivePath), strZ(strLstGet(walDir, idx))),
-                    .expression = WAL_SEGMENT_FILE_REGEXP_STR),
-                sortOrderAsc);
-
-            // If wal segments are found, get the oldest one as the archive start
-            if (!strLstEmpty(list))
-            {
-                archiveStart = strSubN(strLstGet(list, 0), 0, 24);
-                break;
-            }
-        }
-
-        // Iterate through the directory list in reverse processing newest first. Cast comparison to an int for readability.
-        for (unsigned int idx = strLstSize(walDir) - 1; (int)idx >= 0; idx--)
-        {
-            // Get a list of all WAL in this WAL dir and sort the list from newest to oldest to get the newest ending WAL archived
-            // for this db
-            const StringList *const list = strLstSort(
-                storageListP(
-                    storageRepo, strNewFmt("%s/%s", strZ(archivePath), strZ(strLstGet(walDir, idx))),
-                    .expression = WAL_SEGMENT_FILE_REGEXP_STR),
-                sortOrderDesc);
-
-            // If wal segments are found, get the newest one as the archive stop
-            if (!strLstEmpty(list))
-            {
-                archiveStop = strSubN(strLstGet(list, 0), 0, 24);
-                break;
-            }
-        }
+        // Get the oldest WAL archived for this db as the archive start and the newest as the archive stop
+        archiveStart = archiveDbWalFind(storageRepo, archivePath, walDir, sortOrderAsc);
+        archiveStop = archiveDbWalFind(storageRepo, archivePath, walDir, sortOrderDesc);
     }
 
     // If there is an archive or the database is the current database then store it
@@ -0,0 +1,240 @@
+/***********************************************************************************************************************************
+Command Metrics
+***********************************************************************************************************************************/
+#include "build.auto.h"
+
+#include <inttypes.h>
+#include <string.h>
+
+#include "command/metrics.h"
+#include "common/debug.h"
+#include "common/io/http/client.h"
+#include "common/log.h"
+#include "common/stat.h"
+#include "common/time.h"
+#include "config/config.h"
+#include "storage/helper.h"
+
+/***********************************************************************************************************************************
+Metric name prefix
+***********************************************************************************************************************************/
+#define CMD_METRICS_PREFIX                                          "pgbackrest_"
+
+/***********************************************************************************************************************************
+Local variables
+***********************************************************************************************************************************/
+static struct CmdMetricsLocal
+{
+    TimeMSec timeBegin;                                             // Time of the first write, used to calculate throughput
+    TimeMSec timeLast;                                              // Time of the last write
+    bool error;                                                     // Has an error already been logged?
+} cmdMetricsLocal;
+
+/***********************************************************************************************************************************
+Get the metrics file for the current command. The command (and role, when not main) is added to the file name before the extension
+so commands that run at the same time, e.g. archive-push in the main and async roles or archive-push during a backup, do not
+overwrite each other's metrics.
+***********************************************************************************************************************************/
+static String *
+cmdMetricsFile(void)
+{
+    FUNCTION_TEST_VOID();
+
+    String *const result = strNew();
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        const String *const file = cfgOptionStr(cfgOptMetricsFile);
+        const char *const extension = strrchr(strZ(file), '.');
+        const char *const separator = strrchr(strZ(file), '/');
+        const String *const command = strReplaceChr(cfgCommandRoleName(), ':', '-');
+
+        ASSERT(separator != NULL);
+
+        // Add the command before the extension when there is one
+        if (extension != NULL && extension > separator + 1)
+        {
+            strCatZN(result, strZ(file), (size_t)(extension - strZ(file)));
+            strCatFmt(result, "-%s%s", strZ(command), extension);
+        }
+        // Else add the command at the end
+        else
+            strCatFmt(result, "%s-%s", strZ(file), strZ(command));
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN(STRING, result);
+}
+
+/***********************************************************************************************************************************
+Add a metric header and optionally a value
+***********************************************************************************************************************************/
+static void
+cmdMetricsHeader(String *const metrics, const char *const name, const char *const type, const char *const help)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING, metrics);
+        FUNCTION_TEST_PARAM(STRINGZ, name);
+        FUNCTION_TEST_PARAM(STRINGZ, type);
+        FUNCTION_TEST_PARAM(STRINGZ, help);
+    FUNCTION_TEST_END();
+
+    strCatFmt(metrics, "# HELP " CMD_METRICS_PREFIX "%s %s\n# TYPE " CMD_METRICS_PREFIX "%s %s\n", name, help, name, type);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+static void
+cmdMetricsValue(
+    String *const metrics, const char *const name, const char *const type, const char *const help, const String *const label,
+    const uint64_t value)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING, metrics);
+        FUNCTION_TEST_PARAM(STRINGZ, name);
+        FUNCTION_TEST_PARAM(STRINGZ, type);
+        FUNCTION_TEST_PARAM(STRINGZ, help);
+        FUNCTION_TEST_PARAM(STRING, label);
+        FUNCTION_TEST_PARAM(UINT64, value);
+    FUNCTION_TEST_END();
+
+    cmdMetricsHeader(metrics, name, type, help);
+    strCatFmt(metrics, CMD_METRICS_PREFIX "%s{%s} %" PRIu64 "\n", name, strZ(label), value);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Add a byte counter along with the average throughput since the first write
+***********************************************************************************************************************************/
+static void
+cmdMetricsSize(
+    String *const metrics, const char *const name, const char *const help, const String *const label, const uint64_t size,
+    const TimeMSec timeElapsed)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING, metrics);
+        FUNCTION_TEST_PARAM(STRINGZ, name);
+        FUNCTION_TEST_PARAM(STRINGZ, help);
+        FUNCTION_TEST_PARAM(STRING, label);
+        FUNCTION_TEST_PARAM(UINT64, size);
+        FUNCTION_TEST_PARAM(TIME_MSEC, timeElapsed);
+    FUNCTION_TEST_END();
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        cmdMetricsValue(metrics, zNewFmt("%s_bytes_total", name), "counter", zNewFmt("Bytes %s.", help), label, size);
+        cmdMetricsValue(
+            metrics, zNewFmt("%s_bytes_per_second", name), "gauge", zNewFmt("Average bytes %s per second.", help), label,
+            timeElapsed == 0 ? 0 : size * MSEC_PER_SEC / timeElapsed);
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN void
+cmdMetricsWrite(const CmdMetricsWriteParam param)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(BOOL, param.force);
+        FUNCTION_LOG_PARAM(UINT64, param.sizeRead);
+        FUNCTION_LOG_PARAM(UINT64, param.sizeWrite);
+        FUNCTION_LOG_PARAM(UINT64, param.sizeCompress);
+        FUNCTION_LOG_PARAM(UINT64, param.fileComplete);
+        FUNCTION_LOG_PARAM(UINT64, param.fileTotal);
+        FUNCTION_LOG_PARAM(LIST, param.queueList);
+        FUNCTION_LOG_PARAM(TIME, param.archiveTime);
+    FUNCTION_LOG_END();
+
+    if (cfgOptionTest(cfgOptMetricsFile))
+    {
+        const TimeMSec timeNow = timeMSec();
+
+        if (cmdMetricsLocal.timeBegin == 0)
+            cmdMetricsLocal.timeBegin = timeNow;
+
+        // Write when forced, on the first call, or when the interval has elapsed
+        if (param.force || cmdMetricsLocal.timeLast == 0 || timeNow - cmdMetricsLocal.timeLast >= CMD_METRICS_INTERVAL)
+        {
+            cmdMetricsLocal.timeLast = timeNow;
+
+            MEM_CONTEXT_TEMP_BEGIN()
+            {
+                const TimeMSec timeElapsed = timeNow - cmdMetricsLocal.timeBegin;
+                const String *const label = strNewFmt(
+                    "stanza=\"%s\",command=\"%s\"", strZ(cfgOptionStr(cfgOptStanza)), strZ(cfgCommandRoleName()));
+                String *const metrics = strNew();
+
+                // Throughput
+                cmdMetricsSize(metrics, "read", "read", label, param.sizeRead, timeElapsed);
+                cmdMetricsSize(metrics, "write", "written", label, param.sizeWrite, timeElapsed);
+                cmdMetricsSize(metrics, "compress", "written or read in compressed form", label, param.sizeCompress, timeElapsed);
+
+                // Files
+                cmdMetricsValue(metrics, "file_complete", "gauge", "Files complete.", label, param.fileComplete);
+                cmdMetricsValue(
+                    metrics, "file_queued", "gauge", "Files queued or in progress.", label,
+                    param.fileTotal > param.fileComplete ? param.fileTotal - param.fileComplete : 0);
+
+                // Queue depth
+                if (param.queueList != NULL)
+                {
+                    cmdMetricsHeader(metrics, "queue_depth", "gauge", "Files waiting in each processing queue.");
+
+                    for (unsigned int queueIdx = 0; queueIdx < lstSize(param.queueList); queueIdx++)
+                    {
+                        strCatFmt(
+                            metrics, CMD_METRICS_PREFIX "queue_depth{%s,queue=\"%u\"} %u\n", strZ(label), queueIdx,
+                            lstSize(*(List **)lstGet(param.queueList, queueIdx)));
+                    }
+                }
+
+                // HTTP retries in this process
+                cmdMetricsValue(
+                    metrics, "http_retry_total", "counter", "HTTP request retries.", label, statTotal(HTTP_STAT_RETRY_STR));
+
+                // Archive lag, i.e. how long the last WAL segment waited to be archived
+                if (param.archiveTime != 0)
+                {
+                    const time_t timeArchive = (time_t)(timeNow / MSEC_PER_SEC);
+
+                    cmdMetricsValue(
+                        metrics, "archive_lag_seconds", "gauge", "Age of the last WAL segment archived.", label,
+                        timeArchive > param.archiveTime ? (uint64_t)(timeArchive - param.archiveTime) : 0);
+                }
+
+                // Elapsed and update time so stale metrics can be detected
+                cmdMetricsValue(
+                    metrics, "elapsed_seconds", "gauge", "Time since the command started reporting.", label,
+                    timeElapsed / MSEC_PER_SEC);
+                cmdMetricsValue(
+                    metrics, "update_time_seconds", "gauge", "Time the metrics were last updated.", label, timeNow / MSEC_PER_SEC);
+
+                // Metrics are informational so only warn on error. Warn only once to avoid flooding the log when the file cannot be
+                // written on each update.
+                TRY_BEGIN()
+                {
+                    storagePutP(
+                        storageNewWriteP(
+                            storageLocalWrite(), cmdMetricsFile(), .modeFile = 0644, .noSyncFile = true,
+                            .noSyncPath = true),
+                        BUFSTR(metrics));
+                }
+                CATCH_ANY()
+                {
+                    if (!cmdMetricsLocal.error)
+                    {
+                        LOG_WARN_FMT("unable to write metrics: %s", errorMessage());
+                        cmdMetricsLocal.error = true;
+                    }
+                }
+                TRY_END();
+            }
+            MEM_CONTEXT_TEMP_END();
+        }
+    }
+
+    FUNCTION_LOG_RETURN_VOID();
+}
@@ -0,0 +1,43 @@
+/***********************************************************************************************************************************
+Command Metrics
+
+Write progress metrics for a running command to a file in the Prometheus text format so they can be scraped by the node_exporter
+textfile collector. The file is written atomically so a partial file will never be read. Writes happen at most once per interval
+unless forced so metrics may be updated as often as convenient without adding significant overhead.
+***********************************************************************************************************************************/
+#ifndef COMMAND_METRICS_H
+#define COMMAND_METRICS_H
+
+#include <time.h>
+
+#include "common/type/list.h"
+#include "common/type/param.h"
+
+/***********************************************************************************************************************************
+Constants
+***********************************************************************************************************************************/
+#define CMD_METRICS_INTERVAL                                        1000
+
+/***********************************************************************************************************************************
+Functions
+***********************************************************************************************************************************/
+// Write metrics to the file specified by the metrics-file option. Nothing is written when the option is not set.
+typedef struct CmdMetricsWriteParam
+{
+    VAR_PARAM_HEADER;
+    bool force;                                                     // Write even if the interval has not elapsed
+    uint64_t sizeRead;                                              // Bytes read from the source
+    uint64_t sizeWrite;                                             // Bytes written to the destination
+    uint64_t sizeCompress;                                          // Compressed bytes written/read
+    uint64_t fileComplete;                                          // Files complete
+    uint64_t fileTotal;                                             // Total files to process
+    const List *queueList;                                          // Processing queues (List of List *) for queue depth
+    time_t archiveTime;                                             // Modification time of the last WAL segment archived (0 if none)
+} CmdMetricsWriteParam;
+
+#define cmdMetricsWriteP(...)                                                                                                      \
+    cmdMetricsWrite((CmdMetricsWriteParam){VAR_PARAM_INIT, __VA_ARGS__})
+
+FN_EXTERN void cmdMetricsWrite(CmdMetricsWriteParam param);
+
+#endif
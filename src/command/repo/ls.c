@@ -17,6 +17,11 @@ Repository List Command
 #include "config/config.h"
 #include "storage/helper.h"
 
+/***********************************************************************************************************************************
+Subpaths to list concurrently when recursing. This only has an effect on storage that can list paths concurrently, e.g. S3.
+***********************************************************************************************************************************/
+#define REPO_LS_PARALLEL                                            8
+
 /***********************************************************************************************************************************
 Render storage list
 ***********************************************************************************************************************************/
@@ -153,7 +158,8 @@ storageListRender(IoWrite *const write)
 
         // List content of the path
         StorageIterator *const storageItr = storageNewItrP(
-            storageRepo(), path, .sortOrder = sortOrder, .expression = expression, .recurse = cfgOptionBool(cfgOptRecurse));
+            storageRepo(), path, .sortOrder = sortOrder, .expression = expression, .recurse = cfgOptionBool(cfgOptRecurse),
+            .parallel = REPO_LS_PARALLEL);
 
         while (storageItrMore(storageItr))
         {
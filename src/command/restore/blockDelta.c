@@ -7,9 +7,16 @@ Block Restore
 #include "command/restore/blockDelta.h"
 #include "common/crypto/cipherBlock.h"
 #include "common/debug.h"
+#include "common/io/io.h"
 #include "common/io/limitRead.h"
 #include "common/log.h"
 
+/***********************************************************************************************************************************
+Super blocks separated by no more than this many bytes are fetched with a single read and the bytes between them are skipped. Reading
+the extra bytes is cheaper than issuing another request, especially on object stores where each read is a separate ranged GET.
+***********************************************************************************************************************************/
+#define BLOCK_DELTA_READ_GAP_MAX                                    (256 * 1024)
+
 /***********************************************************************************************************************************
 Object type
 ***********************************************************************************************************************************/
@@ -17,6 +24,7 @@ typedef struct BlockDeltaSuperBlock
 {
     uint64_t superBlockSize;                                        // Super block size
     uint64_t size;                                                  // Stored size of superblock (with compression, etc.)
+    uint64_t skip;                                                  // Bytes to skip before the super block
     List *blockList;                                                // Block list
 } BlockDeltaSuperBlock;
 
@@ -143,10 +151,13 @@ blockDeltaNew(
                     const unsigned int blockMapIdx = *(unsigned int *)lstGet(referenceData->blockList, blockIdx);
                     const BlockMapItem *const blockMapItem = blockMapGet(blockMap, blockMapIdx);
 
-                    // Add read when it has changed
+                    // Add read when it has changed. Super blocks that are not contiguous are still added to the current read when the
+                    // gap between them is small enough.
+                    const uint64_t priorEnd = blockMapItemPrior == NULL ? 0 : blockMapItemPrior->offset + blockMapItemPrior->size;
+
                     if (blockMapItemPrior == NULL ||
                         (blockMapItemPrior->offset != blockMapItem->offset &&
-                         blockMapItemPrior->offset + blockMapItemPrior->size != blockMapItem->offset))
+                         (blockMapItem->offset < priorEnd || blockMapItem->offset - priorEnd > BLOCK_DELTA_READ_GAP_MAX)))
                     {
                         MEM_CONTEXT_OBJ_BEGIN(this->pub.readList)
                         {
@@ -172,11 +183,12 @@ blockDeltaNew(
                             {
                                 .superBlockSize = blockMapItem->superBlockSize,
                                 .size = blockMapItem->size,
+                                .skip = blockMapItem->offset - (blockDeltaRead->offset + blockDeltaRead->size),
                                 .blockList = lstNewP(sizeof(BlockDeltaBlock)),
                             };
 
                             blockDeltaSuperBlock = lstAdd(blockDeltaRead->superBlockList, &blockDeltaSuperBlockNew);
-                            blockDeltaRead->size += blockMapItem->size;
+                            blockDeltaRead->size += blockDeltaSuperBlockNew.skip + blockMapItem->size;
                         }
                         MEM_CONTEXT_OBJ_END();
                     }
@@ -231,6 +243,15 @@ blockDeltaNext(BlockDelta *const this, const BlockDeltaRead *const readDelta, Io
             ioReadFree(this->limitRead);
             this->superBlockData = lstGet(readDelta->superBlockList, this->superBlockIdx);
 
+            // Skip bytes between the prior super block and this one
+            if (this->superBlockData->skip != 0)
+            {
+                IoRead *const skipRead = ioLimitReadNew(readIo, this->superBlockData->skip);
+
+                ioReadDrain(skipRead);
+                ioReadFree(skipRead);
+            }
+
             MEM_CONTEXT_OBJ_BEGIN(this)
             {
                 this->limitRead = ioLimitReadNew(readIo, this->superBlockData->size);
@@ -9,6 +9,7 @@ Restore File
 
 #include "command/backup/blockIncr.h"
 #include "command/backup/blockMap.h"
+#include "command/backup/common.h"
 #include "command/restore/blockChecksum.h"
 #include "command/restore/blockDelta.h"
 #include "command/restore/file.h"
@@ -23,14 +24,16 @@ Restore File
 #include "common/log.h"
 #include "config/config.h"
 #include "info/manifest.h"
+#include "postgres/interface.h"
 #include "storage/helper.h"
 
 /**********************************************************************************************************************************/
 FN_EXTERN List *
 restoreFile(
     const String *const repoFile, const unsigned int repoIdx, const CompressType repoFileCompressType, const time_t copyTimeBegin,
-    const bool delta, const bool deltaForce, const bool bundleRaw, const String *const cipherPass,
-    const StringList *const referenceList, List *const fileList)
+    const bool delta, const bool deltaForce, const bool bundleRaw, const bool syncDefer, const bool preallocate,
+    const String *const cipherPass, const StringList *const referenceList, const uint64_t rateLimitPg, const uint64_t rateLimitRepo,
+    List *const fileList)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(STRING, repoFile);
@@ -40,8 +43,12 @@ restoreFile(
         FUNCTION_LOG_PARAM(BOOL, delta);
         FUNCTION_LOG_PARAM(BOOL, deltaForce);
         FUNCTION_LOG_PARAM(BOOL, bundleRaw);
+        FUNCTION_LOG_PARAM(BOOL, syncDefer);                        // Defer file sync to a file system sync at the end of restore
+        FUNCTION_LOG_PARAM(BOOL, preallocate);                      // Preallocate files and skip writing zero pages
         FUNCTION_TEST_PARAM(STRING, cipherPass);
         FUNCTION_LOG_PARAM(STRING_LIST, referenceList);             // List of references (for block incremental)
+        FUNCTION_LOG_PARAM(UINT64, rateLimitPg);                    // Max bytes per second written to pg (0 for no limit)
+        FUNCTION_LOG_PARAM(UINT64, rateLimitRepo);                  // Max bytes per second read from the repo (0 for no limit)
         FUNCTION_LOG_PARAM(LIST, fileList);                         // List of files to restore
     FUNCTION_LOG_END();
 
@@ -102,7 +109,7 @@ restoreFile(
                                     IoWrite *const pgWriteTruncate = storageWriteIo(
                                         storageNewWriteP(
                                             storagePgWrite(), file->name, .noAtomic = true, .noCreatePath = true,
-                                            .noSyncPath = true, .noTruncate = true));
+                                            .noSyncPath = true, .noTruncate = true, .syncDefer = syncDefer));
                                     ioWriteOpen(pgWriteTruncate);
 
                                     // Truncate to original size
@@ -195,7 +202,8 @@ restoreFile(
                     // Create destination file
                     StorageWrite *const pgFileWrite = storageNewWriteP(
                         storagePgWrite(), file->name, .modeFile = file->mode, .user = file->user, .group = file->group,
-                        .timeModified = file->timeModified, .noAtomic = true, .noCreatePath = true, .noSyncPath = true);
+                        .timeModified = file->timeModified, .noAtomic = true, .noCreatePath = true, .noSyncPath = true,
+                        .syncDefer = syncDefer);
 
                     ioWriteOpen(storageWriteIo(pgFileWrite));
 
@@ -276,11 +284,16 @@ restoreFile(
                         MEM_CONTEXT_PRIOR_END();
                     }
 
-                    // Create pg file
+                    // Create pg file. When preallocating, pages that contain only zeros are skipped rather than written. Block
+                    // incremental files that are being updated in place are not preallocated since they already exist.
+                    const bool filePreallocate = preallocate && file->blockChecksum == NULL;
+
                     StorageWrite *const pgFileWrite = storageNewWriteP(
                         storagePgWrite(), file->name, .modeFile = file->mode, .user = file->user, .group = file->group,
                         .timeModified = file->timeModified, .noAtomic = true, .noCreatePath = true, .noSyncPath = true,
-                        .noTruncate = file->blockChecksum != NULL);
+                        .noTruncate = file->blockChecksum != NULL, .syncDefer = syncDefer,
+                        .preallocate = filePreallocate ? file->size : 0,
+                        .sparseSize = filePreallocate && file->blockIncrMapSize == 0 ? pgPageSize8 : 0);
 
                     // If block incremental file
                     const Buffer *checksum = NULL;
@@ -304,8 +317,10 @@ restoreFile(
 
                         const BlockMap *const blockMap = blockMapNewRead(
                             blockMapRead, file->blockIncrSize, file->blockIncrChecksumSize);
+                        fileResult->repoSize += varUInt64(file->limit);
 
-                        // Open file to write
+                        // Open file to write and limit the rate of writes to pg
+                        backupRateFilterGroupAdd(ioWriteFilterGroup(storageWriteIo(pgFileWrite)), rateLimitPg);
                         ioWriteOpen(storageWriteIo(pgFileWrite));
 
                         // Apply delta to file
@@ -325,7 +340,9 @@ restoreFile(
                                     strLstGet(referenceList, read->reference), .manifestName = file->manifestFile,
                                     .bundleId = read->bundleId, .blockIncr = true),
                                 .offset = read->offset, .limit = VARUINT64(read->size));
+                            backupRateFilterGroupAdd(ioReadFilterGroup(storageReadIo(superBlockRead)), rateLimitRepo);
                             ioReadOpen(storageReadIo(superBlockRead));
+                            fileResult->repoSize += read->size;
 
                             // Write updated blocks to the file
                             const BlockDeltaWrite *deltaWrite = blockDeltaNext(blockDelta, read, storageReadIo(superBlockRead));
@@ -370,6 +387,12 @@ restoreFile(
                     {
                         IoFilterGroup *const filterGroup = ioWriteFilterGroup(storageWriteIo(pgFileWrite));
 
+                        // Limit the rate of reads from the repo
+                        backupRateFilterGroupAdd(filterGroup, rateLimitRepo);
+
+                        // Add size filter for the size read from the repo
+                        ioFilterGroupAdd(filterGroup, ioSizeNew());
+
                         // Add decryption filter
                         if (cipherPass != NULL)
                         {
@@ -388,13 +411,17 @@ restoreFile(
                         // Add size filter
                         ioFilterGroupAdd(filterGroup, ioSizeNew());
 
+                        // Limit the rate of writes to pg
+                        backupRateFilterGroupAdd(filterGroup, rateLimitPg);
+
                         // Copy file
                         ioWriteOpen(storageWriteIo(pgFileWrite));
                         ioCopyP(storageReadIo(repoFileRead), storageWriteIo(pgFileWrite), .limit = file->limit);
                         ioWriteClose(storageWriteIo(pgFileWrite));
 
-                        // Get checksum result
+                        // Get checksum and repo size results
                         checksum = pckReadBinP(ioFilterGroupResultP(filterGroup, CRYPTO_HASH_FILTER_TYPE));
+                        fileResult->repoSize = pckReadU64P(ioFilterGroupResultP(filterGroup, SIZE_FILTER_TYPE));
                     }
 
                     // If more than one file is being copied from a single read then decrement the limit
@@ -45,10 +45,12 @@ typedef struct RestoreFileResult
     const String *manifestFile;                                     // Manifest file
     RestoreResult result;                                           // Restore result (e.g. preserve, copy)
     uint64_t blockIncrDeltaSize;                                    // Size restored by block incremental delta
+    uint64_t repoSize;                                              // Size read from the repo
 } RestoreFileResult;
 
 FN_EXTERN List *restoreFile(
     const String *repoFile, unsigned int repoIdx, CompressType repoFileCompressType, time_t copyTimeBegin, bool delta,
-    bool deltaForce, bool bundleRaw, const String *cipherPass, const StringList *referenceList, List *fileList);
+    bool deltaForce, bool bundleRaw, bool syncDefer, bool preallocate, const String *cipherPass, const StringList *referenceList,
+    uint64_t rateLimitPg, uint64_t rateLimitRepo, List *fileList);
 
 #endif
@@ -29,13 +29,18 @@ restoreFileProtocol(PackRead *const param)
         // Restore file
         const String *const repoFile = pckReadStrP(param);
         const unsigned int repoIdx = pckReadU32P(param);
+        const unsigned int repoIdxSelected = pckReadU32P(param);
         const CompressType repoFileCompressType = (CompressType)pckReadU32P(param);
         const time_t copyTimeBegin = pckReadTimeP(param);
         const bool delta = pckReadBoolP(param);
         const bool deltaForce = pckReadBoolP(param);
         const bool bundleRaw = pckReadBoolP(param);
+        const bool syncDefer = pckReadBoolP(param);
+        const bool preallocate = pckReadBoolP(param);
         const String *const cipherPass = pckReadStrP(param);
         const StringList *const referenceList = pckReadStrLstP(param);
+        const uint64_t rateLimitPg = pckReadU64P(param);
+        const uint64_t rateLimitRepo = pckReadU64P(param);
 
         // Build the file list
         List *const fileList = lstNewP(sizeof(RestoreFile));
@@ -72,9 +77,31 @@ restoreFileProtocol(PackRead *const param)
         }
 
         // Restore files
-        const List *const resultList = restoreFile(
-            repoFile, repoIdx, repoFileCompressType, copyTimeBegin, delta, deltaForce, bundleRaw, cipherPass, referenceList,
-            fileList);
+        const List *volatile resultList = NULL;
+
+        TRY_BEGIN()
+        {
+            resultList = restoreFile(
+                repoFile, repoIdx, repoFileCompressType, copyTimeBegin, delta, deltaForce, bundleRaw, syncDefer, preallocate,
+                cipherPass, referenceList, rateLimitPg, rateLimitRepo, fileList);
+        }
+        CATCH_ANY()
+        {
+            // Rethrow when the files were already being read from the repo selected for the restore
+            if (repoIdx == repoIdxSelected)
+                RETHROW();
+
+            // Else read the files again from the selected repo, which has everything required for the restore
+            LOG_WARN_FMT(
+                "unable to restore '%s' from %s, retry from %s: [%s] %s", strZ(repoFile),
+                cfgOptionGroupName(cfgOptGrpRepo, repoIdx), cfgOptionGroupName(cfgOptGrpRepo, repoIdxSelected),
+                errorTypeName(errorType()), errorMessage());
+
+            resultList = restoreFile(
+                repoFile, repoIdxSelected, repoFileCompressType, copyTimeBegin, delta, deltaForce, bundleRaw, syncDefer,
+                preallocate, cipherPass, referenceList, rateLimitPg, rateLimitRepo, fileList);
+        }
+        TRY_END();
 
         // Return result
         PackWrite *const data = protocolServerResultData(result);
@@ -86,6 +113,7 @@ restoreFileProtocol(PackRead *const param)
             pckWriteStrP(data, fileResult->manifestFile);
             pckWriteU32P(data, fileResult->result);
             pckWriteU64P(data, fileResult->blockIncrDeltaSize);
+            pckWriteU64P(data, fileResult->repoSize);
         }
     }
     MEM_CONTEXT_TEMP_END();
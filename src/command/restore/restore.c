@@ -8,7 +8,9 @@ Restore Command
 #include <time.h>
 #include <unistd.h>
 
+#include "command/backup/common.h"
 #include "command/lock.h"
+#include "command/metrics.h"
 #include "command/restore/file.h"
 #include "command/restore/protocol.h"
 #include "command/restore/restore.h"
@@ -327,6 +329,124 @@ restoreBackupSet(void)
     FUNCTION_LOG_RETURN_STRUCT(result);
 }
 
+/***********************************************************************************************************************************
+Find other repos that hold an identical copy of the backup set so files can be read from all of them concurrently
+
+A repo is only used as a source when every file is stored exactly as in the selected repo, i.e. with the same checksum, size,
+reference, and location in the repo. Any restore job can then be read from any source and is still verified against the checksum
+in the manifest. The selected repo is always first in the list.
+***********************************************************************************************************************************/
+static bool
+restoreSourceMatch(const Manifest *const manifest, const Manifest *const manifestSource)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(MANIFEST, manifest);
+        FUNCTION_LOG_PARAM(MANIFEST, manifestSource);
+    FUNCTION_LOG_END();
+
+    ASSERT(manifest != NULL);
+    ASSERT(manifestSource != NULL);
+
+    const ManifestData *const data = manifestData(manifest);
+    const ManifestData *const dataSource = manifestData(manifestSource);
+    const String *const cipherSubPass = manifestCipherSubPass(manifest);
+    const String *const cipherSubPassSource = manifestCipherSubPass(manifestSource);
+
+    bool result =
+        strEq(data->backupLabel, dataSource->backupLabel) &&
+        data->backupOptionCompressType == dataSource->backupOptionCompressType && data->bundleRaw == dataSource->bundleRaw &&
+        data->backupTimestampCopyStart == dataSource->backupTimestampCopyStart &&
+        (cipherSubPass == NULL ? cipherSubPassSource == NULL : strEq(cipherSubPass, cipherSubPassSource)) &&
+        manifestFileTotal(manifest) == manifestFileTotal(manifestSource);
+
+    MEM_CONTEXT_TEMP_RESET_BEGIN()
+    {
+        for (unsigned int fileIdx = 0; result && fileIdx < manifestFileTotal(manifest); fileIdx++)
+        {
+            const ManifestFile file = manifestFile(manifest, fileIdx);
+            const ManifestFile fileSource = manifestFile(manifestSource, fileIdx);
+
+            result =
+                strEq(file.name, fileSource.name) &&
+                (file.reference == NULL ? fileSource.reference == NULL : strEq(file.reference, fileSource.reference)) &&
+                memcmp(file.checksumSha1, fileSource.checksumSha1, HASH_TYPE_SHA1_SIZE) == 0 && file.size == fileSource.size &&
+                file.sizeRepo == fileSource.sizeRepo && file.bundleId == fileSource.bundleId &&
+                file.bundleOffset == fileSource.bundleOffset && file.blockIncrSize == fileSource.blockIncrSize &&
+                file.blockIncrChecksumSize == fileSource.blockIncrChecksumSize &&
+                file.blockIncrMapSize == fileSource.blockIncrMapSize;
+
+            // Reset the memory context occasionally so we don't use too much memory or slow down processing
+            MEM_CONTEXT_TEMP_RESET(1000);
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN(BOOL, result);
+}
+
+static List *
+restoreSourceList(const Manifest *const manifest, const RestoreBackupData backupData)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(MANIFEST, manifest);
+        FUNCTION_LOG_PARAM(UINT, backupData.repoIdx);
+        FUNCTION_LOG_PARAM(STRING, backupData.backupSet);
+    FUNCTION_LOG_END();
+
+    ASSERT(manifest != NULL);
+
+    List *const result = lstNewP(sizeof(unsigned int));
+    lstAdd(result, &backupData.repoIdx);
+
+    // Only the selected repo is used unless multiple repos were requested and the repo was not specified
+    if (cfgOptionBool(cfgOptMultiRepo) && !cfgOptionTest(cfgOptRepo))
+    {
+        MEM_CONTEXT_TEMP_BEGIN()
+        {
+            // Repos before the selected repo have already been searched for the backup set so only check the repos after it
+            for (unsigned int repoIdx = backupData.repoIdx + 1; repoIdx < cfgOptionGroupIdxTotal(cfgOptGrpRepo); repoIdx++)
+            {
+                // Errors are not fatal since the selected repo has everything required for the restore
+                TRY_BEGIN()
+                {
+                    const CipherType cipherType = cfgOptionIdxStrId(cfgOptRepoCipherType, repoIdx);
+                    const InfoBackup *const infoBackup = infoBackupLoadFile(
+                        storageRepoIdx(repoIdx), INFO_BACKUP_PATH_FILE_STR, cipherType,
+                        cfgOptionIdxStrNull(cfgOptRepoCipherPass, repoIdx));
+
+                    if (infoBackupLabelExists(infoBackup, backupData.backupSet))
+                    {
+                        const Manifest *const manifestSource = manifestLoadFile(
+                            storageRepoIdx(repoIdx),
+                            strNewFmt(STORAGE_REPO_BACKUP "/%s/" BACKUP_MANIFEST_FILE, strZ(backupData.backupSet)), cipherType,
+                            infoPgCipherPass(infoBackupPg(infoBackup)));
+
+                        if (restoreSourceMatch(manifest, manifestSource))
+                            lstAdd(result, &repoIdx);
+                        else
+                        {
+                            LOG_DETAIL_FMT(
+                                "%s: backup set %s does not match %s and will not be used as a restore source",
+                                cfgOptionGroupName(cfgOptGrpRepo, repoIdx), strZ(backupData.backupSet),
+                                cfgOptionGroupName(cfgOptGrpRepo, backupData.repoIdx));
+                        }
+                    }
+                }
+                CATCH_ANY()
+                {
+                    LOG_DETAIL_FMT(
+                        "%s: unable to use as a restore source: [%s] %s", cfgOptionGroupName(cfgOptGrpRepo, repoIdx),
+                        errorTypeName(errorType()), errorMessage());
+                }
+                TRY_END();
+            }
+        }
+        MEM_CONTEXT_TEMP_END();
+    }
+
+    FUNCTION_LOG_RETURN(LIST, result);
+}
+
 /***********************************************************************************************************************************
 Validate the manifest
 ***********************************************************************************************************************************/
@@ -1863,9 +1983,9 @@ restoreProcessQueueComparator(const void *const item1, const void *const item2)
     ASSERT(item1 != NULL);
     ASSERT(item2 != NULL);
 
-    // Unpack files
-    const ManifestFile file1 = manifestFileUnpack(restoreProcessQueueComparatorManifest, *(const ManifestFilePack *const *)item1);
-    const ManifestFile file2 = manifestFileUnpack(restoreProcessQueueComparatorManifest, *(const ManifestFilePack *const *)item2);
+    // Unpack file keys
+    const ManifestFileKey file1 = manifestFileUnpackKey(restoreProcessQueueComparatorManifest, *(const ManifestFilePack *const *)item1);
+    const ManifestFileKey file2 = manifestFileUnpackKey(restoreProcessQueueComparatorManifest, *(const ManifestFilePack *const *)item2);
 
     // Zero length files should be ordered at the end
     if (file1.size == 0)
@@ -2050,7 +2170,8 @@ restoreFilePgPath(const Manifest *const manifest, const String *const manifestNa
 static uint64_t
 restoreJobResult(
     const Manifest *const manifest, ProtocolParallelJob *const job, RegExp *const zeroExp, const uint64_t sizeTotal,
-    uint64_t sizeRestored, unsigned int *const currentPercentComplete)
+    uint64_t sizeRestored, uint64_t *const sizeRepoProgress, uint64_t *const sizeWriteProgress, uint64_t *const fileComplete,
+    unsigned int *const currentPercentComplete)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(MANIFEST, manifest);
@@ -2058,6 +2179,9 @@ restoreJobResult(
         FUNCTION_LOG_PARAM(REGEXP, zeroExp);
         FUNCTION_LOG_PARAM(UINT64, sizeTotal);
         FUNCTION_LOG_PARAM(UINT64, sizeRestored);
+        FUNCTION_LOG_PARAM_P(UINT64, sizeRepoProgress);
+        FUNCTION_LOG_PARAM_P(UINT64, sizeWriteProgress);
+        FUNCTION_LOG_PARAM_P(UINT64, fileComplete);
         FUNCTION_LOG_PARAM_P(UINT, currentPercentComplete);
     FUNCTION_LOG_END();
 
@@ -2077,6 +2201,14 @@ restoreJobResult(
                 const bool zeroed = restoreFileZeroed(file.name, zeroExp);
                 const RestoreResult result = (RestoreResult)pckReadU32P(jobResult);
                 const uint64_t blockIncrDeltaSize = pckReadU64P(jobResult);
+                const uint64_t repoSize = pckReadU64P(jobResult);
+
+                // Increment size read from the repo and written to pg (used for metrics)
+                if (result == restoreResultCopy)
+                {
+                    *sizeRepoProgress += repoSize;
+                    *sizeWriteProgress += file.blockIncrMapSize != 0 ? blockIncrDeltaSize : file.size;
+                }
 
                 String *const log = strCatZ(strNew(), "restore");
 
@@ -2141,6 +2273,7 @@ restoreJobResult(
 
                 // Add size and percent complete
                 sizeRestored += file.size;
+                (*fileComplete)++;
 
                 // Store percentComplete as an integer (used to update progress in the lock file)
                 percentComplete = cvtPctToUInt(sizeRestored, sizeTotal);
@@ -2180,13 +2313,16 @@ Return new restore jobs as requested
 ***********************************************************************************************************************************/
 typedef struct RestoreJobData
 {
-    unsigned int repoIdx;                                           // Internal repo idx
+    const List *sourceList;                                         // Internal repo idxs to read from (selected repo first)
     Manifest *manifest;                                             // Backup manifest
     List *queueList;                                                // List of processing queues
     RegExp *zeroExp;                                                // Identify files that should be sparse zeroed
     const String *cipherSubPass;                                    // Passphrase used to decrypt files in the backup
     const String *rootReplaceUser;                                  // User to replace invalid users when root
     const String *rootReplaceGroup;                                 // Group to replace invalid group when root
+    bool syncDefer;                                                 // Defer file syncs to a file system sync at the end
+    bool preallocate;                                               // Preallocate files and skip writing zero pages
+    const ProtocolParallel *parallel;                               // Parallel executor running the jobs
 } RestoreJobData;
 
 // Helper to calculate the next queue to scan based on the client index
@@ -2229,6 +2365,10 @@ restoreJobCallback(void *const data, const unsigned int clientIdx)
         // Get a new job if there are any left
         RestoreJobData *const jobData = data;
 
+        // Each client reads from one source. Clients on a faster source finish sooner and request more jobs so the work is split
+        // between the sources based on throughput.
+        const unsigned int repoIdx = *(unsigned int *)lstGet(jobData->sourceList, clientIdx % lstSize(jobData->sourceList));
+
         // Determine where to begin scanning the queue (we'll stop when we get back here)
         PackWrite *param = NULL;
         int queueIdx = (int)(clientIdx % lstSize(jobData->queueList));
@@ -2271,15 +2411,25 @@ restoreJobCallback(void *const data, const unsigned int clientIdx)
                             .manifestName = file.name, .bundleId = file.bundleId,
                             .compressType = manifestData(jobData->manifest)->backupOptionCompressType,
                             .blockIncr = file.blockIncrMapSize != 0));
-                    pckWriteU32P(param, jobData->repoIdx);
+                    pckWriteU32P(param, repoIdx);
+                    pckWriteU32P(param, *(unsigned int *)lstGet(jobData->sourceList, 0));
                     pckWriteU32P(param, manifestData(jobData->manifest)->backupOptionCompressType);
                     pckWriteTimeP(param, manifestData(jobData->manifest)->backupTimestampCopyStart);
                     pckWriteBoolP(param, cfgOptionBool(cfgOptDelta));
                     pckWriteBoolP(param, cfgOptionBool(cfgOptDelta) && cfgOptionBool(cfgOptForce));
                     pckWriteBoolP(param, file.bundleId != 0 && manifestData(jobData->manifest)->bundleRaw);
+                    pckWriteBoolP(param, jobData->syncDefer);
+                    pckWriteBoolP(param, jobData->preallocate);
                     pckWriteStrP(param, jobData->cipherSubPass);
                     pckWriteStrLstP(param, manifestReferenceList(jobData->manifest));
 
+                    // Share the rate limits among the clients that may be running jobs so the total stays under the limits when
+                    // processing is adaptive and not all clients are in use
+                    const unsigned int clientActive = protocolParallelClientActive(jobData->parallel);
+
+                    pckWriteU64P(param, backupRateLimit(cfgOptRateLimitPg, clientActive));
+                    pckWriteU64P(param, backupRateLimit(cfgOptRateLimitRepo, clientActive));
+
                     fileAdded = true;
                 }
 
@@ -2377,7 +2527,7 @@ cmdRestore(void)
         const RestoreBackupData backupData = restoreBackupSet();
 
         // Load manifest
-        RestoreJobData jobData = {.repoIdx = backupData.repoIdx};
+        RestoreJobData jobData = {0};
 
         jobData.manifest = manifestLoadFile(
             storageRepoIdx(backupData.repoIdx),
@@ -2401,6 +2551,9 @@ cmdRestore(void)
                 cfgOptionIdxStrId(cfgOptRepoCipherType, backupData.repoIdx), infoArchiveCipherPass(archiveInfo));
         }
 
+        // Find other repos with an identical copy of the backup set to read from
+        jobData.sourceList = restoreSourceList(jobData.manifest, backupData);
+
         // Remotes (if any) are no longer needed since the rest of the repository reads will be done by the local processes
         protocolFree();
 
@@ -2433,6 +2586,14 @@ cmdRestore(void)
 
         LOG_INFO(strZ(message));
 
+        for (unsigned int sourceIdx = 1; sourceIdx < lstSize(jobData.sourceList); sourceIdx++)
+        {
+            LOG_INFO_FMT(
+                "%s: also restore from backup set %s",
+                cfgOptionGroupName(cfgOptGrpRepo, *(unsigned int *)lstGet(jobData.sourceList, sourceIdx)),
+                strZ(backupData.backupSet));
+        }
+
         // Map manifest
         restoreManifestMap(jobData.manifest);
 
@@ -2446,6 +2607,18 @@ cmdRestore(void)
         const String *const expression = restoreSelectiveExpression(jobData.manifest);
         jobData.zeroExp = expression == NULL ? NULL : regExpNew(expression);
 
+        // Defer file syncs to a single sync of each file system at the end of the restore when requested
+        if (cfgOptionBool(cfgOptSyncDefer))
+        {
+            if (storageFeature(storagePgWrite(), storageFeatureFileSystemSync))
+                jobData.syncDefer = true;
+            else
+                LOG_WARN("file system sync is not supported so files will be synced as they are restored");
+        }
+
+        // Preallocate files and skip writing zero pages when requested
+        jobData.preallocate = cfgOptionBool(cfgOptPreallocate);
+
         // Clean the data directory and build path/link structure
         restoreCleanBuild(jobData.manifest, jobData.rootReplaceUser, jobData.rootReplaceGroup);
 
@@ -2458,12 +2631,24 @@ cmdRestore(void)
         // Create the parallel executor
         ProtocolParallel *const parallelExec = protocolParallelNew(
             cfgOptionUInt64(cfgOptProtocolTimeout) / 2, restoreJobCallback, &jobData);
+        jobData.parallel = parallelExec;
 
         for (unsigned int processIdx = 1; processIdx <= cfgOptionUInt(cfgOptProcessMax); processIdx++)
             protocolParallelClientAdd(parallelExec, protocolLocalGet(protocolStorageTypeRepo, 0, processIdx));
 
+        // Adjust the number of processes running jobs based on throughput when requested
+        if (cfgOptionTest(cfgOptProcessMin))
+            protocolParallelClientMinSet(parallelExec, cfgOptionUInt(cfgOptProcessMin));
+
         // Process jobs
         uint64_t sizeRestored = 0;
+        uint64_t sizeRepoProgress = 0;
+        uint64_t sizeWriteProgress = 0;
+        uint64_t fileComplete = 0;
+        uint64_t fileTotal = 0;
+
+        for (unsigned int queueIdx = 0; queueIdx < lstSize(jobData.queueList); queueIdx++)
+            fileTotal += lstSize(*(List **)lstGet(jobData.queueList, queueIdx));
 
         // Initialize percent complete and bytes completed/total
         unsigned int currentPercentComplete = 0;
@@ -2481,9 +2666,18 @@ cmdRestore(void)
                 {
                     sizeRestored = restoreJobResult(
                         jobData.manifest, protocolParallelResult(parallelExec), jobData.zeroExp, sizeTotal, sizeRestored,
-                        &currentPercentComplete);
+                        &sizeRepoProgress, &sizeWriteProgress, &fileComplete, &currentPercentComplete);
                 }
 
+                protocolParallelSizeCompleteSet(parallelExec, sizeRestored);
+
+                // Update metrics (always write when all files are complete so the final values are not lost)
+                cmdMetricsWriteP(
+                    .force = fileComplete == fileTotal, .sizeRead = sizeRepoProgress, .sizeWrite = sizeWriteProgress,
+                    .sizeCompress = manifestData(jobData.manifest)->backupOptionCompressType != compressTypeNone ?
+                        sizeRepoProgress : 0,
+                    .fileComplete = fileComplete, .fileTotal = fileTotal, .queueList = jobData.queueList);
+
                 // Reset the memory context occasionally so we don't use too much memory or slow down processing
                 MEM_CONTEXT_TEMP_RESET(1000);
             }
@@ -2502,49 +2696,71 @@ cmdRestore(void)
         // Remove backup.manifest
         storageRemoveP(storagePgWrite(), BACKUP_MANIFEST_FILE_STR);
 
-        // Sync file link paths. These need to be synced separately because they are not linked from the data directory.
-        StringList *const pathSynced = strLstNew();
-
-        for (unsigned int targetIdx = 0; targetIdx < manifestTargetTotal(jobData.manifest); targetIdx++)
+        // When file syncs were deferred sync the file system of each target once. This also syncs all paths in the file system so
+        // they do not need to be synced individually.
+        if (jobData.syncDefer)
         {
-            const ManifestTarget *const target = manifestTarget(jobData.manifest, targetIdx);
+            StringList *const pathSynced = strLstNew();
 
-            if (target->type == manifestTargetTypeLink && target->file != NULL)
+            for (unsigned int targetIdx = 0; targetIdx < manifestTargetTotal(jobData.manifest); targetIdx++)
             {
-                const String *const pgPath = manifestTargetPath(jobData.manifest, target);
+                const String *const pgPath = manifestTargetPath(jobData.manifest, manifestTarget(jobData.manifest, targetIdx));
 
-                // Don't sync the same path twice. There can be multiple links to files in the same path, but syncing it more than
-                // once makes the logs noisy and looks like a bug even though it doesn't hurt anything or realistically affect
-                // performance.
                 if (strLstExists(pathSynced, pgPath))
                     continue;
                 else
                     strLstAdd(pathSynced, pgPath);
 
-                // Sync the path
-                LOG_DETAIL_FMT("sync path '%s'", strZ(pgPath));
-                storagePathSyncP(storageLocalWrite(), pgPath);
+                LOG_DETAIL_FMT("sync file system for path '%s'", strZ(pgPath));
+                storagePathSyncP(storageLocalWrite(), pgPath, .fileSystem = true);
             }
         }
-
-        // Sync paths in the data directory
-        for (unsigned int pathIdx = 0; pathIdx < manifestPathTotal(jobData.manifest); pathIdx++)
+        else
         {
-            const String *const manifestName = manifestPath(jobData.manifest, pathIdx)->name;
+            // Sync file link paths. These need to be synced separately because they are not linked from the data directory.
+            StringList *const pathSynced = strLstNew();
 
-            // Skip the pg_tblspc path because it only maps to the manifest. We should remove this in a future release but not much
-            // can be done about it for now.
-            if (strEqZ(manifestName, MANIFEST_TARGET_PGTBLSPC))
-                continue;
+            for (unsigned int targetIdx = 0; targetIdx < manifestTargetTotal(jobData.manifest); targetIdx++)
+            {
+                const ManifestTarget *const target = manifestTarget(jobData.manifest, targetIdx);
 
-            // We'll sync global after pg_control is written
-            if (strEq(manifestName, STRDEF(MANIFEST_TARGET_PGDATA "/" PG_PATH_GLOBAL)))
-                continue;
+                if (target->type == manifestTargetTypeLink && target->file != NULL)
+                {
+                    const String *const pgPath = manifestTargetPath(jobData.manifest, target);
 
-            const String *const pgPath = storagePathP(storagePg(), manifestPathPg(manifestName));
+                    // Don't sync the same path twice. There can be multiple links to files in the same path, but syncing it more
+                    // than once makes the logs noisy and looks like a bug even though it doesn't hurt anything or realistically
+                    // affect performance.
+                    if (strLstExists(pathSynced, pgPath))
+                        continue;
+                    else
+                        strLstAdd(pathSynced, pgPath);
 
-            LOG_DETAIL_FMT("sync path '%s'", strZ(pgPath));
-            storagePathSyncP(storagePgWrite(), pgPath);
+                    // Sync the path
+                    LOG_DETAIL_FMT("sync path '%s'", strZ(pgPath));
+                    storagePathSyncP(storageLocalWrite(), pgPath);
+                }
+            }
+
+            // Sync paths in the data directory
+            for (unsigned int pathIdx = 0; pathIdx < manifestPathTotal(jobData.manifest); pathIdx++)
+            {
+                const String *const manifestName = manifestPath(jobData.manifest, pathIdx)->name;
+
+                // Skip the pg_tblspc path because it only maps to the manifest. We should remove this in a future release but not
+                // much can be done about it for now.
+                if (strEqZ(manifestName, MANIFEST_TARGET_PGTBLSPC))
+                    continue;
+
+                // We'll sync global after pg_control is written
+                if (strEq(manifestName, STRDEF(MANIFEST_TARGET_PGDATA "/" PG_PATH_GLOBAL)))
+                    continue;
+
+                const String *const pgPath = storagePathP(storagePg(), manifestPathPg(manifestName));
+
+                LOG_DETAIL_FMT("sync path '%s'", strZ(pgPath));
+                storagePathSyncP(storagePgWrite(), pgPath);
+            }
         }
 
         // Rename pg_control to remove the temp extension. This is done last to prevent a partially restored (or unsynced) cluster
@@ -3,6 +3,8 @@ Server Command
 ***********************************************************************************************************************************/
 #include "build.auto.h"
 
+#include <errno.h>
+#include <poll.h>
 #include <sys/wait.h>
 
 #include "command/exit.h"
@@ -16,6 +18,11 @@ Server Command
 #include "config/load.h"
 #include "protocol/helper.h"
 
+/***********************************************************************************************************************************
+Time to wait for a signal when the worker pool is full or when a worker is waiting for a connection
+***********************************************************************************************************************************/
+#define SERVER_WORKER_WAIT_MSEC                                     1000
+
 /***********************************************************************************************************************************
 Local variables
 ***********************************************************************************************************************************/
@@ -27,7 +34,9 @@ static struct ServerLocal
     const char **argList;                                           // Argument list
 
     List *processList;                                              // List of child processes
+    unsigned int workerMax;                                         // Pre-forked workers (0 to fork on each connection)
 
+    bool sigChild;                                                  // SIGCHLD was caught
     bool sigHup;                                                    // SIGHUP was caught
     bool sigTerm;                                                   // SIGTERM was caught
 
@@ -56,6 +65,10 @@ cmdServerInit(void)
         MEM_CONTEXT_END();
     }
 
+    // Get the number of pre-forked workers. Session resumption is enabled for the worker pool so clients that present a session
+    // ticket can skip the full handshake.
+    serverLocal.workerMax = cfgOptionUInt(cfgOptTlsServerWorker);
+
     MEM_CONTEXT_BEGIN(serverLocal.memContext)
     {
         // Free old servers
@@ -67,7 +80,7 @@ cmdServerInit(void)
             cfgOptionStr(cfgOptTlsServerAddress), cfgOptionUInt(cfgOptTlsServerPort), cfgOptionUInt64(cfgOptProtocolTimeout));
         serverLocal.tlsServer = tlsServerNew(
             cfgOptionStr(cfgOptTlsServerAddress), cfgOptionStr(cfgOptTlsServerCaFile), cfgOptionStr(cfgOptTlsServerKeyFile),
-            cfgOptionStr(cfgOptTlsServerCertFile), cfgOptionUInt64(cfgOptProtocolTimeout));
+            cfgOptionStr(cfgOptTlsServerCertFile), cfgOptionUInt64(cfgOptProtocolTimeout), serverLocal.workerMax > 0);
     }
     MEM_CONTEXT_END();
 }
@@ -89,24 +102,108 @@ cmdServerSigTerm(const int signalType)
     serverLocal.sigTerm = true;
 }
 
+static void
+cmdServerSigChild(const int signalType)
+{
+    (void)signalType;
+    serverLocal.sigChild = true;
+}
+
 /***********************************************************************************************************************************
-Handler to reap child processes
+Remove child processes that have exited from the process list. This is not done in the SIGCHLD handler since the list may be in the
+middle of being resized by the main loop. Children are reaped automatically so a child that has exited no longer exists. Signals do
+not queue so when children exit at the same time only one signal may be received, which is why every child is checked.
 ***********************************************************************************************************************************/
 static void
-cmdServerSigChild(const int signalType, siginfo_t *const signalInfo, void *const context)
+cmdServerProcessPrune(void)
 {
-    (void)signalType;
-    (void)context;
+    FUNCTION_TEST_VOID();
+
+    // Reset the flag first so a signal received while checking is not lost
+    serverLocal.sigChild = false;
+
+    unsigned int processIdx = 0;
 
-    // Find the process and remove it
-    for (unsigned int processIdx = 0; processIdx < lstSize(serverLocal.processList); processIdx++)
+    while (processIdx < lstSize(serverLocal.processList))
     {
-        if (*(int *)lstGet(serverLocal.processList, processIdx) == signalInfo->si_pid)
-        {
-            ASSERT(signalInfo->si_code == CLD_EXITED);
+        if (kill(*(pid_t *)lstGet(serverLocal.processList, processIdx), 0) == -1 && errno == ESRCH)
             lstRemoveIdx(serverLocal.processList, processIdx);
-        }
+        else
+            processIdx++;
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Serve a connection in a child process
+***********************************************************************************************************************************/
+static void
+cmdServerChild(IoSession *const socketSession)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(IO_SESSION, socketSession);
+    FUNCTION_LOG_END();
+
+    ASSERT(socketSession != NULL);
+
+    // Set standard signal handlers
+    exitInit();
+
+    // Workers that are waiting for a connection exit on SIGHUP so the pool can be recreated with new configuration, but once a
+    // connection has been accepted it must be allowed to complete. SIGHUP only sets a flag in the worker so it is ignored from here
+    // on.
+    if (serverLocal.workerMax > 0)
+        sigaction(SIGHUP, &(struct sigaction){.sa_handler = SIG_IGN}, NULL);
+
+    // Close the server socket so we don't hold the port open if the parent exits first
+    ioServerFree(serverLocal.socketServer);
+
+    // Disable logging and close log file
+    logClose();
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Start standard remote processing if a server is returned
+        ProtocolServer *const server = protocolServer(serverLocal.tlsServer, socketSession);
+
+        if (server != NULL)
+            cmdRemote(server);
     }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Wait for a connection in a pre-forked worker. NULL is returned when SIGHUP is received so the worker can exit and be replaced by a
+worker with the new configuration.
+***********************************************************************************************************************************/
+static IoSession *
+cmdServerWorkerAccept(void)
+{
+    FUNCTION_LOG_VOID(logLevelDebug);
+
+    // Waiting workers have no state to clean up so SIGTERM terminates them immediately. SIGHUP keeps the handler inherited from the
+    // server, which only sets a flag, so a SIGHUP that arrives after a connection has been accepted cannot terminate the worker.
+    sigaction(SIGTERM, &(struct sigaction){.sa_handler = SIG_DFL}, NULL);
+
+    IoSession *result = NULL;
+    struct pollfd pollFd = {.fd = ioServerFd(serverLocal.socketServer), .events = POLLIN};
+
+    // Wait for a connection until SIGHUP is received. SIGHUP interrupts poll() and accept() (e.g. when another worker accepted the
+    // connection first) but the wait is limited in case SIGHUP arrived just before poll() was called.
+    while (result == NULL && !serverLocal.sigHup)
+    {
+        const int pollResult = poll(&pollFd, 1, SERVER_WORKER_WAIT_MSEC);
+
+        THROW_ON_SYS_ERROR(pollResult == -1 && errno != EINTR, KernelError, "unable to poll socket");
+
+        if (pollResult > 0)
+            result = ioServerAccept(serverLocal.socketServer, NULL);
+    }
+
+    FUNCTION_LOG_RETURN(IO_SESSION, result);
 }
 
 /**********************************************************************************************************************************/
@@ -130,49 +227,83 @@ cmdServer(const unsigned int argListSize, const char *argList[])
         // Set signal handlers
         sigaction(SIGHUP, &(struct sigaction){.sa_handler = cmdServerSigHup}, NULL);
         sigaction(SIGTERM, &(struct sigaction){.sa_handler = cmdServerSigTerm}, NULL);
-        sigaction(
-            SIGCHLD, &(struct sigaction){.sa_sigaction = cmdServerSigChild, .sa_flags = SA_NOCLDSTOP | SA_NOCLDWAIT | SA_SIGINFO},
-            NULL);
+        sigaction(SIGCHLD, &(struct sigaction){.sa_handler = cmdServerSigChild, .sa_flags = SA_NOCLDSTOP | SA_NOCLDWAIT}, NULL);
 
         // Accept connections indefinitely. The only way to exit this loop is for the process to receive a signal.
         do
         {
-            // Accept a new connection
-            IoSession *const socketSession = ioServerAccept(serverLocal.socketServer, NULL);
+            // Remove children that have exited
+            if (serverLocal.sigChild)
+                cmdServerProcessPrune();
 
-            if (socketSession != NULL)
+            // When there is a worker pool, fork workers until the pool is full. Each worker accepts and serves a single connection
+            // and is then replaced. Connections beyond the number of workers queue on the listening socket until a worker is free.
+            if (serverLocal.workerMax > 0)
             {
-                // Fork off the child process
-                pid_t pid = forkSafe();
+                bool child = false;
 
-                if (pid == 0)
+                while (!child && !serverLocal.sigHup && !serverLocal.sigTerm &&
+                       lstSize(serverLocal.processList) < serverLocal.workerMax)
                 {
-                    // Reset SIGCHLD to default
-                    sigaction(SIGCHLD, &(struct sigaction){.sa_handler = SIG_DFL}, NULL);
-
-                    // Set standard signal handlers
-                    exitInit();
-
-                    // Close the server socket so we don't hold the port open if the parent exits first
-                    ioServerFree(serverLocal.socketServer);
-
-                    // Disable logging and close log file
-                    logClose();
+                    // Fork off the worker process
+                    pid_t pid = forkSafe();
+
+                    if (pid == 0)
+                    {
+                        // Reset SIGCHLD to default and clear the process list since it belongs to the parent
+                        sigaction(SIGCHLD, &(struct sigaction){.sa_handler = SIG_DFL}, NULL);
+                        lstClear(serverLocal.processList);
+
+                        // Disable logging and close log file
+                        logClose();
+
+                        child = true;
+                    }
+                    // Add process to list
+                    else
+                        lstAdd(serverLocal.processList, &pid);
+                }
 
-                    // Start standard remote processing if a server is returned
-                    ProtocolServer *server = protocolServer(serverLocal.tlsServer, socketSession);
+                // Wait for a connection in the worker and serve it
+                if (child)
+                {
+                    IoSession *const socketSession = cmdServerWorkerAccept();
 
-                    if (server != NULL)
-                        cmdRemote(server);
+                    if (socketSession != NULL)
+                        cmdServerChild(socketSession);
 
                     break;
                 }
-                // Add process to list
-                else
-                    lstAdd(serverLocal.processList, &pid);
 
-                // Free the socket since the child is now using it
-                ioSessionFree(socketSession);
+                // Wait for a signal, e.g. SIGCHLD when a worker exits. The wait is limited in case the signal arrived first.
+                if (!serverLocal.sigHup && !serverLocal.sigTerm)
+                    sleepMSec(SERVER_WORKER_WAIT_MSEC);
+            }
+            else
+            {
+                // Accept a new connection
+                IoSession *const socketSession = ioServerAccept(serverLocal.socketServer, NULL);
+
+                if (socketSession != NULL)
+                {
+                    // Fork off the child process
+                    pid_t pid = forkSafe();
+
+                    if (pid == 0)
+                    {
+                        // Reset SIGCHLD to default
+                        sigaction(SIGCHLD, &(struct sigaction){.sa_handler = SIG_DFL}, NULL);
+
+                        cmdServerChild(socketSession);
+                        break;
+                    }
+                    // Add process to list
+                    else
+                        lstAdd(serverLocal.processList, &pid);
+
+                    // Free the socket since the child is now using it
+                    ioSessionFree(socketSession);
+                }
             }
 
             // Reload configuration
@@ -180,6 +311,14 @@ cmdServer(const unsigned int argListSize, const char *argList[])
             {
                 LOG_DETAIL("configuration reload begin");
 
+                // Signal workers so the ones waiting for a connection exit and release the listening socket. Workers serving a
+                // connection ignore the signal. The pool is refilled with the new configuration as the waiting workers exit.
+                if (serverLocal.workerMax > 0)
+                {
+                    for (unsigned int processIdx = 0; processIdx < lstSize(serverLocal.processList); processIdx++)
+                        kill(*(pid_t *)lstGet(serverLocal.processList, processIdx), SIGHUP);
+                }
+
                 // Reload configuration
                 cfgLoad(serverLocal.argListSize, serverLocal.argList);
 
@@ -196,10 +335,11 @@ cmdServer(const unsigned int argListSize, const char *argList[])
     }
     MEM_CONTEXT_TEMP_END();
 
-    // Terminate any remaining children on SIGTERM. Disable the callback so it does not fire in the middle of the loop.
+    // Terminate any remaining children on SIGTERM
     if (serverLocal.sigTerm)
     {
-        sigaction(SIGCHLD, &(struct sigaction){.sa_flags = SA_NOCLDSTOP | SA_NOCLDWAIT}, NULL);
+        if (serverLocal.sigChild)
+            cmdServerProcessPrune();
 
         for (unsigned int processIdx = 0; processIdx < lstSize(serverLocal.processList); processIdx++)
         {
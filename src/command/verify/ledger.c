@@ -0,0 +1,351 @@
+/***********************************************************************************************************************************
+Verify Ledger
+***********************************************************************************************************************************/
+#include "build.auto.h"
+
+#include "command/verify/ledger.h"
+#include "common/crypto/cipherBlock.h"
+#include "common/debug.h"
+#include "common/io/bufferRead.h"
+#include "common/io/bufferWrite.h"
+#include "common/io/io.h"
+#include "common/log.h"
+#include "common/type/json.h"
+#include "common/type/list.h"
+#include "info/info.h"
+#include "storage/helper.h"
+
+/***********************************************************************************************************************************
+Constants
+***********************************************************************************************************************************/
+#define VERIFY_LEDGER_SECTION_FILE                                  "ledger:file"
+
+#define VERIFY_LEDGER_KEY_CHECKSUM                                  "checksum"
+#define VERIFY_LEDGER_KEY_TIME                                      "time"
+
+/***********************************************************************************************************************************
+Object type
+***********************************************************************************************************************************/
+typedef struct VerifyLedgerEntry
+{
+    const String *name;                                             // File name (must be first member for sorting)
+    const String *checksum;                                         // Checksum of the file when it was verified
+    time_t time;                                                    // Time the file was verified
+    bool seen;                                                      // Was the file seen in this run?
+    bool removed;                                                   // Was the file removed in this run?
+    unsigned int addIdx;                                            // Order the entry was added in this run
+} VerifyLedgerEntry;
+
+struct VerifyLedger
+{
+    VerifyLedgerPub pub;                                            // Publicly accessible variables
+    List *entryList;                                                // Entries loaded from the ledger (sorted for searching)
+    List *addList;                                                  // Entries added in this run
+};
+
+/***********************************************************************************************************************************
+Load the ledger
+***********************************************************************************************************************************/
+static void
+verifyLedgerLoadCallback(void *const data, const String *const section, const String *const key, const String *const value)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, data);
+        FUNCTION_TEST_PARAM(STRING, section);
+        FUNCTION_TEST_PARAM(STRING, key);
+        FUNCTION_TEST_PARAM(STRING, value);
+    FUNCTION_TEST_END();
+
+    ASSERT(data != NULL);
+    ASSERT(section != NULL);
+    ASSERT(key != NULL);
+    ASSERT(value != NULL);
+
+    VerifyLedger *const this = (VerifyLedger *)data;
+
+    if (strEqZ(section, VERIFY_LEDGER_SECTION_FILE))
+    {
+        MEM_CONTEXT_BEGIN(lstMemContext(this->entryList))
+        {
+            JsonRead *const json = jsonReadNew(value);
+            jsonReadObjectBegin(json);
+
+            VerifyLedgerEntry entry = {.name = strDup(key)};
+
+            entry.checksum = jsonReadStr(jsonReadKeyRequireZ(json, VERIFY_LEDGER_KEY_CHECKSUM));
+            entry.time = (time_t)jsonReadInt64(jsonReadKeyRequireZ(json, VERIFY_LEDGER_KEY_TIME));
+
+            lstAdd(this->entryList, &entry);
+        }
+        MEM_CONTEXT_END();
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+FN_EXTERN VerifyLedger *
+verifyLedgerLoad(const String *const fileName, const CipherType cipherType, const String *const cipherPass)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STRING, fileName);
+        FUNCTION_LOG_PARAM(STRING_ID, cipherType);
+        FUNCTION_TEST_PARAM(STRING, cipherPass);
+    FUNCTION_LOG_END();
+
+    ASSERT(fileName != NULL);
+    ASSERT((cipherType == cipherTypeNone && cipherPass == NULL) || (cipherType != cipherTypeNone && cipherPass != NULL));
+
+    OBJ_NEW_BEGIN(VerifyLedger, .childQty = MEM_CONTEXT_QTY_MAX)
+    {
+        *this = (VerifyLedger)
+        {
+            .entryList = lstNewP(sizeof(VerifyLedgerEntry), .comparator = lstComparatorStr),
+            .addList = lstNewP(sizeof(VerifyLedgerEntry), .comparator = lstComparatorStr),
+        };
+
+        MEM_CONTEXT_TEMP_BEGIN()
+        {
+            const Buffer *const buffer = storageGetP(storageNewReadP(storageRepo(), fileName, .ignoreMissing = true));
+
+            if (buffer != NULL)
+            {
+                TRY_BEGIN()
+                {
+                    IoRead *const read = ioBufferReadNew(buffer);
+                    cipherBlockFilterGroupAdd(ioReadFilterGroup(read), cipherType, cipherModeDecrypt, cipherPass);
+
+                    infoNewLoad(read, verifyLedgerLoadCallback, this);
+                }
+                // The ledger is an optimization so if it cannot be loaded then start over with an empty ledger
+                CATCH_ANY()
+                {
+                    LOG_WARN_FMT(
+                        "unable to load verify ledger '%s', all files will be verified\n"
+                        "%s",
+                        strZ(storagePathP(storageRepo(), fileName)), errorMessage());
+
+                    lstClear(this->entryList);
+                }
+                TRY_END();
+            }
+        }
+        MEM_CONTEXT_TEMP_END();
+
+        lstSort(this->entryList, sortOrderAsc);
+    }
+    OBJ_NEW_END();
+
+    FUNCTION_LOG_RETURN(VERIFY_LEDGER, this);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN bool
+verifyLedgerSkip(VerifyLedger *const this, const String *const name, const String *const checksum, const unsigned int sample)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(VERIFY_LEDGER, this);
+        FUNCTION_TEST_PARAM(STRING, name);
+        FUNCTION_TEST_PARAM(STRING, checksum);
+        FUNCTION_TEST_PARAM(UINT, sample);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(name != NULL);
+    ASSERT(checksum != NULL);
+    ASSERT(sample <= 100);
+
+    bool result = false;
+    VerifyLedgerEntry *const entry = lstFind(this->entryList, &name);
+
+    if (entry != NULL)
+    {
+        entry->seen = true;
+
+        // Skip when the checksum has not changed unless the file was selected to be verified again. A sample of previously verified
+        // files is verified on each run to detect bit rot in files that would otherwise never be read again.
+        if (strEq(entry->checksum, checksum))
+        {
+            uint32_t random = 0;
+
+            if (sample > 0)
+                cryptoRandomBytes((uint8_t *)&random, sizeof(random));
+
+            if (sample == 0 || random % 100 >= sample)
+            {
+                this->pub.skipTotal++;
+                result = true;
+            }
+        }
+    }
+
+    FUNCTION_TEST_RETURN(BOOL, result);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN void
+verifyLedgerSet(VerifyLedger *const this, const String *const name, const String *const checksum, const time_t time)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(VERIFY_LEDGER, this);
+        FUNCTION_TEST_PARAM(STRING, name);
+        FUNCTION_TEST_PARAM(STRING, checksum);
+        FUNCTION_TEST_PARAM(TIME, time);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(name != NULL);
+    ASSERT(checksum != NULL);
+
+    MEM_CONTEXT_OBJ_BEGIN(this)
+    {
+        VerifyLedgerEntry *entry = lstFind(this->entryList, &name);
+
+        // Add to the new entry list rather than the loaded list so the loaded list stays sorted for searching
+        if (entry == NULL)
+            entry = lstAdd(this->addList, &(VerifyLedgerEntry){.name = strDup(name), .addIdx = lstSize(this->addList)});
+
+        entry->checksum = strDup(checksum);
+        entry->time = time;
+        entry->seen = true;
+        entry->removed = false;
+    }
+    MEM_CONTEXT_OBJ_END();
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN void
+verifyLedgerRemove(VerifyLedger *const this, const String *const name)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(VERIFY_LEDGER, this);
+        FUNCTION_TEST_PARAM(STRING, name);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(name != NULL);
+
+    VerifyLedgerEntry *const entry = lstFind(this->entryList, &name);
+
+    if (entry != NULL)
+        entry->removed = true;
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Save the ledger
+***********************************************************************************************************************************/
+// Sort by name and then by the order added so the last entry set for a file comes first
+static int
+verifyLedgerAddComparator(const void *const item1, const void *const item2)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, item1);
+        FUNCTION_TEST_PARAM_P(VOID, item2);
+    FUNCTION_TEST_END();
+
+    ASSERT(item1 != NULL);
+    ASSERT(item2 != NULL);
+
+    const VerifyLedgerEntry *const entry1 = item1;
+    const VerifyLedgerEntry *const entry2 = item2;
+    int result = strCmp(entry1->name, entry2->name);
+
+    if (result == 0)
+        result = entry1->addIdx > entry2->addIdx ? -1 : 1;
+
+    FUNCTION_TEST_RETURN(INT, result);
+}
+
+static void
+verifyLedgerSaveCallback(void *const data, const String *const sectionNext, InfoSave *const infoSaveData)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, data);
+        FUNCTION_TEST_PARAM(STRING, sectionNext);
+        FUNCTION_TEST_PARAM(INFO_SAVE, infoSaveData);
+    FUNCTION_TEST_END();
+
+    FUNCTION_AUDIT_CALLBACK();
+
+    ASSERT(data != NULL);
+    ASSERT(infoSaveData != NULL);
+
+    const List *const saveList = (const List *)data;
+
+    if (infoSaveSection(infoSaveData, VERIFY_LEDGER_SECTION_FILE, sectionNext))
+    {
+        for (unsigned int entryIdx = 0; entryIdx < lstSize(saveList); entryIdx++)
+        {
+            const VerifyLedgerEntry *const entry = lstGet(saveList, entryIdx);
+            JsonWrite *const json = jsonWriteObjectBegin(jsonWriteNewP());
+
+            jsonWriteStr(jsonWriteKeyZ(json, VERIFY_LEDGER_KEY_CHECKSUM), entry->checksum);
+            jsonWriteInt64(jsonWriteKeyZ(json, VERIFY_LEDGER_KEY_TIME), entry->time);
+
+            infoSaveValue(
+                infoSaveData, VERIFY_LEDGER_SECTION_FILE, strZ(entry->name), jsonWriteResult(jsonWriteObjectEnd(json)));
+        }
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+FN_EXTERN void
+verifyLedgerSave(
+    VerifyLedger *const this, const String *const fileName, const CipherType cipherType, const String *const cipherPass,
+    const bool prune)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(VERIFY_LEDGER, this);
+        FUNCTION_LOG_PARAM(STRING, fileName);
+        FUNCTION_LOG_PARAM(STRING_ID, cipherType);
+        FUNCTION_TEST_PARAM(STRING, cipherPass);
+        FUNCTION_LOG_PARAM(BOOL, prune);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(fileName != NULL);
+    ASSERT((cipherType == cipherTypeNone && cipherPass == NULL) || (cipherType != cipherTypeNone && cipherPass != NULL));
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Merge loaded and added entries. Entries for files that were removed or no longer exist in the repo are dropped.
+        List *const saveList = lstNewP(sizeof(VerifyLedgerEntry), .comparator = lstComparatorStr);
+
+        for (unsigned int entryIdx = 0; entryIdx < lstSize(this->entryList); entryIdx++)
+        {
+            const VerifyLedgerEntry *const entry = lstGet(this->entryList, entryIdx);
+
+            if (!entry->removed && (entry->seen || !prune))
+                lstAdd(saveList, entry);
+        }
+
+        // A file set more than once in this run has more than one added entry so only save the entry that was set last
+        lstComparatorSet(this->addList, verifyLedgerAddComparator);
+        lstSort(this->addList, sortOrderAsc);
+
+        for (unsigned int entryIdx = 0; entryIdx < lstSize(this->addList); entryIdx++)
+        {
+            const VerifyLedgerEntry *const entry = lstGet(this->addList, entryIdx);
+
+            if (entryIdx == 0 || !strEq(entry->name, ((const VerifyLedgerEntry *)lstGet(this->addList, entryIdx - 1))->name))
+                lstAdd(saveList, entry);
+        }
+
+        lstSort(saveList, sortOrderAsc);
+
+        // Write the ledger. There is no copy since a missing or corrupt ledger only means files will be verified again.
+        Buffer *const buffer = bufNew(ioBufferSize());
+        IoWrite *const write = ioBufferWriteNew(buffer);
+        cipherBlockFilterGroupAdd(ioWriteFilterGroup(write), cipherType, cipherModeEncrypt, cipherPass);
+        infoSave(infoNew(NULL), write, verifyLedgerSaveCallback, saveList);
+
+        storagePutP(storageNewWriteP(storageRepoWrite(), fileName), buffer);
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN_VOID();
+}
@@ -0,0 +1,80 @@
+/***********************************************************************************************************************************
+Verify Ledger
+
+The ledger records repository files that have been verified along with the checksum that was verified and the time of verification.
+On subsequent runs files already in the ledger with a matching checksum can be skipped so only new files need to be read.
+***********************************************************************************************************************************/
+#ifndef COMMAND_VERIFY_LEDGER_H
+#define COMMAND_VERIFY_LEDGER_H
+
+#include <time.h>
+
+/***********************************************************************************************************************************
+Object type
+***********************************************************************************************************************************/
+typedef struct VerifyLedger VerifyLedger;
+
+#include "common/crypto/common.h"
+#include "common/type/string.h"
+
+/***********************************************************************************************************************************
+Constants
+***********************************************************************************************************************************/
+#define VERIFY_LEDGER_FILE                                          "verify.ledger"
+
+/***********************************************************************************************************************************
+Constructors
+***********************************************************************************************************************************/
+// Load the ledger from the repository. If the ledger is missing or cannot be loaded then an empty ledger is returned.
+FN_EXTERN VerifyLedger *verifyLedgerLoad(const String *fileName, CipherType cipherType, const String *cipherPass);
+
+/***********************************************************************************************************************************
+Getters/Setters
+***********************************************************************************************************************************/
+typedef struct VerifyLedgerPub
+{
+    unsigned int skipTotal;                                         // Total files skipped because they were already verified
+} VerifyLedgerPub;
+
+// Total files skipped because they were already verified
+FN_INLINE_ALWAYS unsigned int
+verifyLedgerSkipTotal(const VerifyLedger *const this)
+{
+    return THIS_PUB(VerifyLedger)->skipTotal;
+}
+
+/***********************************************************************************************************************************
+Functions
+***********************************************************************************************************************************/
+// Can verification of the file be skipped? True when the file is in the ledger with the same checksum and was not selected for
+// resampling. The sample is the percentage (0-100) of previously verified files that should be verified again.
+FN_EXTERN bool verifyLedgerSkip(VerifyLedger *this, const String *name, const String *checksum, unsigned int sample);
+
+// Record a file that passed verification
+FN_EXTERN void verifyLedgerSet(VerifyLedger *this, const String *name, const String *checksum, time_t time);
+
+// Remove a file that failed verification so it will be verified again on the next run
+FN_EXTERN void verifyLedgerRemove(VerifyLedger *this, const String *name);
+
+// Save the ledger to the repository. When prune is true entries for files that were not seen in this run are removed.
+FN_EXTERN void verifyLedgerSave(
+    VerifyLedger *this, const String *fileName, CipherType cipherType, const String *cipherPass, bool prune);
+
+/***********************************************************************************************************************************
+Destructor
+***********************************************************************************************************************************/
+FN_INLINE_ALWAYS void
+verifyLedgerFree(VerifyLedger *const this)
+{
+    objFree(this);
+}
+
+/***********************************************************************************************************************************
+Macros for function logging
+***********************************************************************************************************************************/
+#define FUNCTION_LOG_VERIFY_LEDGER_TYPE                                                                                            \
+    VerifyLedger *
+#define FUNCTION_LOG_VERIFY_LEDGER_FORMAT(value, buffer, bufferSize)                                                               \
+    objNameToLog(value, "VerifyLedger", buffer, bufferSize)
+
+#endif
@@ -11,7 +11,9 @@ Verify contents of the repository.
 
 #include "command/archive/common.h"
 #include "command/check/common.h"
+#include "command/metrics.h"
 #include "command/verify/file.h"
+#include "command/verify/ledger.h"
 #include "command/verify/protocol.h"
 #include "command/verify/verify.h"
 #include "common/compress/helper.h"
@@ -21,6 +23,7 @@ Verify contents of the repository.
 #include "common/io/io.h"
 #include "common/log.h"
 #include "common/regExp.h"
+#include "common/time.h"
 #include "config/config.h"
 #include "info/infoArchive.h"
 #include "info/infoBackup.h"
@@ -37,6 +40,9 @@ Constants
 #define VERIFY_STATUS_OK                                            "ok"
 #define VERIFY_STATUS_ERROR                                         "error"
 
+// Max WAL paths to list concurrently
+#define VERIFY_ARCHIVE_LIST_PARALLEL                                8
+
 /***********************************************************************************************************************************
 Data Types and Structures
 ***********************************************************************************************************************************/
@@ -117,6 +123,7 @@ typedef struct VerifyJobData
     StringList *archiveIdList;                                      // List of archive ids to verify
     StringList *walPathList;                                        // WAL path list for a single archive id
     StringList *walFileList;                                        // WAL file list for a single WAL path
+    List *walFileListNext;                                          // WAL file lists prefetched for the next WAL paths
     StringList *backupList;                                         // List of backups to verify
     Manifest *manifest;                                             // Manifest contents with list of files to verify
     unsigned int manifestFileIdx;                                   // Index of the file within the manifest file list to process
@@ -132,8 +139,139 @@ typedef struct VerifyJobData
     bool enableArchiveFilter;                                       // Only check archives in the specified range
     const String *archiveStart;                                     // Start of the WAL range to be verified
     const String *archiveStop;                                      // End of the WAL range to be verified
+    VerifyLedger *ledger;                                           // Ledger of verified files, if enabled
+    unsigned int ledgerSample;                                      // Percentage of ledger files to verify again
+    List *ledgerJobList;                                            // Jobs in progress that will update the ledger
 } VerifyJobData;
 
+// Ledger entry for a job in progress so the ledger can be updated when the job completes
+typedef struct VerifyLedgerJob
+{
+    const ProtocolParallelJob *job;                                 // Job in progress
+    String *name;                                                   // Ledger name of the file being verified
+    String *checksum;                                               // Checksum being verified
+} VerifyLedgerJob;
+
+/***********************************************************************************************************************************
+Check the ledger to determine if a file needs to be verified. If the file must be verified and the ledger is enabled then the ledger
+name and checksum are stored in the job data so the ledger can be updated when the job completes.
+***********************************************************************************************************************************/
+static bool
+verifyLedgerCheck(
+    VerifyJobData *const jobData, const String *const filePathName, const bool bundled, const uint64_t offset,
+    const Buffer *const checksum)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, jobData);
+        FUNCTION_TEST_PARAM(STRING, filePathName);
+        FUNCTION_TEST_PARAM(BOOL, bundled);
+        FUNCTION_TEST_PARAM(UINT64, offset);
+        FUNCTION_TEST_PARAM(BUFFER, checksum);
+    FUNCTION_TEST_END();
+
+    ASSERT(jobData != NULL);
+    ASSERT(filePathName != NULL);
+    ASSERT(checksum != NULL);
+
+    bool result = true;
+
+    if (jobData->ledger != NULL)
+    {
+        MEM_CONTEXT_TEMP_BEGIN()
+        {
+            // Build the ledger name relative to the stanza. Bundled files share a repo file so the offset is added to the name.
+            const bool archive = strBeginsWithZ(filePathName, STORAGE_REPO_ARCHIVE);
+            String *const name = strCatZ(strNew(), archive ? "archive" : "backup");
+
+            strCat(name, strSub(filePathName, archive ? sizeof(STORAGE_REPO_ARCHIVE) - 1 : sizeof(STORAGE_REPO_BACKUP) - 1));
+
+            if (bundled)
+                strCatFmt(name, ":%" PRIu64, offset);
+
+            const String *const checksumStr = strNewEncode(encodingHex, checksum);
+
+            result = !verifyLedgerSkip(jobData->ledger, name, checksumStr, jobData->ledgerSample);
+
+            // Store the name and checksum until the job is created
+            if (result)
+            {
+                MEM_CONTEXT_BEGIN(lstMemContext(jobData->ledgerJobList))
+                {
+                    lstAdd(
+                        jobData->ledgerJobList,
+                        &(VerifyLedgerJob){.name = strDup(name), .checksum = strDup(checksumStr)});
+                }
+                MEM_CONTEXT_END();
+            }
+        }
+        MEM_CONTEXT_TEMP_END();
+    }
+
+    FUNCTION_TEST_RETURN(BOOL, result);
+}
+
+/***********************************************************************************************************************************
+Associate the last ledger entry with the job that was created to verify the file
+***********************************************************************************************************************************/
+static void
+verifyLedgerJobSet(VerifyJobData *const jobData, const ProtocolParallelJob *const job)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, jobData);
+        FUNCTION_TEST_PARAM(PROTOCOL_PARALLEL_JOB, job);
+    FUNCTION_TEST_END();
+
+    ASSERT(jobData != NULL);
+    ASSERT(job != NULL);
+
+    if (jobData->ledger != NULL)
+        ((VerifyLedgerJob *)lstGetLast(jobData->ledgerJobList))->job = job;
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Update the ledger when a job completes. Files that passed verification are recorded and files that failed are removed so they will
+be verified again on the next run.
+***********************************************************************************************************************************/
+static void
+verifyLedgerJobComplete(VerifyJobData *const jobData, const ProtocolParallelJob *const job, const bool valid)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, jobData);
+        FUNCTION_TEST_PARAM(PROTOCOL_PARALLEL_JOB, job);
+        FUNCTION_TEST_PARAM(BOOL, valid);
+    FUNCTION_TEST_END();
+
+    ASSERT(jobData != NULL);
+    ASSERT(job != NULL);
+
+    if (jobData->ledger != NULL)
+    {
+        // The number of jobs in progress is limited by process-max so a linear search is fine here
+        for (unsigned int ledgerJobIdx = 0; ledgerJobIdx < lstSize(jobData->ledgerJobList); ledgerJobIdx++)
+        {
+            VerifyLedgerJob *const ledgerJob = lstGet(jobData->ledgerJobList, ledgerJobIdx);
+
+            if (ledgerJob->job == job)
+            {
+                if (valid)
+                    verifyLedgerSet(jobData->ledger, ledgerJob->name, ledgerJob->checksum, (time_t)(timeMSec() / MSEC_PER_SEC));
+                else
+                    verifyLedgerRemove(jobData->ledger, ledgerJob->name);
+
+                strFree(ledgerJob->name);
+                strFree(ledgerJob->checksum);
+                lstRemoveIdx(jobData->ledgerJobList, ledgerJobIdx);
+
+                break;
+            }
+        }
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Helper function to add a file to an invalid file list
 ***********************************************************************************************************************************/
@@ -755,8 +893,10 @@ verifyArchive(VerifyJobData *const jobData)
                 }
                 MEM_CONTEXT_END();
 
-                // Free the old WAL path list
+                // Free the old WAL path list and any WAL file lists prefetched for it
                 strLstFree(jobData->walPathList);
+                lstFree(jobData->walFileListNext);
+                jobData->walFileListNext = NULL;
 
                 // Get the WAL paths for the archive Id
                 const String *const archiveIdPath = strNewFmt(STORAGE_REPO_ARCHIVE "/%s", strZ(archiveId));
@@ -785,16 +925,34 @@ verifyArchive(VerifyJobData *const jobData)
                         // Free the old WAL file list
                         strLstFree(jobData->walFileList);
 
-                        // Get WAL file list
-                        const String *const walFilePath = strNewFmt(
-                            STORAGE_REPO_ARCHIVE "/%s/%s", strZ(archiveResult->archiveId), strZ(walPath));
-
-                        MEM_CONTEXT_BEGIN(jobData->memContext)
+                        // Get WAL file lists for the next WAL paths concurrently when none are left from a prior listing
+                        if (jobData->walFileListNext == NULL || lstEmpty(jobData->walFileListNext))
                         {
-                            jobData->walFileList = strLstSort(
-                                storageListP(storageRepo(), walFilePath, .expression = WAL_SEGMENT_FILE_REGEXP_STR), sortOrderAsc);
+                            StringList *const walFilePathList = strLstNew();
+
+                            for (unsigned int walPathIdx = 0;
+                                 walPathIdx < strLstSize(jobData->walPathList) && walPathIdx < VERIFY_ARCHIVE_LIST_PARALLEL;
+                                 walPathIdx++)
+                            {
+                                strLstAddFmt(
+                                    walFilePathList, STORAGE_REPO_ARCHIVE "/%s/%s", strZ(archiveResult->archiveId),
+                                    strZ(strLstGet(jobData->walPathList, walPathIdx)));
+                            }
+
+                            lstFree(jobData->walFileListNext);
+
+                            MEM_CONTEXT_BEGIN(jobData->memContext)
+                            {
+                                jobData->walFileListNext = storageListMultiP(
+                                    storageRepo(), walFilePathList, .expression = WAL_SEGMENT_FILE_REGEXP_STR);
+                            }
+                            MEM_CONTEXT_END();
                         }
-                        MEM_CONTEXT_END();
+
+                        // Get WAL file list for the first WAL path
+                        jobData->walFileList = strLstSort(
+                            strLstMove(*(StringList **)lstGet(jobData->walFileListNext, 0), jobData->memContext), sortOrderAsc);
+                        lstRemoveIdx(jobData->walFileListNext, 0);
 
                         // Filter WAL files if needed
                         if (jobData->enableArchiveFilter)
@@ -864,24 +1022,33 @@ verifyArchive(VerifyJobData *const jobData)
                         const Buffer *const checksum = bufNewDecode(
                             encodingHex, strSubN(fileName, WAL_SEGMENT_NAME_SIZE + 1, HASH_TYPE_SHA1_SIZE_HEX));
 
-                        // Set up the job
-                        PackWrite *const param = protocolPackNew();
+                        // Verify the file unless the ledger shows it has already been verified
+                        if (verifyLedgerCheck(jobData, filePathName, false, 0, checksum))
+                        {
+                            // Set up the job
+                            PackWrite *const param = protocolPackNew();
 
-                        pckWriteStrP(param, filePathName);
-                        pckWriteBoolP(param, false);
-                        pckWriteU32P(param, compressTypeFromName(filePathName));
-                        pckWriteBinP(param, checksum);
-                        pckWriteU64P(param, archiveResult->pgWalInfo.size);
-                        pckWriteStrP(param, jobData->walCipherPass);
+                            pckWriteStrP(param, filePathName);
+                            pckWriteBoolP(param, false);
+                            pckWriteU32P(param, compressTypeFromName(filePathName));
+                            pckWriteBinP(param, checksum);
+                            pckWriteU64P(param, archiveResult->pgWalInfo.size);
+                            pckWriteStrP(param, jobData->walCipherPass);
 
-                        // Assign job to result, prepending the archiveId to the key for consistency with backup processing
-                        const String *const jobKey = strNewFmt("%s/%s", strZ(archiveResult->archiveId), strZ(filePathName));
+                            // Assign job to result, prepending the archiveId to the key for consistency with backup processing
+                            const String *const jobKey = strNewFmt("%s/%s", strZ(archiveResult->archiveId), strZ(filePathName));
 
-                        MEM_CONTEXT_PRIOR_BEGIN()
-                        {
-                            result = protocolParallelJobNew(VARSTR(jobKey), PROTOCOL_COMMAND_VERIFY_FILE, param);
+                            MEM_CONTEXT_PRIOR_BEGIN()
+                            {
+                                result = protocolParallelJobNew(VARSTR(jobKey), PROTOCOL_COMMAND_VERIFY_FILE, param);
+                            }
+                            MEM_CONTEXT_PRIOR_END();
+
+                            verifyLedgerJobSet(jobData, result);
                         }
-                        MEM_CONTEXT_PRIOR_END();
+                        // Else the file was verified by a prior run
+                        else
+                            archiveResult->totalValidWal++;
 
                         // Remove the file to process from the list
                         strLstRemoveIdx(jobData->walFileList, 0);
@@ -1089,51 +1256,66 @@ verifyBackup(VerifyJobData *const jobData)
                         // If backup label is not null then send it off for processing
                         if (fileBackupLabel != NULL)
                         {
-                            // Set up the job
-                            PackWrite *const param = protocolPackNew();
-
                             const String *const filePathName = backupFileRepoPathP(
                                 fileBackupLabel, .manifestName = fileData.name, .bundleId = fileData.bundleId,
                                 .compressType = manifestData(jobData->manifest)->backupOptionCompressType,
                                 .blockIncr = fileData.blockIncrMapSize != 0);
 
-                            pckWriteStrP(param, filePathName);
-
-                            if (fileData.bundleId != 0)
+                            // Verify the file unless the ledger shows it has already been verified. Use the repo checksum when
+                            // present since that is the checksum that will be verified.
+                            if (verifyLedgerCheck(
+                                    jobData, filePathName, fileData.bundleId != 0, fileData.bundleOffset,
+                                    BUF(
+                                        fileData.checksumRepoSha1 != NULL ? fileData.checksumRepoSha1 : fileData.checksumSha1,
+                                        HASH_TYPE_SHA1_SIZE)))
                             {
-                                pckWriteBoolP(param, true);
-                                pckWriteU64P(param, fileData.bundleOffset);
-                                pckWriteU64P(param, fileData.sizeRepo);
-                            }
-                            else
-                                pckWriteBoolP(param, false);
+                                // Set up the job
+                                PackWrite *const param = protocolPackNew();
 
-                            // Use the repo checksum when present
-                            if (fileData.checksumRepoSha1 != NULL)
-                            {
-                                pckWriteU32P(param, compressTypeNone);
-                                pckWriteBinP(param, BUF(fileData.checksumRepoSha1, HASH_TYPE_SHA1_SIZE));
-                                pckWriteU64P(param, fileData.sizeRepo);
-                                pckWriteStrP(param, NULL);
-                            }
-                            // Else use the file checksum, which may require additional filters, e.g. decompression
-                            else
-                            {
-                                pckWriteU32P(param, manifestData(jobData->manifest)->backupOptionCompressType);
-                                pckWriteBinP(param, BUF(fileData.checksumSha1, HASH_TYPE_SHA1_SIZE));
-                                pckWriteU64P(param, fileData.size);
-                                pckWriteStrP(param, jobData->backupCipherPass);
-                            }
+                                pckWriteStrP(param, filePathName);
 
-                            // Assign job to result (prepend backup label being processed to the key since some files are in a prior
-                            // backup)
-                            const String *const jobKey = strNewFmt("%s/%s", strZ(backupResult->backupLabel), strZ(filePathName));
+                                if (fileData.bundleId != 0)
+                                {
+                                    pckWriteBoolP(param, true);
+                                    pckWriteU64P(param, fileData.bundleOffset);
+                                    pckWriteU64P(param, fileData.sizeRepo);
+                                }
+                                else
+                                    pckWriteBoolP(param, false);
 
-                            MEM_CONTEXT_PRIOR_BEGIN()
-                            {
-                                result = protocolParallelJobNew(VARSTR(jobKey), PROTOCOL_COMMAND_VERIFY_FILE, param);
+                                // Use the repo checksum when present
+                                if (fileData.checksumRepoSha1 != NULL)
+                                {
+                                    pckWriteU32P(param, compressTypeNone);
+                                    pckWriteBinP(param, BUF(fileData.checksumRepoSha1, HASH_TYPE_SHA1_SIZE));
+                                    pckWriteU64P(param, fileData.sizeRepo);
+                                    pckWriteStrP(param, NULL);
+                                }
+                                // Else use the file checksum, which may require additional filters, e.g. decompression
+                                else
+                                {
+                                    pckWriteU32P(param, manifestData(jobData->manifest)->backupOptionCompressType);
+                                    pckWriteBinP(param, BUF(fileData.checksumSha1, HASH_TYPE_SHA1_SIZE));
+                                    pckWriteU64P(param, fileData.size);
+                                    pckWriteStrP(param, jobData->backupCipherPass);
+                                }
+
+                                // Assign job to result (prepend backup label being processed to the key since some files are in a
+                                // prior backup)
+                                const String *const jobKey = strNewFmt(
+                                    "%s/%s", strZ(backupResult->backupLabel), strZ(filePathName));
+
+                                MEM_CONTEXT_PRIOR_BEGIN()
+                                {
+                                    result = protocolParallelJobNew(VARSTR(jobKey), PROTOCOL_COMMAND_VERIFY_FILE, param);
+                                }
+                                MEM_CONTEXT_PRIOR_END();
+
+                                verifyLedgerJobSet(jobData, result);
                             }
-                            MEM_CONTEXT_PRIOR_END();
+                            // Else the file was verified by a prior run
+                            else
+                                backupResult->totalFileValid++;
                         }
                     }
                     // Else mark the zero-length file as valid
@@ -1638,6 +1820,7 @@ verifyProcess(const bool verboseText)
                 .memContext = memContextCurrent(),
                 .walPathList = NULL,
                 .walFileList = strLstNew(),
+                .walFileListNext = NULL,
                 .pgHistory = infoArchivePg(archiveInfo),
                 .manifestCipherPass = infoPgCipherPass(infoBackupPg(backupInfo)),
                 .walCipherPass = infoPgCipherPass(infoArchivePg(archiveInfo)),
@@ -1645,6 +1828,16 @@ verifyProcess(const bool verboseText)
                 .backupResultList = lstNewP(sizeof(VerifyBackupResult), .comparator = lstComparatorStr),
             };
 
+            // Load the ledger so files verified by a prior run can be skipped
+            if (cfgOptionBool(cfgOptVerifyLedger))
+            {
+                jobData.ledger = verifyLedgerLoad(
+                    STRDEF(STORAGE_REPO_BACKUP "/" VERIFY_LEDGER_FILE), cfgOptionStrId(cfgOptRepoCipherType),
+                    jobData.manifestCipherPass);
+                jobData.ledgerSample = cfgOptionUInt(cfgOptVerifySample);
+                jobData.ledgerJobList = lstNewP(sizeof(VerifyLedgerJob));
+            }
+
             // Use backup label if specified via --set
             const String *const backupLabel = cfgOptionStrNull(cfgOptSet);
             const String *backupRegExpStr = backupRegExpP(.full = true, .differential = true, .incremental = true);
@@ -1716,11 +1909,14 @@ verifyProcess(const bool verboseText)
                     protocolParallelClientAdd(parallelExec, protocolLocalGet(protocolStorageTypeRepo, 0, processIdx));
 
                 // Process jobs
+                uint64_t fileComplete = 0;
+
                 MEM_CONTEXT_TEMP_RESET_BEGIN()
                 {
                     do
                     {
                         unsigned int completed = protocolParallelProcess(parallelExec);
+                        fileComplete += completed;
 
                         // Process completed jobs
                         for (unsigned int jobIdx = 0; jobIdx < completed; jobIdx++)
@@ -1764,6 +1960,9 @@ verifyProcess(const bool verboseText)
                             {
                                 const VerifyResult verifyResult = (VerifyResult)pckReadU32P(protocolParallelJobResult(job));
 
+                                // Update the ledger with the result
+                                verifyLedgerJobComplete(&jobData, job, verifyResult == verifyOk);
+
                                 // Update the result set for the type of file being processed
                                 if (strEq(fileType, STORAGE_REPO_ARCHIVE_STR))
                                 {
@@ -1805,6 +2004,9 @@ verifyProcess(const bool verboseText)
 
                                 jobData.jobErrorTotal++;
 
+                                // Remove the file from the ledger so it will be verified again
+                                verifyLedgerJobComplete(&jobData, job, false);
+
                                 // Add invalid file with "OtherError" reason to invalid file list
                                 if (strEq(fileType, STORAGE_REPO_ARCHIVE_STR))
                                 {
@@ -1831,6 +2033,9 @@ verifyProcess(const bool verboseText)
                             protocolParallelJobFree(job);
                         }
 
+                        // Update metrics. Jobs are generated as files are found so the total is not known in advance.
+                        cmdMetricsWriteP(.force = protocolParallelDone(parallelExec), .fileComplete = fileComplete);
+
                         // Reset the memory context occasionally so we don't use too much memory or slow down processing
                         MEM_CONTEXT_TEMP_RESET(1000);
                     }
@@ -1838,6 +2043,16 @@ verifyProcess(const bool verboseText)
                 }
                 MEM_CONTEXT_TEMP_END();
 
+                // Save the ledger. Entries for files no longer in the repo are pruned unless only a single backup was verified.
+                if (jobData.ledger != NULL)
+                {
+                    LOG_DETAIL_FMT("%u file(s) verified by a prior run were skipped", verifyLedgerSkipTotal(jobData.ledger));
+
+                    verifyLedgerSave(
+                        jobData.ledger, STRDEF(STORAGE_REPO_BACKUP "/" VERIFY_LEDGER_FILE), cfgOptionStrId(cfgOptRepoCipherType),
+                        jobData.manifestCipherPass, backupLabel == NULL);
+                }
+
                 // ??? Need to do the final reconciliation - checking backup required WAL against, valid WAL
 
                 // Report results
@@ -11,6 +11,8 @@ IO Filter Group
 #include "common/io/filter/group.h"
 #include "common/io/io.h"
 #include "common/log.h"
+#include "common/stat.h"
+#include "common/time.h"
 #include "common/type/list.h"
 
 /***********************************************************************************************************************************
@@ -24,6 +26,7 @@ typedef struct IoFilterData
     Buffer *inputLocal;                                             // Non-null if a locally created buffer that can be cleared
     IoFilter *filter;                                               // Filter to apply
     Buffer *output;                                                 // Output buffer for filter
+    TimeUSec time;                                                  // Time spent processing
 } IoFilterData;
 
 // Macros for logging
@@ -49,6 +52,7 @@ struct IoFilterGroup
     IoFilterGroupPub pub;                                           // Publicly accessible variables
     const Buffer *input;                                            // Input buffer passed in for processing
     List *filterResult;                                             // Filter results (if any)
+    unsigned int filterStatTotal;                                   // Filters to time (excludes filter added on open)
 
 #ifdef DEBUG
     bool flushing;                                                  // Is output being flushed?
@@ -174,6 +178,8 @@ ioFilterGroupOpen(IoFilterGroup *const this)
 
     MEM_CONTEXT_OBJ_BEGIN(this)
     {
+        this->filterStatTotal = ioFilterGroupSize(this);
+
         // If the last filter is not an output filter then add a filter to buffer/copy data. Input filters won't copy to an output
         // buffer so we need some way to get the data to the output buffer.
         if (ioFilterGroupSize(this) == 0 ||
@@ -293,9 +299,12 @@ ioFilterGroupProcess(IoFilterGroup *const this, const Buffer *const input, Buffe
             if (!ioFilterDone(filterData->filter))
             {
                 // If the filter produces output
+                const TimeUSec timeBegin = timeUSec();
+
                 if (ioFilterOutput(filterData->filter))
                 {
                     ioFilterProcessInOut(filterData->filter, *filterData->input, filterData->output);
+                    filterData->time += timeUSec() - timeBegin;
 
                     // If inputSame is set then the output buffer for this filter is full and it will need to be re-processed with
                     // the same input once the output buffer is cleared
@@ -314,7 +323,10 @@ ioFilterGroupProcess(IoFilterGroup *const this, const Buffer *const input, Buffe
                 }
                 // Else the filter does not produce output
                 else
+                {
                     ioFilterProcessIn(filterData->filter, *filterData->input);
+                    filterData->time += timeUSec() - timeBegin;
+                }
             }
 
             // If the filter is done and has no more output then null the output buffer. Downstream filters have a pointer to this
@@ -365,13 +377,24 @@ ioFilterGroupClose(IoFilterGroup *this)
     // Gather results from the filters
     for (unsigned int filterIdx = 0; filterIdx < ioFilterGroupSize(this); filterIdx++)
     {
-        const IoFilter *const filter = ioFilterGroupGet(this, filterIdx)->filter;
+        const IoFilterData *const filterData = ioFilterGroupGet(this, filterIdx);
+        const IoFilter *const filter = filterData->filter;
 
         MEM_CONTEXT_BEGIN(lstMemContext(this->filterResult))
         {
             lstAdd(this->filterResult, &(IoFilterResult){.type = ioFilterType(filter), .result = ioFilterResult(filter)});
         }
         MEM_CONTEXT_END();
+
+        // Record time spent in the filter, e.g. compression or encryption
+        if (filterIdx < this->filterStatTotal)
+        {
+            MEM_CONTEXT_TEMP_BEGIN()
+            {
+                statTime(strNewFmt(IO_FILTER_STAT_PREFIX "%s", strZ(strIdToStr(ioFilterType(filter)))), filterData->time);
+            }
+            MEM_CONTEXT_TEMP_END();
+        }
     }
 
     // Filter group is open
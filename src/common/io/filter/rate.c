@@ -0,0 +1,121 @@
+/***********************************************************************************************************************************
+IO Rate Filter
+***********************************************************************************************************************************/
+#include "build.auto.h"
+
+#include "common/debug.h"
+#include "common/io/filter/filter.h"
+#include "common/io/filter/rate.h"
+#include "common/log.h"
+#include "common/time.h"
+#include "common/type/object.h"
+#include "common/type/pack.h"
+
+/***********************************************************************************************************************************
+Object type
+***********************************************************************************************************************************/
+typedef struct IoRate
+{
+    uint64_t rate;                                                  // Max bytes per second
+    uint64_t size;                                                  // Total size of all input
+    TimeMSec timeBegin;                                             // Time the first input was processed
+    TimeMSec timeSleep;                                             // Total time slept to limit the rate
+} IoRate;
+
+/***********************************************************************************************************************************
+Macros for function logging
+***********************************************************************************************************************************/
+static void
+ioRateToLog(const IoRate *const this, StringStatic *const debugLog)
+{
+    strStcFmt(debugLog, "{rate: %" PRIu64 ", size: %" PRIu64 "}", this->rate, this->size);
+}
+
+#define FUNCTION_LOG_IO_RATE_TYPE                                                                                                  \
+    IoRate *
+#define FUNCTION_LOG_IO_RATE_FORMAT(value, buffer, bufferSize)                                                                     \
+    FUNCTION_LOG_OBJECT_FORMAT(value, ioRateToLog, buffer, bufferSize)
+
+/***********************************************************************************************************************************
+Count bytes in the input and sleep if the rate has been exceeded
+***********************************************************************************************************************************/
+static void
+ioRateProcess(THIS_VOID, const Buffer *const input)
+{
+    THIS(IoRate);
+
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(IO_RATE, this);
+        FUNCTION_LOG_PARAM(BUFFER, input);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(input != NULL);
+
+    const TimeMSec timeNow = timeMSec();
+
+    if (this->size == 0)
+        this->timeBegin = timeNow;
+
+    this->size += bufUsed(input);
+
+    // Sleep until the time when the bytes processed so far would be allowed by the rate
+    const TimeMSec timeTarget = this->timeBegin + this->size * MSEC_PER_SEC / this->rate;
+
+    if (timeTarget > timeNow)
+    {
+        sleepMSec(timeTarget - timeNow);
+        this->timeSleep += timeTarget - timeNow;
+    }
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Return filter result, i.e. total time slept to limit the rate
+***********************************************************************************************************************************/
+static Pack *
+ioRateResult(THIS_VOID)
+{
+    THIS(IoRate);
+
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(IO_RATE, this);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+
+    Pack *result = NULL;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        PackWrite *const packWrite = pckWriteNewP();
+
+        pckWriteU64P(packWrite, this->timeSleep);
+        pckWriteEndP(packWrite);
+
+        result = pckMove(pckWriteResult(packWrite), memContextPrior());
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN(PACK, result);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN IoFilter *
+ioRateNew(const uint64_t rate)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(UINT64, rate);
+    FUNCTION_LOG_END();
+
+    ASSERT(rate > 0);
+
+    OBJ_NEW_BEGIN(IoRate)
+    {
+        *this = (IoRate){.rate = rate};
+    }
+    OBJ_NEW_END();
+
+    FUNCTION_LOG_RETURN(IO_FILTER, ioFilterNewP(RATE_FILTER_TYPE, this, NULL, .in = ioRateProcess, .result = ioRateResult));
+}
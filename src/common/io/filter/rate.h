@@ -0,0 +1,24 @@
+/***********************************************************************************************************************************
+IO Rate Filter
+
+Limit the rate of all bytes that pass through the filter by sleeping when the rate is exceeded. The rate is averaged from the time
+the first bytes are processed so short bursts over the limit are allowed as long as the average does not exceed the limit. Useful
+for limiting reads if added first in a FilterGroup with IoRead or writes if added last in a FilterGroup with IoWrite.
+***********************************************************************************************************************************/
+#ifndef COMMON_IO_FILTER_RATE_H
+#define COMMON_IO_FILTER_RATE_H
+
+#include "common/io/filter/filter.h"
+
+/***********************************************************************************************************************************
+Filter type constant
+***********************************************************************************************************************************/
+#define RATE_FILTER_TYPE                                     STRID5("rate", 0x2d0320)
+
+/***********************************************************************************************************************************
+Constructors
+***********************************************************************************************************************************/
+// Rate is in bytes per second. The filter result is the total time in milliseconds slept to limit the rate.
+FN_EXTERN IoFilter *ioRateNew(uint64_t rate);
+
+#endif
@@ -16,6 +16,7 @@ Statistics constants
 STRING_EXTERN(HTTP_STAT_CLIENT_STR,                                 HTTP_STAT_CLIENT);
 STRING_EXTERN(HTTP_STAT_CLOSE_STR,                                  HTTP_STAT_CLOSE);
 STRING_EXTERN(HTTP_STAT_REQUEST_STR,                                HTTP_STAT_REQUEST);
+STRING_EXTERN(HTTP_STAT_RESPONSE_STR,                               HTTP_STAT_RESPONSE);
 STRING_EXTERN(HTTP_STAT_RETRY_STR,                                  HTTP_STAT_RETRY);
 STRING_EXTERN(HTTP_STAT_SESSION_STR,                                HTTP_STAT_SESSION);
 
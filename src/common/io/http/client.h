@@ -34,6 +34,8 @@ STRING_DECLARE(HTTP_STAT_CLIENT_STR);
 STRING_DECLARE(HTTP_STAT_CLOSE_STR);
 #define HTTP_STAT_REQUEST                                           "http.request"      // Requests (i.e. calls to httpRequestNew())
 STRING_DECLARE(HTTP_STAT_REQUEST_STR);
+#define HTTP_STAT_RESPONSE                                          "http.response"     // Time from request to response
+STRING_DECLARE(HTTP_STAT_RESPONSE_STR);
 #define HTTP_STAT_RETRY                                             "http.retry"        // Request retries
 STRING_DECLARE(HTTP_STAT_RETRY_STR);
 #define HTTP_STAT_SESSION                                           "http.session"      // Sessions created
@@ -49,6 +49,7 @@ struct HttpRequest
     HttpRequestPub pub;                                             // Publicly accessible variables
     HttpClient *client;                                             // HTTP client
     const Buffer *content;                                          // HTTP content
+    TimeUSec timeBegin;                                             // Time the request was started
 
     HttpSession *session;                                           // Session for async requests
 };
@@ -253,6 +254,7 @@ httpRequestNew(HttpClient *const client, const String *const verb, const String
             },
             .client = client,
             .content = param.content == NULL ? NULL : bufDup(param.content),
+            .timeBegin = timeUSec(),
         };
     }
     OBJ_NEW_END();
@@ -275,7 +277,12 @@ httpRequestResponse(HttpRequest *const this, const bool contentCache)
 
     ASSERT(this != NULL);
 
-    FUNCTION_LOG_RETURN(HTTP_RESPONSE, httpRequestProcess(this, true, contentCache));
+    HttpResponse *const result = httpRequestProcess(this, true, contentCache);
+
+    // Record time from the start of the request until the response was received, including retries
+    statTime(HTTP_STAT_RESPONSE_STR, timeUSec() - this->timeBegin);
+
+    FUNCTION_LOG_RETURN(HTTP_RESPONSE, result);
 }
 
 /**********************************************************************************************************************************/
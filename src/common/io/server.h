@@ -49,6 +49,9 @@ ioServerAccept(IoServer *const this, IoSession *const session)
     return THIS_PUB(IoServer)->interface->accept(THIS_PUB(IoServer)->driver, session);
 }
 
+// Server file descriptor, -1 if none
+FN_EXTERN int ioServerFd(IoServer *this);
+
 /***********************************************************************************************************************************
 Destructor
 ***********************************************************************************************************************************/
@@ -22,6 +22,9 @@ typedef struct IoServerInterface
     // Accept a session
     IoSession *(*accept)(void *driver, IoSession *session);
 
+    // Server file descriptor, if any
+    int (*fd)(void *driver);
+
     // Driver log function
     void (*toLog)(const void *driver, StringStatic *debugLog);
 } IoServerInterface;
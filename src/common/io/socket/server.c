@@ -118,6 +118,21 @@ sckServerAccept(THIS_VOID, IoSession *const session)
     FUNCTION_LOG_RETURN(IO_SESSION, result);
 }
 
+/**********************************************************************************************************************************/
+static int
+sckServerFd(THIS_VOID)
+{
+    THIS(SocketServer);
+
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(SOCKET_SERVER, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(INT, this->socket);
+}
+
 /**********************************************************************************************************************************/
 static const String *
 sckServerName(THIS_VOID)                                                                                            // {vm_covered}
@@ -139,6 +154,7 @@ static const IoServerInterface sckServerInterface =
     .type = IO_SERVER_SOCKET_TYPE,
     .name = sckServerName,
     .accept = sckServerAccept,
+    .fd = sckServerFd,
     .toLog = sckServerToLog,
 };
 
@@ -19,12 +19,18 @@ TLS Server
 #include "common/log.h"
 #include "common/stat.h"
 #include "common/type/object.h"
+#include "version.h"
 
 /***********************************************************************************************************************************
 Statistics constants
 ***********************************************************************************************************************************/
 STRING_EXTERN(TLS_STAT_SERVER_STR,                                  TLS_STAT_SERVER);
 
+/***********************************************************************************************************************************
+Session id context required to resume sessions when client certificates are verified
+***********************************************************************************************************************************/
+#define TLS_SERVER_SESSION_ID_CONTEXT                               PROJECT_BIN
+
 /***********************************************************************************************************************************
 Object type
 ***********************************************************************************************************************************/
@@ -280,7 +286,7 @@ static const IoServerInterface tlsServerInterface =
 FN_EXTERN IoServer *
 tlsServerNew(
     const String *const host, const String *const caFile, const String *const keyFile, const String *const certFile,
-    const TimeMSec timeout)
+    const TimeMSec timeout, const bool sessionResume)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(STRING, host);
@@ -288,6 +294,7 @@ tlsServerNew(
         FUNCTION_LOG_PARAM(STRING, keyFile);
         FUNCTION_LOG_PARAM(STRING, certFile);
         FUNCTION_LOG_PARAM(TIME_MSEC, timeout);
+        FUNCTION_LOG_PARAM(BOOL, sessionResume);
     FUNCTION_LOG_END();
 
     ASSERT(host != NULL);
@@ -311,19 +318,33 @@ tlsServerNew(
             this->context,
             // Disable SSL and TLS v1/v1.1
             SSL_OP_NO_TLSv1 | SSL_OP_NO_TLSv1_1 |
-            // Let server set cipher order
-            SSL_OP_CIPHER_SERVER_PREFERENCE |
 #ifdef SSL_OP_NO_RENEGOTIATION
             // Disable renegotiation, available since 1.1.0h. This affects only TLSv1.2 and older protocol versions as TLSv1.3 has
             // no support for renegotiation.
             SSL_OP_NO_RENEGOTIATION |
 #endif
-            // Disable session tickets
-            SSL_OP_NO_TICKET);
+            // Let server set cipher order
+            SSL_OP_CIPHER_SERVER_PREFERENCE);
 
-        // Disable session caching
+        // Disable server-side session caching. Sessions are cached per process so the cache would not be shared by the child
+        // processes that handle connections.
         SSL_CTX_set_session_cache_mode(this->context, SSL_SESS_CACHE_OFF);
 
+        // Session tickets allow clients to resume sessions without a full handshake. The ticket keys are generated randomly when
+        // the context is created, so child processes forked after this point share the keys and accept tickets issued by each
+        // other. New keys are generated when the server is recreated, e.g. on reload.
+        if (sessionResume)
+        {
+            cryptoError(
+                SSL_CTX_set_session_id_context(
+                    this->context, (const unsigned char *)TLS_SERVER_SESSION_ID_CONTEXT,
+                    sizeof(TLS_SERVER_SESSION_ID_CONTEXT) - 1) != 1,
+                "unable to set session id context");
+        }
+        // Else disable session tickets
+        else
+            SSL_CTX_set_options(this->context, SSL_OP_NO_TICKET);
+
         // Setup ephemeral DH and ECDH keys
         tlsServerDh(this->context);
         tlsServerEcdh(this->context);
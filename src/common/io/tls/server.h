@@ -25,6 +25,7 @@ STRING_DECLARE(TLS_STAT_SERVER_STR);
 Constructors
 ***********************************************************************************************************************************/
 FN_EXTERN IoServer *tlsServerNew(
-    const String *host, const String *caFile, const String *keyFile, const String *certFile, TimeMSec timeout);
+    const String *host, const String *caFile, const String *keyFile, const String *certFile, TimeMSec timeout,
+    bool sessionResume);
 
 #endif
@@ -7,8 +7,24 @@ Statistics Collector
 #include "common/memContext.h"
 #include "common/stat.h"
 #include "common/type/json.h"
+#include "common/type/keyValue.h"
 #include "common/type/list.h"
 
+/***********************************************************************************************************************************
+Latency histogram buckets. Each bucket counts times less than its upper bound, starting at 100us and increasing by a factor of ten,
+with the last bucket counting all times greater than or equal to 10s.
+***********************************************************************************************************************************/
+#define STAT_HISTOGRAM_SIZE                                         7
+#define STAT_HISTOGRAM_BUCKET_MIN                                   ((TimeUSec)100)
+
+/***********************************************************************************************************************************
+JSON keys
+***********************************************************************************************************************************/
+#define STAT_KEY_HISTOGRAM                                          "histogram"
+#define STAT_KEY_MAX                                                "max"
+#define STAT_KEY_TIME                                               "time"
+#define STAT_KEY_TOTAL                                              "total"
+
 /***********************************************************************************************************************************
 Cumulative statistics
 ***********************************************************************************************************************************/
@@ -16,6 +32,10 @@ typedef struct Stat
 {
     const String *key;
     uint64_t total;
+    bool timed;                                                     // Has time been recorded?
+    TimeUSec time;                                                  // Cumulative time
+    TimeUSec timeMax;                                               // Maximum time
+    uint64_t histogram[STAT_HISTOGRAM_SIZE];                        // Latency histogram
 } Stat;
 
 /***********************************************************************************************************************************
@@ -101,6 +121,54 @@ statInc(const String *const key)
     FUNCTION_TEST_RETURN_VOID();
 }
 
+/**********************************************************************************************************************************/
+FN_EXTERN void
+statTime(const String *const key, const TimeUSec time)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING, key);
+        FUNCTION_TEST_PARAM(UINT64, time);
+    FUNCTION_TEST_END();
+
+    ASSERT(statLocalData.memContext != NULL);
+    ASSERT(key != NULL);
+
+    Stat *const stat = statGetOrCreate(key);
+
+    stat->total++;
+    stat->timed = true;
+    stat->time += time;
+
+    if (time > stat->timeMax)
+        stat->timeMax = time;
+
+    // Find the histogram bucket
+    unsigned int bucketIdx = 0;
+
+    for (TimeUSec bucketMax = STAT_HISTOGRAM_BUCKET_MIN; bucketIdx < STAT_HISTOGRAM_SIZE - 1 && time >= bucketMax; bucketMax *= 10)
+        bucketIdx++;
+
+    stat->histogram[bucketIdx]++;
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN uint64_t
+statTotal(const String *const key)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING, key);
+    FUNCTION_TEST_END();
+
+    ASSERT(statLocalData.memContext != NULL);
+    ASSERT(key != NULL);
+
+    const Stat *const stat = lstFind(statLocalData.stat, &key);
+
+    FUNCTION_TEST_RETURN(UINT64, stat == NULL ? 0 : stat->total);
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN String *
 statToJson(void)
@@ -124,7 +192,21 @@ statToJson(void)
                 const Stat *const stat = lstGet(statLocalData.stat, statIdx);
 
                 jsonWriteObjectBegin(jsonWriteKey(json, stat->key));
-                jsonWriteUInt64(jsonWriteKeyZ(json, "total"), stat->total);
+
+                // Output time in milliseconds along with the histogram for timed stats
+                if (stat->timed)
+                {
+                    jsonWriteArrayBegin(jsonWriteKeyZ(json, STAT_KEY_HISTOGRAM));
+
+                    for (unsigned int bucketIdx = 0; bucketIdx < STAT_HISTOGRAM_SIZE; bucketIdx++)
+                        jsonWriteUInt64(json, stat->histogram[bucketIdx]);
+
+                    jsonWriteArrayEnd(json);
+                    jsonWriteUInt64(jsonWriteKeyZ(json, STAT_KEY_MAX), stat->timeMax / USEC_PER_MSEC);
+                    jsonWriteUInt64(jsonWriteKeyZ(json, STAT_KEY_TIME), stat->time / USEC_PER_MSEC);
+                }
+
+                jsonWriteUInt64(jsonWriteKeyZ(json, STAT_KEY_TOTAL), stat->total);
                 jsonWriteObjectEnd(json);
             }
 
@@ -135,3 +217,53 @@ statToJson(void)
 
     FUNCTION_TEST_RETURN(STRING, result);
 }
+
+/**********************************************************************************************************************************/
+FN_EXTERN void
+statMerge(const String *const json)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING, json);
+    FUNCTION_TEST_END();
+
+    ASSERT(statLocalData.memContext != NULL);
+    ASSERT(json != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        const KeyValue *const statKv = varKv(jsonToVar(json));
+        const VariantList *const keyList = kvKeyList(statKv);
+
+        for (unsigned int keyIdx = 0; keyIdx < varLstSize(keyList); keyIdx++)
+        {
+            const Variant *const key = varLstGet(keyList, keyIdx);
+            const KeyValue *const valueKv = varKv(kvGet(statKv, key));
+            Stat *const stat = statGetOrCreate(varStr(key));
+
+            stat->total += varUInt64Force(kvGet(valueKv, VARSTRDEF(STAT_KEY_TOTAL)));
+
+            // Time is merged at millisecond precision since that is the precision of the JSON output
+            const Variant *const histogram = kvGet(valueKv, VARSTRDEF(STAT_KEY_HISTOGRAM));
+
+            if (histogram != NULL)
+            {
+                const VariantList *const histogramList = varVarLst(histogram);
+                ASSERT(varLstSize(histogramList) == STAT_HISTOGRAM_SIZE);
+
+                for (unsigned int bucketIdx = 0; bucketIdx < STAT_HISTOGRAM_SIZE; bucketIdx++)
+                    stat->histogram[bucketIdx] += varUInt64Force(varLstGet(histogramList, bucketIdx));
+
+                const TimeUSec timeMax = varUInt64Force(kvGet(valueKv, VARSTRDEF(STAT_KEY_MAX))) * USEC_PER_MSEC;
+
+                if (timeMax > stat->timeMax)
+                    stat->timeMax = timeMax;
+
+                stat->time += varUInt64Force(kvGet(valueKv, VARSTRDEF(STAT_KEY_TIME))) * USEC_PER_MSEC;
+                stat->timed = true;
+            }
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN_VOID();
+}
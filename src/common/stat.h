@@ -5,6 +5,10 @@ Collect simple statistics that can be output to a KeyValue for processing and lo
 uniquely and will also be used in the output. Individual stats do not need to be created in advance since they will be created as
 needed at runtime. However, statInit() must be called before any other stat*() functions.
 
+Stats may also be timed, in which case the cumulative time, maximum time, and a latency histogram are kept along with the total. A
+timed stat should be recorded once per logical operation (e.g. a file or a request) rather than once per buffer to keep the overhead
+negligible.
+
 NOTE: Statistics are held in a sorted list so there is some cost involved in each lookup. In general, statistics should be used for
 relatively important or high-latency operations where measurements are critical. For instance, using statistics to count the
 iterations of a loop would likely be a bad idea.
@@ -12,6 +16,7 @@ iterations of a loop would likely be a bad idea.
 #ifndef COMMON_STAT_H
 #define COMMON_STAT_H
 
+#include "common/time.h"
 #include "common/type/string.h"
 
 /***********************************************************************************************************************************
@@ -23,7 +28,16 @@ FN_EXTERN void statInit(void);
 // Increment stat by one
 FN_EXTERN void statInc(const String *key);
 
+// Increment stat by one and add the time in microseconds
+FN_EXTERN void statTime(const String *key, TimeUSec time);
+
+// Get stat total. Zero is returned if the stat does not exist.
+FN_EXTERN uint64_t statTotal(const String *key);
+
 // Output stats to JSON
 FN_EXTERN String *statToJson(void);
 
+// Merge stats from JSON output by statToJson(), e.g. stats collected by another process
+FN_EXTERN void statMerge(const String *json);
+
 #endif
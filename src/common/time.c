@@ -13,6 +13,7 @@ Time Management
 Constants describing number of sub-units in an interval
 ***********************************************************************************************************************************/
 #define MSEC_PER_USEC                                               ((TimeMSec)1000)
+#define NSEC_PER_USEC                                               ((TimeUSec)1000)
 
 /**********************************************************************************************************************************/
 FN_EXTERN TimeMSec
@@ -26,6 +27,19 @@ timeMSec(void)
     FUNCTION_TEST_RETURN(TIME_MSEC, ((TimeMSec)currentTime.tv_sec * MSEC_PER_SEC) + (TimeMSec)currentTime.tv_usec / MSEC_PER_USEC);
 }
 
+/**********************************************************************************************************************************/
+FN_EXTERN TimeUSec
+timeUSec(void)
+{
+    FUNCTION_TEST_VOID();
+
+    struct timespec currentTime;
+    clock_gettime(CLOCK_MONOTONIC, &currentTime);
+
+    FUNCTION_TEST_RETURN(
+        UINT64, ((TimeUSec)currentTime.tv_sec * MSEC_PER_SEC * USEC_PER_MSEC) + (TimeUSec)currentTime.tv_nsec / NSEC_PER_USEC);
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN void
 sleepMSec(const TimeMSec sleepMSec)
@@ -12,11 +12,13 @@ Time Management
 Time types
 ***********************************************************************************************************************************/
 typedef uint64_t TimeMSec;
+typedef uint64_t TimeUSec;
 
 /***********************************************************************************************************************************
 Constants describing number of sub-units in an interval
 ***********************************************************************************************************************************/
 #define MSEC_PER_SEC                                                ((TimeMSec)1000)
+#define USEC_PER_MSEC                                               ((TimeUSec)1000)
 #define SEC_PER_DAY                                                 ((time_t)86400)
 
 /***********************************************************************************************************************************
@@ -28,6 +30,9 @@ FN_EXTERN void sleepMSec(TimeMSec sleepMSec);
 // Epoch time in milliseconds
 FN_EXTERN TimeMSec timeMSec(void);
 
+// Monotonic time in microseconds. The starting point is undefined so this is only useful for measuring elapsed time.
+FN_EXTERN TimeUSec timeUSec(void);
+
 // Are the date parts valid? (year >= 1970, month 1-12, day 1-31)
 FN_EXTERN void datePartsValid(int year, int month, int day);
 
@@ -738,6 +738,21 @@ jsonReadKeyRequireZ(JsonRead *const this, const char *const key)
     FUNCTION_TEST_RETURN(JSON_READ, jsonReadKeyRequire(this, STR(key)));
 }
 
+/**********************************************************************************************************************************/
+FN_EXTERN bool
+jsonReadMore(JsonRead *const this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(JSON_READ, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    const JsonType type = jsonReadTypeNextIgnoreComma(this);
+
+    FUNCTION_TEST_RETURN(BOOL, type != jsonTypeArrayEnd && type != jsonTypeObjectEnd);
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN void
 jsonReadNull(JsonRead *const this)
@@ -1347,8 +1362,8 @@ jsonWritePush(JsonWrite *const this, const JsonType type, const String *const ke
     if (this->complete)
         THROW(JsonFormatError, "JSON write is complete");
 
-    // If the container stack jas not been created yet
-    if (this->stack == NULL)
+    // If the container stack has not been created yet or is empty after a reset
+    if (this->stack == NULL || lstEmpty(this->stack))
     {
         ASSERT(key == NULL);
 
@@ -1359,7 +1374,7 @@ jsonWritePush(JsonWrite *const this, const JsonType type, const String *const ke
             FUNCTION_TEST_RETURN_VOID();
         }
         // Create the container stack
-        else
+        else if (this->stack == NULL)
         {
             MEM_CONTEXT_OBJ_BEGIN(this)
             {
@@ -2013,6 +2028,28 @@ jsonWriteZ(JsonWrite *const this, const char *const value)
     FUNCTION_TEST_RETURN(JSON_WRITE, this);
 }
 
+/**********************************************************************************************************************************/
+FN_EXTERN JsonWrite *
+jsonWriteReset(JsonWrite *const this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(JSON_WRITE, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    strTrunc(this->json);
+
+    // Empty the stack but keep the list so it can be reused
+    while (this->stack != NULL && !lstEmpty(this->stack))
+        lstRemoveLast(this->stack);
+
+    this->key = false;
+    this->complete = false;
+
+    FUNCTION_TEST_RETURN(JSON_WRITE, this);
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN const String *
 jsonWriteResult(JsonWrite *const this)
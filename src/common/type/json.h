@@ -67,6 +67,10 @@ FN_EXTERN JsonRead *jsonReadKeyRequire(JsonRead *this, const String *key);
 FN_EXTERN JsonRead *jsonReadKeyRequireStrId(JsonRead *this, StringId key);
 FN_EXTERN JsonRead *jsonReadKeyRequireZ(JsonRead *this, const char *key);
 
+// Are there more values in the current array or object? This allows keys to be read in any order, e.g. when the JSON was not
+// generated by this module.
+FN_EXTERN bool jsonReadMore(JsonRead *this);
+
 // Read null
 FN_EXTERN void jsonReadNull(JsonRead *this);
 
@@ -158,6 +162,9 @@ FN_EXTERN JsonWrite *jsonWriteZ(JsonWrite *this, const char *value);
 // Write variant
 FN_EXTERN JsonWrite *jsonWriteVar(JsonWrite *this, const Variant *value);
 
+// Reset to write a new value. This allows a JsonWrite and its buffer to be reused when writing many small values.
+FN_EXTERN JsonWrite *jsonWriteReset(JsonWrite *this);
+
 /***********************************************************************************************************************************
 Write Getters/Setters
 ***********************************************************************************************************************************/
@@ -60,13 +60,15 @@ lstClear(List *const this)
 
     if (this->pub.list != NULL)
     {
+        // Free the original allocation since the list pointer may have been moved up when the first item was removed
         MEM_CONTEXT_BEGIN(lstMemContext(this))
         {
-            memFree(this->pub.list);
+            memFree(this->listAlloc);
         }
         MEM_CONTEXT_END();
 
         this->pub.list = NULL;
+        this->listAlloc = NULL;
         this->pub.listSize = 0;
         this->listSizeMax = 0;
     }
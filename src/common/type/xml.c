@@ -9,6 +9,7 @@ Xml Handler
 #include <libxml/tree.h>
 
 #include "common/debug.h"
+#include "common/io/io.h"
 #include "common/log.h"
 #include "common/memContext.h"
 #include "common/type/xml.h"
@@ -376,3 +377,197 @@ xmlDocumentBuf(const XmlDocument *const this)
 
     FUNCTION_TEST_RETURN(BUFFER, result);
 }
+
+/***********************************************************************************************************************************
+Streaming parser callbacks
+***********************************************************************************************************************************/
+typedef struct XmlParseData
+{
+    XmlParseCallback *callback;                                     // User callback
+    void *callbackData;                                             // User callback data
+    unsigned int depth;                                             // Depth of the current element
+    String *name;                                                   // Name of the current element
+    String *content;                                                // Text of the current element
+    xmlParserCtxtPtr parser;                                        // Parser to stop when the user callback errors
+    const ErrorType *errorType;                                     // Error thrown by the user callback (NULL if none)
+    String *errorMessage;                                           // Error message thrown by the user callback
+} XmlParseData;
+
+// Call the user callback. An error cannot be thrown through libxml2 since it would leave the parser in an inconsistent state, so
+// the error is stored and the parser stopped. The error is thrown when xmlParseChunk() returns.
+static void
+xmlParseCallback(XmlParseData *const parseData, const String *const content)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, parseData);
+        FUNCTION_TEST_PARAM(STRING, content);
+    FUNCTION_TEST_END();
+
+    ASSERT(parseData != NULL);
+
+    TRY_BEGIN()
+    {
+        parseData->callback(parseData->callbackData, parseData->depth, parseData->name, content);
+    }
+    CATCH_ANY()
+    {
+        parseData->errorType = errorType();
+        strCatZ(parseData->errorMessage, errorMessage());
+
+        xmlStopParser(parseData->parser);
+    }
+    TRY_END();
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+static void
+xmlParseElementBegin(
+    void *const data, const xmlChar *const name, const xmlChar *const prefix, const xmlChar *const uri, const int namespaceTotal,
+    const xmlChar **const namespaceList, const int attributeTotal, const int attributeDefaultTotal,
+    const xmlChar **const attributeList)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, data);
+        FUNCTION_TEST_PARAM(STRINGZ, (const char *)name);
+    FUNCTION_TEST_END();
+
+    ASSERT(data != NULL);
+    ASSERT(name != NULL);
+
+    (void)prefix;
+    (void)uri;
+    (void)namespaceTotal;
+    (void)namespaceList;
+    (void)attributeTotal;
+    (void)attributeDefaultTotal;
+    (void)attributeList;
+
+    XmlParseData *const parseData = data;
+
+    parseData->depth++;
+    strCatZ(strTrunc(parseData->name), (const char *)name);
+    strTrunc(parseData->content);
+
+    xmlParseCallback(parseData, NULL);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+static void
+xmlParseElementEnd(void *const data, const xmlChar *const name, const xmlChar *const prefix, const xmlChar *const uri)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, data);
+        FUNCTION_TEST_PARAM(STRINGZ, (const char *)name);
+    FUNCTION_TEST_END();
+
+    ASSERT(data != NULL);
+    ASSERT(name != NULL);
+
+    (void)prefix;
+    (void)uri;
+
+    XmlParseData *const parseData = data;
+
+    strCatZ(strTrunc(parseData->name), (const char *)name);
+    xmlParseCallback(parseData, parseData->content);
+
+    strTrunc(parseData->content);
+    parseData->depth--;
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+static void
+xmlParseCharacters(void *const data, const xmlChar *const content, const int size)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, data);
+        FUNCTION_TEST_PARAM_P(VOID, content);
+        FUNCTION_TEST_PARAM(INT, size);
+    FUNCTION_TEST_END();
+
+    ASSERT(data != NULL);
+    ASSERT(content != NULL);
+
+    strCatZN(((XmlParseData *)data)->content, (const char *)content, (size_t)size);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN void
+xmlParse(IoRead *const read, XmlParseCallback *const callback, void *const callbackData)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(IO_READ, read);
+        FUNCTION_TEST_PARAM(FUNCTIONP, callback);
+        FUNCTION_TEST_PARAM_P(VOID, callbackData);
+    FUNCTION_TEST_END();
+
+    ASSERT(read != NULL);
+    ASSERT(callback != NULL);
+
+    xmlInit();
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        XmlParseData data =
+        {
+            .callback = callback,
+            .callbackData = callbackData,
+            .name = strNew(),
+            .content = strNew(),
+            .errorMessage = strNew(),
+        };
+
+        xmlSAXHandler handler =
+        {
+            .initialized = XML_SAX2_MAGIC,
+            .startElementNs = xmlParseElementBegin,
+            .endElementNs = xmlParseElementEnd,
+            .characters = xmlParseCharacters,
+        };
+
+        xmlParserCtxtPtr const parser = xmlCreatePushParserCtxt(&handler, &data, NULL, 0, NULL);
+        Buffer *const buffer = bufNew(ioBufferSize());
+
+        data.parser = parser;
+
+        // Free the parser even if an error is thrown
+        TRY_BEGIN()
+        {
+            do
+            {
+                bufUsedZero(buffer);
+                ioRead(read, buffer);
+
+                const int parseResult = xmlParseChunk(
+                    parser, (const char *)bufPtrConst(buffer), (int)bufUsed(buffer), ioReadEof(read));
+
+                // Throw the error from the user callback, if any
+                if (data.errorType != NULL)
+                    THROWP(data.errorType, strZ(data.errorMessage));
+
+                if (parseResult != 0)
+                {
+                    const xmlError *const error = xmlCtxtGetLastError(parser);
+
+                    THROW_FMT(
+                        FormatError, "invalid xml: %s",
+                        error != NULL && error->message != NULL ? strZ(strTrim(strNewZ(error->message))) : "unknown error");
+                }
+            }
+            while (!ioReadEof(read));
+        }
+        FINALLY()
+        {
+            xmlFreeParserCtxt(parser);
+        }
+        TRY_END();
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN_VOID();
+}
@@ -15,6 +15,7 @@ typedef struct XmlDocument XmlDocument;
 typedef struct XmlNode XmlNode;
 typedef struct XmlNodeList XmlNodeList;
 
+#include "common/io/read.h"
 #include "common/memContext.h"
 #include "common/type/list.h"
 #include "common/type/object.h"
@@ -113,6 +114,18 @@ xmlNodeLstFree(XmlNodeList *const this)
     lstFree((List *const)this);
 }
 
+/***********************************************************************************************************************************
+Streaming Parser
+
+Parse a document as it is read without building a tree, so large documents such as object store list responses can be processed with
+little memory. The callback is called when an element begins (content is NULL) and when it ends (content is the text of the element).
+The text is only complete for elements that do not have child elements. The depth of the root element is 1.
+***********************************************************************************************************************************/
+typedef void XmlParseCallback(void *callbackData, unsigned int depth, const String *name, const String *content);
+
+// Parse a document from an open IoRead
+FN_EXTERN void xmlParse(IoRead *read, XmlParseCallback *callback, void *callbackData);
+
 /***********************************************************************************************************************************
 Macros for function logging
 ***********************************************************************************************************************************/
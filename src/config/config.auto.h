@@ -14,6 +14,7 @@ Command constants
 #define CFGCMD_ARCHIVE_PUSH                                         "archive-push"
 #define CFGCMD_BACKUP                                               "backup"
 #define CFGCMD_CHECK                                                "check"
+#define CFGCMD_COMPACT                                              "compact"
 #define CFGCMD_EXPIRE                                               "expire"
 #define CFGCMD_HELP                                                 "help"
 #define CFGCMD_INFO                                                 "info"
@@ -33,7 +34,7 @@ Command constants
 #define CFGCMD_VERIFY                                               "verify"
 #define CFGCMD_VERSION                                              "version"
 
-#define CFG_COMMAND_TOTAL                                           23
+#define CFG_COMMAND_TOTAL                                           24
 
 /***********************************************************************************************************************************
 Option group constants
@@ -48,11 +49,13 @@ Option constants
 #define CFGOPT_ARCHIVE_CHECK                                        "archive-check"
 #define CFGOPT_ARCHIVE_COPY                                         "archive-copy"
 #define CFGOPT_ARCHIVE_GET_QUEUE_MAX                                "archive-get-queue-max"
+#define CFGOPT_ARCHIVE_GET_RESIDENT                                 "archive-get-resident"
 #define CFGOPT_ARCHIVE_HEADER_CHECK                                 "archive-header-check"
 #define CFGOPT_ARCHIVE_MISSING_RETRY                                "archive-missing-retry"
 #define CFGOPT_ARCHIVE_MODE                                         "archive-mode"
 #define CFGOPT_ARCHIVE_MODE_CHECK                                   "archive-mode-check"
 #define CFGOPT_ARCHIVE_PUSH_QUEUE_MAX                               "archive-push-queue-max"
+#define CFGOPT_ARCHIVE_RECORD_CHECK                                 "archive-record-check"
 #define CFGOPT_ARCHIVE_TIMEOUT                                      "archive-timeout"
 #define CFGOPT_BACKUP_STANDBY                                       "backup-standby"
 #define CFGOPT_BETA                                                 "beta"
@@ -95,16 +98,22 @@ Option constants
 #define CFGOPT_LOG_SUBPROCESS                                       "log-subprocess"
 #define CFGOPT_LOG_TIMESTAMP                                        "log-timestamp"
 #define CFGOPT_MANIFEST_SAVE_THRESHOLD                              "manifest-save-threshold"
+#define CFGOPT_METRICS_FILE                                         "metrics-file"
+#define CFGOPT_MULTI_REPO                                           "multi-repo"
 #define CFGOPT_NEUTRAL_UMASK                                        "neutral-umask"
 #define CFGOPT_ONLINE                                               "online"
 #define CFGOPT_OUTPUT                                               "output"
 #define CFGOPT_PAGE_HEADER_CHECK                                    "page-header-check"
 #define CFGOPT_PG                                                   "pg"
 #define CFGOPT_PG_VERSION_FORCE                                     "pg-version-force"
+#define CFGOPT_PREALLOCATE                                          "preallocate"
 #define CFGOPT_PRIORITY                                             "priority"
 #define CFGOPT_PROCESS                                              "process"
 #define CFGOPT_PROCESS_MAX                                          "process-max"
+#define CFGOPT_PROCESS_MIN                                          "process-min"
 #define CFGOPT_PROTOCOL_TIMEOUT                                     "protocol-timeout"
+#define CFGOPT_RATE_LIMIT_PG                                        "rate-limit-pg"
+#define CFGOPT_RATE_LIMIT_REPO                                      "rate-limit-repo"
 #define CFGOPT_RAW                                                  "raw"
 #define CFGOPT_RECOVERY_OPTION                                      "recovery-option"
 #define CFGOPT_RECURSE                                              "recurse"
@@ -122,6 +131,8 @@ Option constants
 #define CFGOPT_STANZA                                               "stanza"
 #define CFGOPT_START_FAST                                           "start-fast"
 #define CFGOPT_STOP_AUTO                                            "stop-auto"
+#define CFGOPT_SYNC_DEFER                                           "sync-defer"
+#define CFGOPT_SYNTHETIC                                            "synthetic"
 #define CFGOPT_TABLESPACE_MAP                                       "tablespace-map"
 #define CFGOPT_TABLESPACE_MAP_ALL                                   "tablespace-map-all"
 #define CFGOPT_TARGET                                               "target"
@@ -137,11 +148,15 @@ Option constants
 #define CFGOPT_TLS_SERVER_CERT_FILE                                 "tls-server-cert-file"
 #define CFGOPT_TLS_SERVER_KEY_FILE                                  "tls-server-key-file"
 #define CFGOPT_TLS_SERVER_PORT                                      "tls-server-port"
+#define CFGOPT_TLS_SERVER_WORKER                                    "tls-server-worker"
 #define CFGOPT_TYPE                                                 "type"
 #define CFGOPT_VERBOSE                                              "verbose"
+#define CFGOPT_VERIFY_LEDGER                                        "verify-ledger"
+#define CFGOPT_VERIFY_SAMPLE                                        "verify-sample"
 #define CFGOPT_VERSION                                              "version"
+#define CFGOPT_WAL_CHANGE                                           "wal-change"
 
-#define CFG_OPTION_TOTAL                                            189
+#define CFG_OPTION_TOTAL                                            203
 
 /***********************************************************************************************************************************
 Option value constants
@@ -367,6 +382,7 @@ typedef enum
     cfgCmdArchivePush,
     cfgCmdBackup,
     cfgCmdCheck,
+    cfgCmdCompact,
     cfgCmdExpire,
     cfgCmdHelp,
     cfgCmdInfo,
@@ -406,11 +422,13 @@ typedef enum
     cfgOptArchiveCheck,
     cfgOptArchiveCopy,
     cfgOptArchiveGetQueueMax,
+    cfgOptArchiveGetResident,
     cfgOptArchiveHeaderCheck,
     cfgOptArchiveMissingRetry,
     cfgOptArchiveMode,
     cfgOptArchiveModeCheck,
     cfgOptArchivePushQueueMax,
+    cfgOptArchiveRecordCheck,
     cfgOptArchiveTimeout,
     cfgOptBackupStandby,
     cfgOptBeta,
@@ -453,6 +471,8 @@ typedef enum
     cfgOptLogSubprocess,
     cfgOptLogTimestamp,
     cfgOptManifestSaveThreshold,
+    cfgOptMetricsFile,
+    cfgOptMultiRepo,
     cfgOptNeutralUmask,
     cfgOptOnline,
     cfgOptOutput,
@@ -477,10 +497,14 @@ typedef enum
     cfgOptPgSocketPath,
     cfgOptPgUser,
     cfgOptPgVersionForce,
+    cfgOptPreallocate,
     cfgOptPriority,
     cfgOptProcess,
     cfgOptProcessMax,
+    cfgOptProcessMin,
     cfgOptProtocolTimeout,
+    cfgOptRateLimitPg,
+    cfgOptRateLimitRepo,
     cfgOptRaw,
     cfgOptRecoveryOption,
     cfgOptRecurse,
@@ -572,6 +596,8 @@ typedef enum
     cfgOptStanza,
     cfgOptStartFast,
     cfgOptStopAuto,
+    cfgOptSyncDefer,
+    cfgOptSynthetic,
     cfgOptTablespaceMap,
     cfgOptTablespaceMapAll,
     cfgOptTarget,
@@ -587,9 +613,13 @@ typedef enum
     cfgOptTlsServerCertFile,
     cfgOptTlsServerKeyFile,
     cfgOptTlsServerPort,
+    cfgOptTlsServerWorker,
     cfgOptType,
     cfgOptVerbose,
+    cfgOptVerifyLedger,
+    cfgOptVerifySample,
     cfgOptVersion,
+    cfgOptWalChange,
 } ConfigOption;
 
 #endif
@@ -541,67 +541,102 @@ dbList(Db *const this)
 }
 
 /**********************************************************************************************************************************/
-FN_EXTERN void
-dbReplayWait(Db *const this, const String *const targetLsn, const uint32_t targetTimeline, const TimeMSec timeout)
+struct DbReplayWait
+{
+    Db *db;                                                         // Standby db
+    const String *targetLsn;                                        // Lsn that replay must reach
+    uint32_t targetTimeline;                                        // Timeline the standby must be on
+    TimeMSec timeout;                                               // Timeout, reset when replay makes progress
+    Wait *wait;                                                     // Wait for replay or checkpoint
+    bool replayReached;                                             // Has replay reached the target lsn?
+    const String *replayLsnFunction;                                // Function to get the replay lsn
+    String *replayLsn;                                              // Last replay lsn
+    String *checkpointLsn;                                          // Last checkpoint lsn
+};
+
+FN_EXTERN DbReplayWait *
+dbReplayWaitNew(Db *const db, const String *const targetLsn, const uint32_t targetTimeline, const TimeMSec timeout)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
-        FUNCTION_LOG_PARAM(DB, this);
+        FUNCTION_LOG_PARAM(DB, db);
         FUNCTION_LOG_PARAM(STRING, targetLsn);
         FUNCTION_LOG_PARAM(UINT, targetTimeline);
         FUNCTION_LOG_PARAM(TIME_MSEC, timeout);
     FUNCTION_LOG_END();
 
-    ASSERT(this != NULL);
+    ASSERT(db != NULL);
     ASSERT(targetLsn != NULL);
     ASSERT(targetTimeline != 0);
     ASSERT(timeout > 0);
 
-    MEM_CONTEXT_TEMP_BEGIN()
+    // Standby checkpoint before the backup started must be <= the target LSN. If not, it indicates that the standby was ahead of
+    // the primary and cannot be following it.
+    if (dbPgControl(db).checkpoint > pgLsnFromStr(targetLsn))
+    {
+        THROW_FMT(
+            DbMismatchError, "standby checkpoint '%s' is ahead of target '%s'", strZ(pgLsnToStr(dbPgControl(db).checkpoint)),
+            strZ(targetLsn));
+    }
+
+    OBJ_NEW_BEGIN(DbReplayWait, .childQty = MEM_CONTEXT_QTY_MAX)
     {
-        // Standby checkpoint before the backup started must be <= the target LSN. If not, it indicates that the standby was ahead
-        // of the primary and cannot be following it.
-        if (dbPgControl(this).checkpoint > pgLsnFromStr(targetLsn))
+        *this = (DbReplayWait)
         {
-            THROW_FMT(
-                DbMismatchError, "standby checkpoint '%s' is ahead of target '%s'", strZ(pgLsnToStr(dbPgControl(this).checkpoint)),
-                strZ(targetLsn));
-        }
+            .db = db,
+            .targetLsn = strDup(targetLsn),
+            .targetTimeline = targetTimeline,
+            .timeout = timeout,
+            .wait = waitNew(timeout),
+            .replayLsnFunction = strNewFmt(
+                "pg_catalog.pg_last_%s_replay_%s()", strZ(pgWalName(dbPgVersion(db))), strZ(pgLsnName(dbPgVersion(db)))),
+        };
+    }
+    OBJ_NEW_END();
+
+    FUNCTION_LOG_RETURN(DB_REPLAY_WAIT, this);
+}
 
-        // Loop until lsn has been reached or timeout
-        Wait *wait = waitNew(timeout);
-        bool targetReached = false;
-        const char *const lsnName = strZ(pgLsnName(dbPgVersion(this)));
-        const String *const replayLsnFunction = strNewFmt(
-            "pg_catalog.pg_last_%s_replay_%s()", strZ(pgWalName(dbPgVersion(this))), lsnName);
-        const String *replayLsn = NULL;
+/**********************************************************************************************************************************/
+FN_EXTERN bool
+dbReplayWaitCheck(DbReplayWait *const this)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(DB_REPLAY_WAIT, this);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
 
-        do
+    bool result = false;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        if (!this->replayReached)
         {
             // Build the query
             String *const query = strCatFmt(
                 strNew(),
                 "select replayLsn::text,\n"
                 "       (replayLsn > '%s')::bool as targetReached",
-                strZ(targetLsn));
+                strZ(this->targetLsn));
 
-            if (replayLsn != NULL)
+            if (this->replayLsn != NULL)
             {
                 strCatFmt(
                     query,
                     ",\n"
                     "       (replayLsn > '%s')::bool as replayProgress",
-                    strZ(replayLsn));
+                    strZ(this->replayLsn));
             }
 
             strCatFmt(
                 query,
                 "\n"
                 "  from %s as replayLsn",
-                strZ(replayLsnFunction));
+                strZ(this->replayLsnFunction));
 
             // Execute the query and get replayLsn
-            PackRead *const read = dbQueryRow(this, query);
-            replayLsn = pckReadStrP(read);
+            PackRead *const read = dbQueryRow(this->db, query);
+            const String *const replayLsn = pckReadStrP(read);
 
             // Error when replayLsn is null which indicates that this is not a standby. This should have been sorted out before we
             // connected but it's possible that the standby was promoted in the meantime.
@@ -611,70 +646,135 @@ dbReplayWait(Db *const this, const String *const targetLsn, const uint32_t targe
                     ArchiveTimeoutError,
                     "unable to query replay lsn on the standby using '%s'\n"
                     "HINT: Is this a standby?",
-                    strZ(replayLsnFunction));
+                    strZ(this->replayLsnFunction));
             }
 
-            targetReached = pckReadBoolP(read);
+            this->replayReached = pckReadBoolP(read);
 
-            // If the target has not been reached but progress is being made then reset the timer
-            if (!targetReached && pckReadBoolP(read, .defaultValue = true))
-                wait = waitNew(timeout);
+            MEM_CONTEXT_OBJ_BEGIN(this)
+            {
+                strFree(this->replayLsn);
+                this->replayLsn = strDup(replayLsn);
 
-            protocolKeepAlive();
-        }
-        while (!targetReached && waitMore(wait));
+                // If the target has not been reached but progress is being made then reset the timer
+                if (!this->replayReached && pckReadBoolP(read, .defaultValue = true))
+                {
+                    waitFree(this->wait);
+                    this->wait = waitNew(this->timeout);
+                }
+            }
+            MEM_CONTEXT_OBJ_END();
 
-        // Error if a timeout occurred before the target lsn was reached
-        if (!targetReached)
-        {
-            THROW_FMT(
-                ArchiveTimeoutError,
-                "timeout before standby replayed to %s - only reached %s\n"
-                "HINT: is replication running and current on the standby?\n"
-                "HINT: disable the 'backup-standby' option to backup directly from the primary.",
-                strZ(targetLsn), strZ(replayLsn));
-        }
+            protocolKeepAlive();
 
-        // Perform a checkpoint
-        dbExec(this, STRDEF("checkpoint"));
+            // Perform a checkpoint and start waiting for the checkpoint to reach the target lsn
+            if (this->replayReached)
+            {
+                dbExec(this->db, STRDEF("checkpoint"));
 
-        // Loop until the checkpoint has reached the target lsn (or timeout)
-        wait = waitNew(timeout);
-        targetReached = false;
-        const String *checkpointLsn = NULL;
+                MEM_CONTEXT_OBJ_BEGIN(this)
+                {
+                    waitFree(this->wait);
+                    this->wait = waitNew(this->timeout);
+                }
+                MEM_CONTEXT_OBJ_END();
+            }
+        }
 
-        do
+        if (this->replayReached)
         {
             // Build the query
+            const char *const lsnName = strZ(pgLsnName(dbPgVersion(this->db)));
             const String *const query = strNewFmt(
                 "select (checkpoint_%s >= '%s')::bool as targetReached,\n"
                 "       checkpoint_%s::text as checkpointLsn\n"
                 "  from pg_catalog.pg_control_checkpoint()",
-                lsnName, strZ(targetLsn), lsnName);
+                lsnName, strZ(this->targetLsn), lsnName);
 
             // Execute the query and get checkpointLsn
-            PackRead *const read = dbQueryRow(this, query);
-            targetReached = pckReadBoolP(read);
-            checkpointLsn = pckReadStrP(read);
+            PackRead *const read = dbQueryRow(this->db, query);
+            result = pckReadBoolP(read);
+
+            MEM_CONTEXT_OBJ_BEGIN(this)
+            {
+                strFree(this->checkpointLsn);
+                this->checkpointLsn = pckReadStrP(read);
+            }
+            MEM_CONTEXT_OBJ_END();
 
             protocolKeepAlive();
+
+            if (result)
+            {
+                // Reload pg_control in case timeline was updated by the checkpoint
+                this->db->pub.pgControl = pgControlFromFile(this->db->storage, cfgOptionStrNull(cfgOptPgVersionForce));
+
+                // Check that the timeline matches the primary
+                if (dbPgControl(this->db).timeline != this->targetTimeline)
+                {
+                    THROW_FMT(
+                        DbMismatchError, "standby is on timeline %u but expected %u", dbPgControl(this->db).timeline,
+                        this->targetTimeline);
+                }
+            }
         }
-        while (!targetReached && waitMore(wait));
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN(BOOL, result);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN void
+dbReplayWaitMore(DbReplayWait *const this, const bool sleep)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(DB_REPLAY_WAIT, this);
+        FUNCTION_LOG_PARAM(BOOL, sleep);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
 
-        // Error if a timeout occurred before the target lsn was reached
-        if (!targetReached)
+    // Error if a timeout occurred before the target lsn was reached
+    if (!(sleep ? waitMore(this->wait) : waitRemains(this->wait) > 0))
+    {
+        if (!this->replayReached)
         {
             THROW_FMT(
-                ArchiveTimeoutError, "timeout before standby checkpoint lsn reached %s - only reached %s", strZ(targetLsn),
-                strZ(checkpointLsn));
+                ArchiveTimeoutError,
+                "timeout before standby replayed to %s - only reached %s\n"
+                "HINT: is replication running and current on the standby?\n"
+                "HINT: disable the 'backup-standby' option to backup directly from the primary.",
+                strZ(this->targetLsn), strZ(this->replayLsn));
         }
 
-        // Reload pg_control in case timeline was updated by the checkpoint
-        this->pub.pgControl = pgControlFromFile(this->storage, cfgOptionStrNull(cfgOptPgVersionForce));
+        THROW_FMT(
+            ArchiveTimeoutError, "timeout before standby checkpoint lsn reached %s - only reached %s", strZ(this->targetLsn),
+            strZ(this->checkpointLsn));
+    }
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN void
+dbReplayWait(Db *const this, const String *const targetLsn, const uint32_t targetTimeline, const TimeMSec timeout)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(DB, this);
+        FUNCTION_LOG_PARAM(STRING, targetLsn);
+        FUNCTION_LOG_PARAM(UINT, targetTimeline);
+        FUNCTION_LOG_PARAM(TIME_MSEC, timeout);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        DbReplayWait *const replayWait = dbReplayWaitNew(this, targetLsn, targetTimeline, timeout);
 
-        // Check that the timeline matches the primary
-        if (dbPgControl(this).timeline != targetTimeline)
-            THROW_FMT(DbMismatchError, "standby is on timeline %u but expected %u", dbPgControl(this).timeline, targetTimeline);
+        while (!dbReplayWaitCheck(replayWait))
+            dbReplayWaitMore(replayWait, true);
     }
     MEM_CONTEXT_TEMP_END();
 
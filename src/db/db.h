@@ -128,6 +128,19 @@ FN_EXTERN Pack *dbList(Db *this);
 // Waits for replay on the standby to equal the target LSN
 FN_EXTERN void dbReplayWait(Db *this, const String *targetLsn, uint32_t targetTimeline, TimeMSec timeout);
 
+// Wait for replay on a standby one check at a time so waits on multiple standbys can be interleaved. Call dbReplayWaitCheck() on
+// each standby and then dbReplayWaitMore() on each standby that is not done before checking again. Only one standby needs to sleep
+// per round since the others are checked right after it.
+typedef struct DbReplayWait DbReplayWait;
+
+FN_EXTERN DbReplayWait *dbReplayWaitNew(Db *db, const String *targetLsn, uint32_t targetTimeline, TimeMSec timeout);
+
+// Check replay once without waiting. Returns true when replay and the checkpoint on the standby have reached the target lsn.
+FN_EXTERN bool dbReplayWaitCheck(DbReplayWait *this);
+
+// Sleep (if requested) before the next check and error when the timeout has expired
+FN_EXTERN void dbReplayWaitMore(DbReplayWait *this, bool sleep);
+
 // Check that the cluster is alive and correctly configured during the backup
 FN_EXTERN void dbPing(Db *this, bool force);
 
@@ -165,5 +178,9 @@ FN_EXTERN void dbToLog(const Db *this, StringStatic *debugLog);
     Db *
 #define FUNCTION_LOG_DB_FORMAT(value, buffer, bufferSize)                                                                          \
     FUNCTION_LOG_OBJECT_FORMAT(value, dbToLog, buffer, bufferSize)
+#define FUNCTION_LOG_DB_REPLAY_WAIT_TYPE                                                                                           \
+    DbReplayWait *
+#define FUNCTION_LOG_DB_REPLAY_WAIT_FORMAT(value, buffer, bufferSize)                                                              \
+    objNameToLog(value, "DbReplayWait", buffer, bufferSize)
 
 #endif
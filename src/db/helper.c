@@ -48,22 +48,26 @@ dbGetIdx(const unsigned int pgIdx)
 }
 
 FN_EXTERN DbGetResult
-dbGet(const bool primaryOnly, const bool primaryRequired, const StringId standbyRequired)
+dbGet(const bool primaryOnly, const bool primaryRequired, const StringId standbyRequired, const bool standbyAll)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(BOOL, primaryOnly);
         FUNCTION_LOG_PARAM(BOOL, primaryRequired);
         FUNCTION_LOG_PARAM(STRING_ID, standbyRequired);
+        FUNCTION_LOG_PARAM(BOOL, standbyAll);
     FUNCTION_LOG_END();
 
     FUNCTION_AUDIT_STRUCT();
 
     ASSERT(!(primaryOnly && standbyRequired == CFGOPTVAL_BACKUP_STANDBY_Y));
+    ASSERT(!(primaryOnly && standbyAll));
 
     DbGetResult result = {0};
 
     MEM_CONTEXT_TEMP_BEGIN()
     {
+        List *const standbyList = standbyAll ? lstNewP(sizeof(DbGetResultStandby)) : NULL;
+
         // Loop through to look for primary and standby (if required)
         for (unsigned int pgIdx = 0; pgIdx < cfgOptionGroupIdxTotal(cfgOptGrpPg); pgIdx++)
         {
@@ -109,9 +113,12 @@ dbGet(const bool primaryOnly, const bool primaryRequired, const StringId standby
                         result.standbyIdx = pgIdx;
                         result.standby = db;
                     }
-                    // Else close the connection since we don't need it
-                    else
+                    // Else close the connection since we don't need it (unless all standbys were requested)
+                    else if (!standbyAll)
                         dbFree(db);
+
+                    if (standbyAll)
+                        lstAdd(standbyList, &(DbGetResultStandby){.idx = pgIdx, .db = db});
                 }
                 // Else is a primary
                 else
@@ -140,7 +147,16 @@ dbGet(const bool primaryOnly, const bool primaryRequired, const StringId standby
             THROW(DbConnectError, "unable to find standby cluster - cannot proceed");
 
         dbMove(result.primary, memContextPrior());
-        dbMove(result.standby, memContextPrior());
+
+        if (standbyAll)
+        {
+            for (unsigned int standbyIdx = 0; standbyIdx < lstSize(standbyList); standbyIdx++)
+                dbMove(((DbGetResultStandby *)lstGet(standbyList, standbyIdx))->db, memContextPrior());
+
+            result.standbyList = lstMove(standbyList, memContextPrior());
+        }
+        else
+            dbMove(result.standby, memContextPrior());
     }
     MEM_CONTEXT_TEMP_END();
 
@@ -8,21 +8,30 @@ Helper functions for getting connections to PostgreSQL.
 
 #include <stdbool.h>
 
+#include "common/type/list.h"
 #include "db/db.h"
 
 /***********************************************************************************************************************************
 Functions
 ***********************************************************************************************************************************/
-// Get specified cluster(s)
+// Get specified cluster(s). When standbyAll is set then all standbys found are returned in standbyList, otherwise only the first
+// standby is kept and standbyList is NULL.
+typedef struct DbGetResultStandby
+{
+    unsigned int idx;                                               // cfgOptGrpPg index of the standby
+    Db *db;                                                         // Standby db object
+} DbGetResultStandby;
+
 typedef struct DbGetResult
 {
     unsigned int primaryIdx;                                        // cfgOptGrpPg index of the primary
     Db *primary;                                                    // Primary db object (NULL if none requested)
     unsigned int standbyIdx;                                        // cfgOptGrpPg index of the standby
     Db *standby;                                                    // Standby db object (NULL if none requested)
+    List *standbyList;                                              // All standbys, first is standby (DbGetResultStandby)
 } DbGetResult;
 
-FN_EXTERN DbGetResult dbGet(bool primaryOnly, bool primaryRequired, StringId standbyRequired);
+FN_EXTERN DbGetResult dbGet(bool primaryOnly, bool primaryRequired, StringId standbyRequired, bool standbyAll);
 
 /***********************************************************************************************************************************
 Macros for function logging
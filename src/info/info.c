@@ -32,6 +32,7 @@ struct InfoSave
     MemContext *memContext;                                         // Mem context
     IoWrite *write;                                                 // Write object
     IoFilter *checksum;                                             // hash to generate file checksum
+    JsonWrite *keyJson;                                             // Reusable JSON writer for checksum keys
     String *sectionLast;                                            // The last section seen
 };
 
@@ -67,10 +68,10 @@ BUFFER_STRDEF_STATIC(INFO_CHECKSUM_SECTION_NEXT_END_BUF, "},");
 
 BUFFER_STRDEF_STATIC(INFO_CHECKSUM_KEY_VALUE_END_BUF, ":");
 
-#define INFO_CHECKSUM_KEY_VALUE(checksum, key, value)                                                                              \
+#define INFO_CHECKSUM_KEY_VALUE(checksum, keyJson, key, value)                                                                     \
     do                                                                                                                             \
     {                                                                                                                              \
-        ioFilterProcessIn(checksum, BUFSTR(jsonFromVar(VARSTR(key))));                                                             \
+        ioFilterProcessIn(checksum, BUFSTR(jsonWriteResult(jsonWriteStr(jsonWriteReset(keyJson), key))));                         \
         ioFilterProcessIn(checksum, INFO_CHECKSUM_KEY_VALUE_END_BUF);                                                              \
         ioFilterProcessIn(checksum, BUFSTR(value));                                                                                \
     }                                                                                                                              \
@@ -143,6 +144,7 @@ infoNewLoad(IoRead *const read, InfoLoadNewCallback *const callbackFunction, voi
             String *const sectionLast = strNew();                               // The last section seen during load
             IoFilter *const checksumActualFilter = cryptoHashNew(hashTypeSha1); // Checksum calculated from the file
             const String *checksumExpected = NULL;                              // Checksum found in ini file
+            JsonWrite *const keyJson = jsonWriteNewP();                         // Reusable JSON writer for checksum keys
 
             INFO_CHECKSUM_BEGIN(checksumActualFilter);
 
@@ -170,7 +172,7 @@ infoNewLoad(IoRead *const read, InfoLoadNewCallback *const callbackFunction, voi
                             else
                                 INFO_CHECKSUM_KEY_VALUE_NEXT(checksumActualFilter);
 
-                            INFO_CHECKSUM_KEY_VALUE(checksumActualFilter, value->key, value->value);
+                            INFO_CHECKSUM_KEY_VALUE(checksumActualFilter, keyJson, value->key, value->value);
                         }
 
                         // Process backrest section
@@ -321,7 +323,7 @@ infoSaveValue(InfoSave *const infoSaveData, const char *const section, const cha
         INFO_CHECKSUM_KEY_VALUE_NEXT(infoSaveData->checksum);
 
     // Save key/value
-    INFO_CHECKSUM_KEY_VALUE(infoSaveData->checksum, STR(key), jsonValue);
+    INFO_CHECKSUM_KEY_VALUE(infoSaveData->checksum, infoSaveData->keyJson, STR(key), jsonValue);
 
     ioWrite(infoSaveData->write, BUFSTRZ(key));
     ioWrite(infoSaveData->write, EQ_BUF);
@@ -352,6 +354,7 @@ infoSave(Info *const this, IoWrite *const write, InfoSaveCallback *const callbac
         {
             .memContext = MEM_CONTEXT_TEMP(),
             .write = write,
+            .keyJson = jsonWriteNewP(),
         };
 
         ioWriteOpen(data.write);
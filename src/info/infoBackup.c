@@ -572,6 +572,30 @@ infoBackupDataAnnotationSet(InfoBackup *const this, const String *const backupLa
     FUNCTION_TEST_RETURN_VOID();
 }
 
+/**********************************************************************************************************************************/
+FN_EXTERN void
+infoBackupDataDeltaAdd(InfoBackup *const this, const String *const backupLabel, const uint64_t size, const uint64_t sizeRepo)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(INFO_BACKUP, this);
+        FUNCTION_TEST_PARAM(STRING, backupLabel);
+        FUNCTION_TEST_PARAM(UINT64, size);
+        FUNCTION_TEST_PARAM(UINT64, sizeRepo);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(infoBackupLabelExists(this, backupLabel));
+
+    InfoBackupData *const infoBackupData = lstFind(this->pub.backup, &backupLabel);
+
+    infoBackupData->backupInfoSizeDelta += size;
+    infoBackupData->backupInfoRepoSizeDelta += sizeRepo;
+
+    this->pub.updated = true;
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN void
 infoBackupDataDelete(InfoBackup *const this, const String *const backupDeleteLabel)
@@ -144,6 +144,9 @@ FN_EXTERN void infoBackupDataAdd(InfoBackup *this, const Manifest *manifest);
 // Set Annotation in the backup data for a specific backup label
 FN_EXTERN void infoBackupDataAnnotationSet(InfoBackup *this, const String *const backupLabel, const KeyValue *annotationKv);
 
+// Add to the delta sizes of a backup when files referenced from prior backups have been copied into it
+FN_EXTERN void infoBackupDataDeltaAdd(InfoBackup *this, const String *backupLabel, uint64_t size, uint64_t sizeRepo);
+
 // Delete backup from the current backup list
 FN_EXTERN void infoBackupDataDelete(InfoBackup *this, const String *backupDeleteLabel);
 
@@ -185,13 +185,11 @@ manifestFilePack(const Manifest *const manifest, const ManifestFile *const file)
 
     cvtUInt64ToVarInt128(flag, buffer, &bufferPos, sizeof(buffer));
 
+    // Key fields are packed first so they can be unpacked without unpacking the rest of the file. See manifestFileUnpackKey().
+    // -----------------------------------------------------------------------------------------------------------------------------
     // Size
     cvtUInt64ToVarInt128(file->size, buffer, &bufferPos, sizeof(buffer));
 
-    // Original size
-    if (flag & (1 << manifestFilePackFlagSizeOriginal))
-        cvtUInt64ToVarInt128(file->sizeOriginal, buffer, &bufferPos, sizeof(buffer));
-
     // Use the first timestamp that appears as the base for all other timestamps. Ideally we would like a timestamp as close to the
     // middle as possible but it doesn't seem worth doing the calculation.
     if (manifestPackBaseTime == -1)
@@ -200,6 +198,26 @@ manifestFilePack(const Manifest *const manifest, const ManifestFile *const file)
     // Timestamp
     cvtUInt64ToVarInt128(cvtInt64ToZigZag(manifestPackBaseTime - file->timestamp), buffer, &bufferPos, sizeof(buffer));
 
+    // Bundle
+    if (flag & (1 << manifestFilePackFlagBundle))
+    {
+        cvtUInt64ToVarInt128(file->bundleId, buffer, &bufferPos, sizeof(buffer));
+        cvtUInt64ToVarInt128(file->bundleOffset, buffer, &bufferPos, sizeof(buffer));
+    }
+
+    // Reference
+    if (file->reference != NULL)
+    {
+        cvtUInt64ToVarInt128(
+            strLstFindIdxP(manifest->pub.referenceList, file->reference, .required = true), buffer, &bufferPos, sizeof(buffer));
+    }
+
+    // Remaining fields
+    // -----------------------------------------------------------------------------------------------------------------------------
+    // Original size
+    if (flag & (1 << manifestFilePackFlagSizeOriginal))
+        cvtUInt64ToVarInt128(file->sizeOriginal, buffer, &bufferPos, sizeof(buffer));
+
     // SHA1 checksum
     if (file->checksumSha1 != NULL)
     {
@@ -214,13 +232,6 @@ manifestFilePack(const Manifest *const manifest, const ManifestFile *const file)
         bufferPos += HASH_TYPE_SHA1_SIZE;
     }
 
-    // Reference
-    if (file->reference != NULL)
-    {
-        cvtUInt64ToVarInt128(
-            strLstFindIdxP(manifest->pub.referenceList, file->reference, .required = true), buffer, &bufferPos, sizeof(buffer));
-    }
-
     // Mode
     if (flag & (1 << manifestFilePackFlagMode))
         cvtUInt64ToVarInt128(file->mode, buffer, &bufferPos, sizeof(buffer));
@@ -235,13 +246,6 @@ manifestFilePack(const Manifest *const manifest, const ManifestFile *const file)
     // Repo size
     cvtUInt64ToVarInt128(file->sizeRepo, buffer, &bufferPos, sizeof(buffer));
 
-    // Bundle
-    if (flag & (1 << manifestFilePackFlagBundle))
-    {
-        cvtUInt64ToVarInt128(file->bundleId, buffer, &bufferPos, sizeof(buffer));
-        cvtUInt64ToVarInt128(file->bundleOffset, buffer, &bufferPos, sizeof(buffer));
-    }
-
     // Block incremental
     if (flag & (1 << manifestFilePackFlagBlockIncr))
     {
@@ -288,33 +292,98 @@ manifestFilePack(const Manifest *const manifest, const ManifestFile *const file)
     FUNCTION_TEST_RETURN_TYPE_P(ManifestFilePack, (ManifestFilePack *)result);
 }
 
-FN_EXTERN ManifestFile
-manifestFileUnpack(const Manifest *const manifest, const ManifestFilePack *const filePack)
+// Unpack key fields and return the position of the remaining fields
+static ManifestFileKey
+manifestFileUnpackKeyInternal(
+    const Manifest *const manifest, const ManifestFilePack *const filePack, uint64_t *const flag, size_t *const bufferPos)
 {
     FUNCTION_TEST_BEGIN();
         FUNCTION_TEST_PARAM(MANIFEST, manifest);
         FUNCTION_TEST_PARAM_P(VOID, filePack);
+        FUNCTION_TEST_PARAM_P(UINT64, flag);
+        FUNCTION_TEST_PARAM_P(SIZE, bufferPos);
     FUNCTION_TEST_END();
 
     ASSERT(filePack != NULL);
+    ASSERT(flag != NULL);
+    ASSERT(bufferPos != NULL);
     ASSERT(manifestPackBaseTime != -1);
 
-    ManifestFile result = {0};
-    size_t bufferPos = 0;
+    ManifestFileKey result = {0};
 
     // Name
     result.name = (const String *)filePack;
-    bufferPos += sizeof(StringPub) + strSize(result.name) + 1;
+    *bufferPos = sizeof(StringPub) + strSize(result.name) + 1;
 
     // Flags
-    const uint64_t flag = cvtUInt64FromVarInt128((const uint8_t *)filePack, &bufferPos, UINT_MAX);
-
-    result.copy = (flag >> manifestFilePackFlagCopy) & 1;
-    result.delta = (flag >> manifestFilePackFlagDelta) & 1;
-    result.resume = (flag >> manifestFilePackFlagResume) & 1;
+    *flag = cvtUInt64FromVarInt128((const uint8_t *)filePack, bufferPos, UINT_MAX);
 
     // Size
-    result.size = cvtUInt64FromVarInt128((const uint8_t *)filePack, &bufferPos, UINT_MAX);
+    result.size = cvtUInt64FromVarInt128((const uint8_t *)filePack, bufferPos, UINT_MAX);
+
+    // Timestamp
+    result.timestamp =
+        manifestPackBaseTime - (time_t)cvtInt64FromZigZag(cvtUInt64FromVarInt128((const uint8_t *)filePack, bufferPos, UINT_MAX));
+
+    // Bundle
+    if (*flag & (1 << manifestFilePackFlagBundle))
+    {
+        result.bundleId = cvtUInt64FromVarInt128((const uint8_t *)filePack, bufferPos, UINT_MAX);
+        result.bundleOffset = cvtUInt64FromVarInt128((const uint8_t *)filePack, bufferPos, UINT_MAX);
+    }
+
+    // Reference
+    if (*flag & (1 << manifestFilePackFlagReference))
+    {
+        result.reference = strLstGet(
+            manifest->pub.referenceList, (unsigned int)cvtUInt64FromVarInt128((const uint8_t *)filePack, bufferPos, UINT_MAX));
+    }
+
+    FUNCTION_TEST_RETURN_TYPE(ManifestFileKey, result);
+}
+
+FN_EXTERN ManifestFileKey
+manifestFileUnpackKey(const Manifest *const manifest, const ManifestFilePack *const filePack)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(MANIFEST, manifest);
+        FUNCTION_TEST_PARAM_P(VOID, filePack);
+    FUNCTION_TEST_END();
+
+    uint64_t flag;
+    size_t bufferPos;
+
+    FUNCTION_TEST_RETURN_TYPE(ManifestFileKey, manifestFileUnpackKeyInternal(manifest, filePack, &flag, &bufferPos));
+}
+
+FN_EXTERN ManifestFile
+manifestFileUnpack(const Manifest *const manifest, const ManifestFilePack *const filePack)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(MANIFEST, manifest);
+        FUNCTION_TEST_PARAM_P(VOID, filePack);
+    FUNCTION_TEST_END();
+
+    ASSERT(filePack != NULL);
+
+    // Key fields
+    uint64_t flag;
+    size_t bufferPos;
+    const ManifestFileKey key = manifestFileUnpackKeyInternal(manifest, filePack, &flag, &bufferPos);
+
+    ManifestFile result =
+    {
+        .name = key.name,
+        .size = key.size,
+        .timestamp = key.timestamp,
+        .bundleId = key.bundleId,
+        .bundleOffset = key.bundleOffset,
+        .reference = key.reference,
+        .copy = (flag >> manifestFilePackFlagCopy) & 1,
+        .delta = (flag >> manifestFilePackFlagDelta) & 1,
+        .resume = (flag >> manifestFilePackFlagResume) & 1,
+        .checksumPage = (flag >> manifestFilePackFlagChecksumPage) & 1,
+    };
 
     // Original size
     if (flag & (1 << manifestFilePackFlagSizeOriginal))
@@ -322,13 +391,6 @@ manifestFileUnpack(const Manifest *const manifest, const ManifestFilePack *const
     else
         result.sizeOriginal = result.size;
 
-    // Timestamp
-    result.timestamp =
-        manifestPackBaseTime - (time_t)cvtInt64FromZigZag(cvtUInt64FromVarInt128((const uint8_t *)filePack, &bufferPos, UINT_MAX));
-
-    // Checksum page
-    result.checksumPage = (flag >> manifestFilePackFlagChecksumPage) & 1;
-
     // SHA1 checksum
     if (flag & (1 << manifestFilePackFlagChecksum))
     {
@@ -343,13 +405,6 @@ manifestFileUnpack(const Manifest *const manifest, const ManifestFilePack *const
         bufferPos += HASH_TYPE_SHA1_SIZE;
     }
 
-    // Reference
-    if (flag & (1 << manifestFilePackFlagReference))
-    {
-        result.reference = strLstGet(
-            manifest->pub.referenceList, (unsigned int)cvtUInt64FromVarInt128((const uint8_t *)filePack, &bufferPos, UINT_MAX));
-    }
-
     // Mode
     if (flag & (1 << manifestFilePackFlagMode))
         result.mode = (mode_t)cvtUInt64FromVarInt128((const uint8_t *)filePack, &bufferPos, UINT_MAX);
@@ -370,13 +425,6 @@ manifestFileUnpack(const Manifest *const manifest, const ManifestFilePack *const
     // Repo size
     result.sizeRepo = cvtUInt64FromVarInt128((const uint8_t *)filePack, &bufferPos, UINT_MAX);
 
-    // Bundle
-    if (flag & (1 << manifestFilePackFlagBundle))
-    {
-        result.bundleId = cvtUInt64FromVarInt128((const uint8_t *)filePack, &bufferPos, UINT_MAX);
-        result.bundleOffset = cvtUInt64FromVarInt128((const uint8_t *)filePack, &bufferPos, UINT_MAX);
-    }
-
     // Block incremental
     if (flag & (1 << manifestFilePackFlagBlockIncr))
     {
@@ -1628,13 +1676,15 @@ manifestDeltaCheck(Manifest *const this, const Manifest *const manifestPrior)
 /**********************************************************************************************************************************/
 FN_EXTERN void
 manifestBuildIncr(
-    Manifest *const this, const Manifest *const manifestPrior, const BackupType type, const String *const archiveStart)
+    Manifest *const this, const Manifest *const manifestPrior, const BackupType type, const String *const archiveStart,
+    const StringList *const fileSameList)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(MANIFEST, this);
         FUNCTION_LOG_PARAM(MANIFEST, manifestPrior);
         FUNCTION_LOG_PARAM(STRING_ID, type);
         FUNCTION_LOG_PARAM(STRING, archiveStart);
+        FUNCTION_LOG_PARAM(STRING_LIST, fileSameList);
     FUNCTION_LOG_END();
 
     ASSERT(this != NULL);
@@ -1725,6 +1775,12 @@ manifestBuildIncr(
                 if (!file.delta && fileSizeEqual && file.timestamp == filePrior.timestamp)
                     file.copy = false;
 
+                // If the file is known to be unchanged since the prior backup and size is equal then the file is not copied,
+                // regardless of timestamp. This is skipped when delta is enabled so files are still checked when timestamps cannot
+                // be trusted.
+                if (!file.delta && fileSizeEqual && fileSameList != NULL && strLstExists(fileSameList, file.name))
+                    file.copy = false;
+
                 ASSERT(file.copy || !file.delta);
                 ASSERT(file.copy || fileSizeEqual);
                 ASSERT(!file.delta || fileSizeEqual);
@@ -1770,6 +1826,50 @@ manifestBuildIncr(
     FUNCTION_LOG_RETURN_VOID();
 }
 
+/***********************************************************************************************************************************
+Set annotations, skipping empty values
+***********************************************************************************************************************************/
+static void
+manifestAnnotationSet(Manifest *const this, const KeyValue *const annotation)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(MANIFEST, this);
+        FUNCTION_TEST_PARAM(KEY_VALUE, annotation);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    this->pub.data.annotation = NULL;
+
+    if (annotation != NULL)
+    {
+        MEM_CONTEXT_BEGIN(this->pub.memContext)
+        {
+            this->pub.data.annotation = varNewKv(kvNew());
+
+            KeyValue *const manifestAnnotationKv = varKv(this->pub.data.annotation);
+            const VariantList *const annotationKeyList = kvKeyList(annotation);
+
+            for (unsigned int keyIdx = 0; keyIdx < varLstSize(annotationKeyList); keyIdx++)
+            {
+                const Variant *const key = varLstGet(annotationKeyList, keyIdx);
+                const Variant *const value = kvGet(annotation, key);
+
+                // Skip empty values
+                if (!strEmpty(varStr(value)))
+                    kvPut(manifestAnnotationKv, key, value);
+            }
+
+            // Clean field if there are no annotations to save
+            if (varLstSize(kvKeyList(manifestAnnotationKv)) == 0)
+                this->pub.data.annotation = NULL;
+        }
+        MEM_CONTEXT_END();
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN void
 manifestBuildComplete(
@@ -1832,29 +1932,6 @@ manifestBuildComplete(
             lstSort(this->pub.dbList, sortOrderAsc);
         }
 
-        // Save annotations
-        if (annotation != NULL)
-        {
-            this->pub.data.annotation = varNewKv(kvNew());
-
-            KeyValue *const manifestAnnotationKv = varKv(this->pub.data.annotation);
-            const VariantList *const annotationKeyList = kvKeyList(annotation);
-
-            for (unsigned int keyIdx = 0; keyIdx < varLstSize(annotationKeyList); keyIdx++)
-            {
-                const Variant *const key = varLstGet(annotationKeyList, keyIdx);
-                const Variant *const value = kvGet(annotation, key);
-
-                // Skip empty values
-                if (!strEmpty(varStr(value)))
-                    kvPut(manifestAnnotationKv, key, value);
-            }
-
-            // Clean field if there are no annotations to save
-            if (varLstSize(kvKeyList(manifestAnnotationKv)) == 0)
-                this->pub.data.annotation = NULL;
-        }
-
         // Save options
         this->pub.data.backupOptionArchiveCheck = optionArchiveCheck;
         this->pub.data.backupOptionArchiveCopy = optionArchiveCopy;
@@ -1867,6 +1944,9 @@ manifestBuildComplete(
     }
     MEM_CONTEXT_END();
 
+    // Save annotations
+    manifestAnnotationSet(this, annotation);
+
     FUNCTION_LOG_RETURN_VOID();
 }
 
@@ -2522,6 +2602,21 @@ manifestOwnerVar(const String *const ownerDefault)
     FUNCTION_TEST_RETURN_CONST(VARIANT, ownerDefault == NULL ? BOOL_FALSE_VAR : varNewStr(ownerDefault));
 }
 
+// Is the owner equal to the default? This avoids creating a variant for each file just to compare.
+static bool
+manifestOwnerDefault(const String *const owner, const Variant *const ownerDefault)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING, owner);
+        FUNCTION_TEST_PARAM(VARIANT, ownerDefault);
+    FUNCTION_TEST_END();
+
+    if (owner == NULL)
+        FUNCTION_TEST_RETURN(BOOL, varType(ownerDefault) == varTypeBool);
+
+    FUNCTION_TEST_RETURN(BOOL, varType(ownerDefault) == varTypeString && strEq(owner, varStr(ownerDefault)));
+}
+
 static void
 manifestSaveCallback(void *const callbackData, const String *const sectionNext, InfoSave *const infoSaveData)
 {
@@ -2782,12 +2877,16 @@ manifestSaveCallback(void *const callbackData, const String *const sectionNext,
     // -----------------------------------------------------------------------------------------------------------------------------
     if (infoSaveSection(infoSaveData, MANIFEST_SECTION_TARGET_FILE, sectionNext))
     {
+        // Reuse the JSON writer and checksum buffer for each file to avoid allocations
+        JsonWrite *const json = jsonWriteNewP();
+        char checksum[HASH_TYPE_SHA1_SIZE_HEX + 1];
+
         MEM_CONTEXT_TEMP_RESET_BEGIN()
         {
             for (unsigned int fileIdx = 0; fileIdx < manifestFileTotal(manifest); fileIdx++)
             {
                 const ManifestFile file = manifestFile(manifest, fileIdx);
-                JsonWrite *const json = jsonWriteObjectBegin(jsonWriteNewP());
+                jsonWriteObjectBegin(jsonWriteReset(json));
 
                 // Block incremental info
                 if (file.blockIncrSize != 0)
@@ -2814,9 +2913,8 @@ manifestSaveCallback(void *const callbackData, const String *const sectionNext,
                 // performed during a backup.
                 if (file.size != 0 && file.checksumSha1 != NULL)
                 {
-                    jsonWriteStr(
-                        jsonWriteKeyStrId(json, MANIFEST_KEY_CHECKSUM),
-                        strNewEncode(encodingHex, BUF(file.checksumSha1, HASH_TYPE_SHA1_SIZE)));
+                    encodeToStr(encodingHex, file.checksumSha1, HASH_TYPE_SHA1_SIZE, checksum);
+                    jsonWriteZ(jsonWriteKeyStrId(json, MANIFEST_KEY_CHECKSUM), checksum);
                 }
 
                 if (file.checksumPage)
@@ -2827,7 +2925,7 @@ manifestSaveCallback(void *const callbackData, const String *const sectionNext,
                         jsonWriteJson(jsonWriteKeyZ(json, MANIFEST_KEY_CHECKSUM_PAGE_ERROR), file.checksumPageErrorList);
                 }
 
-                if (!varEq(manifestOwnerVar(file.group), saveData->groupDefault))
+                if (!manifestOwnerDefault(file.group, saveData->groupDefault))
                     jsonWriteVar(jsonWriteKeyZ(json, MANIFEST_KEY_GROUP), manifestOwnerVar(file.group));
 
                 if (file.mode != saveData->fileModeDefault)
@@ -2837,9 +2935,8 @@ manifestSaveCallback(void *const callbackData, const String *const sectionNext,
                 // and encryption applied.
                 if (file.checksumRepoSha1 != NULL)
                 {
-                    jsonWriteStr(
-                        jsonWriteKeyStrId(json, MANIFEST_KEY_CHECKSUM_REPO),
-                        strNewEncode(encodingHex, BUF(file.checksumRepoSha1, HASH_TYPE_SHA1_SIZE)));
+                    encodeToStr(encodingHex, file.checksumRepoSha1, HASH_TYPE_SHA1_SIZE, checksum);
+                    jsonWriteZ(jsonWriteKeyStrId(json, MANIFEST_KEY_CHECKSUM_REPO), checksum);
                 }
 
                 if (file.reference != NULL)
@@ -2855,7 +2952,7 @@ manifestSaveCallback(void *const callbackData, const String *const sectionNext,
 
                 jsonWriteUInt64(jsonWriteKeyStrId(json, MANIFEST_KEY_TIMESTAMP), (uint64_t)file.timestamp);
 
-                if (!varEq(manifestOwnerVar(file.user), saveData->userDefault))
+                if (!manifestOwnerDefault(file.user, saveData->userDefault))
                     jsonWriteVar(jsonWriteKeyZ(json, MANIFEST_KEY_USER), manifestOwnerVar(file.user));
 
                 infoSaveValue(
@@ -3363,6 +3460,43 @@ manifestBackupLabelSet(Manifest *const this, const String *const backupLabel)
     FUNCTION_TEST_RETURN_VOID();
 }
 
+/**********************************************************************************************************************************/
+FN_EXTERN void
+manifestBackupFullSet(Manifest *const this, const String *const backupLabel, const KeyValue *const annotation)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(MANIFEST, this);
+        FUNCTION_TEST_PARAM(STRING, backupLabel);
+        FUNCTION_TEST_PARAM(KEY_VALUE, annotation);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(backupLabel != NULL);
+
+#ifdef DEBUG
+    // All files must be stored in the new backup
+    for (unsigned int fileIdx = 0; fileIdx < manifestFileTotal(this); fileIdx++)
+        ASSERT(manifestFile(this, fileIdx).reference == NULL);
+#endif
+
+    MEM_CONTEXT_BEGIN(this->pub.memContext)
+    {
+        this->pub.data.backrestVersion = strNewZ(PROJECT_VERSION);
+        this->pub.data.backupLabel = strDup(backupLabel);
+        this->pub.data.backupLabelPrior = NULL;
+        this->pub.data.backupType = backupTypeFull;
+
+        strLstFree(this->pub.referenceList);
+        this->pub.referenceList = strLstNew();
+        strLstAdd(this->pub.referenceList, backupLabel);
+    }
+    MEM_CONTEXT_END();
+
+    manifestAnnotationSet(this, annotation);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 /**********************************************************************************************************************************/
 typedef struct ManifestLoadFileData
 {
@@ -167,6 +167,17 @@ typedef struct ManifestFile
     time_t timestamp;                                               // Original timestamp
 } ManifestFile;
 
+// Subset of file fields used to order files. These are packed first so they can be read without unpacking the entire file.
+typedef struct ManifestFileKey
+{
+    const String *name;                                             // File name
+    const String *reference;                                        // Reference to a prior backup
+    uint64_t bundleId;                                              // Bundle id
+    uint64_t bundleOffset;                                          // Bundle offset
+    uint64_t size;                                                  // Final size (after copy)
+    time_t timestamp;                                               // Original timestamp
+} ManifestFileKey;
+
 /***********************************************************************************************************************************
 Link type
 ***********************************************************************************************************************************/
@@ -266,14 +277,19 @@ manifestReferenceList(const Manifest *const this)
 // Set backup label
 FN_EXTERN void manifestBackupLabelSet(Manifest *this, const String *backupLabel);
 
+// Convert the manifest to a full backup with the specified label. All files must already be stored in the new backup.
+FN_EXTERN void manifestBackupFullSet(Manifest *this, const String *backupLabel, const KeyValue *annotation);
+
 /***********************************************************************************************************************************
 Build functions
 ***********************************************************************************************************************************/
 // Validate the timestamps in the manifest given a copy start time, i.e. all times should be <= the copy start time
 FN_EXTERN void manifestBuildValidate(Manifest *this, bool delta, time_t copyStart, CompressType compressType);
 
-// Create a diff/incr backup by comparing to a previous backup manifest
-FN_EXTERN void manifestBuildIncr(Manifest *this, const Manifest *prior, BackupType type, const String *archiveStart);
+// Create a diff/incr backup by comparing to a previous backup manifest. Files in fileSameList (sorted, may be NULL) are known to be
+// unchanged since the prior backup and will be referenced when the size is equal.
+FN_EXTERN void manifestBuildIncr(
+    Manifest *this, const Manifest *prior, BackupType type, const String *archiveStart, const StringList *fileSameList);
 
 // Set remaining values before the final save
 FN_EXTERN void manifestBuildComplete(
@@ -332,6 +348,9 @@ typedef struct ManifestFilePack ManifestFilePack;
 // Unpack file pack returned by manifestFilePackGet()
 FN_EXTERN ManifestFile manifestFileUnpack(const Manifest *manifest, const ManifestFilePack *filePack);
 
+// Unpack only the key fields from a file pack. This is much faster than manifestFileUnpack() so it should be used for sorting.
+FN_EXTERN ManifestFileKey manifestFileUnpackKey(const Manifest *manifest, const ManifestFilePack *filePack);
+
 // Get file in pack format by index
 FN_INLINE_ALWAYS const ManifestFilePack *
 manifestFilePackGet(const Manifest *const this, const unsigned int fileIdx)
@@ -12,6 +12,7 @@ Main
 #include "command/archive/push/push.h"
 #include "command/backup/backup.h"
 #include "command/check/check.h"
+#include "command/compact/compact.h"
 #include "command/command.h"
 #include "command/control/start.h"
 #include "command/control/stop.h"
@@ -169,6 +170,12 @@ main(int argListSize, const char *argList[])
                     cmdCheck();
                     break;
 
+                // Compact command
+                // -----------------------------------------------------------------------------------------------------------------
+                case cfgCmdCompact:
+                    cmdCompact();
+                    break;
+
                 // Expire command
                 // -----------------------------------------------------------------------------------------------------------------
                 case cfgCmdExpire:
@@ -298,6 +305,11 @@ main(int argListSize, const char *argList[])
     }
     TRY_END();
 
+    // Merge stats from local processes that are still running (e.g. when clients are kept) on a clean shutdown. On error the stats
+    // have already been logged and locals may still be running jobs.
+    if (!error)
+        protocolLocalStat();
+
     // Free protocol objects
     protocolFree();
 
@@ -105,6 +105,7 @@ typedef struct PgControl
 
     PgPageSize pageSize;
     unsigned int walSegmentSize;
+    unsigned int segmentBlockTotal;                                 // Blocks per relation segment (relseg_size)
 
     unsigned int pageChecksumVersion;                               // Page checksum version (0 if no checksum, 1 if checksum)
 } PgControl;
@@ -3,6 +3,16 @@ CRC-32 Calculation
 ***********************************************************************************************************************************/
 #include "build.auto.h"
 
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(HAVE_CRC32C_SSE42)
+#include <nmmintrin.h>
+#elif defined(HAVE_CRC32C_ARMV8)
+#include <arm_acle.h>
+#include <sys/auxv.h>
+#endif
+
 #include "postgres/interface/crc32.h"
 
 /**********************************************************************************************************************************/
@@ -42,13 +52,94 @@ static const uint32_t crc32c_lookup[256] =
     0x79B737BA, 0x8BDCB4B9, 0x988C474D, 0x6AE7C44E, 0xBE2DA0A5, 0x4C4623A6, 0x5F16D052, 0xAD7D5351,
 };
 
+/***********************************************************************************************************************************
+Hardware CRC-32C calculation using the SSE 4.2 (x86-64) or ARMv8 CRC instructions. The pointer is aligned before the bulk of the
+data is processed eight bytes at a time. Support is checked at runtime since the build host may not match the host running the code.
+***********************************************************************************************************************************/
+#if defined(HAVE_CRC32C_SSE42) || defined(HAVE_CRC32C_ARMV8)
+
+#ifdef HAVE_CRC32C_SSE42
+#define CRC32C_HARDWARE_TARGET                                      __attribute__((target("sse4.2")))
+#define CRC32C_HARDWARE_U8(crc, value)                              _mm_crc32_u8(crc, value)
+#define CRC32C_HARDWARE_U64(crc, value)                             (uint32_t)_mm_crc32_u64(crc, value)
+#else
+#define CRC32C_HARDWARE_TARGET                                      __attribute__((target("+crc")))
+#define CRC32C_HARDWARE_U8(crc, value)                              __crc32cb(crc, value)
+#define CRC32C_HARDWARE_U64(crc, value)                             __crc32cd(crc, value)
+#endif
+
+static struct Crc32cLocal
+{
+    bool init;                                                      // Has hardware support been checked?
+    bool hardware;                                                  // Use hardware instructions?
+} crc32cLocal;
+
+static bool
+crc32cHardwareSupported(void)
+{
+#ifdef HAVE_CRC32C_SSE42
+    return __builtin_cpu_supports("sse4.2");
+#else
+    return (getauxval(AT_HWCAP) & HWCAP_CRC32) != 0;
+#endif
+}
+
+CRC32C_HARDWARE_TARGET static uint32_t
+crc32cHardware(uint32_t crc, const uint8_t *data, size_t size)
+{
+    while (size > 0 && (uintptr_t)data % sizeof(uint64_t) != 0)
+    {
+        crc = CRC32C_HARDWARE_U8(crc, *data++);
+        size--;
+    }
+
+    while (size >= sizeof(uint64_t))
+    {
+        uint64_t value;
+        memcpy(&value, data, sizeof(value));
+
+        crc = CRC32C_HARDWARE_U64(crc, value);
+        data += sizeof(uint64_t);
+        size -= sizeof(uint64_t);
+    }
+
+    while (size > 0)
+    {
+        crc = CRC32C_HARDWARE_U8(crc, *data++);
+        size--;
+    }
+
+    return crc;
+}
+
+#endif
+
+/**********************************************************************************************************************************/
 FN_EXTERN uint32_t
-crc32cOne(const uint8_t *data, size_t size)
+crc32cUpdate(const uint32_t crc, const uint8_t *data, size_t size)
 {
-    uint32_t result = 0xffffffff;
+    uint32_t result = crc ^ 0xffffffff;
+
+#if defined(HAVE_CRC32C_SSE42) || defined(HAVE_CRC32C_ARMV8)
+    if (!crc32cLocal.init)
+    {
+        crc32cLocal.hardware = crc32cHardwareSupported();
+        crc32cLocal.init = true;
+    }
+
+    if (crc32cLocal.hardware)
+        return crc32cHardware(result, data, size) ^ 0xffffffff;
+#endif
 
     while (size--)
         result = crc32c_lookup[(result ^ *data++) & 0xFF] ^ (result >> 8);
 
     return result ^ 0xffffffff;
 }
+
+/**********************************************************************************************************************************/
+FN_EXTERN uint32_t
+crc32cOne(const uint8_t *const data, const size_t size)
+{
+    return crc32cUpdate(0, data, size);
+}
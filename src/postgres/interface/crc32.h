@@ -1,7 +1,8 @@
 /***********************************************************************************************************************************
 CRC-32 Calculation
 
-CRC-32 and CRC-32C calculations required to validate the integrity of pg_control.
+CRC-32C calculations required to validate the integrity of pg_control and WAL records. Hardware instructions are used when the
+compiler and CPU support them.
 ***********************************************************************************************************************************/
 #ifndef POSTGRES_INTERFACE_CRC32_H
 #define POSTGRES_INTERFACE_CRC32_H
@@ -15,4 +16,8 @@ Functions
 // Generate CRC-32C checksum
 FN_EXTERN uint32_t crc32cOne(const uint8_t *data, size_t size);
 
+// Update a CRC-32C checksum with more data. Pass 0 as the initial checksum. The result is the same as calling crc32cOne() on all
+// the data at once.
+FN_EXTERN uint32_t crc32cUpdate(uint32_t crc, const uint8_t *data, size_t size);
+
 #endif
@@ -60,6 +60,7 @@ Read the version specific pg_control into a general data structure
             .timeline = ((const ControlFileData *)controlFile)->checkPointCopy.ThisTimeLineID,                                     \
             .pageSize = ((const ControlFileData *)controlFile)->blcksz,                                                            \
             .walSegmentSize = ((const ControlFileData *)controlFile)->xlog_seg_size,                                               \
+            .segmentBlockTotal = ((const ControlFileData *)controlFile)->relseg_size,                                              \
             .pageChecksumVersion = ((const ControlFileData *)controlFile)->data_checksum_version,                                  \
         };                                                                                                                         \
     }
@@ -0,0 +1,568 @@
+/***********************************************************************************************************************************
+PostgreSQL WAL Record Read
+
+Adapted from PostgreSQL src/backend/access/transam/xlogreader.c and src/include/access/xlogrecord.h.
+***********************************************************************************************************************************/
+#include "build.auto.h"
+
+#include <string.h>
+
+#include "common/debug.h"
+#include "common/log.h"
+#include "common/type/object.h"
+#include "postgres/interface/crc32.h"
+#include "postgres/version.h"
+#include "postgres/walRecord.h"
+
+/***********************************************************************************************************************************
+Page header constants. All WAL data is aligned on 8 bytes so the headers are padded to that alignment.
+***********************************************************************************************************************************/
+#define PG_WAL_ALIGN(size)                                          (((size) + 7) & ~(size_t)7)
+
+#define PG_WAL_PAGE_HEADER_SIZE                                     24
+#define PG_WAL_PAGE_HEADER_LONG_SIZE                                40
+
+#define PG_WAL_PAGE_FIRST_IS_CONTRECORD                             0x0001
+#define PG_WAL_PAGE_LONG_HEADER                                     0x0002
+#define PG_WAL_PAGE_FIRST_IS_OVERWRITE_CONTRECORD                   0x0008
+
+// Records can be a little over 1GiB in some versions but anything larger is certainly corrupt
+#define PG_WAL_RECORD_SIZE_MAX                                      ((uint32_t)(1024 * 1024 * 1024) + 65536)
+
+/***********************************************************************************************************************************
+Record header constants
+***********************************************************************************************************************************/
+#define PG_WAL_RECORD_HEADER_SIZE                                   24
+#define PG_WAL_RECORD_CRC_OFFSET                                    20
+
+#define PG_WAL_BLOCK_ID_MAX                                         32
+#define PG_WAL_BLOCK_ID_TOPLEVEL_XID                                252
+#define PG_WAL_BLOCK_ID_ORIGIN                                      253
+#define PG_WAL_BLOCK_ID_DATA_LONG                                   254
+#define PG_WAL_BLOCK_ID_DATA_SHORT                                  255
+
+#define PG_WAL_BLOCK_FORK_MASK                                      0x0F
+#define PG_WAL_BLOCK_HAS_IMAGE                                      0x10
+#define PG_WAL_BLOCK_SAME_REL                                       0x80
+
+#define PG_WAL_IMAGE_HAS_HOLE                                       0x01
+#define PG_WAL_IMAGE_COMPRESSED                                     0x02    // Before PostgreSQL 15
+#define PG_WAL_IMAGE_COMPRESSED_15                                  0x1C    // PostgreSQL >= 15 (pglz, lz4, or zstd)
+
+/***********************************************************************************************************************************
+Object type
+***********************************************************************************************************************************/
+struct PgWalRecordRead
+{
+    uint8_t imageCompressed;                                        // Image compressed flags for this version
+    bool crcCheck;                                                  // Check the CRC of each record?
+    PgWalRecordCallback *callback;                                  // Called for each record (NULL if none)
+    void *callbackData;                                             // Data passed to the callback
+
+    Buffer *page;                                                   // Current page
+    size_t pageSize;                                                // Page size (0 until the first long header has been read)
+    unsigned int segmentSize;                                       // Segment size
+    uint16_t magic;                                                 // Magic for all pages (from the first page)
+    uint64_t pageLsn;                                               // Expected LSN of the current page
+    unsigned int pageIdx;                                           // Page index in the current segment
+    bool segmentSkip;                                               // Skip the rest of the segment (no more records)
+
+    Buffer *record;                                                 // Record spanning pages (NULL if none in progress)
+    uint32_t recordSize;                                            // Total size of record spanning pages
+    uint64_t recordLsn;                                             // LSN of record spanning pages
+    List *blockList;                                                // Blocks referenced by the current record
+};
+
+/***********************************************************************************************************************************
+Read unaligned values from WAL data
+***********************************************************************************************************************************/
+static uint16_t
+pgWalRecordU16(const uint8_t *const data)
+{
+    uint16_t result;
+    memcpy(&result, data, sizeof(result));
+
+    return result;
+}
+
+static uint32_t
+pgWalRecordU32(const uint8_t *const data)
+{
+    uint32_t result;
+    memcpy(&result, data, sizeof(result));
+
+    return result;
+}
+
+static uint64_t
+pgWalRecordU64(const uint8_t *const data)
+{
+    uint64_t result;
+    memcpy(&result, data, sizeof(result));
+
+    return result;
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN PgWalRecordRead *
+pgWalRecordReadNew(
+    const unsigned int pgVersion, const bool crcCheck, PgWalRecordCallback *const callback, void *const callbackData)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(UINT, pgVersion);
+        FUNCTION_LOG_PARAM(BOOL, crcCheck);
+        FUNCTION_LOG_PARAM(FUNCTIONP, callback);
+        FUNCTION_LOG_PARAM_P(VOID, callbackData);
+    FUNCTION_LOG_END();
+
+    ASSERT(crcCheck || callback != NULL);
+
+    OBJ_NEW_BEGIN(PgWalRecordRead, .childQty = MEM_CONTEXT_QTY_MAX)
+    {
+        *this = (PgWalRecordRead)
+        {
+            .imageCompressed = pgVersion >= PG_VERSION_15 ? PG_WAL_IMAGE_COMPRESSED_15 : PG_WAL_IMAGE_COMPRESSED,
+            .crcCheck = crcCheck,
+            .callback = callback,
+            .callbackData = callbackData,
+            .page = bufNew(PG_WAL_PAGE_HEADER_LONG_SIZE),
+            .blockList = lstNewP(sizeof(PgWalRecordBlock)),
+        };
+    }
+    OBJ_NEW_END();
+
+    FUNCTION_LOG_RETURN(PG_WAL_RECORD_READ, this);
+}
+
+/***********************************************************************************************************************************
+Decode a complete record and pass it to the callback
+***********************************************************************************************************************************/
+// Error when the record is not long enough to contain the next value
+static void
+pgWalRecordDecodeCheck(const uint64_t lsn, const size_t size, const size_t offset, const size_t required)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(UINT64, lsn);
+        FUNCTION_TEST_PARAM(SIZE, size);
+        FUNCTION_TEST_PARAM(SIZE, offset);
+        FUNCTION_TEST_PARAM(SIZE, required);
+    FUNCTION_TEST_END();
+
+    if (size - offset < required)
+    {
+        THROW_FMT(
+            FormatError, "record at %X/%X is too short to decode", (unsigned int)(lsn >> 32), (unsigned int)(lsn & 0xFFFFFFFF));
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+static void
+pgWalRecordDecode(PgWalRecordRead *const this, const uint64_t lsn, const uint8_t *const record, const size_t size)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(PG_WAL_RECORD_READ, this);
+        FUNCTION_TEST_PARAM(UINT64, lsn);
+        FUNCTION_TEST_PARAM_P(BYTEDATA, record);
+        FUNCTION_TEST_PARAM(SIZE, size);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(record != NULL);
+    ASSERT(size >= PG_WAL_RECORD_HEADER_SIZE);
+
+    // Check the CRC, which is calculated on the data following the header and then on the header up to the CRC
+    if (this->crcCheck)
+    {
+        const uint32_t crc = crc32cUpdate(
+            crc32cUpdate(0, record + PG_WAL_RECORD_HEADER_SIZE, size - PG_WAL_RECORD_HEADER_SIZE), record,
+            PG_WAL_RECORD_CRC_OFFSET);
+
+        if (crc != pgWalRecordU32(record + PG_WAL_RECORD_CRC_OFFSET))
+        {
+            THROW_FMT(
+                FormatError, "incorrect resource manager data checksum in record at %X/%X", (unsigned int)(lsn >> 32),
+                (unsigned int)(lsn & 0xFFFFFFFF));
+        }
+    }
+
+    // Decode block headers. Block data, images, and main data follow the headers in the same order.
+    size_t offset = PG_WAL_RECORD_HEADER_SIZE;
+    size_t dataTotal = 0;
+    size_t mainDataSize = 0;
+    const PgWalRecordBlock *blockPrior = NULL;
+
+    lstClear(this->blockList);
+
+    while (size - offset > dataTotal)
+    {
+        const uint8_t blockId = record[offset++];
+
+        switch (blockId)
+        {
+            case PG_WAL_BLOCK_ID_DATA_SHORT:
+                pgWalRecordDecodeCheck(lsn, size, offset, 1);
+                mainDataSize = record[offset++];
+                break;
+
+            case PG_WAL_BLOCK_ID_DATA_LONG:
+                pgWalRecordDecodeCheck(lsn, size, offset, 4);
+                mainDataSize = pgWalRecordU32(record + offset);
+                offset += 4;
+                break;
+
+            case PG_WAL_BLOCK_ID_ORIGIN:
+                pgWalRecordDecodeCheck(lsn, size, offset, 2);
+                offset += 2;
+                continue;
+
+            case PG_WAL_BLOCK_ID_TOPLEVEL_XID:
+                pgWalRecordDecodeCheck(lsn, size, offset, 4);
+                offset += 4;
+                continue;
+
+            default:
+            {
+                if (blockId > PG_WAL_BLOCK_ID_MAX)
+                {
+                    THROW_FMT(
+                        FormatError, "invalid block id %u in record at %X/%X", blockId, (unsigned int)(lsn >> 32),
+                        (unsigned int)(lsn & 0xFFFFFFFF));
+                }
+
+                // Fork, flags, and data length
+                pgWalRecordDecodeCheck(lsn, size, offset, 3);
+
+                const uint8_t forkFlags = record[offset];
+                dataTotal += pgWalRecordU16(record + offset + 1);
+                offset += 3;
+
+                // Full page image
+                if (forkFlags & PG_WAL_BLOCK_HAS_IMAGE)
+                {
+                    pgWalRecordDecodeCheck(lsn, size, offset, 5);
+
+                    const uint8_t imageInfo = record[offset + 4];
+                    dataTotal += pgWalRecordU16(record + offset);
+                    offset += 5;
+
+                    // Hole length is only stored when the image is compressed
+                    if ((imageInfo & PG_WAL_IMAGE_HAS_HOLE) && (imageInfo & this->imageCompressed))
+                    {
+                        pgWalRecordDecodeCheck(lsn, size, offset, 2);
+                        offset += 2;
+                    }
+                }
+
+                // Relation, unless it is the same as the prior block
+                PgWalRecordBlock block = {.fork = forkFlags & PG_WAL_BLOCK_FORK_MASK};
+
+                if (forkFlags & PG_WAL_BLOCK_SAME_REL)
+                {
+                    if (blockPrior == NULL)
+                    {
+                        THROW_FMT(
+                            FormatError, "block references same relation without prior in record at %X/%X",
+                            (unsigned int)(lsn >> 32), (unsigned int)(lsn & 0xFFFFFFFF));
+                    }
+
+                    block.tablespaceId = blockPrior->tablespaceId;
+                    block.dbId = blockPrior->dbId;
+                    block.relFileNode = blockPrior->relFileNode;
+                }
+                else
+                {
+                    pgWalRecordDecodeCheck(lsn, size, offset, 12);
+
+                    block.tablespaceId = pgWalRecordU32(record + offset);
+                    block.dbId = pgWalRecordU32(record + offset + 4);
+                    block.relFileNode = pgWalRecordU32(record + offset + 8);
+                    offset += 12;
+                }
+
+                // Block number
+                pgWalRecordDecodeCheck(lsn, size, offset, 4);
+
+                block.blockNo = pgWalRecordU32(record + offset);
+                offset += 4;
+
+                blockPrior = lstAdd(this->blockList, &block);
+                continue;
+            }
+        }
+
+        // Main data is always last
+        dataTotal += mainDataSize;
+        break;
+    }
+
+    // The remainder of the record must be exactly the data described by the headers
+    if (size - offset != dataTotal)
+    {
+        THROW_FMT(
+            FormatError, "invalid data length in record at %X/%X", (unsigned int)(lsn >> 32), (unsigned int)(lsn & 0xFFFFFFFF));
+    }
+
+    const PgWalRecord walRecord =
+    {
+        .lsn = lsn,
+        .resourceManagerId = record[17],
+        .info = record[16],
+        .blockList = this->blockList,
+        .mainData = mainDataSize == 0 ? NULL : record + size - mainDataSize,
+        .mainDataSize = mainDataSize,
+    };
+
+    if (this->callback != NULL)
+        this->callback(this->callbackData, &walRecord);
+
+    // There are no more records in the segment after a switch
+    if (walRecord.resourceManagerId == PG_WAL_RMGR_XLOG && (walRecord.info & PG_WAL_INFO_TYPE_MASK) == PG_WAL_XLOG_SWITCH)
+        this->segmentSkip = true;
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Process a complete page
+***********************************************************************************************************************************/
+static void
+pgWalRecordPage(PgWalRecordRead *const this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(PG_WAL_RECORD_READ, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(bufUsed(this->page) == this->pageSize);
+
+    const uint8_t *const page = bufPtrConst(this->page);
+    const uint16_t magic = pgWalRecordU16(page);
+    const uint16_t info = pgWalRecordU16(page + 2);
+
+    // The first page of each segment resets skipping
+    if (this->pageIdx == 0)
+        this->segmentSkip = false;
+
+    // A zeroed page means there are no more records in the segment. Archived segments are complete so this is only expected after a
+    // switch, which has already set skip.
+    if (magic == 0 && !this->segmentSkip)
+    {
+        if (this->crcCheck)
+        {
+            THROW_FMT(
+                FormatError, "unexpected zeroed page at %X/%X", (unsigned int)(this->pageLsn >> 32),
+                (unsigned int)(this->pageLsn & 0xFFFFFFFF));
+        }
+
+        // A record in progress cannot be continued
+        bufFree(this->record);
+        this->record = NULL;
+
+        this->segmentSkip = true;
+    }
+
+    if (!this->segmentSkip)
+    {
+        // Check the header
+        if (magic != this->magic)
+        {
+            THROW_FMT(
+                FormatError, "invalid magic %04X in page at %X/%X", magic, (unsigned int)(this->pageLsn >> 32),
+                (unsigned int)(this->pageLsn & 0xFFFFFFFF));
+        }
+
+        if (pgWalRecordU64(page + 8) != this->pageLsn)
+        {
+            THROW_FMT(
+                FormatError, "unexpected page address %" PRIX64 " (expected %X/%X)", pgWalRecordU64(page + 8),
+                (unsigned int)(this->pageLsn >> 32), (unsigned int)(this->pageLsn & 0xFFFFFFFF));
+        }
+
+        size_t offset = (info & PG_WAL_PAGE_LONG_HEADER) ? PG_WAL_PAGE_HEADER_LONG_SIZE : PG_WAL_PAGE_HEADER_SIZE;
+
+        // Continue the record from the prior page
+        if (info & PG_WAL_PAGE_FIRST_IS_CONTRECORD)
+        {
+            const size_t remainSize = pgWalRecordU32(page + 16);
+            const size_t copySize = remainSize < this->pageSize - offset ? remainSize : this->pageSize - offset;
+
+            if (this->record != NULL)
+            {
+                if (remainSize != this->recordSize - bufUsed(this->record))
+                {
+                    THROW_FMT(
+                        FormatError, "invalid continuation length %zu in page at %X/%X", remainSize,
+                        (unsigned int)(this->pageLsn >> 32), (unsigned int)(this->pageLsn & 0xFFFFFFFF));
+                }
+
+                bufCatC(this->record, page, offset, copySize);
+
+                // Decode the record when complete
+                if (bufUsed(this->record) == this->recordSize)
+                {
+                    pgWalRecordDecode(this, this->recordLsn, bufPtrConst(this->record), this->recordSize);
+
+                    bufFree(this->record);
+                    this->record = NULL;
+                }
+            }
+
+            // Skip continuation data for a record that started before the stream (or was just completed)
+            offset = PG_WAL_ALIGN(offset + copySize);
+        }
+        // Else discard a record in progress since it was not continued. This is only valid when the record was overwritten after a
+        // crash, which is flagged on the page.
+        else if (this->record != NULL)
+        {
+            if (this->crcCheck && !(info & PG_WAL_PAGE_FIRST_IS_OVERWRITE_CONTRECORD))
+            {
+                THROW_FMT(
+                    FormatError, "record at %X/%X is not continued in page at %X/%X", (unsigned int)(this->recordLsn >> 32),
+                    (unsigned int)(this->recordLsn & 0xFFFFFFFF), (unsigned int)(this->pageLsn >> 32),
+                    (unsigned int)(this->pageLsn & 0xFFFFFFFF));
+            }
+
+            bufFree(this->record);
+            this->record = NULL;
+        }
+
+        // Read records that start on this page
+        while (!this->segmentSkip && offset < this->pageSize)
+        {
+            ASSERT(this->record == NULL);
+            ASSERT(offset % 8 == 0);
+
+            const uint32_t recordSize = pgWalRecordU32(page + offset);
+            const uint64_t recordLsn = this->pageLsn + offset;
+
+            // Zero length means there are no more records in this segment, which is only expected after a switch
+            if (recordSize == 0)
+            {
+                if (this->crcCheck)
+                {
+                    THROW_FMT(
+                        FormatError, "unexpected zero length record at %X/%X", (unsigned int)(recordLsn >> 32),
+                        (unsigned int)(recordLsn & 0xFFFFFFFF));
+                }
+
+                this->segmentSkip = true;
+                break;
+            }
+
+            if (recordSize < PG_WAL_RECORD_HEADER_SIZE || recordSize > PG_WAL_RECORD_SIZE_MAX)
+            {
+                THROW_FMT(
+                    FormatError, "invalid length %u in record at %X/%X", recordSize, (unsigned int)(recordLsn >> 32),
+                    (unsigned int)(recordLsn & 0xFFFFFFFF));
+            }
+
+            // Decode directly from the page when the record fits
+            if (recordSize <= this->pageSize - offset)
+            {
+                pgWalRecordDecode(this, recordLsn, page + offset, recordSize);
+                offset = PG_WAL_ALIGN(offset + recordSize);
+            }
+            // Else the record continues on the next page
+            else
+            {
+                MEM_CONTEXT_OBJ_BEGIN(this)
+                {
+                    this->record = bufNew(recordSize);
+                }
+                MEM_CONTEXT_OBJ_END();
+
+                bufCatC(this->record, page, offset, this->pageSize - offset);
+                this->recordSize = recordSize;
+                this->recordLsn = recordLsn;
+
+                break;
+            }
+        }
+    }
+
+    // Advance to the next page
+    this->pageLsn += this->pageSize;
+    this->pageIdx = (this->pageIdx + 1) % (unsigned int)(this->segmentSize / this->pageSize);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Get page and segment size from the first long page header
+***********************************************************************************************************************************/
+static void
+pgWalRecordHeader(PgWalRecordRead *const this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(PG_WAL_RECORD_READ, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(bufUsed(this->page) == PG_WAL_PAGE_HEADER_LONG_SIZE);
+
+    const uint8_t *const page = bufPtrConst(this->page);
+
+    if (!(pgWalRecordU16(page + 2) & PG_WAL_PAGE_LONG_HEADER))
+        THROW(FormatError, "first page header in WAL file is expected to be in long format");
+
+    this->magic = pgWalRecordU16(page);
+    this->pageLsn = pgWalRecordU64(page + 8);
+    this->segmentSize = pgWalRecordU32(page + 32);
+    this->pageSize = pgWalRecordU32(page + 36);
+
+    // Page size must be a power of two that evenly divides the segment
+    if (this->pageSize < 1024 || this->pageSize > 65536 || (this->pageSize & (this->pageSize - 1)) != 0 ||
+        this->segmentSize < this->pageSize || this->segmentSize % this->pageSize != 0)
+    {
+        THROW_FMT(FormatError, "invalid WAL page size %zu or segment size %u", this->pageSize, this->segmentSize);
+    }
+
+    // The stream must start on a segment boundary
+    if (this->pageLsn % this->segmentSize != 0)
+        THROW(FormatError, "WAL must start on a segment boundary");
+
+    bufResize(this->page, this->pageSize);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN void
+pgWalRecordReadProcess(PgWalRecordRead *const this, const Buffer *const input)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(PG_WAL_RECORD_READ, this);
+        FUNCTION_LOG_PARAM(BUFFER, input);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(input != NULL);
+
+    size_t inputOffset = 0;
+
+    while (inputOffset < bufUsed(input))
+    {
+        // Copy as much input as possible to the page
+        const size_t copySize =
+            bufRemains(this->page) < bufUsed(input) - inputOffset ? bufRemains(this->page) : bufUsed(input) - inputOffset;
+
+        bufCatSub(this->page, input, inputOffset, copySize);
+        inputOffset += copySize;
+
+        if (bufFull(this->page))
+        {
+            // Page size is not known until the first long header has been read
+            if (this->pageSize == 0)
+                pgWalRecordHeader(this);
+            // Else process the page
+            else
+            {
+                pgWalRecordPage(this);
+                bufUsedZero(this->page);
+            }
+        }
+    }
+
+    FUNCTION_LOG_RETURN_VOID();
+}
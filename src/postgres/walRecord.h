@@ -0,0 +1,102 @@
+/***********************************************************************************************************************************
+PostgreSQL WAL Record Read
+
+Decode the records in a stream of WAL segments. Segments must be provided in order, without gaps, and each segment must be complete.
+Data may be provided in buffers of any size. Records that started before the first segment are skipped since they cannot be decoded.
+The record format has been stable since PostgreSQL 9.5 so all supported versions can be decoded.
+
+For each record decoded the callback is called with the block references and main data. The record and block list are only valid
+for the duration of the callback. When the CRC check is enabled the CRC of each record is verified before it is decoded, so the
+callback may be omitted when only the integrity of the records is of interest. The CRC check also requires each segment to be filled
+with records unless it ends with a switch and each record to be continued on the next page unless it was overwritten after a crash.
+A record that continues into a segment that is not provided cannot be checked.
+***********************************************************************************************************************************/
+#ifndef POSTGRES_WALRECORD_H
+#define POSTGRES_WALRECORD_H
+
+/***********************************************************************************************************************************
+Object type
+***********************************************************************************************************************************/
+typedef struct PgWalRecordRead PgWalRecordRead;
+
+#include "common/type/buffer.h"
+#include "common/type/list.h"
+
+/***********************************************************************************************************************************
+Resource manager ids and record types needed to interpret records
+***********************************************************************************************************************************/
+#define PG_WAL_RMGR_XLOG                                            0
+#define PG_WAL_RMGR_SMGR                                            2
+#define PG_WAL_RMGR_DBASE                                           4
+
+// Mask of the record type in info (the lower bits are reserved for flags)
+#define PG_WAL_INFO_TYPE_MASK                                       0xF0
+
+#define PG_WAL_XLOG_SWITCH                                          0x40
+#define PG_WAL_SMGR_CREATE                                          0x10
+#define PG_WAL_SMGR_TRUNCATE                                        0x20
+
+/***********************************************************************************************************************************
+Tablespace and fork constants needed to map block references to files
+***********************************************************************************************************************************/
+#define PG_TABLESPACE_DEFAULT                                       1663
+#define PG_TABLESPACE_GLOBAL                                        1664
+
+#define PG_FORK_MAIN                                                0
+
+/***********************************************************************************************************************************
+Record types
+***********************************************************************************************************************************/
+// Block referenced by a record
+typedef struct PgWalRecordBlock
+{
+    unsigned int tablespaceId;                                      // Tablespace oid
+    unsigned int dbId;                                              // Database oid (0 for shared relations)
+    unsigned int relFileNode;                                       // Relation file node
+    unsigned int fork;                                              // Fork number
+    unsigned int blockNo;                                           // Block number in the relation
+} PgWalRecordBlock;
+
+// Decoded record
+typedef struct PgWalRecord
+{
+    uint64_t lsn;                                                   // Record LSN
+    uint8_t resourceManagerId;                                      // Resource manager that created the record
+    uint8_t info;                                                   // Record type and flags
+    const List *blockList;                                          // Blocks referenced (PgWalRecordBlock)
+    const uint8_t *mainData;                                        // Main data (NULL if none)
+    size_t mainDataSize;                                            // Main data size
+} PgWalRecord;
+
+typedef void PgWalRecordCallback(void *callbackData, const PgWalRecord *record);
+
+/***********************************************************************************************************************************
+Constructors
+***********************************************************************************************************************************/
+FN_EXTERN PgWalRecordRead *pgWalRecordReadNew(
+    unsigned int pgVersion, bool crcCheck, PgWalRecordCallback *callback, void *callbackData);
+
+/***********************************************************************************************************************************
+Functions
+***********************************************************************************************************************************/
+// Process the next part of the WAL stream. The callback is called for each record completed by the data provided.
+FN_EXTERN void pgWalRecordReadProcess(PgWalRecordRead *this, const Buffer *input);
+
+/***********************************************************************************************************************************
+Destructor
+***********************************************************************************************************************************/
+FN_INLINE_ALWAYS void
+pgWalRecordReadFree(PgWalRecordRead *const this)
+{
+    objFree(this);
+}
+
+/***********************************************************************************************************************************
+Macros for function logging
+***********************************************************************************************************************************/
+#define FUNCTION_LOG_PG_WAL_RECORD_READ_TYPE                                                                                       \
+    PgWalRecordRead *
+#define FUNCTION_LOG_PG_WAL_RECORD_READ_FORMAT(value, buffer, bufferSize)                                                          \
+    objNameToLog(value, "PgWalRecordRead", buffer, bufferSize)
+
+#endif
@@ -5,6 +5,7 @@ Protocol Client
 
 #include "common/debug.h"
 #include "common/log.h"
+#include "common/stat.h"
 #include "common/time.h"
 #include "common/type/json.h"
 #include "common/type/keyValue.h"
@@ -437,6 +438,29 @@ protocolClientNoOp(ProtocolClient *const this)
     FUNCTION_LOG_RETURN_VOID();
 }
 
+/**********************************************************************************************************************************/
+FN_EXTERN void
+protocolClientStat(ProtocolClient *const this)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(PROTOCOL_CLIENT, this);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        const String *const json = pckReadStrP(protocolClientRequestP(this, PROTOCOL_COMMAND_STAT));
+
+        // Stats will be NULL when none were collected
+        if (json != NULL)
+            statMerge(json);
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Free client session
 ***********************************************************************************************************************************/
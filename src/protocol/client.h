@@ -73,6 +73,7 @@ Constants
 #define PROTOCOL_COMMAND_CONFIG                                     STRID5("config", 0xe9339e30)
 #define PROTOCOL_COMMAND_EXIT                                       STRID5("exit", 0xa27050)
 #define PROTOCOL_COMMAND_NOOP                                       STRID5("noop", 0x83dee0)
+#define PROTOCOL_COMMAND_STAT                                       STRID5("stat", 0xa06930)
 
 /***********************************************************************************************************************************
 This size should be safe for most pack data without wasting a lot of space. If binary data is being transferred then this size can
@@ -127,6 +128,9 @@ protocolClientNoExit(ProtocolClient *const this)
 // Send noop to test connection or keep it alive
 FN_EXTERN void protocolClientNoOp(ProtocolClient *this);
 
+// Merge stats collected by the server into the stats for this process
+FN_EXTERN void protocolClientStat(ProtocolClient *this);
+
 // Simple request that does not require a session or async
 typedef struct ProtocolClientRequestParam
 {
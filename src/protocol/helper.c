@@ -281,6 +281,34 @@ protocolLocalGet(const ProtocolStorageType protocolStorageType, const unsigned i
     FUNCTION_LOG_RETURN(PROTOCOL_CLIENT, protocolHelperClient->client);
 }
 
+/***********************************************************************************************************************************
+Merge stats from a local process so they are included in the stats for this process. This must only be done on a clean shutdown
+when the local is idle since the request would otherwise read the response of a running job or wait for the protocol timeout. Stats
+are informational so errors are only logged at debug level.
+***********************************************************************************************************************************/
+static void
+protocolHelperClientStat(const ProtocolHelperClient *const protocolHelperClient)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM_P(VOID, protocolHelperClient);
+    FUNCTION_LOG_END();
+
+    if (protocolHelperClient->type == protocolClientLocal)
+    {
+        TRY_BEGIN()
+        {
+            protocolClientStat(protocolHelperClient->client);
+        }
+        CATCH_ANY()
+        {
+            LOG_DEBUG_FMT("unable to get stats from local process: %s", errorMessage());
+        }
+        TRY_END();
+    }
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Free the protocol client and underlying exec'd process. Log any errors as warnings since it is not worth terminating the process
 while closing a local/remote that has already completed its work. The warning will be an indication that something is not right.
@@ -862,6 +890,7 @@ protocolHelperFree(ProtocolClient *const client)
 
             if (match->client == client)
             {
+                protocolHelperClientStat(match);
                 protocolHelperClientFree(match);
                 lstRemoveIdx(protocolHelper.clientList, clientIdx);
 
@@ -893,6 +922,21 @@ protocolKeepAlive(void)
     FUNCTION_LOG_RETURN_VOID();
 }
 
+/**********************************************************************************************************************************/
+FN_EXTERN void
+protocolLocalStat(void)
+{
+    FUNCTION_LOG_VOID(logLevelTrace);
+
+    if (protocolHelper.clientList != NULL)
+    {
+        for (unsigned int clientIdx = 0; clientIdx < lstSize(protocolHelper.clientList); clientIdx++)
+            protocolHelperClientStat(lstGet(protocolHelper.clientList, clientIdx));
+    }
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN void
 protocolFree(void)
@@ -50,9 +50,12 @@ FN_EXTERN ProtocolClient *protocolLocalGet(ProtocolStorageType protocolStorageTy
 // Remote protocol client
 FN_EXTERN ProtocolClient *protocolRemoteGet(ProtocolStorageType protocolStorageType, unsigned int hostId, bool create);
 
-// Free (shutdown) a local/remote client
+// Free (shutdown) a local/remote client. Stats are merged from a local client so it must be idle, i.e. not running a job.
 FN_EXTERN void protocolHelperFree(ProtocolClient *client);
 
+// Merge stats from all local clients. Only call on a clean shutdown since all local clients must be idle.
+FN_EXTERN void protocolLocalStat(void);
+
 // Initialize a server
 FN_EXTERN ProtocolServer *protocolServer(IoServer *const tlsServer, IoSession *const socketSession);
 
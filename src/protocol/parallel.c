@@ -9,10 +9,23 @@ Protocol Parallel Executor
 #include "common/debug.h"
 #include "common/log.h"
 #include "common/macro.h"
+#include "common/stat.h"
+#include "common/type/convert.h"
 #include "common/type/keyValue.h"
 #include "common/type/list.h"
 #include "protocol/helper.h"
 #include "protocol/parallel.h"
+#include "storage/helper.h"
+
+/***********************************************************************************************************************************
+File containing system CPU statistics
+***********************************************************************************************************************************/
+#define PROTOCOL_PARALLEL_CPU_STAT_FILE                             "/proc/stat"
+
+/***********************************************************************************************************************************
+Statistics constants
+***********************************************************************************************************************************/
+STRING_EXTERN(PROTOCOL_STAT_WAIT_STR,                               PROTOCOL_STAT_WAIT);
 
 /***********************************************************************************************************************************
 Object type
@@ -35,6 +48,23 @@ struct ProtocolParallel
     ProtocolParallelJobData *clientJobList;                         // Jobs being processing by each client
 
     ProtocolParallelJobState state;                                 // Overall state of job processing
+
+    unsigned int clientMin;                                         // Min clients running jobs (0 when not adaptive)
+    unsigned int clientActive;                                      // Max clients running jobs concurrently
+    bool clientKeep;                                                // Keep clients when there are no more jobs?
+    uint64_t sizeComplete;                                          // Size of jobs completed
+
+    struct
+    {
+        TimeMSec time;                                              // Time of the last adjustment
+        uint64_t sizeComplete;                                      // Size of jobs completed at the last adjustment
+        uint64_t throughput;                                        // Throughput during the last interval
+        bool grow;                                                  // Is throughput still improving as clients are added?
+        bool retry;                                                 // Was the last client added to retry growth?
+        unsigned int retryInterval;                                 // Intervals since growth stopped
+        uint64_t cpuIdle;                                           // CPU idle ticks at the last adjustment
+        uint64_t cpuTotal;                                          // CPU total ticks at the last adjustment
+    } adapt;
 };
 
 /**********************************************************************************************************************************/
@@ -88,6 +118,132 @@ protocolParallelClientAdd(ProtocolParallel *const this, ProtocolClient *const cl
     FUNCTION_LOG_RETURN_VOID();
 }
 
+/***********************************************************************************************************************************
+Get system CPU idle percent since the last call or -1 when it cannot be determined, e.g. the stat file is missing or this is the
+first call. I/O wait is not counted as idle so a saturated disk will also reduce the number of clients.
+***********************************************************************************************************************************/
+static int
+protocolParallelCpuIdle(ProtocolParallel *const this, const String *const file)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(PROTOCOL_PARALLEL, this);
+        FUNCTION_TEST_PARAM(STRING, file);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(file != NULL);
+
+    int result = -1;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        const Buffer *const buffer = storageGetP(storageNewReadP(storageLocal(), file, .ignoreMissing = true));
+
+        // The first line has ticks for all CPUs in the format: cpu user nice system idle iowait irq softirq steal ...
+        if (buffer != NULL)
+        {
+            const String *const line = strLstGet(strLstNewSplitZ(strNewBuf(buffer), "\n"), 0);
+
+            if (strBeginsWithZ(line, "cpu "))
+            {
+                const StringList *const fieldList = strLstNewSplitZ(strTrim(strSub(line, 4)), " ");
+                uint64_t cpuTotal = 0;
+
+                for (unsigned int fieldIdx = 0; fieldIdx < strLstSize(fieldList) && fieldIdx < 8; fieldIdx++)
+                    cpuTotal += cvtZToUInt64(strZ(strLstGet(fieldList, fieldIdx)));
+
+                const uint64_t cpuIdle = strLstSize(fieldList) > 3 ? cvtZToUInt64(strZ(strLstGet(fieldList, 3))) : 0;
+
+                if (this->adapt.cpuTotal != 0 && cpuTotal > this->adapt.cpuTotal && cpuIdle >= this->adapt.cpuIdle)
+                    result = (int)((cpuIdle - this->adapt.cpuIdle) * 100 / (cpuTotal - this->adapt.cpuTotal));
+
+                this->adapt.cpuIdle = cpuIdle;
+                this->adapt.cpuTotal = cpuTotal;
+            }
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN(INT, result);
+}
+
+/***********************************************************************************************************************************
+Determine how many clients should run jobs based on the throughput of the last interval and CPU idle. Clients are added one at a
+time while throughput improves. If adding a client makes throughput worse then it is removed and no more clients are added. When the
+CPU is saturated a client is removed and growth starts again once the CPU is available, so the number of clients may vary by one
+around the saturation point. Growth is also retried periodically since the best number of clients may change, e.g. when the mix of
+file sizes changes. A client added to retry growth is removed unless it improves throughput.
+***********************************************************************************************************************************/
+static unsigned int
+protocolParallelAdapt(ProtocolParallel *const this, const uint64_t throughput, const int cpuIdle)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(PROTOCOL_PARALLEL, this);
+        FUNCTION_TEST_PARAM(UINT64, throughput);
+        FUNCTION_TEST_PARAM(INT, cpuIdle);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(this->clientMin > 0);
+
+    unsigned int result = this->clientActive;
+
+    // Remove a client when the CPU is saturated. Reset throughput so growth is retried when the CPU becomes available.
+    if (cpuIdle != -1 && cpuIdle < PROTOCOL_PARALLEL_ADAPT_IDLE_MIN)
+    {
+        if (result > this->clientMin)
+            result--;
+
+        this->adapt.grow = true;
+        this->adapt.retry = false;
+        this->adapt.throughput = 0;
+    }
+    else
+    {
+        if (this->adapt.grow)
+        {
+            // Add a client while throughput is improving
+            if (throughput * 100 >= this->adapt.throughput * (100 + PROTOCOL_PARALLEL_ADAPT_THRESHOLD))
+            {
+                if (result < lstSize(this->clientList))
+                    result++;
+                else
+                    this->adapt.grow = false;
+            }
+            // Else stop adding clients and remove the last client added if it made throughput worse or was added to retry growth
+            else
+            {
+                if ((this->adapt.retry || throughput * 100 <= this->adapt.throughput * (100 - PROTOCOL_PARALLEL_ADAPT_THRESHOLD)) &&
+                    result > this->clientMin)
+                {
+                    result--;
+                }
+
+                this->adapt.grow = false;
+            }
+
+            this->adapt.retry = false;
+            this->adapt.retryInterval = 0;
+        }
+        // Else retry growth periodically by adding a client
+        else if (++this->adapt.retryInterval >= PROTOCOL_PARALLEL_ADAPT_RETRY)
+        {
+            if (result < lstSize(this->clientList))
+            {
+                result++;
+                this->adapt.grow = true;
+                this->adapt.retry = true;
+            }
+
+            this->adapt.retryInterval = 0;
+        }
+
+        this->adapt.throughput = throughput;
+    }
+
+    FUNCTION_TEST_RETURN(UINT, result);
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN unsigned int
 protocolParallelProcess(ProtocolParallel *const this)
@@ -115,6 +271,9 @@ protocolParallelProcess(ProtocolParallel *const this)
             }
             MEM_CONTEXT_OBJ_END();
 
+            if (this->clientMin == 0)
+                this->clientActive = lstSize(this->clientList);
+
             this->state = protocolParallelJobStateRunning;
         }
 
@@ -149,9 +308,12 @@ protocolParallelProcess(ProtocolParallel *const this)
             timeoutSelect.tv_usec = (suseconds_t)(this->timeout % MSEC_PER_SEC * 1000);
 
             // Determine if there is data to be read
+            const TimeUSec timeBegin = timeUSec();
             const int completed = select(fdMax + 1, &selectSet, NULL, NULL, &timeoutSelect);
             THROW_ON_SYS_ERROR(completed == -1, AssertError, "unable to select from parallel client(s)");
 
+            statTime(PROTOCOL_STAT_WAIT_STR, timeUSec() - timeBegin);
+
             // If any jobs have completed then get the results
             if (completed > 0)
             {
@@ -186,14 +348,45 @@ protocolParallelProcess(ProtocolParallel *const this)
                 }
 
                 result = (unsigned int)completed;
+                clientRunningTotal -= result;
             }
         }
 
-        // Find new jobs to be run
+        // Adjust the number of clients running jobs when adaptive
+        if (this->clientMin != 0)
+        {
+            const TimeMSec timeNow = timeMSec();
+
+            if (timeNow - this->adapt.time >= PROTOCOL_PARALLEL_ADAPT_INTERVAL)
+            {
+                const int cpuIdle = protocolParallelCpuIdle(this, STRDEF(PROTOCOL_PARALLEL_CPU_STAT_FILE));
+
+                // Throughput is measured on completed jobs so it is not known until a job completes. Extend the interval until then
+                // (unless the CPU is saturated) since large jobs that are still running would otherwise look like lower throughput.
+                if (this->sizeComplete != this->adapt.sizeComplete || (cpuIdle != -1 && cpuIdle < PROTOCOL_PARALLEL_ADAPT_IDLE_MIN))
+                {
+                    const unsigned int clientActive = protocolParallelAdapt(
+                        this, (this->sizeComplete - this->adapt.sizeComplete) * MSEC_PER_SEC / (timeNow - this->adapt.time),
+                        cpuIdle);
+
+                    if (clientActive != this->clientActive)
+                    {
+                        LOG_DETAIL_FMT("adjust processes running jobs from %u to %u", this->clientActive, clientActive);
+                        this->clientActive = clientActive;
+                    }
+
+                    this->adapt.time = timeNow;
+                    this->adapt.sizeComplete = this->sizeComplete;
+                }
+            }
+        }
+
+        // Find new jobs to be run. Any client that is not running a job may get a job as long as the number of clients running jobs
+        // is less than the active limit, so a client that has no more jobs does not prevent other clients from running jobs.
         for (unsigned int clientIdx = 0; clientIdx < lstSize(this->clientList); clientIdx++)
         {
             // If nothing is running for this client
-            if (this->clientJobList[clientIdx].job == NULL)
+            if (this->clientJobList[clientIdx].job == NULL && clientRunningTotal < this->clientActive)
             {
                 MEM_CONTEXT_BEGIN(lstMemContext(this->jobList))
                 {
@@ -218,9 +411,11 @@ protocolParallelProcess(ProtocolParallel *const this)
 
                         this->clientJobList[clientIdx].job = job;
                         this->clientJobList[clientIdx].session = session;
+
+                        clientRunningTotal++;
                     }
-                    // Else no more jobs for this client so free it
-                    else
+                    // Else no more jobs for this client so free it (unless it will be reused)
+                    else if (!this->clientKeep)
                         protocolHelperFree(client);
                 }
                 MEM_CONTEXT_END();
@@ -261,6 +456,79 @@ protocolParallelResult(ProtocolParallel *const this)
     FUNCTION_LOG_RETURN(PROTOCOL_PARALLEL_JOB, result);
 }
 
+/**********************************************************************************************************************************/
+FN_EXTERN unsigned int
+protocolParallelClientActive(const ProtocolParallel *const this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(PROTOCOL_PARALLEL, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(this->state != protocolParallelJobStatePending);
+
+    FUNCTION_TEST_RETURN(UINT, this->clientActive);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN void
+protocolParallelClientMinSet(ProtocolParallel *const this, const unsigned int clientMin)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(PROTOCOL_PARALLEL, this);
+        FUNCTION_LOG_PARAM(UINT, clientMin);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(clientMin > 0);
+    ASSERT(this->state == protocolParallelJobStatePending);
+
+    // Adaptive processing is only needed when the minimum is less than the number of clients
+    if (clientMin < lstSize(this->clientList))
+    {
+        this->clientMin = clientMin;
+        this->clientActive = clientMin;
+        this->adapt.time = timeMSec();
+        this->adapt.grow = true;
+
+        // Initialize CPU ticks so idle can be calculated at the first adjustment
+        protocolParallelCpuIdle(this, STRDEF(PROTOCOL_PARALLEL_CPU_STAT_FILE));
+    }
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN void
+protocolParallelSizeCompleteSet(ProtocolParallel *const this, const uint64_t sizeComplete)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(PROTOCOL_PARALLEL, this);
+        FUNCTION_TEST_PARAM(UINT64, sizeComplete);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    this->sizeComplete = sizeComplete;
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN void
+protocolParallelClientKeepSet(ProtocolParallel *const this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(PROTOCOL_PARALLEL, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    this->clientKeep = true;
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN bool
 protocolParallelDone(ProtocolParallel *const this)
@@ -14,6 +14,27 @@ typedef struct ProtocolParallel ProtocolParallel;
 #include "protocol/client.h"
 #include "protocol/parallelJob.h"
 
+/***********************************************************************************************************************************
+Constants
+***********************************************************************************************************************************/
+// Interval between adjustments to the number of clients running jobs when adaptive processing is enabled
+#define PROTOCOL_PARALLEL_ADAPT_INTERVAL                            5000
+
+// Intervals without growth before adding a client is retried, since the best number of clients may change as processing proceeds
+#define PROTOCOL_PARALLEL_ADAPT_RETRY                               6
+
+// Throughput change (percent) required before adding or removing a client
+#define PROTOCOL_PARALLEL_ADAPT_THRESHOLD                           10
+
+// Clients are removed when system CPU idle (percent) drops below this level so the database is not starved
+#define PROTOCOL_PARALLEL_ADAPT_IDLE_MIN                            10
+
+/***********************************************************************************************************************************
+Statistics constants
+***********************************************************************************************************************************/
+#define PROTOCOL_STAT_WAIT                                          "protocol.wait"     // Time spent waiting for parallel jobs
+STRING_DECLARE(PROTOCOL_STAT_WAIT_STR);
+
 /***********************************************************************************************************************************
 Job request callback
 
@@ -36,6 +57,21 @@ FN_EXTERN bool protocolParallelDone(ProtocolParallel *this);
 // Completed job result
 FN_EXTERN ProtocolParallelJob *protocolParallelResult(ProtocolParallel *this);
 
+// Number of clients that may run jobs concurrently. This is less than the number of clients added when processing is adaptive and
+// not all clients are in use. Only valid once processing has started, e.g. in the job callback.
+FN_EXTERN unsigned int protocolParallelClientActive(const ProtocolParallel *this);
+
+// Set the minimum number of clients that run jobs concurrently. When less than the number of clients added, processing starts with
+// the minimum and clients are added or removed based on throughput and system load. Must be called after all clients are added.
+FN_EXTERN void protocolParallelClientMinSet(ProtocolParallel *this, unsigned int clientMin);
+
+// Set the size of jobs completed so far, used to measure throughput for adaptive processing
+FN_EXTERN void protocolParallelSizeCompleteSet(ProtocolParallel *this, uint64_t sizeComplete);
+
+// Keep clients running when there are no more jobs so they can be reused by another executor. By default clients are freed as soon
+// as there are no more jobs for them.
+FN_EXTERN void protocolParallelClientKeepSet(ProtocolParallel *this);
+
 /***********************************************************************************************************************************
 Functions
 ***********************************************************************************************************************************/
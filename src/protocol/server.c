@@ -8,6 +8,7 @@ Protocol Server
 #include "common/debug.h"
 #include "common/error/retry.h"
 #include "common/log.h"
+#include "common/stat.h"
 #include "common/time.h"
 #include "common/type/json.h"
 #include "common/type/keyValue.h"
@@ -471,6 +472,15 @@ protocolServerProcess(ProtocolServer *const this, const VariantList *const retry
                             protocolServerResponseP(this);
                             break;
 
+                        case PROTOCOL_COMMAND_STAT:
+                        {
+                            PackWrite *const response = protocolPackNew();
+
+                            pckWriteStrP(response, statToJson());
+                            protocolServerResponseP(this, .data = response);
+                            break;
+                        }
+
                         default:
                             THROW_FMT(
                                 ProtocolError, "invalid request '%s' (0x%" PRIx64 ")", strZ(strIdToStr(request.id)), request.id);
@@ -8,6 +8,7 @@ Azure Storage
 #include "common/crypto/common.h"
 #include "common/crypto/hash.h"
 #include "common/debug.h"
+#include "common/io/bufferRead.h"
 #include "common/io/http/client.h"
 #include "common/io/http/common.h"
 #include "common/io/socket/client.h"
@@ -16,16 +17,26 @@ Azure Storage
 #include "common/regExp.h"
 #include "common/type/object.h"
 #include "common/type/xml.h"
+#include "common/wait.h"
 #include "storage/azure/read.h"
 #include "storage/azure/write.h"
 
 /***********************************************************************************************************************************
 Azure http headers
 ***********************************************************************************************************************************/
+STRING_STATIC(AZURE_HEADER_COPY_SOURCE_STR,                          "x-ms-copy-source");
+STRING_STATIC(AZURE_HEADER_COPY_STATUS_STR,                          "x-ms-copy-status");
+STRING_STATIC(AZURE_HEADER_COPY_STATUS_DESCRIPTION_STR,              "x-ms-copy-status-description");
 STRING_STATIC(AZURE_HEADER_TAGS,                                    "x-ms-tags");
 STRING_STATIC(AZURE_HEADER_VERSION_STR,                             "x-ms-version");
 STRING_STATIC(AZURE_HEADER_VERSION_VALUE_STR,                       "2021-06-08");
 
+/***********************************************************************************************************************************
+Azure copy status values
+***********************************************************************************************************************************/
+STRING_STATIC(AZURE_COPY_STATUS_PENDING_STR,                        "pending");
+STRING_STATIC(AZURE_COPY_STATUS_SUCCESS_STR,                        "success");
+
 /***********************************************************************************************************************************
 Azure query tokens
 ***********************************************************************************************************************************/
@@ -72,6 +83,8 @@ struct StorageAzure
     size_t blockSize;                                               // Block size for multi-block upload
     const String *tag;                                              // Tags to be applied to objects
     const String *pathPrefix;                                       // Account/container prefix
+    const String *copySourcePrefix;                                 // URL prefix for the copy source (through the container)
+    TimeMSec timeout;                                               // Timeout for copies to complete
 
     uint64_t fileId;                                                // Id to used to make file block identifiers unique
 };
@@ -311,6 +324,129 @@ storageAzureRequest(StorageAzure *const this, const String *const verb, const St
     FUNCTION_LOG_RETURN(HTTP_RESPONSE, result);
 }
 
+/***********************************************************************************************************************************
+Parse a page of list results. Paths and files are collected as the page is parsed rather than building a document tree, which uses
+much less memory and CPU when there are many files.
+***********************************************************************************************************************************/
+typedef struct StorageAzureListFile
+{
+    const String *name;                                             // File name
+    const String *timeModified;                                     // Time file was last modified
+    const String *size;                                             // File size
+    const String *versionId;                                        // Version id
+} StorageAzureListFile;
+
+typedef struct StorageAzureListPage
+{
+    StringList *pathList;                                           // Paths (blob prefixes)
+    List *fileList;                                                 // Files or versions
+    const String *continuationMarker;                               // Marker to get more results
+    bool blobs;                                                     // Are blobs currently being parsed?
+    StorageAzureListFile *file;                                     // File currently being parsed
+    bool path;                                                      // Is a path currently being parsed?
+    bool property;                                                  // Are file properties currently being parsed?
+} StorageAzureListPage;
+
+static void
+storageAzureListPageCallback(
+    void *const callbackData, const unsigned int depth, const String *const name, const String *const content)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, callbackData);
+        FUNCTION_TEST_PARAM(UINT, depth);
+        FUNCTION_TEST_PARAM(STRING, name);
+        FUNCTION_TEST_PARAM(STRING, content);
+    FUNCTION_TEST_END();
+
+    ASSERT(callbackData != NULL);
+    ASSERT(name != NULL);
+
+    StorageAzureListPage *const page = callbackData;
+
+    MEM_CONTEXT_BEGIN(lstMemContext(page->fileList))
+    {
+        switch (depth)
+        {
+            // Blobs and continuation marker
+            case 2:
+            {
+                if (content == NULL)
+                    page->blobs = strEq(name, AZURE_XML_TAG_BLOBS_STR);
+                else if (page->blobs)
+                    page->blobs = false;
+                else if (strEq(name, AZURE_XML_TAG_NEXT_MARKER_STR))
+                    page->continuationMarker = strDup(content);
+
+                break;
+            }
+
+            // Children of blobs
+            case 3:
+            {
+                if (!page->blobs)
+                    break;
+
+                // Begin a file or path
+                if (content == NULL)
+                {
+                    if (strEq(name, AZURE_XML_TAG_BLOB_STR))
+                        page->file = lstAdd(page->fileList, &(StorageAzureListFile){0});
+                    else
+                        page->path = strEq(name, AZURE_XML_TAG_BLOB_PREFIX_STR);
+                }
+                // End a file
+                else if (page->file != NULL)
+                {
+                    CHECK(FormatError, page->file->name != NULL, "file name missing");
+                    page->file = NULL;
+                }
+                // End a path
+                else
+                    page->path = false;
+
+                break;
+            }
+
+            // Children of a file or path
+            case 4:
+            {
+                if (page->file != NULL)
+                {
+                    if (content == NULL)
+                        page->property = strEq(name, AZURE_XML_TAG_PROPERTIES_STR);
+                    else if (page->property)
+                        page->property = false;
+                    else if (strEq(name, AZURE_XML_TAG_NAME_STR))
+                        page->file->name = strDup(content);
+                    else if (strEq(name, AZURE_XML_TAG_VERSION_ID_STR))
+                        page->file->versionId = strDup(content);
+                }
+                else if (page->path && content != NULL && strEq(name, AZURE_XML_TAG_NAME_STR))
+                    strLstAdd(page->pathList, content);
+
+                break;
+            }
+
+            // File properties
+            case 5:
+            {
+                if (page->property && content != NULL)
+                {
+                    if (strEq(name, AZURE_XML_TAG_LAST_MODIFIED_STR))
+                        page->file->timeModified = strDup(content);
+                    else if (strEq(name, AZURE_XML_TAG_CONTENT_LENGTH_STR))
+                        page->file->size = strDup(content);
+                }
+
+                break;
+            }
+        }
+    }
+    MEM_CONTEXT_END();
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 General function for listing files to be used by other list routines
 
@@ -410,15 +546,14 @@ storageAzureListInternal(
                 else
                     response = storageAzureRequestP(this, HTTP_VERB_GET_STR, .query = query);
 
-                const XmlNode *const xmlRoot = xmlDocumentRoot(xmlDocumentNewBuf(httpResponseContent(response)));
+                // Parse the page
+                StorageAzureListPage page = {.pathList = strLstNew(), .fileList = lstNewP(sizeof(StorageAzureListFile))};
+                xmlParse(ioBufferReadNewOpen(httpResponseContent(response)), storageAzureListPageCallback, &page);
 
                 // If a continuation marker exists then send an async request to get more data
-                const String *const continuationMarker = xmlNodeContent(
-                    xmlNodeChild(xmlRoot, AZURE_XML_TAG_NEXT_MARKER_STR, false));
-
-                if (!strEq(continuationMarker, EMPTY_STR))
+                if (page.continuationMarker != NULL && !strEmpty(page.continuationMarker))
                 {
-                    httpQueryPut(query, AZURE_QUERY_MARKER_STR, continuationMarker);
+                    httpQueryPut(query, AZURE_QUERY_MARKER_STR, page.continuationMarker);
 
                     // Store request in the outer temp context
                     MEM_CONTEXT_PRIOR_BEGIN()
@@ -428,25 +563,19 @@ storageAzureListInternal(
                     MEM_CONTEXT_PRIOR_END();
                 }
 
-                // Get prefix list
-                const XmlNode *const blobs = xmlNodeChild(xmlRoot, AZURE_XML_TAG_BLOBS_STR, true);
-                const XmlNodeList *const blobPrefixList = xmlNodeChildList(blobs, AZURE_XML_TAG_BLOB_PREFIX_STR);
-
-                for (unsigned int blobPrefixIdx = 0; blobPrefixIdx < xmlNodeLstSize(blobPrefixList); blobPrefixIdx++)
+                // Callback for paths
+                for (unsigned int pathIdx = 0; pathIdx < strLstSize(page.pathList); pathIdx++)
                 {
-                    const XmlNode *const subPathNode = xmlNodeLstGet(blobPrefixList, blobPrefixIdx);
+                    const String *const path = strLstGet(page.pathList, pathIdx);
 
-                    // Get path name
+                    // Strip off base prefix and final /
                     StorageInfo info =
                     {
                         .level = level,
-                        .name = xmlNodeContent(xmlNodeChild(subPathNode, AZURE_XML_TAG_NAME_STR, true)),
+                        .name = strSubN(path, strSize(basePrefix), strSize(path) - strSize(basePrefix) - 1),
                         .exists = true,
                     };
 
-                    // Strip off base prefix and final /
-                    info.name = strSubN(info.name, strSize(basePrefix), strSize(info.name) - strSize(basePrefix) - 1);
-
                     // Add type info if requested
                     if (level >= storageInfoLevelType)
                         info.type = storageTypePath;
@@ -455,16 +584,13 @@ storageAzureListInternal(
                     callback(callbackData, &info);
                 }
 
-                // Get file list
-                const XmlNodeList *const fileList = xmlNodeChildList(blobs, AZURE_XML_TAG_BLOB_STR);
-
-                for (unsigned int fileIdx = 0; fileIdx < xmlNodeLstSize(fileList); fileIdx++)
+                // Callback for files
+                for (unsigned int fileIdx = 0; fileIdx < lstSize(page.fileList); fileIdx++)
                 {
-                    const XmlNode *const fileNode = xmlNodeLstGet(fileList, fileIdx);
-                    const XmlNode *const property = xmlNodeChild(fileNode, AZURE_XML_TAG_PROPERTIES_STR, true);
+                    const StorageAzureListFile *const file = lstGet(page.fileList, fileIdx);
 
                     // Get file name and strip off the base prefix when present
-                    const String *name = xmlNodeContent(xmlNodeChild(fileNode, AZURE_XML_TAG_NAME_STR, true));
+                    const String *name = file->name;
 
                     if (!strEmpty(basePrefix))
                         name = strSub(name, strSize(basePrefix));
@@ -484,8 +610,8 @@ storageAzureListInternal(
                     // documentation so it does not seem to be a good idea to use it.
                     if (targetTime != 0)
                     {
-                        infoLast.timeModified = httpDateToTime(
-                            xmlNodeContent(xmlNodeChild(property, AZURE_XML_TAG_LAST_MODIFIED_STR, true)));
+                        CHECK(FormatError, file->timeModified != NULL, "file modified time missing");
+                        infoLast.timeModified = httpDateToTime(file->timeModified);
 
                         // Skip this version if it is newer than the time limit
                         if (infoLast.timeModified > targetTime)
@@ -499,19 +625,18 @@ storageAzureListInternal(
                     // Add basic info if requested (no need to add type info since file is default type)
                     if (level >= storageInfoLevelBasic)
                     {
-                        infoLast.size = cvtZToUInt64(
-                            strZ(xmlNodeContent(xmlNodeChild(property, AZURE_XML_TAG_CONTENT_LENGTH_STR, true))));
+                        CHECK(FormatError, file->size != NULL, "file size missing");
+                        infoLast.size = cvtZToUInt64(strZ(file->size));
 
                         if (targetTime == 0)
                         {
-                            infoLast.timeModified = httpDateToTime(
-                                xmlNodeContent(xmlNodeChild(property, AZURE_XML_TAG_LAST_MODIFIED_STR, true)));
+                            CHECK(FormatError, file->timeModified != NULL, "file modified time missing");
+                            infoLast.timeModified = httpDateToTime(file->timeModified);
                         }
                         else
                         {
-                            strCat(
-                                strTrunc(versionIdLast),
-                                xmlNodeContent(xmlNodeChild(fileNode, AZURE_XML_TAG_VERSION_ID_STR, true)));
+                            CHECK(FormatError, file->versionId != NULL, "file version id missing");
+                            strCat(strTrunc(versionIdLast), file->versionId);
                         }
                     }
                 }
@@ -749,11 +874,93 @@ storageAzureRemove(THIS_VOID, const String *const file, const StorageInterfaceRe
     FUNCTION_LOG_RETURN_VOID();
 }
 
+/***********************************************************************************************************************************
+Copy a blob within the container. Copies within a storage account are usually complete when the request returns but the copy may
+also be performed asynchronously, in which case the status is polled until the copy is done.
+
+Based on the documentation at https://learn.microsoft.com/en-us/rest/api/storageservices/copy-blob
+***********************************************************************************************************************************/
+static bool
+storageAzureCopy(THIS_VOID, StorageRead *const source, StorageWrite *const destination, const StorageInterfaceCopyParam param)
+{
+    THIS(StorageAzure);
+
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STORAGE_AZURE, this);
+        FUNCTION_LOG_PARAM(STORAGE_READ, source);
+        FUNCTION_LOG_PARAM(STORAGE_WRITE, destination);
+        (void)param;                                                // No parameters are used
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(source != NULL);
+    ASSERT(destination != NULL);
+
+    bool result = true;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // The source is authorized with the same SAS key as the request (shared key authorization covers the source implicitly)
+        String *const copySource = strCatFmt(
+            strNew(), "%s%s", strZ(this->copySourcePrefix),
+            strZ(httpUriEncode(strNewFmt("%s%s", strZ(this->pathPrefix), strZ(storageReadName(source))), true)));
+
+        if (this->sasKey != NULL)
+            strCatFmt(copySource, "?%s", strZ(httpQueryRenderP(this->sasKey)));
+
+        HttpResponse *response = storageAzureRequestP(
+            this, HTTP_VERB_PUT_STR, .path = storageWriteName(destination), .allowMissing = true, .tag = true,
+            .header = httpHeaderAdd(httpHeaderNew(this->headerRedactList), AZURE_HEADER_COPY_SOURCE_STR, copySource));
+
+        // Error when the source is missing unless ignoring missing
+        if (httpResponseCode(response) == HTTP_RESPONSE_CODE_NOT_FOUND)
+        {
+            if (!storageReadIgnoreMissing(source))
+                THROW_FMT(FileMissingError, STORAGE_ERROR_READ_MISSING, strZ(storageReadName(source)));
+
+            result = false;
+        }
+        else
+        {
+            // Poll the destination until the copy is no longer pending
+            Wait *const wait = waitNew(this->timeout);
+
+            while (strEq(httpHeaderGet(httpResponseHeader(response), AZURE_HEADER_COPY_STATUS_STR), AZURE_COPY_STATUS_PENDING_STR))
+            {
+                if (!waitMore(wait))
+                {
+                    THROW_FMT(
+                        FileWriteError, "timeout copying '%s' to '%s'", strZ(storageReadName(source)),
+                        strZ(storageWriteName(destination)));
+                }
+
+                httpResponseFree(response);
+                response = storageAzureRequestP(this, HTTP_VERB_HEAD_STR, .path = storageWriteName(destination));
+            }
+
+            // Error when the copy failed or was aborted
+            const String *const status = httpHeaderGet(httpResponseHeader(response), AZURE_HEADER_COPY_STATUS_STR);
+
+            if (!strEq(status, AZURE_COPY_STATUS_SUCCESS_STR))
+            {
+                THROW_FMT(
+                    FileWriteError, "unable to copy '%s' to '%s': status '%s' (%s)", strZ(storageReadName(source)),
+                    strZ(storageWriteName(destination)), strZNull(status),
+                    strZNull(httpHeaderGet(httpResponseHeader(response), AZURE_HEADER_COPY_STATUS_DESCRIPTION_STR)));
+            }
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN(BOOL, result);
+}
+
 /**********************************************************************************************************************************/
 static const StorageInterface storageInterfaceAzure =
 {
     .feature = 1 << storageFeatureVersioning,
 
+    .copy = storageAzureCopy,
     .info = storageAzureInfo,
     .list = storageAzureList,
     .newRead = storageAzureNewRead,
@@ -808,8 +1015,12 @@ storageAzureNew(
             .pathPrefix =
                 uriStyle == storageAzureUriStyleHost ?
                     strNewFmt("/%s", strZ(container)) : strNewFmt("/%s/%s", strZ(account), strZ(container)),
+            .timeout = timeout,
         };
 
+        this->copySourcePrefix =
+            port == 443 ? strNewFmt("https://%s", strZ(this->host)) : strNewFmt("https://%s:%u", strZ(this->host), port);
+
         // Create tag query string
         if (tag != NULL)
         {
@@ -835,6 +1046,7 @@ storageAzureNew(
         this->headerRedactList = strLstNew();
         strLstAdd(this->headerRedactList, HTTP_HEADER_AUTHORIZATION_STR);
         strLstAdd(this->headerRedactList, HTTP_HEADER_DATE_STR);
+        strLstAdd(this->headerRedactList, AZURE_HEADER_COPY_SOURCE_STR);
 
         // Create list of redacted query keys
         this->queryRedactList = strLstNew();
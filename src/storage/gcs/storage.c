@@ -47,6 +47,7 @@ STRING_EXTERN(GCS_QUERY_MEDIA_STR,                                  GCS_QUERY_ME
 STRING_EXTERN(GCS_QUERY_NAME_STR,                                   GCS_QUERY_NAME);
 STRING_STATIC(GCS_QUERY_PAGE_TOKEN_STR,                             "pageToken");
 STRING_STATIC(GCS_QUERY_PREFIX_STR,                                 "prefix");
+STRING_STATIC(GCS_QUERY_REWRITE_TOKEN_STR,                          "rewriteToken");
 STRING_EXTERN(GCS_QUERY_UPLOAD_ID_STR,                              GCS_QUERY_UPLOAD_ID);
 STRING_STATIC(GCS_QUERY_VERSIONS_STR,                               "versions");
 STRING_STATIC(GCS_QUERY_USER_PROJECT_STR,                           "userProject");
@@ -56,19 +57,20 @@ JSON tokens
 ***********************************************************************************************************************************/
 VARIANT_STRDEF_STATIC(GCS_JSON_ACCESS_TOKEN_VAR,                    "access_token");
 VARIANT_STRDEF_STATIC(GCS_JSON_CLIENT_EMAIL_VAR,                    "client_email");
+#define GCS_JSON_DONE                                               "done"
+VARIANT_STRDEF_STATIC(GCS_JSON_DONE_VAR,                            GCS_JSON_DONE);
 VARIANT_STRDEF_STATIC(GCS_JSON_ERROR_VAR,                           "error");
 VARIANT_STRDEF_STATIC(GCS_JSON_ERROR_DESCRIPTION_VAR,               "error_description");
 VARIANT_STRDEF_STATIC(GCS_JSON_EXPIRES_IN_VAR,                      "expires_in");
 #define GCS_JSON_ITEMS                                              "items"
-VARIANT_STRDEF_STATIC(GCS_JSON_ITEMS_VAR,                           GCS_JSON_ITEMS);
 VARIANT_STRDEF_EXTERN(GCS_JSON_GENERATION_VAR,                      GCS_JSON_GENERATION);
 VARIANT_STRDEF_EXTERN(GCS_JSON_MD5_HASH_VAR,                        GCS_JSON_MD5_HASH);
 VARIANT_STRDEF_EXTERN(GCS_JSON_NAME_VAR,                            GCS_JSON_NAME);
 #define GCS_JSON_NEXT_PAGE_TOKEN                                    "nextPageToken"
-VARIANT_STRDEF_STATIC(GCS_JSON_NEXT_PAGE_TOKEN_VAR,                 GCS_JSON_NEXT_PAGE_TOKEN);
 #define GCS_JSON_PREFIXES                                           "prefixes"
-VARIANT_STRDEF_STATIC(GCS_JSON_PREFIXES_VAR,                        GCS_JSON_PREFIXES);
 VARIANT_STRDEF_STATIC(GCS_JSON_PRIVATE_KEY_VAR,                     "private_key");
+#define GCS_JSON_REWRITE_TOKEN                                      "rewriteToken"
+VARIANT_STRDEF_STATIC(GCS_JSON_REWRITE_TOKEN_VAR,                   GCS_JSON_REWRITE_TOKEN);
 VARIANT_STRDEF_EXTERN(GCS_JSON_SIZE_VAR,                            GCS_JSON_SIZE);
 VARIANT_STRDEF_STATIC(GCS_JSON_TOKEN_TYPE_VAR,                      "token_type");
 VARIANT_STRDEF_STATIC(GCS_JSON_TOKEN_URI_VAR,                       "token_uri");
@@ -623,6 +625,105 @@ storageGcsInfoFile(StorageInfo *const info, const KeyValue *const file)
     FUNCTION_TEST_RETURN_VOID();
 }
 
+/***********************************************************************************************************************************
+Parse a page of list results. Paths and files are read directly from the JSON rather than building a variant tree, which uses much
+less memory and CPU when there are many files.
+***********************************************************************************************************************************/
+typedef struct StorageGcsListFile
+{
+    const String *name;                                             // File name
+    const String *timeModified;                                     // Time file was last modified
+    const String *size;                                             // File size
+    const String *versionId;                                        // Version id (generation)
+} StorageGcsListFile;
+
+typedef struct StorageGcsListPage
+{
+    StringList *pathList;                                           // Paths (prefixes)
+    List *fileList;                                                 // Files or versions
+    const String *nextPageToken;                                    // Token to get more results
+} StorageGcsListPage;
+
+static void
+storageGcsListPage(StorageGcsListPage *const page, const Buffer *const content)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, page);
+        FUNCTION_TEST_PARAM(BUFFER, content);
+    FUNCTION_TEST_END();
+
+    ASSERT(page != NULL);
+    ASSERT(content != NULL);
+
+    MEM_CONTEXT_BEGIN(lstMemContext(page->fileList))
+    {
+        JsonRead *const json = jsonReadNew(strNewBuf(content));
+
+        jsonReadObjectBegin(json);
+
+        while (jsonReadMore(json))
+        {
+            const String *const key = jsonReadKey(json);
+
+            // Token to get more results
+            if (strEqZ(key, GCS_JSON_NEXT_PAGE_TOKEN))
+                page->nextPageToken = jsonReadStr(json);
+            // Paths
+            else if (strEqZ(key, GCS_JSON_PREFIXES))
+            {
+                jsonReadArrayBegin(json);
+
+                while (jsonReadMore(json))
+                    strLstAdd(page->pathList, jsonReadStr(json));
+
+                jsonReadArrayEnd(json);
+            }
+            // Files or versions
+            else if (strEqZ(key, GCS_JSON_ITEMS))
+            {
+                jsonReadArrayBegin(json);
+
+                while (jsonReadMore(json))
+                {
+                    StorageGcsListFile file = {0};
+
+                    jsonReadObjectBegin(json);
+
+                    while (jsonReadMore(json))
+                    {
+                        const String *const fileKey = jsonReadKey(json);
+
+                        if (strEqZ(fileKey, GCS_JSON_NAME))
+                            file.name = jsonReadStr(json);
+                        else if (strEqZ(fileKey, GCS_JSON_UPDATED))
+                            file.timeModified = jsonReadStr(json);
+                        else if (strEqZ(fileKey, GCS_JSON_SIZE))
+                            file.size = jsonReadStr(json);
+                        else if (strEqZ(fileKey, GCS_JSON_GENERATION))
+                            file.versionId = jsonReadStr(json);
+                        else
+                            jsonReadSkip(json);
+                    }
+
+                    jsonReadObjectEnd(json);
+
+                    CHECK(FormatError, file.name != NULL, "file name missing");
+                    lstAdd(page->fileList, &file);
+                }
+
+                jsonReadArrayEnd(json);
+            }
+            else
+                jsonReadSkip(json);
+        }
+
+        jsonReadObjectEnd(json);
+    }
+    MEM_CONTEXT_END();
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 static void
 storageGcsListInternal(
     StorageGcs *const this, const String *const path, const StorageInfoLevel level, const String *const expression,
@@ -729,14 +830,14 @@ storageGcsListInternal(
                 else
                     response = storageGcsRequestP(this, HTTP_VERB_GET_STR, .query = query);
 
-                const KeyValue *const content = varKv(jsonToVar(strNewBuf(httpResponseContent(response))));
+                // Parse the page
+                StorageGcsListPage page = {.pathList = strLstNew(), .fileList = lstNewP(sizeof(StorageGcsListFile))};
+                storageGcsListPage(&page, httpResponseContent(response));
 
                 // If next page token exists then send an async request to get more data
-                const String *const nextPageToken = varStr(kvGet(content, GCS_JSON_NEXT_PAGE_TOKEN_VAR));
-
-                if (nextPageToken != NULL)
+                if (page.nextPageToken != NULL)
                 {
-                    httpQueryPut(query, GCS_QUERY_PAGE_TOKEN_STR, nextPageToken);
+                    httpQueryPut(query, GCS_QUERY_PAGE_TOKEN_STR, page.nextPageToken);
 
                     // Store request in the outer temp context
                     MEM_CONTEXT_PRIOR_BEGIN()
@@ -746,80 +847,75 @@ storageGcsListInternal(
                     MEM_CONTEXT_PRIOR_END();
                 }
 
-                // Get prefix list
-                const VariantList *const prefixList = varVarLst(kvGet(content, GCS_JSON_PREFIXES_VAR));
-
-                if (prefixList != NULL)
+                // Callback for paths
+                for (unsigned int pathIdx = 0; pathIdx < strLstSize(page.pathList); pathIdx++)
                 {
-                    for (unsigned int prefixIdx = 0; prefixIdx < varLstSize(prefixList); prefixIdx++)
-                    {
-                        // Get path name
-                        StorageInfo info =
-                        {
-                            .level = level,
-                            .name = varStr(varLstGet(prefixList, prefixIdx)),
-                            .exists = true,
-                        };
+                    const String *const path = strLstGet(page.pathList, pathIdx);
 
-                        // Strip off base prefix and final /
-                        info.name = strSubN(info.name, strSize(basePrefix), strSize(info.name) - strSize(basePrefix) - 1);
+                    // Strip off base prefix and final /
+                    StorageInfo info =
+                    {
+                        .level = level,
+                        .name = strSubN(path, strSize(basePrefix), strSize(path) - strSize(basePrefix) - 1),
+                        .exists = true,
+                    };
 
-                        // Add type info if requested
-                        if (level >= storageInfoLevelType)
-                            info.type = storageTypePath;
+                    // Add type info if requested
+                    if (level >= storageInfoLevelType)
+                        info.type = storageTypePath;
 
-                        // Callback with info
-                        callback(callbackData, &info);
-                    }
+                    // Callback with info
+                    callback(callbackData, &info);
                 }
 
-                // Get file list
-                const VariantList *const fileList = varVarLst(kvGet(content, GCS_JSON_ITEMS_VAR));
-
-                if (fileList != NULL)
+                // Callback for files
+                for (unsigned int fileIdx = 0; fileIdx < lstSize(page.fileList); fileIdx++)
                 {
-                    for (unsigned int fileIdx = 0; fileIdx < varLstSize(fileList); fileIdx++)
-                    {
-                        const KeyValue *const file = varKv(varLstGet(fileList, fileIdx));
-                        CHECK(FormatError, file != NULL, "file missing");
+                    const StorageGcsListFile *const file = lstGet(page.fileList, fileIdx);
 
-                        // Get file name and strip off the base prefix when present
-                        const String *name = varStr(kvGet(file, GCS_JSON_NAME_VAR));
-                        CHECK(FormatError, name != NULL, "file name missing");
+                    // Get file name and strip off the base prefix when present
+                    const String *name = file->name;
 
-                        if (!strEmpty(basePrefix))
-                            name = strSub(name, strSize(basePrefix));
+                    if (!strEmpty(basePrefix))
+                        name = strSub(name, strSize(basePrefix));
 
-                        // Return info for last file if new file
-                        if (infoLast.exists && !strEq(name, nameLast))
-                        {
-                            callback(callbackData, &infoLast);
-                            infoLast.exists = false;
-                        }
+                    // Return info for last file if new file
+                    if (infoLast.exists && !strEq(name, nameLast))
+                    {
+                        callback(callbackData, &infoLast);
+                        infoLast.exists = false;
+                    }
 
-                        // If targeting by time exclude versions that are newer than targetTime. Note that the API does not provide
-                        // delete markers so the filtering will also show files that have been deleted rather than replaced with a
-                        // new version.
-                        if (targetTime != 0)
-                        {
-                            infoLast.timeModified = storageGcsCvtTime(varStr(kvGet(file, GCS_JSON_UPDATED_VAR)));
+                    // If targeting by time exclude versions that are newer than targetTime. Note that the API does not provide
+                    // delete markers so the filtering will also show files that have been deleted rather than replaced with a
+                    // new version.
+                    if (targetTime != 0)
+                    {
+                        CHECK(FormatError, file->timeModified != NULL, "file modified time missing");
+                        infoLast.timeModified = storageGcsCvtTime(file->timeModified);
 
-                            // Skip this version if it is newer than the time limit
-                            if (infoLast.timeModified > targetTime)
-                                continue;
-                        }
+                        // Skip this version if it is newer than the time limit
+                        if (infoLast.timeModified > targetTime)
+                            continue;
+                    }
 
-                        // Update last name and set exists
-                        strCat(strTrunc(nameLast), name);
-                        infoLast.exists = true;
+                    // Update last name and set exists
+                    strCat(strTrunc(nameLast), name);
+                    infoLast.exists = true;
 
-                        // Add basic level info if requested
-                        if (level >= storageInfoLevelBasic)
-                        {
-                            storageGcsInfoFile(&infoLast, file);
+                    // Add basic level info if requested
+                    if (level >= storageInfoLevelBasic)
+                    {
+                        CHECK(FormatError, file->size != NULL, "file size missing");
+                        CHECK(FormatError, file->timeModified != NULL, "file modified time missing");
+
+                        infoLast.size = cvtZToUInt64(strZ(file->size));
+                        infoLast.timeModified = storageGcsCvtTime(file->timeModified);
 
-                            if (targetTime != 0)
-                                strCat(strTrunc(versionIdLast), varStr(kvGet(file, GCS_JSON_GENERATION_VAR)));
+                        if (targetTime != 0)
+                        {
+                            CHECK(FormatError, file->versionId != NULL, "file version id missing");
+                            strCat(strTrunc(versionIdLast), file->versionId);
                         }
                     }
                 }
@@ -1148,6 +1244,56 @@ storageGcsPathRemove(THIS_VOID, const String *const path, const bool recurse, co
     FUNCTION_LOG_RETURN(BOOL, true);
 }
 
+/**********************************************************************************************************************************/
+static void
+storageGcsRemoveList(
+    THIS_VOID, const String *const path, const StringList *const fileList, const StorageInterfaceRemoveListParam param)
+{
+    THIS(StorageGcs);
+
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STORAGE_GCS, this);
+        FUNCTION_LOG_PARAM(STRING, path);
+        FUNCTION_LOG_PARAM(STRING_LIST, fileList);
+        (void)param;                                                // No parameters are used
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(path != NULL);
+    ASSERT(fileList != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        StorageGcsPathRemoveData data =
+        {
+            .this = this,
+            .memContext = memContextCurrent(),
+            .path = strEq(path, FSLASH_STR) ? EMPTY_STR : path,
+        };
+
+        MEM_CONTEXT_TEMP_BEGIN()
+        {
+            // Add files to the batch as if they had been listed. A new batch is sent while the prior batch is still running.
+            for (unsigned int fileIdx = 0; fileIdx < strLstSize(fileList); fileIdx++)
+            {
+                storageGcsPathRemoveCallback(
+                    &data, &(StorageInfo){.name = strLstGet(fileList, fileIdx), .type = storageTypeFile, .exists = true});
+            }
+
+            // Call if there is more to be removed
+            if (data.contentList != NULL)
+                storageGcsPathRemoveInternal(&data);
+
+            // Check response on last async request
+            storageGcsPathRemoveInternal(&data);
+        }
+        MEM_CONTEXT_TEMP_END();
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
 /**********************************************************************************************************************************/
 static void
 storageGcsRemove(THIS_VOID, const String *const file, const StorageInterfaceRemoveParam param)
@@ -1170,17 +1316,83 @@ storageGcsRemove(THIS_VOID, const String *const file, const StorageInterfaceRemo
     FUNCTION_LOG_RETURN_VOID();
 }
 
+/***********************************************************************************************************************************
+Copy an object with the rewrite API. Large objects may require more than one request, in which case each response includes a token
+to continue the rewrite.
+
+Based on the documentation at https://cloud.google.com/storage/docs/json_api/v1/objects/rewrite
+***********************************************************************************************************************************/
+static bool
+storageGcsCopy(THIS_VOID, StorageRead *const source, StorageWrite *const destination, const StorageInterfaceCopyParam param)
+{
+    THIS(StorageGcs);
+
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STORAGE_GCS, this);
+        FUNCTION_LOG_PARAM(STORAGE_READ, source);
+        FUNCTION_LOG_PARAM(STORAGE_WRITE, destination);
+        (void)param;                                                // No parameters are used
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(source != NULL);
+    ASSERT(destination != NULL);
+
+    bool result = true;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        String *const path = storageGcsRequestPath(this, storageReadName(source), true, false);
+        strCatFmt(
+            path, "/rewriteTo/b/%s/o/%s", strZ(this->bucket), strZ(httpUriEncode(strSub(storageWriteName(destination), 1), false)));
+
+        const String *rewriteToken = NULL;
+
+        do
+        {
+            HttpQuery *const query = httpQueryAdd(
+                httpQueryNewP(), GCS_QUERY_FIELDS_STR, STRDEF(GCS_JSON_DONE "," GCS_JSON_REWRITE_TOKEN));
+
+            if (rewriteToken != NULL)
+                httpQueryAdd(query, GCS_QUERY_REWRITE_TOKEN_STR, rewriteToken);
+
+            HttpResponse *const response = storageGcsRequestP(
+                this, HTTP_VERB_POST_STR, .path = path, .query = query, .allowMissing = true);
+
+            // Error when the source is missing unless ignoring missing
+            if (httpResponseCode(response) == HTTP_RESPONSE_CODE_NOT_FOUND)
+            {
+                if (!storageReadIgnoreMissing(source))
+                    THROW_FMT(FileMissingError, STORAGE_ERROR_READ_MISSING, strZ(storageReadName(source)));
+
+                result = false;
+                break;
+            }
+
+            const KeyValue *const content = varKv(jsonToVar(strNewBuf(httpResponseContent(response))));
+
+            rewriteToken = varBool(kvGet(content, GCS_JSON_DONE_VAR)) ? NULL : varStr(kvGet(content, GCS_JSON_REWRITE_TOKEN_VAR));
+        }
+        while (rewriteToken != NULL);
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN(BOOL, result);
+}
+
 /**********************************************************************************************************************************/
 static const StorageInterface storageInterfaceGcs =
 {
     .feature = 1 << storageFeatureVersioning,
 
+    .copy = storageGcsCopy,
     .info = storageGcsInfo,
     .list = storageGcsList,
     .newRead = storageGcsNewRead,
     .newWrite = storageGcsNewWrite,
     .pathRemove = storageGcsPathRemove,
     .remove = storageGcsRemove,
+    .removeList = storageGcsRemoveList,
 };
 
 FN_EXTERN Storage *
@@ -24,6 +24,8 @@ struct StorageIterator
     time_t targetTime;                                              // List max version <= time
     const String *expression;                                       // Match expression
     RegExp *regExp;                                                 // Parsed match expression
+    unsigned int parallel;                                          // Max subpaths to list concurrently
+    List *prefetchList;                                             // Subpath lists retrieved ahead of when they are needed
 
     List *stack;                                                    // Stack of info lists
     bool returnedNext;                                              // Next info was returned
@@ -40,6 +42,80 @@ typedef struct StorageIteratorInfo
     bool pathContentSkip;                                           // Skip reading path content
 } StorageIteratorInfo;
 
+// Subpath list retrieved ahead of when it is needed
+typedef struct StorageIteratorPrefetch
+{
+    String *pathSub;                                                // Subpath
+    StorageList *list;                                              // Storage info list (NULL if the path is missing)
+} StorageIteratorPrefetch;
+
+/***********************************************************************************************************************************
+Get lists for the next subpaths in a list concurrently. Subpaths are listed depth-first so new lists are added to the front of the
+prefetch list where they will be consumed before the lists from the parent level.
+***********************************************************************************************************************************/
+static void
+storageItrPrefetch(StorageIterator *const this, const StorageIteratorInfo *const listInfo)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(STORAGE_ITERATOR, this);
+        FUNCTION_LOG_PARAM_P(VOID, listInfo);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(this->prefetchList != NULL);
+    ASSERT(listInfo != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Get the next subpaths in the list
+        StringList *const pathSubList = strLstNew();
+        StringList *const pathList = strLstNew();
+
+        for (unsigned int listIdx = listInfo->listIdx;
+             listIdx < storageLstSize(listInfo->list) && strLstSize(pathSubList) < this->parallel; listIdx++)
+        {
+            const StorageInfo info = storageLstGet(listInfo->list, listIdx);
+
+            if (info.type == storageTypePath)
+            {
+                const String *const pathSub =
+                    listInfo->pathSub == NULL ? info.name : strNewFmt("%s/%s", strZ(listInfo->pathSub), strZ(info.name));
+
+                strLstAdd(pathSubList, pathSub);
+                strLstAddFmt(pathList, "%s/%s", strZ(this->path), strZ(pathSub));
+            }
+        }
+
+        // Getting info from the list overwrites the name of the current info so get the current info again to restore it
+        storageLstGet(listInfo->list, listInfo->listIdx);
+
+        // Get the lists and add them to the front of the prefetch list
+        const List *const list = storageInterfaceListMultiP(
+            this->driver, pathList, this->level, .expression = this->expression, .targetTime = this->targetTime);
+        ASSERT(lstSize(list) == strLstSize(pathSubList));
+
+        MEM_CONTEXT_BEGIN(lstMemContext(this->prefetchList))
+        {
+            for (unsigned int listIdx = 0; listIdx < lstSize(list); listIdx++)
+            {
+                StorageList *const listPath = *(StorageList **)lstGet(list, listIdx);
+
+                lstInsert(
+                    this->prefetchList, listIdx,
+                    &(StorageIteratorPrefetch)
+                    {
+                        .pathSub = strDup(strLstGet(pathSubList, listIdx)),
+                        .list = listPath == NULL ? NULL : storageLstMove(listPath, memContextCurrent()),
+                    });
+            }
+        }
+        MEM_CONTEXT_END();
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Check a path and add it to the stack if it exists and has content
 ***********************************************************************************************************************************/
@@ -63,10 +139,26 @@ storageItrPathAdd(StorageIterator *const this, const String *const pathSub)
 
     MEM_CONTEXT_TEMP_BEGIN()
     {
-        // Get path content
-        StorageList *const list = storageInterfaceListP(
-            this->driver, pathSub == NULL ? this->path : strNewFmt("%s/%s", strZ(this->path), strZ(pathSub)), this->level,
-            .expression = this->expression, .targetTime = this->targetTime);
+        StorageList *list;
+
+        // Get path content from the prefetch list when it has already been retrieved
+        const StorageIteratorPrefetch *const prefetch =
+            pathSub == NULL || this->prefetchList == NULL || lstEmpty(this->prefetchList) ? NULL : lstGet(this->prefetchList, 0);
+
+        if (prefetch != NULL && strEq(prefetch->pathSub, pathSub))
+        {
+            list = prefetch->list == NULL ? NULL : storageLstMove(prefetch->list, memContextCurrent());
+
+            strFree(prefetch->pathSub);
+            lstRemoveIdx(this->prefetchList, 0);
+        }
+        // Else get path content
+        else
+        {
+            list = storageInterfaceListP(
+                this->driver, pathSub == NULL ? this->path : strNewFmt("%s/%s", strZ(this->path), strZ(pathSub)), this->level,
+                .expression = this->expression, .targetTime = this->targetTime);
+        }
 
         // If path exists
         if (list != NULL)
@@ -112,7 +204,8 @@ storageItrPathAdd(StorageIterator *const this, const String *const pathSub)
 FN_EXTERN StorageIterator *
 storageItrNew(
     void *const driver, const String *const path, const StorageInfoLevel level, const bool errorOnMissing, const bool nullOnMissing,
-    const bool recurse, const SortOrder sortOrder, const time_t targetTime, const String *const expression)
+    const bool recurse, const SortOrder sortOrder, const time_t targetTime, const String *const expression,
+    const unsigned int parallel)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM_P(VOID, driver);
@@ -124,6 +217,7 @@ storageItrNew(
         FUNCTION_LOG_PARAM(ENUM, sortOrder);
         FUNCTION_LOG_PARAM(TIME, targetTime);
         FUNCTION_LOG_PARAM(STRING, expression);
+        FUNCTION_LOG_PARAM(UINT, parallel);
     FUNCTION_LOG_END();
 
     ASSERT(driver != NULL);
@@ -152,6 +246,13 @@ storageItrNew(
                 .returnedNext = true,
             };
 
+            // Prefetch subpath lists when recursing in parallel and the driver supports it
+            if (recurse && parallel > 1 && STORAGE_COMMON_INTERFACE(driver).listMulti != NULL)
+            {
+                this->parallel = parallel;
+                this->prefetchList = lstNewP(sizeof(StorageIteratorPrefetch));
+            }
+
             // Compile regular expression
             if (this->expression != NULL)
                 this->regExp = regExpNew(this->expression);
@@ -212,9 +313,20 @@ storageItrMore(StorageIterator *const this)
             }
 
             // Does the path have content?
-            const bool pathContent =
-                this->infoNext.type == storageTypePath && this->recurse && !listInfo->pathContentSkip &&
-                storageItrPathAdd(this, this->infoNext.name).content;
+            bool pathContent = false;
+
+            if (this->infoNext.type == storageTypePath && this->recurse && !listInfo->pathContentSkip)
+            {
+                // Get the lists for this and the following subpaths concurrently if they have not already been retrieved
+                if (this->prefetchList != NULL &&
+                    (lstEmpty(this->prefetchList) ||
+                     !strEq(((StorageIteratorPrefetch *)lstGet(this->prefetchList, 0))->pathSub, this->infoNext.name)))
+                {
+                    storageItrPrefetch(this, listInfo);
+                }
+
+                pathContent = storageItrPathAdd(this, this->infoNext.name).content;
+            }
 
             // Clear path content skip flag if it was set on a previous iteration
             listInfo->pathContentSkip = false;
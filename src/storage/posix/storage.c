@@ -27,6 +27,13 @@ Define PATH_MAX if it is not defined
 #define PATH_MAX                                                    (4 * 1024)
 #endif
 
+/***********************************************************************************************************************************
+Declare syncfs() since it is only declared by unistd.h when _GNU_SOURCE is defined
+***********************************************************************************************************************************/
+#ifdef HAVE_SYNCFS
+int syncfs(int fd);
+#endif
+
 /***********************************************************************************************************************************
 Object type
 ***********************************************************************************************************************************/
@@ -380,8 +387,11 @@ storagePosixNewWrite(THIS_VOID, const String *const file, const StorageInterface
         FUNCTION_LOG_PARAM(BOOL, param.createPath);
         FUNCTION_LOG_PARAM(BOOL, param.syncFile);
         FUNCTION_LOG_PARAM(BOOL, param.syncPath);
+        FUNCTION_LOG_PARAM(BOOL, param.syncDefer);
         FUNCTION_LOG_PARAM(BOOL, param.atomic);
         FUNCTION_LOG_PARAM(BOOL, param.truncate);
+        FUNCTION_LOG_PARAM(UINT64, param.preallocate);
+        FUNCTION_LOG_PARAM(SIZE, param.sparseSize);
     FUNCTION_LOG_END();
 
     ASSERT(this != NULL);
@@ -391,7 +401,8 @@ storagePosixNewWrite(THIS_VOID, const String *const file, const StorageInterface
         STORAGE_WRITE,
         storageWritePosixNew(
             this, file, param.modeFile, param.modePath, param.user, param.group, param.timeModified, param.createPath,
-            param.syncFile, this->interface.pathSync != NULL ? param.syncPath : false, param.atomic, param.truncate));
+            param.syncFile, this->interface.pathSync != NULL ? param.syncPath : false, param.syncDefer, param.atomic,
+            param.truncate, param.preallocate, param.sparseSize));
 }
 
 /**********************************************************************************************************************************/
@@ -504,6 +515,25 @@ storagePosixPathRemove(THIS_VOID, const String *const path, const bool recurse,
     FUNCTION_LOG_RETURN(BOOL, result);
 }
 
+/***********************************************************************************************************************************
+Sync the file system containing the file descriptor. Only called when storageFeatureFileSystemSync is enabled.
+***********************************************************************************************************************************/
+static int
+storagePosixFileSystemSync(const int fd)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(INT, fd);
+    FUNCTION_TEST_END();
+
+#ifdef HAVE_SYNCFS
+    FUNCTION_TEST_RETURN(INT, syncfs(fd));
+#else
+    (void)fd;                                                                                                       // {uncoverable}
+    errno = ENOSYS;                                                                                                 // {uncoverable}
+    FUNCTION_TEST_RETURN(INT, -1);                                                                                  // {uncoverable}
+#endif
+}
+
 /**********************************************************************************************************************************/
 static void
 storagePosixPathSync(THIS_VOID, const String *const path, const StorageInterfacePathSyncParam param)
@@ -513,7 +543,7 @@ storagePosixPathSync(THIS_VOID, const String *const path, const StorageInterface
     FUNCTION_LOG_BEGIN(logLevelTrace);
         FUNCTION_LOG_PARAM(STORAGE_POSIX, this);
         FUNCTION_LOG_PARAM(STRING, path);
-        (void)param;                                                // No parameters are used
+        FUNCTION_LOG_PARAM(BOOL, param.fileSystem);
     FUNCTION_LOG_END();
 
     ASSERT(this != NULL);
@@ -532,15 +562,16 @@ storagePosixPathSync(THIS_VOID, const String *const path, const StorageInterface
     }
     else
     {
-        // Attempt to sync the directory
-        if (fsync(fd) == -1)
+        // Attempt to sync the directory or the file system containing the directory
+        if ((param.fileSystem ? storagePosixFileSystemSync(fd) : fsync(fd)) == -1)
         {
             const int errNo = errno;
 
             // Close the file descriptor to free resources but don't check for failure
             close(fd);
 
-            THROW_SYS_ERROR_CODE_FMT(errNo, PathSyncError, STORAGE_ERROR_PATH_SYNC, strZ(path));
+            THROW_SYS_ERROR_CODE_FMT(
+                errNo, PathSyncError, param.fileSystem ? STORAGE_ERROR_PATH_SYNC_FILE_SYSTEM : STORAGE_ERROR_PATH_SYNC, strZ(path));
         }
 
         THROW_ON_SYS_ERROR_FMT(close(fd) == -1, PathCloseError, STORAGE_ERROR_PATH_SYNC_CLOSE, strZ(path));
@@ -633,6 +664,12 @@ storagePosixNewInternal(
             this->interface.feature |=
                 1 << storageFeatureHardLink | (unsigned int)symLink << storageFeatureSymLink | 1 << storageFeaturePathSync |
                 1 << storageFeatureInfoDetail;
+
+#ifdef HAVE_SYNCFS
+            // The file system is synced through path sync so it is not available when path sync is disabled
+            if (pathSync)
+                this->interface.feature |= 1 << storageFeatureFileSystemSync;
+#endif
         }
     }
     OBJ_NEW_END();
@@ -3,8 +3,10 @@ Posix Storage File write
 ***********************************************************************************************************************************/
 #include "build.auto.h"
 
+#include <errno.h>
 #include <fcntl.h>
 #include <stdio.h>
+#include <string.h>
 #include <unistd.h>
 #include <utime.h>
 
@@ -27,6 +29,11 @@ typedef struct StorageWritePosix
     const String *nameTmp;
     const String *path;
     int fd;                                                         // File descriptor
+
+    uint64_t preallocate;                                           // Size to preallocate
+    size_t sparseSize;                                              // Size of zero blocks to skip (0 to write all blocks)
+    uint64_t offset;                                                // Current offset in the file (when sparse)
+    uint64_t sparseSkip;                                            // Zero bytes skipped since the last write (when sparse)
 } StorageWritePosix;
 
 /***********************************************************************************************************************************
@@ -151,12 +158,94 @@ storageWritePosixOpen(THIS_VOID)
         MEM_CONTEXT_TEMP_END();
     }
 
+    // Preallocate the file. Errors indicating that preallocation is not supported are ignored since preallocation is only a hint.
+    if (this->preallocate != 0)
+    {
+        const int result = posix_fallocate(this->fd, 0, (off_t)this->preallocate);
+
+        if (result != 0 && result != EINVAL && result != EOPNOTSUPP)
+            THROW_SYS_ERROR_CODE_FMT(result, FileWriteError, "unable to preallocate '%s'", strZ(this->nameTmp));
+    }
+
     FUNCTION_LOG_RETURN_VOID();
 }
 
 /***********************************************************************************************************************************
 Write to the file
 ***********************************************************************************************************************************/
+// Write data at the current offset after seeking past any skipped zero blocks
+static void
+storageWritePosixData(StorageWritePosix *const this, const unsigned char *const data, const size_t size)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_WRITE_POSIX, this);
+        FUNCTION_TEST_PARAM_P(VOID, data);
+        FUNCTION_TEST_PARAM(SIZE, size);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(data != NULL);
+
+    if (this->sparseSkip != 0)
+    {
+        THROW_ON_SYS_ERROR_FMT(
+            lseek(this->fd, (off_t)this->sparseSkip, SEEK_CUR) == -1, FileWriteError, "unable to seek '%s'", strZ(this->nameTmp));
+
+        this->sparseSkip = 0;
+    }
+
+    if (write(this->fd, data, size) != (ssize_t)size)
+        THROW_SYS_ERROR_FMT(FileWriteError, "unable to write '%s'", strZ(this->nameTmp));
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+// Write data while skipping blocks that contain only zeros. Blocks are aligned on the offset in the file and contiguous data is
+// written in a single write.
+static void
+storageWritePosixSparse(StorageWritePosix *const this, const Buffer *const buffer)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_WRITE_POSIX, this);
+        FUNCTION_TEST_PARAM(BUFFER, buffer);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(buffer != NULL);
+
+    const unsigned char *const data = bufPtrConst(buffer);
+    size_t dataIdx = 0;
+    size_t writeIdx = 0;
+
+    while (dataIdx < bufUsed(buffer))
+    {
+        // Size of data up to the next block boundary
+        size_t blockSize = this->sparseSize - (size_t)(this->offset % this->sparseSize);
+
+        if (blockSize > bufUsed(buffer) - dataIdx)
+            blockSize = bufUsed(buffer) - dataIdx;
+
+        // Skip complete blocks that contain only zeros after writing the data before them
+        if (blockSize == this->sparseSize && data[dataIdx] == 0 && memcmp(data + dataIdx, data + dataIdx + 1, blockSize - 1) == 0)
+        {
+            if (dataIdx != writeIdx)
+                storageWritePosixData(this, data + writeIdx, dataIdx - writeIdx);
+
+            this->sparseSkip += blockSize;
+            writeIdx = dataIdx + blockSize;
+        }
+
+        dataIdx += blockSize;
+        this->offset += blockSize;
+    }
+
+    // Write remaining data
+    if (dataIdx != writeIdx)
+        storageWritePosixData(this, data + writeIdx, dataIdx - writeIdx);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 static void
 storageWritePosix(THIS_VOID, const Buffer *const buffer)
 {
@@ -172,7 +261,9 @@ storageWritePosix(THIS_VOID, const Buffer *const buffer)
     ASSERT(this->fd != -1);
 
     // Write the data
-    if (write(this->fd, bufPtrConst(buffer), bufUsed(buffer)) != (ssize_t)bufUsed(buffer))
+    if (this->sparseSize != 0)
+        storageWritePosixSparse(this, buffer);
+    else if (write(this->fd, bufPtrConst(buffer), bufUsed(buffer)) != (ssize_t)bufUsed(buffer))
         THROW_SYS_ERROR_FMT(FileWriteError, "unable to write '%s'", strZ(this->nameTmp));
 
     FUNCTION_LOG_RETURN_VOID();
@@ -195,8 +286,20 @@ storageWritePosixClose(THIS_VOID)
     // Close if the file has not already been closed
     if (this->fd != -1)
     {
-        // Sync the file
-        if (this->interface.syncFile)
+        // Set the file size when it ends with skipped zero blocks or was preallocated. If preallocated, this also frees any space
+        // preallocated past the end of the file.
+        if (this->sparseSkip != 0 || (this->preallocate != 0 && this->sparseSize != 0))
+        {
+            THROW_ON_SYS_ERROR_FMT(
+                ftruncate(this->fd, (off_t)this->offset) == -1, FileWriteError, "unable to truncate '%s'", strZ(this->nameTmp));
+        }
+
+        // When the sync is deferred start writing the file to disk now so there is less to do when the file system is synced. This
+        // is only advice so errors are ignored.
+        if (this->interface.syncDefer)
+            posix_fadvise(this->fd, 0, 0, POSIX_FADV_DONTNEED);
+        // Else sync the file
+        else if (this->interface.syncFile)
             THROW_ON_SYS_ERROR_FMT(fsync(this->fd) == -1, FileSyncError, STORAGE_ERROR_WRITE_SYNC, strZ(this->nameTmp));
 
         // Close the file
@@ -251,7 +354,7 @@ FN_EXTERN StorageWrite *
 storageWritePosixNew(
     StoragePosix *const storage, const String *const name, const mode_t modeFile, const mode_t modePath, const String *const user,
     const String *const group, const time_t timeModified, const bool createPath, const bool syncFile, const bool syncPath,
-    const bool atomic, const bool truncate)
+    const bool syncDefer, const bool atomic, const bool truncate, const uint64_t preallocate, const size_t sparseSize)
 {
     FUNCTION_LOG_BEGIN(logLevelTrace);
         FUNCTION_LOG_PARAM(STORAGE_POSIX, storage);
@@ -264,8 +367,11 @@ storageWritePosixNew(
         FUNCTION_LOG_PARAM(BOOL, createPath);
         FUNCTION_LOG_PARAM(BOOL, syncFile);
         FUNCTION_LOG_PARAM(BOOL, syncPath);
+        FUNCTION_LOG_PARAM(BOOL, syncDefer);
         FUNCTION_LOG_PARAM(BOOL, atomic);
         FUNCTION_LOG_PARAM(BOOL, truncate);
+        FUNCTION_LOG_PARAM(UINT64, preallocate);
+        FUNCTION_LOG_PARAM(SIZE, sparseSize);
     FUNCTION_LOG_END();
 
     ASSERT(storage != NULL);
@@ -280,6 +386,8 @@ storageWritePosixNew(
             .storage = storage,
             .path = strPath(name),
             .fd = -1,
+            .preallocate = preallocate,
+            .sparseSize = sparseSize,
 
             .interface = (StorageWriteInterface)
             {
@@ -292,6 +400,7 @@ storageWritePosixNew(
                 .modePath = modePath,
                 .syncFile = syncFile,
                 .syncPath = syncPath,
+                .syncDefer = syncDefer,
                 .truncate = truncate,
                 .user = strDup(user),
                 .timeModified = timeModified,
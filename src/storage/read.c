@@ -6,9 +6,16 @@ Storage Read Interface
 #include "common/debug.h"
 #include "common/log.h"
 #include "common/memContext.h"
+#include "common/stat.h"
+#include "common/time.h"
 #include "common/wait.h"
 #include "storage/read.h"
 
+/***********************************************************************************************************************************
+Statistics constants
+***********************************************************************************************************************************/
+STRING_EXTERN(STORAGE_STAT_READ_STR,                                STORAGE_STAT_READ);
+
 /***********************************************************************************************************************************
 Object type
 ***********************************************************************************************************************************/
@@ -17,6 +24,7 @@ struct StorageRead
     StorageReadPub pub;                                             // Publicly accessible variables
     void *driver;                                                   // Driver
     uint64_t bytesRead;                                             // Bytes that have been successfully read
+    TimeUSec time;                                                  // Time spent reading
 };
 
 /***********************************************************************************************************************************
@@ -60,6 +68,7 @@ storageRead(THIS_VOID, Buffer *const buffer, const bool block)
 
     ASSERT(this != NULL);
 
+    const TimeUSec timeBegin = timeUSec();
     const size_t bufUsedBegin = bufUsed(buffer);
     size_t result = 0;
 
@@ -126,6 +135,8 @@ storageRead(THIS_VOID, Buffer *const buffer, const bool block)
     }
     MEM_CONTEXT_TEMP_END();
 
+    this->time += timeUSec() - timeBegin;
+
     FUNCTION_LOG_RETURN(SIZE, result);
 }
 
@@ -143,8 +154,13 @@ storageReadClose(THIS_VOID)
 
     ASSERT(this != NULL);
 
+    const TimeUSec timeBegin = timeUSec();
+
     this->pub.interface->ioInterface.close(this->driver);
 
+    // Record time spent reading the file
+    statTime(STORAGE_STAT_READ_STR, this->time + timeUSec() - timeBegin);
+
     FUNCTION_LOG_RETURN_VOID();
 }
 
@@ -235,6 +251,22 @@ storageReadNew(void *const driver, StorageReadInterface *const interface)
     FUNCTION_LOG_RETURN(STORAGE_READ, this);
 }
 
+/**********************************************************************************************************************************/
+FN_EXTERN void
+storageReadStorageDriverSet(StorageRead *const this, const void *const storageDriver)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_READ, this);
+        FUNCTION_TEST_PARAM_P(VOID, storageDriver);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    this->pub.storageDriver = storageDriver;
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN void
 storageReadToLog(const StorageRead *const this, StringStatic *const debugLog)
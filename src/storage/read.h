@@ -14,6 +14,12 @@ typedef struct StorageRead StorageRead;
 #include "common/type/stringId.h"
 #include "storage/read.intern.h"
 
+/***********************************************************************************************************************************
+Statistics constants
+***********************************************************************************************************************************/
+#define STORAGE_STAT_READ                                           "storage.read"      // Time spent reading files
+STRING_DECLARE(STORAGE_STAT_READ_STR);
+
 /***********************************************************************************************************************************
 Functions
 ***********************************************************************************************************************************/
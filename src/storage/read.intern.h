@@ -36,6 +36,7 @@ typedef struct StorageReadPub
     uint64_t offset;                                                // Where to start reading in the file
     const Variant *limit;                                           // Limit how many bytes are read (NULL for no limit)
     bool ignoreMissing;                                             // Ignore missing file?
+    const void *storageDriver;                                      // Driver of the storage that created the read
 } StorageReadPub;
 
 // Read interface
@@ -45,4 +46,13 @@ storageReadInterface(const StorageRead *const this)
     return THIS_PUB(StorageRead)->interface;
 }
 
+// Driver of the storage that created the read (NULL when not created by storageNewRead())
+FN_INLINE_ALWAYS const void *
+storageReadStorageDriver(const StorageRead *const this)
+{
+    return THIS_PUB(StorageRead)->storageDriver;
+}
+
+FN_EXTERN void storageReadStorageDriverSet(StorageRead *this, const void *storageDriver);
+
 #endif
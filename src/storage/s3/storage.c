@@ -7,6 +7,7 @@ S3 Storage
 
 #include "common/crypto/hash.h"
 #include "common/debug.h"
+#include "common/io/bufferRead.h"
 #include "common/io/http/client.h"
 #include "common/io/http/common.h"
 #include "common/io/socket/client.h"
@@ -25,10 +26,17 @@ Defaults
 ***********************************************************************************************************************************/
 #define STORAGE_S3_DELETE_MAX                                       1000
 
+// Maximum size of an object that can be copied in a single request
+#define STORAGE_S3_COPY_SIZE_MAX                                    ((uint64_t)5 * 1024 * 1024 * 1024)
+
 /***********************************************************************************************************************************
 S3 HTTP headers
 ***********************************************************************************************************************************/
 STRING_STATIC(S3_HEADER_CONTENT_SHA256_STR,                         "x-amz-content-sha256");
+STRING_STATIC(S3_HEADER_COPY_SOURCE_STR,                            "x-amz-copy-source");
+STRING_STATIC(S3_HEADER_COPY_SSECUSTKEY_ALGO_STR,                   "x-amz-copy-source-server-side-encryption-customer-algorithm");
+STRING_STATIC(S3_HEADER_COPY_SSECUSTKEY_KEY_STR,                    "x-amz-copy-source-server-side-encryption-customer-key");
+STRING_STATIC(S3_HEADER_COPY_SSECUSTKEY_KEY_MD5_STR,                "x-amz-copy-source-server-side-encryption-customer-key-md5");
 STRING_STATIC(S3_HEADER_DATE_STR,                                   "x-amz-date");
 STRING_STATIC(S3_HEADER_TOKEN_STR,                                  "x-amz-security-token");
 STRING_STATIC(S3_HEADER_SRVSDENC_STR,                               "x-amz-server-side-encryption");
@@ -59,6 +67,7 @@ XML tags
 ***********************************************************************************************************************************/
 STRING_STATIC(S3_XML_TAG_COMMON_PREFIXES_STR,                       "CommonPrefixes");
 STRING_STATIC(S3_XML_TAG_CONTENTS_STR,                              "Contents");
+STRING_STATIC(S3_XML_TAG_COPY_OBJECT_RESULT_STR,                    "CopyObjectResult");
 STRING_STATIC(S3_XML_TAG_DELETE_STR,                                "Delete");
 STRING_STATIC(S3_XML_TAG_DELETE_MARKER_STR,                         "DeleteMarker");
 STRING_STATIC(S3_XML_TAG_ERROR_STR,                                 "Error");
@@ -626,29 +635,114 @@ storageS3Request(StorageS3 *const this, const String *const verb, const String *
 }
 
 /***********************************************************************************************************************************
-General function for listing files to be used by other list routines
+Parse a page of list results. Paths and files are collected as the page is parsed rather than building a document tree, which uses
+much less memory and CPU when there are many files.
 ***********************************************************************************************************************************/
+typedef struct StorageS3ListFile
+{
+    const String *name;                                             // File name
+    const String *timeModified;                                     // Time file was last modified
+    const String *size;                                             // File size
+    const String *versionId;                                        // Version id
+    bool deleteMarker;                                              // Is this a delete marker?
+} StorageS3ListFile;
+
+typedef struct StorageS3ListPage
+{
+    StringList *pathList;                                           // Paths (common prefixes)
+    List *fileList;                                                 // Files or versions
+    bool truncated;                                                 // Are there more results?
+    const String *continuationToken;                                // Token to get more results
+    StorageS3ListFile *file;                                        // File currently being parsed
+    bool path;                                                      // Is a path currently being parsed?
+} StorageS3ListPage;
+
 static void
-storageS3ListInternal(
-    StorageS3 *const this, const String *const path, const StorageInfoLevel level, const String *const expression,
-    const bool recurse, const time_t targetTime, StorageListCallback callback, void *const callbackData)
+storageS3ListPageCallback(void *const callbackData, const unsigned int depth, const String *const name, const String *const content)
 {
-    FUNCTION_LOG_BEGIN(logLevelDebug);
-        FUNCTION_LOG_PARAM(STORAGE_S3, this);
-        FUNCTION_LOG_PARAM(STRING, path);
-        FUNCTION_LOG_PARAM(ENUM, level);
-        FUNCTION_LOG_PARAM(STRING, expression);
-        FUNCTION_LOG_PARAM(BOOL, recurse);
-        FUNCTION_LOG_PARAM(TIME, targetTime);
-        FUNCTION_LOG_PARAM(FUNCTIONP, callback);
-        FUNCTION_LOG_PARAM_P(VOID, callbackData);
-    FUNCTION_LOG_END();
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, callbackData);
+        FUNCTION_TEST_PARAM(UINT, depth);
+        FUNCTION_TEST_PARAM(STRING, name);
+        FUNCTION_TEST_PARAM(STRING, content);
+    FUNCTION_TEST_END();
 
-    FUNCTION_AUDIT_CALLBACK();
+    ASSERT(callbackData != NULL);
+    ASSERT(name != NULL);
+
+    StorageS3ListPage *const page = callbackData;
+
+    MEM_CONTEXT_BEGIN(lstMemContext(page->fileList))
+    {
+        // Children of the list result
+        if (depth == 2)
+        {
+            // Begin a file, version, or path
+            if (content == NULL)
+            {
+                if (strEq(name, S3_XML_TAG_CONTENTS_STR) || strEq(name, S3_XML_TAG_VERSION_STR) ||
+                    strEq(name, S3_XML_TAG_DELETE_MARKER_STR))
+                {
+                    page->file = lstAdd(
+                        page->fileList, &(StorageS3ListFile){.deleteMarker = strEq(name, S3_XML_TAG_DELETE_MARKER_STR)});
+                }
+                else
+                    page->path = strEq(name, S3_XML_TAG_COMMON_PREFIXES_STR);
+            }
+            // End a file or version
+            else if (page->file != NULL)
+            {
+                CHECK(FormatError, page->file->name != NULL, "file name missing");
+                page->file = NULL;
+            }
+            // End a path
+            else if (page->path)
+                page->path = false;
+            else if (strEq(name, S3_XML_TAG_IS_TRUNCATED_STR))
+                page->truncated = strEq(content, TRUE_STR);
+            else if (strEq(name, S3_XML_TAG_NEXT_CONTINUATION_TOKEN_STR))
+                page->continuationToken = strDup(content);
+        }
+        // Children of a file/version or path
+        else if (depth == 3 && content != NULL)
+        {
+            if (page->file != NULL)
+            {
+                if (strEq(name, S3_XML_TAG_KEY_STR))
+                    page->file->name = strDup(content);
+                else if (strEq(name, S3_XML_TAG_LAST_MODIFIED_STR))
+                    page->file->timeModified = strDup(content);
+                else if (strEq(name, S3_XML_TAG_SIZE_STR))
+                    page->file->size = strDup(content);
+                else if (strEq(name, S3_XML_TAG_VERSION_ID_STR))
+                    page->file->versionId = strDup(content);
+            }
+            else if (page->path && strEq(name, S3_XML_TAG_PREFIX_STR))
+                strLstAdd(page->pathList, content);
+        }
+    }
+    MEM_CONTEXT_END();
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Build the query for the first page of a list
+***********************************************************************************************************************************/
+static HttpQuery *
+storageS3ListQuery(const String *const path, const String *const expression, const bool recurse, const time_t targetTime)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING, path);
+        FUNCTION_TEST_PARAM(STRING, expression);
+        FUNCTION_TEST_PARAM(BOOL, recurse);
+        FUNCTION_TEST_PARAM(TIME, targetTime);
+    FUNCTION_TEST_END();
 
-    ASSERT(this != NULL);
     ASSERT(path != NULL);
 
+    HttpQuery *const result = httpQueryNewP();
+
     MEM_CONTEXT_TEMP_BEGIN()
     {
         // Build the base prefix by stripping off the initial /
@@ -670,22 +764,58 @@ storageS3ListInternal(
                 queryPrefix = strNewFmt("%s%s", strZ(basePrefix), strZ(expressionPrefix));
         }
 
-        // Create query
-        HttpQuery *const query = httpQueryNewP();
-
         // Add the delimiter to not recurse
         if (!recurse)
-            httpQueryAdd(query, S3_QUERY_DELIMITER_STR, FSLASH_STR);
+            httpQueryAdd(result, S3_QUERY_DELIMITER_STR, FSLASH_STR);
 
         // Use list type 2 or versions as specified
         if (targetTime != 0)
-            httpQueryAdd(query, S3_QUERY_VERSIONS_STR, EMPTY_STR);
+            httpQueryAdd(result, S3_QUERY_VERSIONS_STR, EMPTY_STR);
         else
-            httpQueryAdd(query, S3_QUERY_LIST_TYPE_STR, S3_QUERY_VALUE_LIST_TYPE_2_STR);
+            httpQueryAdd(result, S3_QUERY_LIST_TYPE_STR, S3_QUERY_VALUE_LIST_TYPE_2_STR);
 
         // Don't specify empty prefix because it is the default
         if (!strEmpty(queryPrefix))
-            httpQueryAdd(query, S3_QUERY_PREFIX_STR, queryPrefix);
+            httpQueryAdd(result, S3_QUERY_PREFIX_STR, queryPrefix);
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN(HTTP_QUERY, result);
+}
+
+/***********************************************************************************************************************************
+General function for listing files to be used by other list routines. If request is not NULL then it must be an outstanding request
+for the first page of the list, e.g. sent so that multiple lists can be retrieved concurrently.
+***********************************************************************************************************************************/
+static void
+storageS3ListInternal(
+    StorageS3 *const this, const String *const path, const StorageInfoLevel level, const String *const expression,
+    const bool recurse, const time_t targetTime, HttpRequest *request, StorageListCallback callback, void *const callbackData)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STORAGE_S3, this);
+        FUNCTION_LOG_PARAM(STRING, path);
+        FUNCTION_LOG_PARAM(ENUM, level);
+        FUNCTION_LOG_PARAM(STRING, expression);
+        FUNCTION_LOG_PARAM(BOOL, recurse);
+        FUNCTION_LOG_PARAM(TIME, targetTime);
+        FUNCTION_LOG_PARAM(HTTP_REQUEST, request);
+        FUNCTION_LOG_PARAM(FUNCTIONP, callback);
+        FUNCTION_LOG_PARAM_P(VOID, callbackData);
+    FUNCTION_LOG_END();
+
+    FUNCTION_AUDIT_CALLBACK();
+
+    ASSERT(this != NULL);
+    ASSERT(path != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Build the base prefix by stripping off the initial /
+        const String *const basePrefix = strSize(path) == 1 ? EMPTY_STR : strNewFmt("%s/", strZ(strSub(path, 1)));
+
+        // Create query
+        HttpQuery *const query = storageS3ListQuery(path, expression, recurse, targetTime);
 
         // Store last info so it can be updated across requests for versioning
         String *const nameLast = strNew();
@@ -696,8 +826,6 @@ storageS3ListInternal(
             infoLast.versionId = versionIdLast;
 
         // Loop as long as a continuation token returned
-        HttpRequest *request = NULL;
-
         do
         {
             // Use an inner mem context here because we could potentially be retrieving millions of files so it is a good idea to
@@ -718,16 +846,18 @@ storageS3ListInternal(
                 else
                     response = storageS3RequestP(this, HTTP_VERB_GET_STR, FSLASH_STR, .query = query);
 
-                const XmlNode *const xmlRoot = xmlDocumentRoot(xmlDocumentNewBuf(httpResponseContent(response)));
+                // Parse the page
+                StorageS3ListPage page = {.pathList = strLstNew(), .fileList = lstNewP(sizeof(StorageS3ListFile))};
+                xmlParse(ioBufferReadNewOpen(httpResponseContent(response)), storageS3ListPageCallback, &page);
 
                 // If list is truncated then send an async request to get more data
-                if (strEq(xmlNodeContent(xmlNodeChild(xmlRoot, S3_XML_TAG_IS_TRUNCATED_STR, true)), TRUE_STR))
+                if (page.truncated)
                 {
-                    const String *const nextContinuationToken = xmlNodeContent(
-                        xmlNodeChild(xmlRoot, S3_XML_TAG_NEXT_CONTINUATION_TOKEN_STR, true));
-                    CHECK(FormatError, !strEmpty(nextContinuationToken), S3_XML_TAG_NEXT_CONTINUATION_TOKEN " may not be empty");
+                    CHECK(
+                        FormatError, page.continuationToken != NULL && !strEmpty(page.continuationToken),
+                        S3_XML_TAG_NEXT_CONTINUATION_TOKEN " may not be empty");
 
-                    httpQueryPut(query, S3_QUERY_CONTINUATION_TOKEN_STR, nextContinuationToken);
+                    httpQueryPut(query, S3_QUERY_CONTINUATION_TOKEN_STR, page.continuationToken);
 
                     // Store request in the outer temp context
                     MEM_CONTEXT_PRIOR_BEGIN()
@@ -737,24 +867,19 @@ storageS3ListInternal(
                     MEM_CONTEXT_PRIOR_END();
                 }
 
-                // Get prefix list
-                const XmlNodeList *const subPathList = xmlNodeChildList(xmlRoot, S3_XML_TAG_COMMON_PREFIXES_STR);
-
-                for (unsigned int subPathIdx = 0; subPathIdx < xmlNodeLstSize(subPathList); subPathIdx++)
+                // Callback for paths
+                for (unsigned int pathIdx = 0; pathIdx < strLstSize(page.pathList); pathIdx++)
                 {
-                    const XmlNode *const subPathNode = xmlNodeLstGet(subPathList, subPathIdx);
+                    const String *const path = strLstGet(page.pathList, pathIdx);
 
-                    // Get path name
+                    // Strip off base prefix and final /
                     StorageInfo info =
                     {
                         .level = level,
-                        .name = xmlNodeContent(xmlNodeChild(subPathNode, S3_XML_TAG_PREFIX_STR, true)),
+                        .name = strSubN(path, strSize(basePrefix), strSize(path) - strSize(basePrefix) - 1),
                         .exists = true,
                     };
 
-                    // Strip off base prefix and final /
-                    info.name = strSubN(info.name, strSize(basePrefix), strSize(info.name) - strSize(basePrefix) - 1);
-
                     // Add type info if requested
                     if (level >= storageInfoLevelType)
                         info.type = storageTypePath;
@@ -763,26 +888,13 @@ storageS3ListInternal(
                     callback(callbackData, &info);
                 }
 
-                // Get file list
-                const XmlNodeList *fileList;
-
-                if (targetTime != 0)
-                {
-                    StringList *const nameList = strLstNew();
-                    strLstAdd(nameList, S3_XML_TAG_VERSION_STR);
-                    strLstAdd(nameList, S3_XML_TAG_DELETE_MARKER_STR);
-
-                    fileList = xmlNodeChildListMulti(xmlRoot, nameList);
-                }
-                else
-                    fileList = xmlNodeChildList(xmlRoot, S3_XML_TAG_CONTENTS_STR);
-
-                for (unsigned int fileIdx = 0; fileIdx < xmlNodeLstSize(fileList); fileIdx++)
+                // Callback for files
+                for (unsigned int fileIdx = 0; fileIdx < lstSize(page.fileList); fileIdx++)
                 {
-                    const XmlNode *const fileNode = xmlNodeLstGet(fileList, fileIdx);
+                    const StorageS3ListFile *const file = lstGet(page.fileList, fileIdx);
 
                     // Get file name and strip off the base prefix when present
-                    const String *name = xmlNodeContent(xmlNodeChild(fileNode, S3_XML_TAG_KEY_STR, true));
+                    const String *name = file->name;
 
                     if (!strEmpty(basePrefix))
                         name = strSub(name, strSize(basePrefix));
@@ -798,8 +910,8 @@ storageS3ListInternal(
                     if (targetTime != 0)
                     {
                         // Skip later versions
-                        infoLast.timeModified = storageS3CvtTime(
-                            xmlNodeContent(xmlNodeChild(fileNode, S3_XML_TAG_LAST_MODIFIED_STR, true)));
+                        CHECK(FormatError, file->timeModified != NULL, "file modified time missing");
+                        infoLast.timeModified = storageS3CvtTime(file->timeModified);
 
                         if (infoLast.timeModified > targetTime)
                             continue;
@@ -809,9 +921,7 @@ storageS3ListInternal(
                             continue;
 
                         // If most recent version is a delete marker then the file will not be returned
-                        const bool deleteMarker = strEq(xmlNodeName(fileNode), S3_XML_TAG_DELETE_MARKER_STR);
-
-                        if (deleteMarker)
+                        if (file->deleteMarker)
                         {
                             strCat(strTrunc(nameLast), name);
                             infoLast.exists = false;
@@ -828,16 +938,17 @@ storageS3ListInternal(
                     {
                         if (targetTime != 0)
                         {
-                            strCat(
-                                strTrunc(versionIdLast), xmlNodeContent(xmlNodeChild(fileNode, S3_XML_TAG_VERSION_ID_STR, true)));
+                            CHECK(FormatError, file->versionId != NULL, "file version id missing");
+                            strCat(strTrunc(versionIdLast), file->versionId);
                         }
                         else
                         {
-                            infoLast.timeModified = storageS3CvtTime(
-                                xmlNodeContent(xmlNodeChild(fileNode, S3_XML_TAG_LAST_MODIFIED_STR, true)));
+                            CHECK(FormatError, file->timeModified != NULL, "file modified time missing");
+                            infoLast.timeModified = storageS3CvtTime(file->timeModified);
                         }
 
-                        infoLast.size = cvtZToUInt64(strZ(xmlNodeContent(xmlNodeChild(fileNode, S3_XML_TAG_SIZE_STR, true))));
+                        CHECK(FormatError, file->size != NULL, "file size missing");
+                        infoLast.size = cvtZToUInt64(strZ(file->size));
                     }
                 }
             }
@@ -931,11 +1042,66 @@ storageS3List(THIS_VOID, const String *const path, const StorageInfoLevel level,
     StorageList *const result = storageLstNew(level);
 
     storageS3ListInternal(
-        this, path, level, param.expression, false, param.targetTime, storageS3ListCallback, result);
+        this, path, level, param.expression, false, param.targetTime, NULL, storageS3ListCallback, result);
 
     FUNCTION_LOG_RETURN(STORAGE_LIST, result);
 }
 
+/**********************************************************************************************************************************/
+static List *
+storageS3ListMulti(THIS_VOID, const StringList *const pathList, const StorageInfoLevel level, const StorageInterfaceListParam param)
+{
+    THIS(StorageS3);
+
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(STORAGE_S3, this);
+        FUNCTION_LOG_PARAM(STRING_LIST, pathList);
+        FUNCTION_LOG_PARAM(ENUM, level);
+        FUNCTION_LOG_PARAM(STRING, param.expression);
+        FUNCTION_LOG_PARAM(TIME, param.targetTime);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(pathList != NULL);
+
+    List *const result = lstNewP(sizeof(StorageList *));
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Send requests for the first page of each list so they are processed by S3 concurrently. Each outstanding request uses a
+        // separate connection.
+        List *const requestList = lstNewP(sizeof(HttpRequest *));
+
+        for (unsigned int pathIdx = 0; pathIdx < strLstSize(pathList); pathIdx++)
+        {
+            HttpRequest *const request = storageS3RequestAsyncP(
+                this, HTTP_VERB_GET_STR, FSLASH_STR,
+                .query = storageS3ListQuery(strLstGet(pathList, pathIdx), param.expression, false, param.targetTime));
+
+            lstAdd(requestList, &request);
+        }
+
+        // Get the lists in order. Additional pages for each list are requested as the list is processed.
+        for (unsigned int pathIdx = 0; pathIdx < strLstSize(pathList); pathIdx++)
+        {
+            MEM_CONTEXT_BEGIN(lstMemContext(result))
+            {
+                StorageList *const list = storageLstNew(level);
+
+                storageS3ListInternal(
+                    this, strLstGet(pathList, pathIdx), level, param.expression, false, param.targetTime,
+                    *(HttpRequest **)lstGet(requestList, pathIdx), storageS3ListCallback, list);
+
+                lstAdd(result, &list);
+            }
+            MEM_CONTEXT_END();
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN(LIST, result);
+}
+
 /**********************************************************************************************************************************/
 static StorageRead *
 storageS3NewRead(THIS_VOID, const String *const file, const bool ignoreMissing, const StorageInterfaceNewReadParam param)
@@ -1130,7 +1296,7 @@ storageS3PathRemove(THIS_VOID, const String *const path, const bool recurse, con
             .path = strEq(path, FSLASH_STR) ? EMPTY_STR : strNewFmt("%s/", strZ(strSub(path, 1))),
         };
 
-        storageS3ListInternal(this, path, storageInfoLevelType, NULL, true, 0, storageS3PathRemoveCallback, &data);
+        storageS3ListInternal(this, path, storageInfoLevelType, NULL, true, 0, NULL, storageS3PathRemoveCallback, &data);
 
         // Call if there is more to be removed
         if (data.xml != NULL)
@@ -1144,6 +1310,56 @@ storageS3PathRemove(THIS_VOID, const String *const path, const bool recurse, con
     FUNCTION_LOG_RETURN(BOOL, true);
 }
 
+/**********************************************************************************************************************************/
+static void
+storageS3RemoveList(
+    THIS_VOID, const String *const path, const StringList *const fileList, const StorageInterfaceRemoveListParam param)
+{
+    THIS(StorageS3);
+
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STORAGE_S3, this);
+        FUNCTION_LOG_PARAM(STRING, path);
+        FUNCTION_LOG_PARAM(STRING_LIST, fileList);
+        (void)param;                                                // No parameters are used
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(path != NULL);
+    ASSERT(fileList != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        StorageS3PathRemoveData data =
+        {
+            .this = this,
+            .memContext = memContextCurrent(),
+            .path = strEq(path, FSLASH_STR) ? EMPTY_STR : strNewFmt("%s/", strZ(strSub(path, 1))),
+        };
+
+        // Add files to the batch as if they had been listed. A new batch is sent while the prior batch is still running.
+        MEM_CONTEXT_TEMP_BEGIN()
+        {
+            for (unsigned int fileIdx = 0; fileIdx < strLstSize(fileList); fileIdx++)
+            {
+                storageS3PathRemoveCallback(
+                    &data, &(StorageInfo){.name = strLstGet(fileList, fileIdx), .type = storageTypeFile, .exists = true});
+            }
+        }
+        MEM_CONTEXT_TEMP_END();
+
+        // Call if there is more to be removed
+        if (data.xml != NULL)
+            data.request = storageS3PathRemoveInternal(this, data.request, data.xml);
+
+        // Check response on last async request
+        storageS3PathRemoveInternal(this, data.request, NULL);
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
 /**********************************************************************************************************************************/
 static void
 storageS3Remove(THIS_VOID, const String *const file, const StorageInterfaceRemoveParam param)
@@ -1165,17 +1381,90 @@ storageS3Remove(THIS_VOID, const String *const file, const StorageInterfaceRemov
     FUNCTION_LOG_RETURN_VOID();
 }
 
+/**********************************************************************************************************************************/
+static bool
+storageS3Copy(THIS_VOID, StorageRead *const source, StorageWrite *const destination, const StorageInterfaceCopyParam param)
+{
+    THIS(StorageS3);
+
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STORAGE_S3, this);
+        FUNCTION_LOG_PARAM(STORAGE_READ, source);
+        FUNCTION_LOG_PARAM(STORAGE_WRITE, destination);
+        (void)param;                                                // No parameters are used
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(source != NULL);
+    ASSERT(destination != NULL);
+
+    bool result = false;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        const StorageInfo info = storageS3Info(
+            this, storageReadName(source), storageInfoLevelBasic, (StorageInterfaceInfoParam){.followLink = false});
+
+        if (!info.exists)
+        {
+            if (!storageReadIgnoreMissing(source))
+                THROW_FMT(FileMissingError, STORAGE_ERROR_READ_MISSING, strZ(storageReadName(source)));
+        }
+        // Objects too large for a single copy request are rare in a repository (relation segments are 1GiB) so copy them through
+        // the client rather than with a multi-part copy
+        else if (info.size > STORAGE_S3_COPY_SIZE_MAX)
+            result = storageCopyP(source, destination);
+        // Else copy the object on the server
+        else
+        {
+            HttpHeader *const header = httpHeaderNew(this->headerRedactList);
+
+            httpHeaderAdd(
+                header, S3_HEADER_COPY_SOURCE_STR,
+                httpUriEncode(strNewFmt("/%s%s", strZ(this->bucket), strZ(storageReadName(source))), true));
+
+            // The source must be decrypted with the same customer key that will be used to encrypt the destination
+            if (this->sseCustomerKey != NULL)
+            {
+                httpHeaderAdd(header, S3_HEADER_COPY_SSECUSTKEY_ALGO_STR, S3_HEADER_SSECUSTKEY_AES256_STR);
+                httpHeaderAdd(header, S3_HEADER_COPY_SSECUSTKEY_KEY_STR, this->sseCustomerKey);
+                httpHeaderAdd(header, S3_HEADER_COPY_SSECUSTKEY_KEY_MD5_STR, this->sseCustomerKeyMd5);
+            }
+
+            HttpRequest *const request = storageS3RequestAsyncP(
+                this, HTTP_VERB_PUT_STR, storageWriteName(destination), .header = header, .sseKms = true, .sseC = true);
+            HttpResponse *const response = storageS3ResponseP(request);
+
+            // Error when the result is not a copy result. This indicates that the request did not succeed despite the success code.
+            if (!strEq(
+                    xmlNodeName(xmlDocumentRoot(xmlDocumentNewBuf(httpResponseContent(response)))),
+                    S3_XML_TAG_COPY_OBJECT_RESULT_STR))
+            {
+                httpRequestError(request, response);
+            }
+
+            result = true;
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN(BOOL, result);
+}
+
 /**********************************************************************************************************************************/
 static const StorageInterface storageInterfaceS3 =
 {
     .feature = 1 << storageFeatureVersioning,
 
+    .copy = storageS3Copy,
     .info = storageS3Info,
     .list = storageS3List,
+    .listMulti = storageS3ListMulti,
     .newRead = storageS3NewRead,
     .newWrite = storageS3NewWrite,
     .pathRemove = storageS3PathRemove,
     .remove = storageS3Remove,
+    .removeList = storageS3RemoveList,
 };
 
 FN_EXTERN Storage *
@@ -1320,6 +1609,8 @@ storageS3New(
         // Create list of redacted headers
         this->headerRedactList = strLstNew();
         strLstAdd(this->headerRedactList, HTTP_HEADER_AUTHORIZATION_STR);
+        strLstAdd(this->headerRedactList, S3_HEADER_COPY_SSECUSTKEY_KEY_STR);
+        strLstAdd(this->headerRedactList, S3_HEADER_COPY_SSECUSTKEY_KEY_MD5_STR);
         strLstAdd(this->headerRedactList, S3_HEADER_DATE_STR);
         strLstAdd(this->headerRedactList, S3_HEADER_SSECUSTKEY_KEY_STR);
         strLstAdd(this->headerRedactList, S3_HEADER_SSECUSTKEY_KEY_MD5_STR);
@@ -125,11 +125,12 @@ storageNew(
 
 /**********************************************************************************************************************************/
 FN_EXTERN bool
-storageCopy(StorageRead *const source, StorageWrite *const destination)
+storageCopy(StorageRead *const source, StorageWrite *const destination, const StorageCopyParam param)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(STORAGE_READ, source);
         FUNCTION_LOG_PARAM(STORAGE_WRITE, destination);
+        FUNCTION_LOG_PARAM(STORAGE, param.storage);
     FUNCTION_LOG_END();
 
     ASSERT(source != NULL);
@@ -139,8 +140,18 @@ storageCopy(StorageRead *const source, StorageWrite *const destination)
 
     MEM_CONTEXT_TEMP_BEGIN()
     {
-        // Open source file
-        if (ioReadOpen(storageReadIo(source)))
+        // Let the driver copy the file when the content does not need to pass through the client
+        if (param.storage != NULL && param.storage->pub.interface.copy != NULL &&
+            storageReadStorageDriver(source) == storageDriver(param.storage) &&
+            storageWriteStorageDriver(destination) == storageDriver(param.storage) &&
+            storageReadOffset(source) == 0 && storageReadLimit(source) == NULL && !storageReadInterface(source)->version &&
+            ioFilterGroupSize(ioReadFilterGroup(storageReadIo(source))) == 0 &&
+            ioFilterGroupSize(ioWriteFilterGroup(storageWriteIo(destination))) == 0)
+        {
+            result = storageInterfaceCopyP(storageDriver(param.storage), source, destination);
+        }
+        // Else open source file
+        else if (ioReadOpen(storageReadIo(source)))
         {
             // Open the destination file now that we know the source file exists and is readable
             ioWriteOpen(storageWriteIo(destination));
@@ -361,6 +372,7 @@ storageNewItr(const Storage *const this, const String *const pathExp, StorageNew
         FUNCTION_LOG_PARAM(ENUM, param.sortOrder);
         FUNCTION_LOG_PARAM(STRING, param.expression);
         FUNCTION_LOG_PARAM(BOOL, param.recurse);
+        FUNCTION_LOG_PARAM(UINT, param.parallel);
     FUNCTION_LOG_END();
 
     ASSERT(this != NULL);
@@ -378,7 +390,7 @@ storageNewItr(const Storage *const this, const String *const pathExp, StorageNew
         result = storageItrMove(
             storageItrNew(
                 storageDriver(this), storagePathP(this, pathExp), param.level, param.errorOnMissing, param.nullOnMissing,
-                param.recurse, param.sortOrder, this->targetTime, param.expression),
+                param.recurse, param.sortOrder, this->targetTime, param.expression, param.parallel),
             memContextPrior());
     }
     MEM_CONTEXT_TEMP_END();
@@ -454,6 +466,77 @@ storageList(const Storage *const this, const String *const pathExp, const Storag
     FUNCTION_LOG_RETURN(STRING_LIST, result);
 }
 
+/**********************************************************************************************************************************/
+FN_EXTERN List *
+storageListMulti(const Storage *const this, const StringList *const pathExpList, const StorageListMultiParam param)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STORAGE, this);
+        FUNCTION_LOG_PARAM(STRING_LIST, pathExpList);
+        FUNCTION_LOG_PARAM(STRING, param.expression);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(pathExpList != NULL);
+
+    List *const result = lstNewP(sizeof(StringList *));
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Get the lists concurrently when the driver supports it
+        if (STORAGE_COMMON_INTERFACE(storageDriver(this)).listMulti != NULL)
+        {
+            StringList *const pathList = strLstNew();
+
+            for (unsigned int pathIdx = 0; pathIdx < strLstSize(pathExpList); pathIdx++)
+                strLstAdd(pathList, storagePathP(this, strLstGet(pathExpList, pathIdx)));
+
+            const List *const list = storageInterfaceListMultiP(
+                storageDriver(this), pathList, storageInfoLevelExists, .expression = param.expression,
+                .targetTime = this->targetTime);
+            ASSERT(lstSize(list) == strLstSize(pathList));
+
+            // The expression is only a hint to the driver so names must still be matched
+            RegExp *const regExp = param.expression == NULL ? NULL : regExpNew(param.expression);
+
+            for (unsigned int listIdx = 0; listIdx < lstSize(list); listIdx++)
+            {
+                const StorageList *const storageList = *(StorageList **)lstGet(list, listIdx);
+
+                MEM_CONTEXT_BEGIN(lstMemContext(result))
+                {
+                    StringList *const nameList = strLstNew();
+
+                    for (unsigned int infoIdx = 0; storageList != NULL && infoIdx < storageLstSize(storageList); infoIdx++)
+                    {
+                        const StorageInfo info = storageLstGet(storageList, infoIdx);
+
+                        if (regExp == NULL || regExpMatch(regExp, info.name))
+                            strLstAdd(nameList, info.name);
+                    }
+
+                    lstAdd(result, &nameList);
+                }
+                MEM_CONTEXT_END();
+            }
+        }
+        // Else get the lists one at a time
+        else
+        {
+            for (unsigned int pathIdx = 0; pathIdx < strLstSize(pathExpList); pathIdx++)
+            {
+                StringList *const nameList = strLstMove(
+                    storageListP(this, strLstGet(pathExpList, pathIdx), .expression = param.expression), lstMemContext(result));
+
+                lstAdd(result, &nameList);
+            }
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN(LIST, result);
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN void
 storageMove(const Storage *const this, StorageRead *const source, StorageWrite *const destination)
@@ -531,6 +614,8 @@ storageNewRead(const Storage *const this, const String *const fileExp, const Sto
                 storageDriver(this), path, param.ignoreMissing, .compressible = param.compressible, .offset = param.offset,
                 .limit = param.limit, .version = this->targetTime != 0, .versionId = versionId),
             memContextPrior());
+
+        storageReadStorageDriverSet(result, storageDriver(this));
     }
     MEM_CONTEXT_TEMP_END();
 
@@ -554,11 +639,15 @@ storageNewWrite(const Storage *const this, const String *const fileExp, const St
         FUNCTION_LOG_PARAM(BOOL, param.noSyncPath);
         FUNCTION_LOG_PARAM(BOOL, param.noAtomic);
         FUNCTION_LOG_PARAM(BOOL, param.noTruncate);
+        FUNCTION_LOG_PARAM(BOOL, param.syncDefer);
+        FUNCTION_LOG_PARAM(UINT64, param.preallocate);
+        FUNCTION_LOG_PARAM(SIZE, param.sparseSize);
         FUNCTION_LOG_PARAM(BOOL, param.compressible);
     FUNCTION_LOG_END();
 
     ASSERT(this != NULL);
     ASSERT(this->write);
+    ASSERT(!param.syncDefer || storageFeature(this, storageFeatureFileSystemSync));
     // noTruncate does not work with atomic writes because a new file is always created for atomic writes
     ASSERT(!param.noTruncate || param.noAtomic);
 
@@ -571,9 +660,12 @@ storageNewWrite(const Storage *const this, const String *const fileExp, const St
                 storageDriver(this), storagePathP(this, fileExp), .modeFile = param.modeFile != 0 ? param.modeFile : this->modeFile,
                 .modePath = param.modePath != 0 ? param.modePath : this->modePath, .user = param.user, .group = param.group,
                 .timeModified = param.timeModified, .createPath = !param.noCreatePath, .syncFile = !param.noSyncFile,
-                .syncPath = !param.noSyncPath, .atomic = !param.noAtomic, .truncate = !param.noTruncate,
+                .syncPath = !param.noSyncPath, .syncDefer = param.syncDefer, .atomic = !param.noAtomic,
+                .truncate = !param.noTruncate, .preallocate = param.preallocate, .sparseSize = param.sparseSize,
                 .compressible = param.compressible),
             memContextPrior());
+
+        storageWriteStorageDriverSet(result, storageDriver(this));
     }
     MEM_CONTEXT_TEMP_END();
 
@@ -761,22 +853,24 @@ storagePathRemove(const Storage *const this, const String *const pathExp, const
 
 /**********************************************************************************************************************************/
 FN_EXTERN void
-storagePathSync(const Storage *const this, const String *const pathExp)
+storagePathSync(const Storage *const this, const String *const pathExp, const StoragePathSyncParam param)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(STORAGE, this);
         FUNCTION_LOG_PARAM(STRING, pathExp);
+        FUNCTION_LOG_PARAM(BOOL, param.fileSystem);
     FUNCTION_LOG_END();
 
     ASSERT(this != NULL);
     ASSERT(this->write);
+    ASSERT(!param.fileSystem || storageFeature(this, storageFeatureFileSystemSync));
 
     // Not all storage requires path sync so just do nothing if the function is not implemented
     if (this->pub.interface.pathSync != NULL)
     {
         MEM_CONTEXT_TEMP_BEGIN()
         {
-            storageInterfacePathSyncP(storageDriver(this), storagePathP(this, pathExp));
+            storageInterfacePathSyncP(storageDriver(this), storagePathP(this, pathExp), .fileSystem = param.fileSystem);
         }
         MEM_CONTEXT_TEMP_END();
     }
@@ -825,6 +919,46 @@ storageRemove(const Storage *const this, const String *const fileExp, const Stor
     FUNCTION_LOG_RETURN_VOID();
 }
 
+/**********************************************************************************************************************************/
+FN_EXTERN void
+storageRemoveList(const Storage *const this, const String *const pathExp, const StringList *const fileList)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STORAGE, this);
+        FUNCTION_LOG_PARAM(STRING, pathExp);
+        FUNCTION_LOG_PARAM(STRING_LIST, fileList);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(this->write);
+    ASSERT(fileList != NULL);
+
+    if (!strLstEmpty(fileList))
+    {
+        MEM_CONTEXT_TEMP_BEGIN()
+        {
+            const String *const path = storagePathP(this, pathExp);
+
+            // Remove files in batches when the driver supports it
+            if (this->pub.interface.removeList != NULL)
+                storageInterfaceRemoveListP(storageDriver(this), path, fileList);
+            // Else remove files individually
+            else
+            {
+                for (unsigned int fileIdx = 0; fileIdx < strLstSize(fileList); fileIdx++)
+                {
+                    storageInterfaceRemoveP(
+                        storageDriver(this),
+                        strNewFmt("%s/%s", strEq(path, FSLASH_STR) ? "" : strZ(path), strZ(strLstGet(fileList, fileIdx))));
+                }
+            }
+        }
+        MEM_CONTEXT_TEMP_END();
+    }
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN void
 storageToLog(const Storage *const this, StringStatic *const debugLog)
@@ -60,16 +60,30 @@ typedef enum
 
     // Does the storage support versioning?
     storageFeatureVersioning,
+
+    // Can the entire file system containing a path be synced at once? This allows file syncs to be deferred (see syncDefer) and
+    // done in a single operation rather than syncing each file as it is closed.
+    storageFeatureFileSystemSync,
 } StorageFeature;
 
 /***********************************************************************************************************************************
 Functions
 ***********************************************************************************************************************************/
 // Copy a file
-#define storageCopyP(source, destination)                                                                                          \
-    storageCopy(source, destination)
+typedef struct StorageCopyParam
+{
+    VAR_PARAM_HEADER;
 
-FN_EXTERN bool storageCopy(StorageRead *source, StorageWrite *destination);
+    // Storage that contains both the source and the destination. When the source and destination were both created by this
+    // storage, the storage driver supports it, and there are no filters, offset, or limit, the copy is performed by the driver
+    // (e.g. a server-side copy on object stores) rather than reading and writing the file.
+    const Storage *storage;
+} StorageCopyParam;
+
+#define storageCopyP(source, destination, ...)                                                                                     \
+    storageCopy(source, destination, (StorageCopyParam){VAR_PARAM_INIT, __VA_ARGS__})
+
+FN_EXTERN bool storageCopy(StorageRead *source, StorageWrite *destination, StorageCopyParam param);
 
 // Does a file exist? This function is only for files, not paths.
 typedef struct StorageExistsParam
@@ -110,7 +124,8 @@ typedef struct StorageInfoParam
 
 FN_EXTERN StorageInfo storageInfo(const Storage *this, const String *fileExp, StorageInfoParam param);
 
-// Iterator for all files/links/paths in a path which returns different info based on the value of the level parameter
+// Iterator for all files/links/paths in a path which returns different info based on the value of the level parameter. When
+// recursing, parallel > 1 allows up to that many subpaths to be listed concurrently if the driver supports it.
 typedef struct StorageNewItrParam
 {
     VAR_PARAM_HEADER;
@@ -120,6 +135,7 @@ typedef struct StorageNewItrParam
     bool recurse;
     SortOrder sortOrder;
     const String *expression;
+    unsigned int parallel;
 } StorageNewItrParam;
 
 #define storageNewItrP(this, fileExp, ...)                                                                                         \
@@ -141,6 +157,20 @@ typedef struct StorageListParam
 
 FN_EXTERN StringList *storageList(const Storage *this, const String *pathExp, StorageListParam param);
 
+// Get lists of files from multiple directories. The lists are retrieved concurrently when the driver supports it, so the caller
+// controls concurrency with the number of paths. Lists are returned in the same order as the paths (List of StringList *) and a
+// list is empty when the path is missing.
+typedef struct StorageListMultiParam
+{
+    VAR_PARAM_HEADER;
+    const String *expression;
+} StorageListMultiParam;
+
+#define storageListMultiP(this, pathExpList, ...)                                                                                  \
+    storageListMulti(this, pathExpList, (StorageListMultiParam){VAR_PARAM_INIT, __VA_ARGS__})
+
+FN_EXTERN List *storageListMulti(const Storage *this, const StringList *pathExpList, StorageListMultiParam param);
+
 // Move a file
 #define storageMoveP(this, source, destination)                                                                                    \
     storageMove(this, source, destination)
@@ -175,6 +205,17 @@ typedef struct StorageNewWriteParam
     bool noSyncPath;
     bool noAtomic;
 
+    // Start writing the file to disk on close but do not wait for the sync. The file is not durable until storagePathSyncP() is
+    // called with fileSystem on a path in the same file system. Requires storageFeatureFileSystemSync.
+    bool syncDefer;
+
+    // Size to preallocate for the file so it can be allocated contiguously. This is a hint that may be ignored by the storage.
+    uint64_t preallocate;
+
+    // Skip writing blocks of this size that contain only zeros. Skipped blocks read as zeros but are left as holes or preallocated
+    // space. This is a hint that may be ignored by the storage. Writes must be sequential.
+    size_t sparseSize;
+
     // Do not truncate file if it exists. Use this only in cases where the file will be manipulated directly through the file
     // handle, which should always be the exception and indicates functionality that should be added to the storage interface.
     bool noTruncate;
@@ -238,10 +279,16 @@ typedef struct StoragePathRemoveParam
 FN_EXTERN void storagePathRemove(const Storage *this, const String *pathExp, StoragePathRemoveParam param);
 
 // Sync a path
-#define storagePathSyncP(this, pathExp)                                                                                            \
-    storagePathSync(this, pathExp)
+typedef struct StoragePathSyncParam
+{
+    VAR_PARAM_HEADER;
+    bool fileSystem;                                                // Sync the file system containing the path
+} StoragePathSyncParam;
+
+#define storagePathSyncP(this, pathExp, ...)                                                                                       \
+    storagePathSync(this, pathExp, (StoragePathSyncParam){VAR_PARAM_INIT, __VA_ARGS__})
 
-FN_EXTERN void storagePathSync(const Storage *this, const String *pathExp);
+FN_EXTERN void storagePathSync(const Storage *this, const String *pathExp, StoragePathSyncParam param);
 
 // Write a buffer to storage
 #define storagePutP(file, buffer)                                                                                                  \
@@ -261,6 +308,13 @@ typedef struct StorageRemoveParam
 
 FN_EXTERN void storageRemove(const Storage *this, const String *fileExp, StorageRemoveParam param);
 
+// Remove a list of files relative to a path. Files are removed in batches when the storage supports it, otherwise they are removed
+// one at a time. Missing files are ignored.
+#define storageRemoveListP(this, pathExp, fileList)                                                                                \
+    storageRemoveList(this, pathExp, fileList)
+
+FN_EXTERN void storageRemoveList(const Storage *this, const String *pathExp, const StringList *fileList);
+
 // Create a hard or symbolic link
 typedef struct StorageLinkCreateParam
 {
@@ -285,6 +339,13 @@ storageFeature(const Storage *const this, const StorageFeature feature)
     return THIS_PUB(Storage)->interface.feature >> feature & 1;
 }
 
+// Can files be copied by the storage driver without reading them through the client? See StorageCopyParam.
+FN_INLINE_ALWAYS bool
+storageCopyServer(const Storage *const this)
+{
+    return THIS_PUB(Storage)->interface.copy != NULL;
+}
+
 // Storage type (posix, cifs, etc.)
 FN_INLINE_ALWAYS StringId
 storageType(const Storage *const this)
@@ -47,6 +47,7 @@ Error messages
 #define STORAGE_ERROR_PATH_SYNC_CLOSE                               "unable to close path '%s' after sync"
 #define STORAGE_ERROR_PATH_SYNC_OPEN                                "unable to open path '%s' for sync"
 #define STORAGE_ERROR_PATH_SYNC_MISSING                             "unable to sync missing path '%s'"
+#define STORAGE_ERROR_PATH_SYNC_FILE_SYSTEM                         "unable to sync file system for path '%s'"
 
 #define STORAGE_ERROR_WRITE_CLOSE                                   "unable to close file '%s' after write"
 #define STORAGE_ERROR_WRITE_OPEN                                    "unable to open file '%s' for write"
@@ -158,6 +159,14 @@ typedef struct StorageInterfaceNewWriteParam
     bool syncFile;
     bool syncPath;
 
+    // Start writing the file to disk on close instead of syncing it. Only valid when the storage supports
+    // storageFeatureFileSystemSync.
+    bool syncDefer;
+
+    // Size to preallocate for the file and size of zero blocks to skip when writing (see StorageNewWriteParam)
+    uint64_t preallocate;
+    size_t sparseSize;
+
     // Ensure the file is written atomically. If this is false it's OK to write atomically if that's all the storage supports
     // (e.g. S3). Non-atomic writes are used in some places where there is a performance advantage and atomicity is not needed.
     bool atomic;
@@ -203,6 +212,16 @@ typedef StorageList *StorageInterfaceList(
     STORAGE_COMMON_INTERFACE(thisVoid).list(                                                                                       \
         thisVoid, path, level, (StorageInterfaceListParam){VAR_PARAM_INIT, __VA_ARGS__})
 
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Get lists for multiple paths. Drivers with high request latency should implement this to retrieve the lists concurrently. Lists
+// are returned in the same order as the paths (List of StorageList *) and a list is NULL when the path does not exist.
+typedef List *StorageInterfaceListMulti(
+    void *thisVoid, const StringList *pathList, StorageInfoLevel level, StorageInterfaceListParam param);
+
+#define storageInterfaceListMultiP(thisVoid, pathList, level, ...)                                                                 \
+    STORAGE_COMMON_INTERFACE(thisVoid).listMulti(                                                                                  \
+        thisVoid, pathList, level, (StorageInterfaceListParam){VAR_PARAM_INIT, __VA_ARGS__})
+
 // ---------------------------------------------------------------------------------------------------------------------------------
 // Remove a path (and optionally recurse)
 typedef struct StorageInterfacePathRemoveParam
@@ -234,6 +253,21 @@ typedef void StorageInterfaceRemove(void *thisVoid, const String *file, StorageI
 /***********************************************************************************************************************************
 Optional interface functions
 ***********************************************************************************************************************************/
+// Copy a file within the storage without reading it through the client, e.g. a server-side copy on object stores. Only called when
+// there are no filters, offset, or limit on the source and destination. Returns false when the source is missing and ignoreMissing
+// is set on the source.
+typedef struct StorageInterfaceCopyParam
+{
+    VAR_PARAM_HEADER;
+} StorageInterfaceCopyParam;
+
+typedef bool StorageInterfaceCopy(void *thisVoid, StorageRead *source, StorageWrite *destination, StorageInterfaceCopyParam param);
+
+#define storageInterfaceCopyP(thisVoid, source, destination, ...)                                                                  \
+    STORAGE_COMMON_INTERFACE(thisVoid).copy(                                                                                       \
+        thisVoid, source, destination, (StorageInterfaceCopyParam){VAR_PARAM_INIT, __VA_ARGS__})
+
+// ---------------------------------------------------------------------------------------------------------------------------------
 // Move a path/file atomically
 typedef struct StorageInterfaceMoveParam
 {
@@ -266,6 +300,10 @@ typedef void StorageInterfacePathCreate(
 typedef struct StorageInterfacePathSyncParam
 {
     VAR_PARAM_HEADER;
+
+    // Sync the entire file system containing the path, which includes all files and paths written to the file system. Only valid
+    // when the storage supports storageFeatureFileSystemSync.
+    bool fileSystem;
 } StorageInterfacePathSyncParam;
 
 typedef void StorageInterfacePathSync(void *thisVoid, const String *path, StorageInterfacePathSyncParam param);
@@ -273,6 +311,21 @@ typedef void StorageInterfacePathSync(void *thisVoid, const String *path, Storag
 #define storageInterfacePathSyncP(thisVoid, path, ...)                                                                             \
     STORAGE_COMMON_INTERFACE(thisVoid).pathSync(thisVoid, path, (StorageInterfacePathSyncParam){VAR_PARAM_INIT, __VA_ARGS__})
 
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Remove a list of files relative to a path. Drivers that can remove multiple files in a single request should implement this to
+// reduce the number of requests. Missing files must be ignored.
+typedef struct StorageInterfaceRemoveListParam
+{
+    VAR_PARAM_HEADER;
+} StorageInterfaceRemoveListParam;
+
+typedef void StorageInterfaceRemoveList(
+    void *thisVoid, const String *path, const StringList *fileList, StorageInterfaceRemoveListParam param);
+
+#define storageInterfaceRemoveListP(thisVoid, path, fileList, ...)                                                                 \
+    STORAGE_COMMON_INTERFACE(thisVoid).removeList(                                                                                 \
+        thisVoid, path, fileList, (StorageInterfaceRemoveListParam){VAR_PARAM_INIT, __VA_ARGS__})
+
 /***********************************************************************************************************************************
 Storage type and helper function struct
 
@@ -305,10 +358,13 @@ typedef struct StorageInterface
     StorageInterfaceRemove *remove;
 
     // Optional functions
+    StorageInterfaceCopy *copy;
     StorageInterfaceLinkCreate *linkCreate;
+    StorageInterfaceListMulti *listMulti;
     StorageInterfaceMove *move;
     StorageInterfacePathCreate *pathCreate;
     StorageInterfacePathSync *pathSync;
+    StorageInterfaceRemoveList *removeList;
 } StorageInterface;
 
 #define storageNewP(type, path, modeFile, modePath, write, pathExpressionFunction, driver, ...)                                    \
@@ -6,14 +6,23 @@ Storage Write Interface
 #include "common/debug.h"
 #include "common/log.h"
 #include "common/memContext.h"
+#include "common/stat.h"
+#include "common/time.h"
 #include "storage/write.h"
 
+/***********************************************************************************************************************************
+Statistics constants
+***********************************************************************************************************************************/
+STRING_EXTERN(STORAGE_STAT_WRITE_STR,                               STORAGE_STAT_WRITE);
+
 /***********************************************************************************************************************************
 Object type
 ***********************************************************************************************************************************/
 struct StorageWrite
 {
     StorageWritePub pub;                                            // Publicly accessible variables
+    void *driver;                                                   // Driver
+    TimeUSec time;                                                  // Time spent writing
 };
 
 /***********************************************************************************************************************************
@@ -24,6 +33,112 @@ Macros for function logging
 #define FUNCTION_LOG_STORAGE_WRITE_INTERFACE_FORMAT(value, buffer, bufferSize)                                                     \
     objNameToLog(&value, "StorageWriteInterface", buffer, bufferSize)
 
+/***********************************************************************************************************************************
+Open the file
+***********************************************************************************************************************************/
+static void
+storageWriteOpen(THIS_VOID)
+{
+    THIS(StorageWrite);
+
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(STORAGE_WRITE, this);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+
+    const TimeUSec timeBegin = timeUSec();
+
+    this->pub.interface->ioInterface.open(this->driver);
+    this->time += timeUSec() - timeBegin;
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Is the file ready for write?
+***********************************************************************************************************************************/
+static bool
+storageWriteReady(THIS_VOID, const bool error)
+{
+    THIS(StorageWrite);
+
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(STORAGE_WRITE, this);
+        FUNCTION_LOG_PARAM(BOOL, error);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_LOG_RETURN(BOOL, this->pub.interface->ioInterface.ready(this->driver, error));
+}
+
+/***********************************************************************************************************************************
+Write to the file
+***********************************************************************************************************************************/
+static void
+storageWrite(THIS_VOID, const Buffer *const buffer)
+{
+    THIS(StorageWrite);
+
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(STORAGE_WRITE, this);
+        FUNCTION_LOG_PARAM(BUFFER, buffer);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(buffer != NULL);
+
+    const TimeUSec timeBegin = timeUSec();
+
+    this->pub.interface->ioInterface.write(this->driver, buffer);
+    this->time += timeUSec() - timeBegin;
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Close the file
+***********************************************************************************************************************************/
+static void
+storageWriteClose(THIS_VOID)
+{
+    THIS(StorageWrite);
+
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(STORAGE_WRITE, this);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+
+    const TimeUSec timeBegin = timeUSec();
+
+    if (this->pub.interface->ioInterface.close != NULL)
+        this->pub.interface->ioInterface.close(this->driver);
+
+    // Record time spent writing the file, including sync and rename on close
+    statTime(STORAGE_STAT_WRITE_STR, this->time + timeUSec() - timeBegin);
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Get file descriptor
+***********************************************************************************************************************************/
+static int
+storageWriteFd(const THIS_VOID)
+{
+    THIS(const StorageWrite);
+
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_WRITE, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(INT, this->pub.interface->ioInterface.fd(this->driver));
+}
+
 /***********************************************************************************************************************************
 This object expects its context to be created in advance. This is so the calling function can add whatever data it wants without
 required multiple functions and contexts to make it safe.
@@ -48,9 +163,16 @@ storageWriteNew(void *const driver, const StorageWriteInterface *const interface
             .pub =
             {
                 .interface = interface,
-                .io = ioWriteNew(driver, interface->ioInterface),
             },
+            .driver = objMove(driver, memContextCurrent()),
         };
+
+        // Wrap the driver interface so time spent writing can be recorded. Close is always wrapped so the time is recorded but other
+        // optional functions are only wrapped when present in the driver.
+        this->pub.io = ioWriteNewP(
+            this, .open = interface->ioInterface.open != NULL ? storageWriteOpen : NULL, .write = storageWrite,
+            .close = storageWriteClose, .ready = interface->ioInterface.ready != NULL ? storageWriteReady : NULL,
+            .fd = interface->ioInterface.fd != NULL ? storageWriteFd : NULL);
     }
     OBJ_NEW_END();
 
@@ -151,6 +273,22 @@ storageWriteChunkBufferResize(const Buffer *const input, Buffer *const chunk, co
     FUNCTION_TEST_RETURN_VOID();
 }
 
+/**********************************************************************************************************************************/
+FN_EXTERN void
+storageWriteStorageDriverSet(StorageWrite *const this, const void *const storageDriver)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_WRITE, this);
+        FUNCTION_TEST_PARAM_P(VOID, storageDriver);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    this->pub.storageDriver = storageDriver;
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN void
 storageWriteToLog(const StorageWrite *const this, StringStatic *const debugLog)
@@ -16,6 +16,12 @@ typedef struct StorageWrite StorageWrite;
 #include "common/type/stringId.h"
 #include "storage/write.intern.h"
 
+/***********************************************************************************************************************************
+Statistics constants
+***********************************************************************************************************************************/
+#define STORAGE_STAT_WRITE                                          "storage.write"     // Time spent writing files
+STRING_DECLARE(STORAGE_STAT_WRITE_STR);
+
 /***********************************************************************************************************************************
 Functions
 ***********************************************************************************************************************************/
@@ -30,6 +30,7 @@ typedef struct StorageWriteInterface
     mode_t modePath;
     bool syncFile;
     bool syncPath;
+    bool syncDefer;                                                 // Start write to disk on close instead of syncing the file
     time_t timeModified;                                            // Time file was last modified
     const String *user;                                             // User that owns the file
 
@@ -45,6 +46,7 @@ typedef struct StorageWritePub
 {
     const StorageWriteInterface *interface;                         // File data (name, driver type, etc.)
     IoWrite *io;                                                    // Write interface
+    const void *storageDriver;                                      // Driver of the storage that created the write
 } StorageWritePub;
 
 // Write interface
@@ -54,4 +56,13 @@ storageWriteInterface(const StorageWrite *const this)
     return THIS_PUB(StorageWrite)->interface;
 }
 
+// Driver of the storage that created the write (NULL when not created by storageNewWrite())
+FN_INLINE_ALWAYS const void *
+storageWriteStorageDriver(const StorageWrite *const this)
+{
+    return THIS_PUB(StorageWrite)->storageDriver;
+}
+
+FN_EXTERN void storageWriteStorageDriverSet(StorageWrite *this, const void *storageDriver);
+
 #endif
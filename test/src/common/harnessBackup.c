@@ -325,6 +325,14 @@ hrnBackupPqScript(const unsigned int pgVersion, const time_t backupTimeStart, Hr
             // Continue if there is no error after start
             if (!param.errorAfterStart)
             {
+                // Switch WAL segment so changes since the prior backup can be found
+                if (param.walChange)
+                {
+                    HRN_PQ_SCRIPT_ADD(
+                        HRN_PQ_SCRIPT_CREATE_RESTORE_POINT(1, "X/X"),
+                        HRN_PQ_SCRIPT_WAL_SWITCH(1, "wal", walSegmentStart));
+                }
+
                 // Ping to check standby mode
                 HRN_PQ_SCRIPT_ADD(HRN_PQ_SCRIPT_IS_STANDBY_QUERY(1, false));
 
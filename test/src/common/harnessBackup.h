@@ -46,6 +46,7 @@ typedef struct HrnBackupPqScriptParam
     bool noPriorWal;                                                // Don't write prior test WAL segments
     bool noArchiveCheck;                                            // Do not check archive
     bool walSwitch;                                                 // WAL switch is required
+    bool walChange;                                                 // WAL switch is required to find changes since prior backup
     CompressType walCompressType;                                   // Compress type for the archive files
     CipherType cipherType;                                          // Cipher type
     const char *cipherPass;                                         // Cipher pass
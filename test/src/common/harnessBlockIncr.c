@@ -41,8 +41,12 @@ hrnBlockDeltaRender(const BlockMap *const blockMap, const size_t blockSize, cons
         {
             const BlockDeltaSuperBlock *const superBlock = lstGet(read->superBlockList, superBlockIdx);
 
-            strCatFmt(
-                result, "  super block {max: %" PRIu64 ", size: %" PRIu64 "}\n", superBlock->superBlockSize, superBlock->size);
+            strCatFmt(result, "  super block {max: %" PRIu64 ", size: %" PRIu64, superBlock->superBlockSize, superBlock->size);
+
+            if (superBlock->skip != 0)
+                strCatFmt(result, ", skip: %" PRIu64, superBlock->skip);
+
+            strCatZ(result, "}\n");
 
             for (unsigned int blockIdx = 0; blockIdx < lstSize(superBlock->blockList); blockIdx++)
             {
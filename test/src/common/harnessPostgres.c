@@ -3,7 +3,10 @@ Harness for PostgreSQL Interface
 ***********************************************************************************************************************************/
 #include "build.auto.h"
 
+#include <string.h>
+
 #include "common/assert.h"
+#include "postgres/interface/crc32.h"
 
 #include "common/harnessDebug.h"
 #include "common/harnessPostgres.h"
@@ -238,3 +241,237 @@ hrnPgWalToBuffer(Buffer *const walBuffer, const unsigned int magic, PgWal pgWal)
 
     FUNCTION_HARNESS_RETURN_VOID();
 }
+
+/**********************************************************************************************************************************/
+HrnPgWal *
+hrnPgWalNew(const unsigned int version, const uint64_t lsn, const size_t pageSize, const unsigned int segmentSize)
+{
+    FUNCTION_HARNESS_BEGIN();
+        FUNCTION_HARNESS_PARAM(UINT, version);
+        FUNCTION_HARNESS_PARAM(UINT64, lsn);
+        FUNCTION_HARNESS_PARAM(SIZE, pageSize);
+        FUNCTION_HARNESS_PARAM(UINT, segmentSize);
+    FUNCTION_HARNESS_END();
+
+    ASSERT(lsn % segmentSize == 0);
+    ASSERT(segmentSize % pageSize == 0);
+
+    OBJ_NEW_BEGIN(HrnPgWal, .childQty = MEM_CONTEXT_QTY_MAX)
+    {
+        *this = (HrnPgWal)
+        {
+            .version = version,
+            .lsn = lsn,
+            .pageSize = pageSize,
+            .segmentSize = segmentSize,
+            .buffer = bufNew(segmentSize),
+        };
+    }
+    OBJ_NEW_END();
+
+    FUNCTION_HARNESS_RETURN(HRN_PG_WAL, this);
+}
+
+/**********************************************************************************************************************************/
+void
+hrnPgWalWrite(HrnPgWal *const wal, const uint8_t *const data, const size_t size, const size_t remainSize)
+{
+    FUNCTION_HARNESS_BEGIN();
+        FUNCTION_HARNESS_PARAM(HRN_PG_WAL, wal);
+        FUNCTION_HARNESS_PARAM_P(VOID, data);
+        FUNCTION_HARNESS_PARAM(SIZE, size);
+        FUNCTION_HARNESS_PARAM(SIZE, remainSize);
+    FUNCTION_HARNESS_END();
+
+    ASSERT(wal != NULL);
+    ASSERT(data != NULL || size == 0);
+
+    size_t dataOffset = 0;
+
+    while (dataOffset < size)
+    {
+        const size_t offset = bufUsed(wal->buffer);
+
+        // Add a page header at the beginning of each page
+        if (offset % wal->pageSize == 0)
+        {
+            const bool longHeader = offset % wal->segmentSize == 0;
+            Buffer *const headerBuffer = bufNew(40);
+
+            memset(bufPtr(headerBuffer), 0, bufSize(headerBuffer));
+            bufUsedSet(headerBuffer, bufSize(headerBuffer));
+            hrnPgWalToBuffer(headerBuffer, 0, (PgWal){.version = wal->version, .size = wal->segmentSize});
+
+            uint8_t *const header = bufPtr(headerBuffer);
+
+            const uint16_t info =
+                (uint16_t)((longHeader ? 0x0002 : 0) | (dataOffset != 0 || remainSize != 0 ? 0x0001 : 0));
+            const uint32_t timeline = 1;
+            const uint64_t pageLsn = wal->lsn + offset;
+            const uint32_t remain = (uint32_t)(remainSize + size - dataOffset);
+            const uint32_t pageSize = (uint32_t)wal->pageSize;
+
+            memcpy(header + 2, &info, sizeof(info));
+            memcpy(header + 4, &timeline, sizeof(timeline));
+            memcpy(header + 8, &pageLsn, sizeof(pageLsn));
+            memcpy(header + 16, dataOffset != 0 || remainSize != 0 ? &remain : &(uint32_t){0}, sizeof(remain));
+            memcpy(header + 36, &pageSize, sizeof(pageSize));
+
+            bufCatC(wal->buffer, header, 0, longHeader ? 40 : 24);
+            bufFree(headerBuffer);
+        }
+
+        // Write as much data as will fit on the page
+        const size_t pageRemains = wal->pageSize - bufUsed(wal->buffer) % wal->pageSize;
+        const size_t copySize = size - dataOffset < pageRemains ? size - dataOffset : pageRemains;
+
+        bufCatC(wal->buffer, data, dataOffset, copySize);
+        dataOffset += copySize;
+    }
+
+    FUNCTION_HARNESS_RETURN_VOID();
+}
+
+/**********************************************************************************************************************************/
+void
+hrnPgWalRecord(HrnPgWal *const wal, const HrnPgWalRecordParam param)
+{
+    FUNCTION_HARNESS_BEGIN();
+        FUNCTION_HARNESS_PARAM(HRN_PG_WAL, wal);
+        FUNCTION_HARNESS_PARAM(UINT, param.resourceManagerId);
+        FUNCTION_HARNESS_PARAM(UINT, param.info);
+        FUNCTION_HARNESS_PARAM(UINT, param.blockTotal);
+    FUNCTION_HARNESS_END();
+
+    ASSERT(wal != NULL);
+
+    Buffer *const record = bufNew(0);
+    const size_t imageSize = 16;
+
+    // Header (total length and CRC are set at the end)
+    const uint8_t header[24] = {[16] = param.info, [17] = param.resourceManagerId};
+    bufCatC(record, header, 0, sizeof(header));
+
+    if (param.origin)
+        bufCatC(record, (const uint8_t []){253, 1, 0}, 0, 3);
+
+    if (param.topXid)
+        bufCatC(record, (const uint8_t []){252, 1, 0, 0, 0}, 0, 5);
+
+    // Block headers
+    for (unsigned int blockIdx = 0; blockIdx < param.blockTotal; blockIdx++)
+    {
+        const PgWalRecordBlock *const block = &param.blockList[blockIdx];
+        const bool sameRel =
+            blockIdx > 0 && block->tablespaceId == param.blockList[blockIdx - 1].tablespaceId &&
+            block->dbId == param.blockList[blockIdx - 1].dbId && block->relFileNode == param.blockList[blockIdx - 1].relFileNode;
+        const uint8_t forkFlags = (uint8_t)(block->fork | (param.blockImage ? 0x10 : 0) | (sameRel ? 0x80 : 0));
+        const uint16_t dataSize = (uint16_t)param.blockDataSize;
+
+        bufCatC(record, (const uint8_t []){(uint8_t)blockIdx, forkFlags}, 0, 2);
+        bufCatC(record, (const uint8_t *)&dataSize, 0, sizeof(dataSize));
+
+        if (param.blockImage)
+        {
+            const uint16_t imageLength = (uint16_t)imageSize;
+
+            bufCatC(record, (const uint8_t *)&imageLength, 0, sizeof(imageLength));
+            bufCatC(record, (const uint8_t []){0, 0, param.blockImageInfo}, 0, 3);
+
+            // Hole length is only present for compressed images, any compression flag is fine for testing
+            if ((param.blockImageInfo & 0x01) && (param.blockImageInfo & (wal->version >= PG_VERSION_15 ? 0x1C : 0x02)))
+                bufCatC(record, (const uint8_t []){0, 0}, 0, 2);
+        }
+
+        if (!sameRel)
+        {
+            const uint32_t relFileNode[] = {block->tablespaceId, block->dbId, block->relFileNode};
+            bufCatC(record, (const uint8_t *)relFileNode, 0, sizeof(relFileNode));
+        }
+
+        bufCatC(record, (const uint8_t *)&block->blockNo, 0, sizeof(block->blockNo));
+    }
+
+    // Main data header
+    if (param.mainData != NULL)
+    {
+        if (bufUsed(param.mainData) < 256)
+            bufCatC(record, (const uint8_t []){255, (uint8_t)bufUsed(param.mainData)}, 0, 2);
+        else
+        {
+            const uint32_t mainDataSize = (uint32_t)bufUsed(param.mainData);
+
+            bufCatC(record, (const uint8_t []){254}, 0, 1);
+            bufCatC(record, (const uint8_t *)&mainDataSize, 0, sizeof(mainDataSize));
+        }
+    }
+
+    // Block data
+    for (unsigned int blockIdx = 0; blockIdx < param.blockTotal; blockIdx++)
+    {
+        const size_t dataSize = (param.blockImage ? imageSize : 0) + param.blockDataSize;
+        Buffer *const data = bufNew(dataSize);
+
+        memset(bufPtr(data), (int)blockIdx + 1, dataSize);
+        bufUsedSet(data, dataSize);
+        bufCat(record, data);
+        bufFree(data);
+    }
+
+    // Main data
+    if (param.mainData != NULL)
+        bufCat(record, param.mainData);
+
+    // Set total length and CRC
+    const uint32_t totalSize = (uint32_t)bufUsed(record);
+    memcpy(bufPtr(record), &totalSize, sizeof(totalSize));
+
+    uint32_t crc = param.crc;
+
+    if (crc == 0)
+    {
+        Buffer *const crcData = bufNew(totalSize);
+
+        bufCatC(crcData, bufPtrConst(record), 24, totalSize - 24);
+        bufCatC(crcData, bufPtrConst(record), 0, 20);
+        crc = crc32cOne(bufPtrConst(crcData), bufUsed(crcData));
+        bufFree(crcData);
+    }
+
+    memcpy(bufPtr(record) + 20, &crc, sizeof(crc));
+
+    // Align the record start
+    while (bufUsed(wal->buffer) % 8 != 0)
+        bufCatC(wal->buffer, (const uint8_t []){0}, 0, 1);
+
+    // Write the record
+    hrnPgWalWrite(wal, bufPtrConst(record), bufUsed(record), 0);
+    bufFree(record);
+
+    FUNCTION_HARNESS_RETURN_VOID();
+}
+
+/**********************************************************************************************************************************/
+void
+hrnPgWalSegmentEnd(HrnPgWal *const wal)
+{
+    FUNCTION_HARNESS_BEGIN();
+        FUNCTION_HARNESS_PARAM(HRN_PG_WAL, wal);
+    FUNCTION_HARNESS_END();
+
+    ASSERT(wal != NULL);
+
+    const size_t remains = wal->segmentSize - bufUsed(wal->buffer) % wal->segmentSize;
+
+    if (remains != wal->segmentSize)
+    {
+        Buffer *const zero = bufNew(remains);
+
+        memset(bufPtr(zero), 0, remains);
+        bufUsedSet(zero, remains);
+        bufCat(wal->buffer, zero);
+        bufFree(zero);
+    }
+
+    FUNCTION_HARNESS_RETURN_VOID();
+}
@@ -6,6 +6,7 @@ Harness for PostgreSQL Interface
 
 #include "postgres/interface.h"
 #include "postgres/version.h"
+#include "postgres/walRecord.h"
 
 #include "common/harnessStorage.h"
 
@@ -72,6 +73,45 @@ Copy WAL info to buffer
 #define HRN_PG_WAL_OVERRIDE_TO_BUFFER(walBufferParam, versionParam, magicParam, ...)                                               \
     hrnPgWalToBuffer(walBufferParam, magicParam, (PgWal){.version = versionParam, __VA_ARGS__})
 
+/***********************************************************************************************************************************
+Build a stream of WAL segments containing records
+
+Page headers are added as records are written and records span pages (and segments) as required. The stream always begins at the
+start of a segment.
+***********************************************************************************************************************************/
+typedef struct HrnPgWal
+{
+    unsigned int version;                                           // PostgreSQL version
+    uint64_t lsn;                                                   // LSN where the stream begins
+    size_t pageSize;                                                // WAL page size
+    unsigned int segmentSize;                                       // WAL segment size
+    Buffer *buffer;                                                 // WAL stream
+} HrnPgWal;
+
+typedef struct HrnPgWalRecordParam
+{
+    VAR_PARAM_HEADER;
+    uint8_t resourceManagerId;                                      // Resource manager id
+    uint8_t info;                                                   // Record info
+    const PgWalRecordBlock *blockList;                              // Blocks referenced by the record
+    unsigned int blockTotal;                                        // Number of blocks referenced
+    size_t blockDataSize;                                           // Data stored with each block
+    bool blockImage;                                                // Store an image with each block
+    uint8_t blockImageInfo;                                         // Image info flags
+    bool origin;                                                    // Add replication origin
+    bool topXid;                                                    // Add top-level transaction id
+    const Buffer *mainData;                                         // Main data
+    uint32_t crc;                                                   // Override the CRC (0 to calculate)
+} HrnPgWalRecordParam;
+
+#define FUNCTION_LOG_HRN_PG_WAL_TYPE                                                                                               \
+    HrnPgWal *
+#define FUNCTION_LOG_HRN_PG_WAL_FORMAT(value, buffer, bufferSize)                                                                  \
+    objNameToLog(value, "HrnPgWal", buffer, bufferSize)
+
+#define hrnPgWalRecordP(wal, ...)                                                                                                  \
+    hrnPgWalRecord(wal, (HrnPgWalRecordParam){VAR_PARAM_INIT, __VA_ARGS__})
+
 /***********************************************************************************************************************************
 Update control file time
 ***********************************************************************************************************************************/
@@ -97,4 +137,17 @@ hrnPgSystemId(const unsigned int pgVersion)
 // Create WAL for testing
 void hrnPgWalToBuffer(Buffer *walBuffer, unsigned int magic, PgWal pgWal);
 
+// Create a WAL stream for testing
+HrnPgWal *hrnPgWalNew(unsigned int version, uint64_t lsn, size_t pageSize, unsigned int segmentSize);
+
+// Add a record to the WAL stream
+void hrnPgWalRecord(HrnPgWal *wal, HrnPgWalRecordParam param);
+
+// Write bytes to the WAL stream, adding page headers as required. Any data that continues a record must pass the number of bytes
+// remaining in the record.
+void hrnPgWalWrite(HrnPgWal *wal, const uint8_t *data, size_t size, size_t remainSize);
+
+// Zero the remainder of the current segment
+void hrnPgWalSegmentEnd(HrnPgWal *wal);
+
 #endif
@@ -43,6 +43,7 @@ Create a pg_control file
             },                                                                                                                     \
             .blcksz = pgControl.pageSize,                                                                                          \
             .xlog_seg_size = pgControl.walSegmentSize,                                                                             \
+            .relseg_size = pgControl.segmentBlockTotal,                                                                            \
             .data_checksum_version = pgControl.pageChecksumVersion,                                                                \
         };                                                                                                                         \
                                                                                                                                    \
@@ -490,6 +490,40 @@ Macros for defining groups of functions that implement various queries and comma
     HRN_PQ_SCRIPT_CHECKPOINT_TARGET_REACHED(                                                                                       \
         sessionParam, "lsn", targetLsnParam, targetReachedParam, checkpointLsnParam, sleepParam)
 
+#define                                                                                                                            \
+    HRN_PQ_SCRIPT_REPLAY_TARGET_REACHED_PROGRESS(                                                                                  \
+        sessionParam, walNameParam, lsnNameParam, targetLsnParam, targetReachedParam, replayLsnParam, replayLastLsnParam,          \
+        replayProgressParam, sleepParam)                                                                                           \
+    {.session = sessionParam,                                                                                                      \
+        .function = HRN_PQ_SENDQUERY,                                                                                              \
+        .param =                                                                                                                   \
+            "[\"select replayLsn::text,\\n"                                                                                        \
+            "       (replayLsn > '" targetLsnParam "')::bool as targetReached,\\n"                                                 \
+            "       (replayLsn > '" replayLastLsnParam "')::bool as replayProgress\\n"                                             \
+            "  from pg_catalog.pg_last_" walNameParam "_replay_" lsnNameParam "() as replayLsn\"]",                                \
+        .resultInt = 1, .sleep = sleepParam},                                                                                      \
+    {.session = sessionParam, .function = HRN_PQ_CONSUMEINPUT},                                                                    \
+    {.session = sessionParam, .function = HRN_PQ_ISBUSY},                                                                          \
+    {.session = sessionParam, .function = HRN_PQ_GETRESULT},                                                                       \
+    {.session = sessionParam, .function = HRN_PQ_RESULTSTATUS, .resultInt = PGRES_TUPLES_OK},                                      \
+    {.session = sessionParam, .function = HRN_PQ_NTUPLES, .resultInt = 1},                                                         \
+    {.session = sessionParam, .function = HRN_PQ_NFIELDS, .resultInt = 3},                                                         \
+    {.session = sessionParam, .function = HRN_PQ_FTYPE, .param = "[0]", .resultInt = HRN_PQ_TYPE_TEXT},                            \
+    {.session = sessionParam, .function = HRN_PQ_FTYPE, .param = "[1]", .resultInt = HRN_PQ_TYPE_BOOL},                            \
+    {.session = sessionParam, .function = HRN_PQ_FTYPE, .param = "[2]", .resultInt = HRN_PQ_TYPE_BOOL},                            \
+    {.session = sessionParam, .function = HRN_PQ_GETVALUE, .param = "[0,0]", .resultZ = replayLsnParam},                           \
+    {.session = sessionParam, .function = HRN_PQ_GETVALUE, .param = "[0,1]", .resultZ = cvtBoolToConstZ(targetReachedParam)},      \
+    {.session = sessionParam, .function = HRN_PQ_GETVALUE, .param = "[0,2]", .resultZ = cvtBoolToConstZ(replayProgressParam)},     \
+    {.session = sessionParam, .function = HRN_PQ_CLEAR},                                                                           \
+    {.session = sessionParam, .function = HRN_PQ_GETRESULT, .resultNull = true}
+
+#define                                                                                                                            \
+    HRN_PQ_SCRIPT_REPLAY_TARGET_REACHED_PROGRESS_GE_10(                                                                            \
+        sessionParam, targetLsnParam, targetReachedParam, replayLsnParam, replayLastLsnParam, replayProgressParam, sleepParam)     \
+    HRN_PQ_SCRIPT_REPLAY_TARGET_REACHED_PROGRESS(                                                                                  \
+        sessionParam, "wal", "lsn", targetLsnParam, targetReachedParam, replayLsnParam, replayLastLsnParam, replayProgressParam,   \
+        sleepParam)
+
 #define HRN_PQ_SCRIPT_REPLAY_WAIT_96(sessionParam, targetLsnParam)                                                                 \
     HRN_PQ_SCRIPT_REPLAY_TARGET_REACHED_LE_96(sessionParam, targetLsnParam, true, "X/X"),                                          \
     HRN_PQ_SCRIPT_CHECKPOINT(sessionParam),                                                                                        \
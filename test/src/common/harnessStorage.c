@@ -145,7 +145,7 @@ hrnStorageList(const Storage *const storage, const char *const path, const char
 
     StorageIterator *const storageItr = storageNewItrP(
         storage, pathFull, .recurse = !param.noRecurse, .sortOrder = sortOrder, .level = level,
-        .expression = param.expression != NULL ? STR(param.expression) : NULL);
+        .expression = param.expression != NULL ? STR(param.expression) : NULL, .parallel = param.parallel);
 
     while (storageItrMore(storageItr))
     {
@@ -72,6 +72,7 @@ typedef struct HrnStorageListParam
     bool levelForce;                                                // Use the level specified (rather than updating default)
     SortOrder sortOrder;                                            // Sort order
     const char *expression;                                         // Filter the list based on expression
+    unsigned int parallel;                                          // Subpaths to list concurrently
     const char *comment;                                            // Comment
 } HrnStorageListParam;
 
@@ -554,6 +554,131 @@ testRun(void)
         TEST_STORAGE_LIST(
             storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN, "000000010000000200000000.pgbackrest.tmp\n", .remove = true);
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("index is written when listing");
+
+        argList = strLstNew();
+        hrnCfgArgRawZ(argList, cfgOptPgPath, TEST_PATH "/pg");
+        hrnCfgArgRawZ(argList, cfgOptRepoPath, TEST_PATH "/repo");
+        hrnCfgArgRawZ(argList, cfgOptSpoolPath, TEST_PATH "/spool");
+        hrnCfgArgRawBool(argList, cfgOptArchiveAsync, true);
+        hrnCfgArgRawZ(argList, cfgOptStanza, "test2");
+        strLstAddZ(argList, "000000010000000300000001");
+        strLstAddZ(argList, "000000010000000300000002");
+        HRN_CFG_LOAD(cfgCmdArchiveGet, argList, .role = cfgCmdRoleAsync);
+
+        HRN_STORAGE_PUT_EMPTY(
+            storageRepoWrite(), STORAGE_REPO_ARCHIVE "/10-1/000000010000000300000001-abcdabcdabcdabcdabcdabcdabcdabcdabcdabcd");
+        HRN_STORAGE_PUT_EMPTY(
+            storageRepoWrite(), STORAGE_REPO_ARCHIVE "/10-1/000000010000000300000002-abcdabcdabcdabcdabcdabcdabcdabcdabcdabcd");
+        HRN_STORAGE_PUT_EMPTY(
+            storageRepoWrite(), STORAGE_REPO_ARCHIVE "/10-1/000000010000000300000003-abcdabcdabcdabcdabcdabcdabcdabcdabcdabcd");
+
+        TEST_RESULT_VOID(cmdArchiveGetAsync(), "archive async");
+
+        TEST_RESULT_LOG(
+            "P00   INFO: get 2 WAL file(s) from archive: 000000010000000300000001...000000010000000300000002\n"
+            "P01 DETAIL: found 000000010000000300000001 in the repo1: 10-1 archive\n"
+            "P01 DETAIL: found 000000010000000300000002 in the repo1: 10-1 archive");
+
+        TEST_STORAGE_LIST(
+            storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN, "000000010000000300000001\n000000010000000300000002\n", .remove = true);
+        TEST_STORAGE_LIST(storageSpool(), STORAGE_SPOOL_ARCHIVE "/index", "repo1/\nrepo1/10-1/\nrepo1/10-1/0000000100000003\n");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("files in the index are found without listing");
+
+        // Remove read permission so the path cannot be listed
+        HRN_STORAGE_MODE(storageRepoIdxWrite(0), STORAGE_REPO_ARCHIVE "/10-1/0000000100000003", .mode = 0300);
+
+        argList = strLstNew();
+        hrnCfgArgRawZ(argList, cfgOptPgPath, TEST_PATH "/pg");
+        hrnCfgArgRawZ(argList, cfgOptRepoPath, TEST_PATH "/repo");
+        hrnCfgArgRawZ(argList, cfgOptSpoolPath, TEST_PATH "/spool");
+        hrnCfgArgRawBool(argList, cfgOptArchiveAsync, true);
+        hrnCfgArgRawZ(argList, cfgOptStanza, "test2");
+        strLstAddZ(argList, "000000010000000300000002");
+        strLstAddZ(argList, "000000010000000300000003");
+        HRN_CFG_LOAD(cfgCmdArchiveGet, argList, .role = cfgCmdRoleAsync);
+
+        TEST_RESULT_VOID(cmdArchiveGetAsync(), "archive async");
+
+        TEST_RESULT_LOG(
+            "P00   INFO: get 2 WAL file(s) from archive: 000000010000000300000002...000000010000000300000003\n"
+            "P01 DETAIL: found 000000010000000300000002 in the repo1: 10-1 archive\n"
+            "P01 DETAIL: found 000000010000000300000003 in the repo1: 10-1 archive");
+
+        TEST_STORAGE_LIST(
+            storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN, "000000010000000300000002\n000000010000000300000003\n", .remove = true);
+
+        HRN_STORAGE_MODE(storageRepoIdxWrite(0), STORAGE_REPO_ARCHIVE "/10-1/0000000100000003");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("files not in the index are listed");
+
+        HRN_STORAGE_PUT_EMPTY(
+            storageRepoWrite(), STORAGE_REPO_ARCHIVE "/10-1/000000010000000300000004-abcdabcdabcdabcdabcdabcdabcdabcdabcdabcd");
+
+        strLstAddZ(argList, "000000010000000300000004");
+        HRN_CFG_LOAD(cfgCmdArchiveGet, argList, .role = cfgCmdRoleAsync);
+
+        TEST_RESULT_VOID(cmdArchiveGetAsync(), "archive async");
+
+        TEST_RESULT_LOG(
+            "P00   INFO: get 3 WAL file(s) from archive: 000000010000000300000002...000000010000000300000004\n"
+            "P01 DETAIL: found 000000010000000300000002 in the repo1: 10-1 archive\n"
+            "P01 DETAIL: found 000000010000000300000003 in the repo1: 10-1 archive\n"
+            "P01 DETAIL: found 000000010000000300000004 in the repo1: 10-1 archive");
+
+        TEST_STORAGE_LIST(
+            storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN,
+            "000000010000000300000002\n000000010000000300000003\n000000010000000300000004\n", .remove = true);
+        TEST_STORAGE_GET(
+            storageSpool(), STORAGE_SPOOL_ARCHIVE "/index/repo1/10-1/0000000100000003",
+            "000000010000000300000001-abcdabcdabcdabcdabcdabcdabcdabcdabcdabcd\n"
+            "000000010000000300000002-abcdabcdabcdabcdabcdabcdabcdabcdabcdabcd\n"
+            "000000010000000300000003-abcdabcdabcdabcdabcdabcdabcdabcdabcdabcd\n"
+            "000000010000000300000004-abcdabcdabcdabcdabcdabcdabcdabcdabcdabcd");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("index is removed when a file in the index is missing");
+
+        HRN_STORAGE_REMOVE(
+            storageRepoWrite(),
+            STORAGE_REPO_ARCHIVE "/10-1/0000000100000003/000000010000000300000002-abcdabcdabcdabcdabcdabcdabcdabcdabcdabcd");
+
+        TEST_RESULT_VOID(cmdArchiveGetAsync(), "archive async");
+
+        TEST_RESULT_LOG(
+            "P00   INFO: get 3 WAL file(s) from archive: 000000010000000300000002...000000010000000300000004\n"
+            "P01   WARN: [FileReadError] raised from local-1 shim protocol: unable to get 000000010000000300000002:\n"
+            "            repo1: 10-1/0000000100000003/000000010000000300000002-abcdabcdabcdabcdabcdabcdabcdabcdabcdabcd"
+            " [FileMissingError] unable to open missing file '" TEST_PATH "/repo/archive/test2/10-1/0000000100000003"
+            "/000000010000000300000002-abcdabcdabcdabcdabcdabcdabcdabcdabcdabcd' for read\n"
+            "P01 DETAIL: found 000000010000000300000003 in the repo1: 10-1 archive\n"
+            "P01 DETAIL: found 000000010000000300000004 in the repo1: 10-1 archive");
+
+        TEST_STORAGE_LIST(
+            storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN,
+            "000000010000000300000002.error\n000000010000000300000003\n000000010000000300000004\n", .remove = true);
+        TEST_STORAGE_LIST(storageSpool(), STORAGE_SPOOL_ARCHIVE, "in/\n");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("index is rebuilt");
+
+        TEST_RESULT_VOID(cmdArchiveGetAsync(), "archive async");
+
+        TEST_RESULT_LOG(
+            "P00   INFO: get 3 WAL file(s) from archive: 000000010000000300000002...000000010000000300000004\n"
+            "P00 DETAIL: unable to find 000000010000000300000002 in the archive");
+
+        TEST_STORAGE_LIST(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN, "000000010000000300000002.ok\n", .remove = true);
+        TEST_STORAGE_GET(
+            storageSpool(), STORAGE_SPOOL_ARCHIVE "/index/repo1/10-1/0000000100000003",
+            "000000010000000300000001-abcdabcdabcdabcdabcdabcdabcdabcdabcdabcd\n"
+            "000000010000000300000003-abcdabcdabcdabcdabcdabcdabcdabcdabcdabcd\n"
+            "000000010000000300000004-abcdabcdabcdabcdabcdabcdabcdabcdabcdabcd");
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("global error on invalid executable");
 
@@ -587,6 +712,147 @@ testRun(void)
         TEST_STORAGE_LIST(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN, "global.error\n", .remove = true);
     }
 
+    // *****************************************************************************************************************************
+    if (testBegin("cmdArchiveGetAsync() resident"))
+    {
+        harnessLogLevelSet(logLevelDetail);
+
+        // Install local command handler shim
+        static const ProtocolServerHandler testLocalHandlerList[] = {PROTOCOL_SERVER_HANDLER_ARCHIVE_GET_LIST};
+        hrnProtocolLocalShimInstall(LSTDEF(testLocalHandlerList));
+
+        // Arguments that must be included. The queue holds two segments.
+        StringList *argBaseList = strLstNew();
+        hrnCfgArgRawZ(argBaseList, cfgOptPgPath, TEST_PATH "/pg");
+        hrnCfgArgRawZ(argBaseList, cfgOptRepoPath, TEST_PATH "/repo");
+        hrnCfgArgRawZ(argBaseList, cfgOptSpoolPath, TEST_PATH "/spool");
+        hrnCfgArgRawBool(argBaseList, cfgOptArchiveAsync, true);
+        hrnCfgArgRawZ(argBaseList, cfgOptArchiveGetQueueMax, "32MiB");
+        hrnCfgArgRawZ(argBaseList, cfgOptArchiveGetResident, "200ms");
+        hrnCfgArgRawZ(argBaseList, cfgOptStanza, "test2");
+        strLstAddZ(argBaseList, "000000010000000100000001");
+        HRN_CFG_LOAD(cfgCmdArchiveGet, argBaseList, .role = cfgCmdRoleAsync);
+
+        HRN_PG_CONTROL_PUT(storagePgWrite(), PG_VERSION_10);
+        HRN_STORAGE_PUT_EMPTY(storagePgWrite(), PG_FILE_BACKUPLABEL);
+
+        HRN_INFO_PUT(
+            storageRepoWrite(), INFO_ARCHIVE_PATH_FILE,
+            "[db]\n"
+            "db-id=1\n"
+            "\n"
+            "[db:history]\n"
+            "1={\"db-id\":" HRN_PG_SYSTEMID_10_Z ",\"db-version\":\"10\"}\n");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("lookahead and average");
+
+        TEST_RESULT_UINT(archiveGetAsyncLookahead(0, 0, 1, 8), 8, "replay time unknown");
+        TEST_RESULT_UINT(archiveGetAsyncLookahead(1000, 0, 0, 8), 2, "minimum");
+        TEST_RESULT_UINT(archiveGetAsyncLookahead(1000, 1500, 2, 8), 5, "replay faster than fetch");
+        TEST_RESULT_UINT(archiveGetAsyncLookahead(10, 1500, 2, 8), 8, "maximum");
+
+        TEST_RESULT_UINT(archiveGetAsyncAverage(0, 100), 100, "first sample");
+        TEST_RESULT_UINT(archiveGetAsyncAverage(100, 200), 125, "next sample");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("exit on missing segment");
+
+        HRN_STORAGE_PUT_EMPTY(
+            storageRepoWrite(), STORAGE_REPO_ARCHIVE "/10-1/000000010000000100000001-abcdabcdabcdabcdabcdabcdabcdabcdabcdabcd");
+        HRN_STORAGE_PUT_EMPTY(
+            storageRepoWrite(), STORAGE_REPO_ARCHIVE "/10-1/000000010000000100000002-abcdabcdabcdabcdabcdabcdabcdabcdabcdabcd");
+        HRN_STORAGE_PUT_Z(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE "/get.request", "000000010000000100000001");
+        HRN_STORAGE_PATH_CREATE(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN);
+
+        TEST_RESULT_VOID(cmdArchiveGetAsync(), "get async");
+
+        TEST_RESULT_LOG(
+            "P00   INFO: get 1 WAL file(s) from archive: 000000010000000100000001\n"
+            "P01 DETAIL: found 000000010000000100000001 in the repo1: 10-1 archive\n"
+            "P00   INFO: get 2 WAL file(s) from archive: 000000010000000100000002...000000010000000100000003\n"
+            "P01 DETAIL: found 000000010000000100000002 in the repo1: 10-1 archive\n"
+            "P00 DETAIL: unable to find 000000010000000100000003 in the archive");
+
+        TEST_STORAGE_LIST(
+            storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN,
+            "000000010000000100000001\n000000010000000100000002\n000000010000000100000003.ok\n", .remove = true);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("exit when no segment is requested");
+
+        HRN_STORAGE_PUT_EMPTY(
+            storageRepoWrite(), STORAGE_REPO_ARCHIVE "/10-1/000000010000000100000003-abcdabcdabcdabcdabcdabcdabcdabcdabcdabcd");
+
+        TEST_RESULT_VOID(cmdArchiveGetAsync(), "get async");
+
+        TEST_RESULT_LOG(
+            "P00   INFO: get 1 WAL file(s) from archive: 000000010000000100000001\n"
+            "P01 DETAIL: found 000000010000000100000001 in the repo1: 10-1 archive\n"
+            "P00   INFO: get 2 WAL file(s) from archive: 000000010000000100000002...000000010000000100000003\n"
+            "P01 DETAIL: found 000000010000000100000002 in the repo1: 10-1 archive\n"
+            "P01 DETAIL: found 000000010000000100000003 in the repo1: 10-1 archive\n"
+            "P00 DETAIL: no WAL requested for 200ms");
+
+        TEST_STORAGE_LIST(
+            storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN,
+            "000000010000000100000001\n000000010000000100000002\n000000010000000100000003\n", .remove = true);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("track requests");
+
+        ArchiveGetAsyncResident resident;
+
+        HRN_STORAGE_REMOVE(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE "/get.request");
+
+        StringList *requestList = strLstNew();
+        strLstAddZ(requestList, "000000010000000100000002");
+        strLstAddZ(requestList, "000000010000000100000003");
+
+        TEST_RESULT_VOID(archiveGetAsyncResidentInit(&resident, requestList), "init");
+        TEST_RESULT_UINT(resident.queueMax, 2, "queue max");
+
+        TEST_RESULT_BOOL(archiveGetAsyncResidentRequest(&resident), true, "no request");
+        TEST_RESULT_PTR(resident.request, NULL, "request not set");
+
+        HRN_STORAGE_PUT_Z(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE "/get.request", "000000010000000100000001");
+
+        TEST_RESULT_BOOL(archiveGetAsyncResidentRequest(&resident), true, "first request before plan");
+        TEST_RESULT_STR_Z(resident.request, "000000010000000100000001", "request");
+        TEST_RESULT_BOOL(resident.requestPlanned, false, "request not planned");
+        TEST_RESULT_STRLST_Z(resident.planList, "000000010000000100000002\n000000010000000100000003\n", "plan");
+
+        HRN_STORAGE_PUT_Z(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE "/get.request", "000000010000000100000002");
+
+        TEST_RESULT_BOOL(archiveGetAsyncResidentRequest(&resident), true, "request in plan");
+        TEST_RESULT_BOOL(resident.requestPlanned, true, "request planned");
+        TEST_RESULT_UINT(resident.replayTime, 0, "replay time unknown");
+        TEST_RESULT_STRLST_Z(resident.planList, "000000010000000100000002\n000000010000000100000003\n", "plan");
+
+        HRN_STORAGE_PUT_Z(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE "/get.request", "000000010000000100000004");
+        resident.requestTime -= 2000;
+
+        TEST_RESULT_BOOL(archiveGetAsyncResidentRequest(&resident), true, "request after plan");
+        TEST_RESULT_BOOL(resident.replayTime >= 1000, true, "replay time");
+        TEST_RESULT_STRLST_Z(resident.planList, NULL, "plan empty");
+
+        TEST_RESULT_STRLST_Z(
+            archiveGetAsyncResidentNext(&resident), "000000010000000100000004\n000000010000000100000005\n", "next");
+        TEST_RESULT_STRLST_Z(resident.planList, "000000010000000100000004\n000000010000000100000005\n", "plan");
+
+        HRN_STORAGE_PUT_Z(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE "/get.request", "000000020000000100000004");
+
+        TEST_RESULT_BOOL(archiveGetAsyncResidentRequest(&resident), false, "request outside plan");
+        TEST_RESULT_PTR(archiveGetAsyncResidentNext(&resident), NULL, "no next");
+        TEST_RESULT_STR_Z(resident.request, "000000010000000100000004", "request not updated");
+
+        TEST_RESULT_LOG(
+            "P00 DETAIL: WAL file 000000020000000100000004 requested outside of the queue\n"
+            "P00 DETAIL: WAL file 000000020000000100000004 requested outside of the queue");
+
+        HRN_STORAGE_REMOVE(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE "/get.request");
+    }
+
     // *****************************************************************************************************************************
     if (testBegin("cmdArchiveGet()"))
     {
@@ -341,6 +341,90 @@ testRun(void)
             storageRepoIdxWrite(0), zNewFmt(STORAGE_REPO_ARCHIVE "/11-1/000000010000000100000001-%s.gz", walBuffer1Sha1),
             .remove = true, .comment = "check repo for WAL file, then remove");
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("attempt to push WAL with an invalid record CRC");
+
+        argListTemp = strLstDup(argList);
+        hrnCfgArgRawBool(argListTemp, cfgOptArchiveHeaderCheck, false);
+        hrnCfgArgRawBool(argListTemp, cfgOptArchiveRecordCheck, true);
+        strLstAddZ(argListTemp, "pg_wal/000000010000000100000001");
+        HRN_CFG_LOAD(cfgCmdArchivePush, argListTemp);
+
+        HrnPgWal *wal = hrnPgWalNew(PG_VERSION_11, 0x100000000, 8192, 16 * 1024 * 1024);
+        hrnPgWalRecordP(
+            wal, .resourceManagerId = 10, .blockList = (const PgWalRecordBlock []){{1663, 1, 2, 0, 3}}, .blockTotal = 1);
+        hrnPgWalRecordP(wal, .resourceManagerId = 10, .mainData = BUFSTRDEF("DATA"), .crc = 0xDEADBEEF);
+        hrnPgWalSegmentEnd(wal);
+
+        HRN_STORAGE_PUT(storagePgWrite(), "pg_wal/000000010000000100000001", wal->buffer);
+
+        TEST_ERROR(
+            cmdArchivePush(), FormatError, "incorrect resource manager data checksum in record at 1/58");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("attempt to push WAL that ends without a switch");
+
+        wal = hrnPgWalNew(PG_VERSION_11, 0x100000000, 8192, 16 * 1024 * 1024);
+        hrnPgWalRecordP(
+            wal, .resourceManagerId = 10, .blockList = (const PgWalRecordBlock []){{1663, 1, 2, 0, 3}}, .blockTotal = 1);
+        hrnPgWalRecordP(wal, .resourceManagerId = 10, .mainData = BUFSTRDEF("DATA"));
+        hrnPgWalSegmentEnd(wal);
+
+        HRN_STORAGE_PUT(storagePgWrite(), "pg_wal/000000010000000100000001", wal->buffer);
+
+        TEST_ERROR(cmdArchivePush(), FormatError, "unexpected zero length record at 1/78");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("push partial WAL that ends without a switch");
+
+        argListTemp = strLstDup(argList);
+        hrnCfgArgRawBool(argListTemp, cfgOptArchiveHeaderCheck, false);
+        hrnCfgArgRawBool(argListTemp, cfgOptArchiveRecordCheck, true);
+        strLstAddZ(argListTemp, "pg_wal/000000010000000100000001.partial");
+        HRN_CFG_LOAD(cfgCmdArchivePush, argListTemp);
+
+        HRN_STORAGE_PUT(storagePgWrite(), "pg_wal/000000010000000100000001.partial", wal->buffer);
+
+        TEST_RESULT_VOID(cmdArchivePush(), "push the partial WAL segment");
+        TEST_RESULT_LOG("P00   INFO: pushed WAL file '000000010000000100000001.partial' to the archive");
+
+        TEST_STORAGE_EXISTS(
+            storageRepoIdxWrite(0),
+            zNewFmt(
+                STORAGE_REPO_ARCHIVE "/11-1/000000010000000100000001.partial-%s.gz",
+                strZ(strNewEncode(encodingHex, cryptoHashOne(hashTypeSha1, wal->buffer)))),
+            .remove = true, .comment = "check repo for partial WAL file, then remove");
+
+        HRN_STORAGE_REMOVE(storagePgWrite(), "pg_wal/000000010000000100000001.partial", .errorOnMissing = true);
+
+        argListTemp = strLstDup(argList);
+        hrnCfgArgRawBool(argListTemp, cfgOptArchiveHeaderCheck, false);
+        hrnCfgArgRawBool(argListTemp, cfgOptArchiveRecordCheck, true);
+        strLstAddZ(argListTemp, "pg_wal/000000010000000100000001");
+        HRN_CFG_LOAD(cfgCmdArchivePush, argListTemp);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("push WAL with valid record CRCs");
+
+        wal = hrnPgWalNew(PG_VERSION_11, 0x100000000, 8192, 16 * 1024 * 1024);
+        hrnPgWalRecordP(
+            wal, .resourceManagerId = 10, .blockList = (const PgWalRecordBlock []){{1663, 1, 2, 0, 3}}, .blockTotal = 1);
+        hrnPgWalRecordP(wal, .resourceManagerId = 10, .mainData = BUFSTRDEF("DATA"));
+        hrnPgWalRecordP(wal, .resourceManagerId = PG_WAL_RMGR_XLOG, .info = PG_WAL_XLOG_SWITCH);
+        hrnPgWalSegmentEnd(wal);
+
+        HRN_STORAGE_PUT(storagePgWrite(), "pg_wal/000000010000000100000001", wal->buffer);
+
+        TEST_RESULT_VOID(cmdArchivePush(), "push the WAL segment");
+        TEST_RESULT_LOG("P00   INFO: pushed WAL file '000000010000000100000001' to the archive");
+
+        TEST_STORAGE_EXISTS(
+            storageRepoIdxWrite(0),
+            zNewFmt(
+                STORAGE_REPO_ARCHIVE "/11-1/000000010000000100000001-%s.gz",
+                strZ(strNewEncode(encodingHex, cryptoHashOne(hashTypeSha1, wal->buffer)))),
+            .remove = true, .comment = "check repo for WAL file, then remove");
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("generate valid WAL and push them, with parameter --no-archive-mode-check to suppress duplicate WAL warning");
 
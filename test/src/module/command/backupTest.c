@@ -549,6 +549,42 @@ testBackupValidate(const Storage *const storage, const String *const path, const
     FUNCTION_HARNESS_RETURN(STRING, result);
 }
 
+/***********************************************************************************************************************************
+Get backup data with all standbys
+***********************************************************************************************************************************/
+static BackupData
+testBackupDataStandby(void)
+{
+    FUNCTION_HARNESS_VOID();
+
+    const DbGetResult dbInfo = dbGet(false, false, CFGOPTVAL_BACKUP_STANDBY_Y, true);
+    BackupData result = {.timeline = dbPgControl(dbInfo.standby).timeline, .standbyList = lstNewP(sizeof(BackupStandby))};
+
+    for (unsigned int standbyIdx = 0; standbyIdx < lstSize(dbInfo.standbyList); standbyIdx++)
+    {
+        const DbGetResultStandby *const standby = lstGet(dbInfo.standbyList, standbyIdx);
+        lstAdd(result.standbyList, &(BackupStandby){.pgIdx = standby->idx, .db = standby->db});
+    }
+
+    FUNCTION_HARNESS_RETURN_STRUCT(result);
+}
+
+/***********************************************************************************************************************************
+Free standbys in backup data
+***********************************************************************************************************************************/
+static void
+testBackupDataStandbyFree(const BackupData *const backupData)
+{
+    FUNCTION_HARNESS_BEGIN();
+        FUNCTION_HARNESS_PARAM_P(VOID, backupData);
+    FUNCTION_HARNESS_END();
+
+    for (unsigned int standbyIdx = 0; standbyIdx < lstSize(backupData->standbyList); standbyIdx++)
+        dbFree(((BackupStandby *)lstGet(backupData->standbyList, standbyIdx))->db);
+
+    FUNCTION_HARNESS_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Test Run
 ***********************************************************************************************************************************/
@@ -661,6 +697,26 @@ testRun(void)
         TEST_RESULT_BOOL(regExpMatchOne(filter, incr), false, "does not match incr");
         TEST_RESULT_BOOL(regExpMatchOne(filter, diff), true, "match diff");
         TEST_RESULT_BOOL(regExpMatchOne(filter, full), false, "does not match full");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("rate limit shared by processes");
+
+        StringList *argList = strLstNew();
+        hrnCfgArgRawZ(argList, cfgOptStanza, "test1");
+        hrnCfgArgRawZ(argList, cfgOptRepoPath, TEST_PATH "/repo");
+        hrnCfgArgRawZ(argList, cfgOptPgPath, TEST_PATH "/pg");
+        hrnCfgArgRawZ(argList, cfgOptRepoRetentionFull, "1");
+        hrnCfgArgRawZ(argList, cfgOptRateLimitPg, "3KiB");
+        HRN_CFG_LOAD(cfgCmdBackup, argList);
+
+        TEST_RESULT_UINT(backupRateLimit(cfgOptRateLimitPg, 1), 3072, "one process");
+        TEST_RESULT_UINT(backupRateLimit(cfgOptRateLimitPg, 3), 1024, "three processes");
+        TEST_RESULT_UINT(backupRateLimit(cfgOptRateLimitPg, 4000), 1, "rate is never zero");
+        TEST_RESULT_UINT(backupRateLimit(cfgOptRateLimitRepo, 3), 0, "no limit");
+
+        IoFilterGroup *filterGroup = ioFilterGroupNew();
+        TEST_RESULT_UINT(ioFilterGroupSize(backupRateFilterGroupAdd(filterGroup, 0)), 0, "no filter without limit");
+        TEST_RESULT_UINT(ioFilterGroupSize(backupRateFilterGroupAdd(filterGroup, 1024)), 1, "filter with limit");
     }
 
     // *****************************************************************************************************************************
@@ -880,11 +936,10 @@ testRun(void)
             "read {reference: 4, bundleId: 0, offset: 0, size: 8}\n"
             "  super block {max: 1, size: 8}\n"
             "    block {no: 0, offset: 5}\n"
-            "read {reference: 0, bundleId: 1, offset: 1, size: 5}\n"
+            "read {reference: 0, bundleId: 1, offset: 1, size: 105}\n"
             "  super block {max: 1, size: 5}\n"
             "    block {no: 0, offset: 2}\n"
-            "read {reference: 0, bundleId: 1, offset: 7, size: 99}\n"
-            "  super block {max: 1, size: 99}\n"
+            "  super block {max: 1, size: 99, skip: 1}\n"
             "    block {no: 0, offset: 4}\n",
             "check delta");
 
@@ -1320,6 +1375,126 @@ testRun(void)
             "block incr pack");
     }
 
+    // *****************************************************************************************************************************
+    if (testBegin("WalChange"))
+    {
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("find changed files");
+
+        const unsigned int smgrCreate[] = {1700, 16384, 16390, 0};
+        const unsigned int smgrTruncate[] = {0, 1664, 0, 1262, 7};
+        const unsigned int dbaseCreate[] = {16400, 1663};
+
+        HrnPgWal *wal = hrnPgWalNew(PG_VERSION_16, 0x1000000, 8192, 16 * 1024 * 1024);
+
+        hrnPgWalRecordP(
+            wal, .resourceManagerId = 10,
+            .blockList = (const PgWalRecordBlock []){{1663, 16384, 16385, 0, 0}, {1663, 16384, 16385, 0, 131072}}, .blockTotal = 2);
+        hrnPgWalRecordP(
+            wal, .resourceManagerId = 10,
+            .blockList = (const PgWalRecordBlock []){{1663, 16384, 16385, 0, 131073}, {1663, 16384, 16386, 1, 0}}, .blockTotal = 2);
+        hrnPgWalRecordP(
+            wal, .resourceManagerId = PG_WAL_RMGR_SMGR, .info = PG_WAL_SMGR_CREATE,
+            .mainData = BUF(smgrCreate, sizeof(smgrCreate)));
+        hrnPgWalRecordP(
+            wal, .resourceManagerId = PG_WAL_RMGR_SMGR, .info = PG_WAL_SMGR_TRUNCATE,
+            .mainData = BUF(smgrTruncate, sizeof(smgrTruncate)));
+        hrnPgWalRecordP(wal, .resourceManagerId = PG_WAL_RMGR_SMGR, .info = 0x30, .mainData = BUF(smgrCreate, sizeof(smgrCreate)));
+        hrnPgWalRecordP(wal, .resourceManagerId = PG_WAL_RMGR_DBASE, .mainData = BUF(dbaseCreate, sizeof(dbaseCreate)));
+        hrnPgWalRecordP(wal, .resourceManagerId = PG_WAL_RMGR_DBASE, .mainData = BUF(dbaseCreate, sizeof(unsigned int)));
+        hrnPgWalRecordP(
+            wal, .resourceManagerId = 10, .blockList = (const PgWalRecordBlock []){{1664, 0, 1260, 0, 5}}, .blockTotal = 1);
+        hrnPgWalSegmentEnd(wal);
+
+        WalChange *walChange = NULL;
+
+        TEST_ASSIGN(walChange, walChangeNew(PG_VERSION_16, PG_SEGMENT_SIZE_DEFAULT / pgPageSize8), "new");
+        TEST_RESULT_VOID(walChangeProcess(walChange, wal->buffer), "process");
+        TEST_RESULT_UINT(walChangeSize(walChange), 5, "segments");
+
+        TEST_RESULT_BOOL(walChangeFile(walChange, STRDEF("pg_data/base/16384/16385")), true, "segment 0 changed");
+        TEST_RESULT_BOOL(walChangeFile(walChange, STRDEF("pg_data/base/16384/16385.1")), true, "segment 1 changed");
+        TEST_RESULT_BOOL(walChangeFile(walChange, STRDEF("pg_data/base/16384/16385.2")), false, "segment 2 not changed");
+        TEST_RESULT_BOOL(walChangeFile(walChange, STRDEF("pg_data/base/16384/16386")), false, "main fork not changed");
+        TEST_RESULT_BOOL(walChangeFile(walChange, STRDEF("pg_data/base/16384/16386_fsm")), true, "fsm fork not tracked");
+        TEST_RESULT_BOOL(walChangeFile(walChange, STRDEF("pg_data/base/16400/16386")), true, "database changed");
+        TEST_RESULT_BOOL(walChangeFile(walChange, STRDEF("pg_data/global/1260")), true, "global changed");
+        TEST_RESULT_BOOL(walChangeFile(walChange, STRDEF("pg_data/global/1261")), false, "global not changed");
+        TEST_RESULT_BOOL(walChangeFile(walChange, STRDEF("pg_data/global/1262.3")), true, "global truncated");
+        TEST_RESULT_BOOL(walChangeFile(walChange, STRDEF("pg_data/global/pg_control")), true, "pg_control not tracked");
+        TEST_RESULT_BOOL(walChangeFile(walChange, STRDEF("pg_data/PG_VERSION")), true, "PG_VERSION not tracked");
+        TEST_RESULT_BOOL(
+            walChangeFile(walChange, STRDEF("pg_tblspc/1700/PG_16_202307071/16384/16390.4")), true, "tablespace created");
+        TEST_RESULT_BOOL(
+            walChangeFile(walChange, STRDEF("pg_tblspc/1700/PG_16_202307071/16384/16391")), false, "tablespace not changed");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("invalid file names are not tracked");
+
+        TEST_RESULT_BOOL(walChangeFile(walChange, STRDEF("pg_tblspc/1700")), true, "tablespace only");
+        TEST_RESULT_BOOL(walChangeFile(walChange, STRDEF("pg_tblspc/X/PG_16_202307071/16384/16391")), true, "invalid tablespace");
+        TEST_RESULT_BOOL(walChangeFile(walChange, STRDEF("pg_tblspc/1700/PG_16_202307071")), true, "no database");
+        TEST_RESULT_BOOL(walChangeFile(walChange, STRDEF("pg_tblspc/1700/PG_16_202307071/X/16391")), true, "invalid database");
+        TEST_RESULT_BOOL(walChangeFile(walChange, STRDEF("pg_tblspc/1700/PG_16_202307071/16384")), true, "no relation");
+        TEST_RESULT_BOOL(walChangeFile(walChange, STRDEF("pg_data/base/X/16391")), true, "invalid database");
+        TEST_RESULT_BOOL(walChangeFile(walChange, STRDEF("pg_data/base/16384")), true, "no relation");
+        TEST_RESULT_BOOL(walChangeFile(walChange, STRDEF("pg_data/base/16384/99999999999")), true, "relation too large");
+        TEST_RESULT_BOOL(walChangeFile(walChange, STRDEF("pg_data/base/16384/16391.X")), true, "invalid segment");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("non-default relation segment size");
+
+        walChangeFree(walChange);
+        walChange = walChangeNew(PG_VERSION_16, 1024);
+
+        TEST_RESULT_VOID(walChangeProcess(walChange, wal->buffer), "process");
+        TEST_RESULT_BOOL(walChangeFile(walChange, STRDEF("pg_data/base/16384/16385")), true, "segment 0 changed");
+        TEST_RESULT_BOOL(walChangeFile(walChange, STRDEF("pg_data/base/16384/16385.1")), false, "segment 1 not changed");
+        TEST_RESULT_BOOL(walChangeFile(walChange, STRDEF("pg_data/base/16384/16385.128")), true, "segment 128 changed");
+        TEST_RESULT_BOOL(walChangeFile(walChange, STRDEF("pg_data/global/1260")), true, "global changed");
+        TEST_RESULT_BOOL(walChangeFile(walChange, STRDEF("pg_data/global/1260.1")), false, "global not changed");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("compact while processing");
+
+        walChangeFree(walChange);
+        walChange = walChangeNew(PG_VERSION_16, PG_SEGMENT_SIZE_DEFAULT / pgPageSize8);
+        walChange->compactSize = 2;
+
+        TEST_RESULT_VOID(walChangeProcess(walChange, wal->buffer), "process");
+        TEST_RESULT_UINT(walChange->compactSize, WAL_CHANGE_COMPACT_SIZE_MIN, "compact size");
+        TEST_RESULT_UINT(walChangeSize(walChange), 5, "segments");
+
+        for (unsigned int segmentIdx = 0; segmentIdx < WAL_CHANGE_COMPACT_SIZE_MIN; segmentIdx++)
+            walChangeSegmentAdd(walChange, &(WalChangeSegment){.relFileNode = segmentIdx});
+
+        TEST_RESULT_UINT(walChange->compactSize, WAL_CHANGE_COMPACT_SIZE_MIN * 2, "compact size");
+        TEST_RESULT_VOID(walChangeFree(walChange), "free");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("invalid records");
+
+        wal = hrnPgWalNew(PG_VERSION_16, 0x1000000, 8192, 16 * 1024 * 1024);
+        hrnPgWalRecordP(
+            wal, .resourceManagerId = PG_WAL_RMGR_SMGR, .info = PG_WAL_SMGR_TRUNCATE,
+            .mainData = BUF(smgrTruncate, 12));
+        hrnPgWalSegmentEnd(wal);
+
+        TEST_ERROR(
+            walChangeProcess(walChangeNew(PG_VERSION_16, PG_SEGMENT_SIZE_DEFAULT / pgPageSize8), wal->buffer), FormatError,
+            "smgr record at 0/1000028 is too short");
+
+        wal = hrnPgWalNew(PG_VERSION_16, 0x1000000, 8192, 16 * 1024 * 1024);
+        hrnPgWalRecordP(wal, .resourceManagerId = PG_WAL_RMGR_DBASE, .mainData = BUF(dbaseCreate, 2));
+        hrnPgWalSegmentEnd(wal);
+
+        TEST_ERROR(
+            walChangeProcess(walChangeNew(PG_VERSION_16, PG_SEGMENT_SIZE_DEFAULT / pgPageSize8), wal->buffer), FormatError,
+            "database record at 0/1000028 is too short");
+
+        TEST_ERROR(walChangeNew(PG_VERSION_16, 0), FormatError, "relation segment size is zero");
+    }
+
     // *****************************************************************************************************************************
     if (testBegin("backupLabelCreate()"))
     {
@@ -1818,6 +1993,215 @@ testRun(void)
         manifestResume->pub.data.backupOptionCompressType = compressTypeNone;
     }
 
+    // *****************************************************************************************************************************
+    if (testBegin("backupJobQueueSelect()"))
+    {
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("select queue");
+
+        BackupJobData jobData =
+        {
+            .backupStandby = true,
+            .queueList = lstNewP(sizeof(List *)),
+            .queueStatList = lstNewP(sizeof(BackupJobQueueStat)),
+            .queueRunningMax = 2,
+        };
+
+        for (unsigned int queueIdx = 0; queueIdx < 4; queueIdx++)
+        {
+            List *const queue = lstNewP(sizeof(ManifestFilePack *));
+            lstAdd(jobData.queueList, &queue);
+            lstAdd(jobData.queueStatList, &(BackupJobQueueStat){0});
+        }
+
+        List *const queuePrimary = *(List **)lstGet(jobData.queueList, 0);
+        List *const queue1 = *(List **)lstGet(jobData.queueList, 1);
+        List *const queue2 = *(List **)lstGet(jobData.queueList, 2);
+        List *const queue3 = *(List **)lstGet(jobData.queueList, 3);
+        BackupJobQueueStat *const queueStat1 = lstGet(jobData.queueStatList, 1);
+        BackupJobQueueStat *const queueStat2 = lstGet(jobData.queueStatList, 2);
+        BackupJobQueueStat *const queueStat3 = lstGet(jobData.queueStatList, 3);
+
+        TEST_RESULT_INT(backupJobQueueSelect(&jobData, 0), -1, "primary queue empty");
+        TEST_RESULT_INT(backupJobQueueSelect(&jobData, 1), -1, "standby queues empty");
+
+        lstAdd(queuePrimary, &(ManifestFilePack *){NULL});
+        lstAdd(queue1, &(ManifestFilePack *){NULL});
+        lstAdd(queue2, &(ManifestFilePack *){NULL});
+        lstAdd(queue3, &(ManifestFilePack *){NULL});
+        queueStat1->size = 1000;
+        queueStat2->size = 100;
+        queueStat3->size = 10;
+
+        TEST_RESULT_INT(backupJobQueueSelect(&jobData, 0), 0, "primary queue");
+        TEST_RESULT_INT(backupJobQueueSelect(&jobData, 1), 2, "own queue");
+
+        queueStat2->running = 2;
+        TEST_RESULT_INT(backupJobQueueSelect(&jobData, 1), 1, "own queue full, steal from largest");
+
+        queueStat1->running = 2;
+        TEST_RESULT_INT(backupJobQueueSelect(&jobData, 1), 3, "steal from queue that is not full");
+
+        queueStat3->running = 2;
+        TEST_RESULT_INT(backupJobQueueSelect(&jobData, 1), 1, "all queues full, steal from largest");
+
+        lstClear(queue1);
+        TEST_RESULT_INT(backupJobQueueSelect(&jobData, 4), 2, "skip empty queue");
+    }
+
+    // *****************************************************************************************************************************
+    if (testBegin("backupProcessStandby()"))
+    {
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("all processes copy from the primary when not backup from standby");
+
+        BackupData backupData = {.pgIdxPrimary = 1, .standbyList = lstNewP(sizeof(BackupStandby))};
+
+        TEST_RESULT_PTR(backupProcessStandby(&backupData, 1), NULL, "process 1 on primary");
+        TEST_RESULT_PTR(backupProcessStandby(&backupData, 2), NULL, "process 2 on primary");
+        TEST_RESULT_UINT(backupProcessPgIdx(&backupData, 2), 1, "process 2 pg idx");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("processes are spread across the standbys");
+
+        lstAdd(backupData.standbyList, &(BackupStandby){.pgIdx = 0});
+        lstAdd(backupData.standbyList, &(BackupStandby){.pgIdx = 3});
+        lstAdd(backupData.standbyList, &(BackupStandby){.pgIdx = 4});
+
+        TEST_RESULT_PTR(backupProcessStandby(&backupData, 1), NULL, "process 1 on primary");
+        TEST_RESULT_UINT(backupProcessPgIdx(&backupData, 1), 1, "process 1 pg idx");
+        TEST_RESULT_UINT(backupProcessPgIdx(&backupData, 2), 0, "process 2 pg idx");
+        TEST_RESULT_UINT(backupProcessPgIdx(&backupData, 3), 3, "process 3 pg idx");
+        TEST_RESULT_UINT(backupProcessPgIdx(&backupData, 4), 4, "process 4 pg idx");
+        TEST_RESULT_UINT(backupProcessPgIdx(&backupData, 5), 0, "process 5 pg idx");
+        TEST_RESULT_PTR(backupProcessStandby(&backupData, 6), lstGet(backupData.standbyList, 1), "process 6 standby");
+    }
+
+    // *****************************************************************************************************************************
+    if (testBegin("backupStandbyReplayWait()"))
+    {
+        StringList *argList = strLstNew();
+        hrnCfgArgRawZ(argList, cfgOptStanza, "test1");
+        hrnCfgArgRawZ(argList, cfgOptRepoPath, TEST_PATH "/repo");
+        hrnCfgArgKeyRawZ(argList, cfgOptPgPath, 1, TEST_PATH "/pg1");
+        hrnCfgArgKeyRawZ(argList, cfgOptPgPath, 2, TEST_PATH "/pg2");
+        hrnCfgArgKeyRawZ(argList, cfgOptPgPort, 2, "5433");
+        hrnCfgArgKeyRawZ(argList, cfgOptPgPath, 3, TEST_PATH "/pg3");
+        hrnCfgArgKeyRawZ(argList, cfgOptPgPort, 3, "5434");
+        hrnCfgArgRawZ(argList, cfgOptRepoRetentionFull, "1");
+        HRN_CFG_LOAD(cfgCmdBackup, argList);
+
+        // Set archive timeout to 200ms
+        cfgOptionSet(cfgOptArchiveTimeout, cfgSourceParam, varNewInt64(200));
+
+        // The third standby has a checkpoint ahead of some target lsns
+        HRN_PG_CONTROL_PUT(storagePgIdxWrite(0), PG_VERSION_10, .timeline = 5, .checkpoint = pgLsnFromStr(STRDEF("5/4")));
+        HRN_PG_CONTROL_PUT(storagePgIdxWrite(1), PG_VERSION_10, .timeline = 5, .checkpoint = pgLsnFromStr(STRDEF("5/4")));
+        HRN_PG_CONTROL_PUT(storagePgIdxWrite(2), PG_VERSION_10, .timeline = 5, .checkpoint = pgLsnFromStr(STRDEF("5/8")));
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("all standbys are checked in the same wait loop");
+
+        // The first and third standbys have not reached the target on the first pass so they are checked again on the second pass
+        // after the second standby is done
+        HRN_PQ_SCRIPT_SET(
+            HRN_PQ_SCRIPT_OPEN(1, "dbname='postgres' port=5432", PG_VERSION_10, TEST_PATH "/pg1", true, NULL, NULL),
+            HRN_PQ_SCRIPT_OPEN(2, "dbname='postgres' port=5433", PG_VERSION_10, TEST_PATH "/pg2", true, NULL, NULL),
+            HRN_PQ_SCRIPT_OPEN(3, "dbname='postgres' port=5434", PG_VERSION_10, TEST_PATH "/pg3", true, NULL, NULL),
+            HRN_PQ_SCRIPT_REPLAY_TARGET_REACHED_GE_10(1, "6/1", false, "5/9"),
+            HRN_PQ_SCRIPT_REPLAY_WAIT_GE_10(2, "6/1"),
+            HRN_PQ_SCRIPT_REPLAY_TARGET_REACHED_GE_10(3, "6/1", false, "6/0"),
+            HRN_PQ_SCRIPT_REPLAY_TARGET_REACHED_PROGRESS_GE_10(1, "6/1", true, "6/1", "5/9", true, 0),
+            HRN_PQ_SCRIPT_CHECKPOINT(1),
+            HRN_PQ_SCRIPT_CHECKPOINT_TARGET_REACHED_GE_10(1, "6/1", true, "6/1", 0),
+            HRN_PQ_SCRIPT_REPLAY_TARGET_REACHED_PROGRESS_GE_10(3, "6/1", true, "6/1", "6/0", true, 0),
+            HRN_PQ_SCRIPT_CHECKPOINT(3),
+            HRN_PQ_SCRIPT_CHECKPOINT_TARGET_REACHED_GE_10(3, "6/1", true, "6/1", 0));
+
+        BackupData backupData = testBackupDataStandby();
+
+        TEST_RESULT_VOID(backupStandbyReplayWait(&backupData, STRDEF("6/1")), "wait for replay");
+        TEST_RESULT_UINT(lstSize(backupData.standbyList), 3, "standby total");
+        TEST_RESULT_LOG(
+            "P00   INFO: wait for replay on the standbys to reach 6/1\n"
+            "P00   INFO: replay on the standbys reached 6/1");
+
+        testBackupDataStandbyFree(&backupData);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("drop standby that does not reach the lsn before the timeout");
+
+        HRN_PQ_SCRIPT_SET(
+            HRN_PQ_SCRIPT_OPEN(1, "dbname='postgres' port=5432", PG_VERSION_10, TEST_PATH "/pg1", true, NULL, NULL),
+            HRN_PQ_SCRIPT_OPEN(2, "dbname='postgres' port=5433", PG_VERSION_10, TEST_PATH "/pg2", true, NULL, NULL),
+            HRN_PQ_SCRIPT_OPEN(3, "dbname='postgres' port=5434", PG_VERSION_10, TEST_PATH "/pg3", true, NULL, NULL),
+            HRN_PQ_SCRIPT_REPLAY_WAIT_GE_10(1, "6/2"),
+            HRN_PQ_SCRIPT_REPLAY_TARGET_REACHED_GE_10(2, "6/2", false, "6/1"),
+            HRN_PQ_SCRIPT_REPLAY_WAIT_GE_10(3, "6/2"),
+            HRN_PQ_SCRIPT_REPLAY_TARGET_REACHED_PROGRESS_GE_10(2, "6/2", false, "6/1", "6/1", false, 100),
+            HRN_PQ_SCRIPT_REPLAY_TARGET_REACHED_PROGRESS_GE_10(2, "6/2", false, "6/1", "6/1", false, 100));
+
+        backupData = testBackupDataStandby();
+
+        TEST_RESULT_VOID(backupStandbyReplayWait(&backupData, STRDEF("6/2")), "wait for replay");
+        TEST_RESULT_UINT(lstSize(backupData.standbyList), 2, "standby total");
+        TEST_RESULT_UINT(((BackupStandby *)lstGet(backupData.standbyList, 1))->pgIdx, 2, "third standby kept");
+        TEST_RESULT_LOG(
+            "P00   INFO: wait for replay on the standbys to reach 6/2\n"
+            "P00   WARN: unable to copy files from standby pg2: [ArchiveTimeoutError] timeout before standby replayed to 6/2 - only"
+            " reached 6/1\n"
+            "            HINT: is replication running and current on the standby?\n"
+            "            HINT: disable the 'backup-standby' option to backup directly from the primary.\n"
+            "P00   INFO: replay on the standbys reached 6/2");
+
+        testBackupDataStandbyFree(&backupData);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("all additional standbys dropped");
+
+        HRN_PQ_SCRIPT_SET(
+            HRN_PQ_SCRIPT_OPEN(1, "dbname='postgres' port=5432", PG_VERSION_10, TEST_PATH "/pg1", true, NULL, NULL),
+            HRN_PQ_SCRIPT_OPEN(2, "dbname='postgres' port=5433", PG_VERSION_10, TEST_PATH "/pg2", true, NULL, NULL),
+            HRN_PQ_SCRIPT_OPEN(3, "dbname='postgres' port=5434", PG_VERSION_10, TEST_PATH "/pg3", true, NULL, NULL),
+            HRN_PQ_SCRIPT_REPLAY_WAIT_GE_10(1, "5/7"),
+            HRN_PQ_SCRIPT_REPLAY_TARGET_REACHED_GE_10(2, "5/7", false, "5/6"),
+            HRN_PQ_SCRIPT_REPLAY_TARGET_REACHED_PROGRESS_GE_10(2, "5/7", false, "5/6", "5/6", false, 100),
+            HRN_PQ_SCRIPT_REPLAY_TARGET_REACHED_PROGRESS_GE_10(2, "5/7", false, "5/6", "5/6", false, 100));
+
+        backupData = testBackupDataStandby();
+
+        TEST_RESULT_VOID(backupStandbyReplayWait(&backupData, STRDEF("5/7")), "wait for replay");
+        TEST_RESULT_UINT(lstSize(backupData.standbyList), 1, "standby total");
+        TEST_RESULT_LOG(
+            "P00   INFO: wait for replay on the standbys to reach 5/7\n"
+            "P00   WARN: unable to copy files from standby pg3: [DbMismatchError] standby checkpoint '5/8' is ahead of target"
+            " '5/7'\n"
+            "P00   WARN: unable to copy files from standby pg2: [ArchiveTimeoutError] timeout before standby replayed to 5/7 - only"
+            " reached 5/6\n"
+            "            HINT: is replication running and current on the standby?\n"
+            "            HINT: disable the 'backup-standby' option to backup directly from the primary.\n"
+            "P00   INFO: replay on the standby reached 5/7");
+
+        testBackupDataStandbyFree(&backupData);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("error on first standby");
+
+        HRN_PQ_SCRIPT_SET(
+            HRN_PQ_SCRIPT_OPEN(1, "dbname='postgres' port=5432", PG_VERSION_10, TEST_PATH "/pg1", true, NULL, NULL),
+            HRN_PQ_SCRIPT_OPEN(2, "dbname='postgres' port=5433", PG_VERSION_10, TEST_PATH "/pg2", true, NULL, NULL),
+            HRN_PQ_SCRIPT_OPEN(3, "dbname='postgres' port=5434", PG_VERSION_10, TEST_PATH "/pg3", true, NULL, NULL));
+
+        backupData = testBackupDataStandby();
+
+        TEST_ERROR(
+            backupStandbyReplayWait(&backupData, STRDEF("4/0")), DbMismatchError,
+            "standby checkpoint '5/4' is ahead of target '4/0'");
+        TEST_RESULT_LOG("P00   INFO: wait for replay on the standbys to reach 4/0");
+
+        testBackupDataStandbyFree(&backupData);
+    }
+
     // *****************************************************************************************************************************
     if (testBegin("backupJobResult()"))
     {
@@ -1834,7 +2218,8 @@ testRun(void)
 
         TEST_ERROR(
             backupJobResult(
-                (Manifest *)1, NULL, storageTest, strLstNew(), job, false, pgPageSize8, 0, NULL, &currentPercentComplete),
+                (Manifest *)1, NULL, storageTest, strLstNew(), job, false, pgPageSize8, 0, NULL, NULL, NULL,
+                &currentPercentComplete),
             AssertError, "error message");
 
         // -------------------------------------------------------------------------------------------------------------------------
@@ -1862,6 +2247,8 @@ testRun(void)
         OBJ_NEW_END();
 
         uint64_t sizeProgress = 0;
+        uint64_t sizeRepoProgress = 0;
+        uint64_t fileComplete = 0;
         currentPercentComplete = 4567;
 
         lockInit(TEST_PATH_STR, cfgOptionStr(cfgOptExecId));
@@ -1870,7 +2257,7 @@ testRun(void)
         TEST_RESULT_VOID(
             backupJobResult(
                 manifest, STRDEF("host"), storageTest, strLstNew(), job, false, pgPageSize8, 0, &sizeProgress,
-                &currentPercentComplete),
+                &sizeRepoProgress, &fileComplete, &currentPercentComplete),
             "log noop result");
         TEST_RESULT_VOID(cmdLockReleaseP(), "release backup lock");
 
@@ -2162,6 +2549,8 @@ testRun(void)
             hrnCfgArgRawStrId(argList, cfgOptType, backupTypeFull);
             hrnCfgArgRawBool(argList, cfgOptCompress, false);
             hrnCfgArgRawBool(argList, cfgOptArchiveCheck, false);
+            hrnCfgArgRawZ(argList, cfgOptRateLimitPg, "1TiB");
+            hrnCfgArgRawZ(argList, cfgOptRateLimitRepo, "1TiB");
             HRN_CFG_LOAD(cfgCmdBackup, argList);
 
             // Add files
@@ -2796,6 +3185,7 @@ testRun(void)
             hrnCfgArgRawBool(argList, cfgOptCompress, false);
             hrnCfgArgRawZ(argList, cfgOptBackupStandby, "prefer");
             hrnCfgArgRawBool(argList, cfgOptStartFast, true);
+            hrnCfgArgRawBool(argList, cfgOptWalChange, true);
             HRN_CFG_LOAD(cfgCmdBackup, argList);
 
             // Increase size of file on standby. This demonstrates that copy is using the larger file from the primary as the basis
@@ -2859,6 +3249,7 @@ testRun(void)
             TEST_RESULT_VOID(hrnCmdBackup(), "backup");
 
             TEST_RESULT_LOG(
+                "P00   WARN: option 'wal-change' is not supported for PostgreSQL < 10\n"
                 "P00   WARN: unable to check pg2: [DbConnectError] unable to connect to 'dbname='postgres' port=5433': error\n"
                 "P00   WARN: unable to find a standby to perform the backup, using primary instead\n"
                 "P00   INFO: last backup label = 20191020-193320F_20191021-232000I, version = " PROJECT_VERSION "\n"
@@ -4091,6 +4482,28 @@ testRun(void)
                 "compare file list");
         }
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("synthetic full backup from incr backup that references block incremental files");
+
+        {
+            // Load options
+            StringList *argList = strLstNew();
+            hrnCfgArgRawZ(argList, cfgOptStanza, "test1");
+            hrnCfgArgRaw(argList, cfgOptRepoPath, repoPath);
+            hrnCfgArgRaw(argList, cfgOptPgPath, pg1Path);
+            hrnCfgArgRawZ(argList, cfgOptRepoRetentionFull, "1");
+            hrnCfgArgRawStrId(argList, cfgOptType, backupTypeFull);
+            hrnCfgArgRawBool(argList, cfgOptSynthetic, true);
+            hrnCfgArgRawBool(argList, cfgOptRepoBundle, true);
+            hrnCfgArgRawZ(argList, cfgOptRepoCipherType, "aes-256-cbc");
+            hrnCfgEnvRawZ(cfgOptRepoCipherPass, TEST_CIPHER_PASS);
+            HRN_CFG_LOAD(cfgCmdBackup, argList);
+
+            TEST_ERROR(
+                hrnCmdBackup(), BackupSetInvalidError,
+                "synthetic full backup cannot be created from block incremental backup set 20191108-080000F_20191111-052640I");
+        }
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("online 11 full backup with enc");
 
@@ -4103,7 +4516,7 @@ testRun(void)
             // Update pg_control
             HRN_PG_CONTROL_PUT(
                 storagePgWrite(), PG_VERSION_11, .pageChecksumVersion = 1, .walSegmentSize = 2 * 1024 * 1024,
-                .pageSize = pgPageSize4);
+                .pageSize = pgPageSize4, .segmentBlockTotal = PG_SEGMENT_SIZE_DEFAULT / pgPageSize4);
 
             // Update version
             HRN_STORAGE_PUT_Z(storagePgWrite(), PG_FILE_PGVERSION, PG_VERSION_11_Z, .timeModified = backupTimeStart);
@@ -4178,6 +4591,200 @@ testRun(void)
                 "pg_data={\"path\":\"" TEST_PATH "/pg1\",\"type\":\"path\"}\n",
                 "compare file list");
         }
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("online 11 incr backup with wal-change and invalid WAL");
+
+        backupTimeStart = BACKUP_EPOCH + 3500100;
+
+        {
+            // Load options
+            StringList *argList = strLstNew();
+            hrnCfgArgRawZ(argList, cfgOptStanza, "test1");
+            hrnCfgArgRaw(argList, cfgOptRepoPath, repoPath);
+            hrnCfgArgRaw(argList, cfgOptPgPath, pg1Path);
+            hrnCfgArgRawZ(argList, cfgOptRepoRetentionFull, "1");
+            hrnCfgArgRawStrId(argList, cfgOptType, backupTypeIncr);
+            hrnCfgArgRawBool(argList, cfgOptRepoBundle, true);
+            hrnCfgArgRawZ(argList, cfgOptRepoBundleLimit, "8KiB");
+            hrnCfgArgRawZ(argList, cfgOptCompressType, "none");
+            hrnCfgArgRawZ(argList, cfgOptRepoCipherType, "aes-256-cbc");
+            hrnCfgArgRawBool(argList, cfgOptWalChange, true);
+            hrnCfgEnvRawZ(cfgOptRepoCipherPass, TEST_CIPHER_PASS);
+            HRN_CFG_LOAD(cfgCmdBackup, argList);
+
+            // Run backup. The WAL written by the harness is not encrypted so it cannot be read.
+            hrnBackupPqScriptP(
+                PG_VERSION_11, backupTimeStart, .walCompressType = compressTypeNone, .cipherType = cipherTypeAes256Cbc,
+                .cipherPass = TEST_CIPHER_PASS, .walTotal = 1, .walChange = true);
+            TEST_RESULT_VOID(hrnCmdBackup(), "backup");
+
+            TEST_RESULT_LOG(
+                "P00   INFO: last backup label = 20191111-192000F, version = " PROJECT_VERSION "\n"
+                "P00   INFO: execute backup start: backup begins after the next regular checkpoint completes\n"
+                "P00   INFO: backup start archive = 0000000105DC9B4000000000, lsn = 5dc9b40/0\n"
+                "P00   INFO: check archive for prior segment 0000000105DC9B3F000007FF\n"
+                "P00   INFO: find changes in WAL segment(s) 0000000105DC9B4000000000:0000000105DC9B4000000000\n"
+                "P00   WARN: unable to find changes in WAL since prior backup: [CryptoError] cipher header invalid\n"
+                "P01 DETAIL: backup file " TEST_PATH "/pg1/global/1 (16KB, [PCT]) checksum [SHA1]\n"
+                "P00   WARN: invalid page checksum found in file " TEST_PATH "/pg1/global/1 at page 3\n"
+                "P01 DETAIL: match file from prior backup " TEST_PATH "/pg1/global/pg_control (8KB, [PCT]) checksum [SHA1]\n"
+                "P00 DETAIL: reference pg_data/PG_VERSION to 20191111-192000F\n"
+                "P00 DETAIL: reference pg_data/global/2 to 20191111-192000F\n"
+                "P00 DETAIL: reference pg_data/global/pg_control to 20191111-192000F\n"
+                "P00   INFO: execute backup stop and wait for all WAL segments to archive\n"
+                "P00   INFO: backup stop archive = 0000000105DC9B4000000000, lsn = 5dc9b40/100000\n"
+                "P00 DETAIL: wrote 'backup_label' file returned from backup stop function\n"
+                "P00   INFO: check archive for segment(s) 0000000105DC9B4000000000:0000000105DC9B4000000000\n"
+                "P00   INFO: new backup label = 20191111-192000F_20191111-192140I\n"
+                "P00   INFO: incr backup size = [SIZE], file total = 5");
+        }
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("online 11 incr backup with wal-change");
+
+        backupTimeStart = BACKUP_EPOCH + 3500150;
+
+        {
+            // Load options
+            StringList *argList = strLstNew();
+            hrnCfgArgRawZ(argList, cfgOptStanza, "test1");
+            hrnCfgArgRaw(argList, cfgOptRepoPath, repoPath);
+            hrnCfgArgRaw(argList, cfgOptPgPath, pg1Path);
+            hrnCfgArgRawZ(argList, cfgOptRepoRetentionFull, "1");
+            hrnCfgArgRawStrId(argList, cfgOptType, backupTypeIncr);
+            hrnCfgArgRawBool(argList, cfgOptRepoBundle, true);
+            hrnCfgArgRawZ(argList, cfgOptRepoBundleLimit, "8KiB");
+            hrnCfgArgRawZ(argList, cfgOptCompressType, "none");
+            hrnCfgArgRawZ(argList, cfgOptRepoCipherType, "aes-256-cbc");
+            hrnCfgArgRawBool(argList, cfgOptWalChange, true);
+            hrnCfgEnvRawZ(cfgOptRepoCipherPass, TEST_CIPHER_PASS);
+            HRN_CFG_LOAD(cfgCmdBackup, argList);
+
+            // Both relations have new timestamps but only global/1 is referenced in WAL
+            HRN_STORAGE_TIME(storagePgWrite(), "global/1", backupTimeStart);
+            HRN_STORAGE_TIME(storagePgWrite(), "global/2", backupTimeStart);
+
+            // Run backup
+            hrnBackupPqScriptP(
+                PG_VERSION_11, backupTimeStart, .walCompressType = compressTypeNone, .cipherType = cipherTypeAes256Cbc,
+                .cipherPass = TEST_CIPHER_PASS, .walTotal = 1, .walChange = true);
+
+            // Replace the WAL segment written by the harness with encrypted WAL that references global/1
+            const InfoArchive *const infoArchive = infoArchiveLoadFile(
+                storageRepo(), INFO_ARCHIVE_PATH_FILE_STR, cipherTypeAes256Cbc, STRDEF(TEST_CIPHER_PASS));
+            const String *const walPath = strNewFmt(
+                STORAGE_REPO_ARCHIVE "/%s/0000000105DC9B40", strZ(infoArchiveId(infoArchive)));
+
+            HRN_STORAGE_REMOVE(
+                storageRepoWrite(),
+                zNewFmt(
+                    "%s/%s", strZ(walPath),
+                    strZ(strLstGet(storageListP(storageRepo(), walPath, .expression = STRDEF("^0000000105DC9B4000000000-")), 0))));
+
+            HrnPgWal *const wal = hrnPgWalNew(PG_VERSION_11, 0x05DC9B4000000000, 8192, 2 * 1024 * 1024);
+            hrnPgWalRecordP(
+                wal, .resourceManagerId = 10, .blockList = (const PgWalRecordBlock []){{PG_TABLESPACE_GLOBAL, 0, 1, 0, 0}},
+                .blockTotal = 1);
+            hrnPgWalSegmentEnd(wal);
+
+            StorageWrite *const write = storageNewWriteP(
+                storageRepoWrite(),
+                strNewFmt(
+                    "%s/0000000105DC9B4000000000-%s", strZ(walPath),
+                    strZ(strNewEncode(encodingHex, cryptoHashOne(hashTypeSha1, wal->buffer)))));
+            cipherBlockFilterGroupAdd(
+                ioWriteFilterGroup(storageWriteIo(write)), cipherTypeAes256Cbc, cipherModeEncrypt,
+                infoArchiveCipherPass(infoArchive));
+            storagePutP(write, wal->buffer);
+
+            TEST_RESULT_VOID(hrnCmdBackup(), "backup");
+
+            TEST_RESULT_LOG(
+                "P00   INFO: last backup label = 20191111-192000F_20191111-192140I, version = " PROJECT_VERSION "\n"
+                "P00   INFO: execute backup start: backup begins after the next regular checkpoint completes\n"
+                "P00   INFO: backup start archive = 0000000105DC9B4000000000, lsn = 5dc9b40/0\n"
+                "P00   INFO: check archive for prior segment 0000000105DC9B3F000007FF\n"
+                "P00   INFO: find changes in WAL segment(s) 0000000105DC9B4000000000:0000000105DC9B4000000000\n"
+                "P00 DETAIL: 1 relation segment(s) changed in WAL, 1 file(s) unchanged since prior backup\n"
+                "P01 DETAIL: match file from prior backup " TEST_PATH "/pg1/global/1 (16KB, [PCT]) checksum [SHA1]\n"
+                "P01 DETAIL: match file from prior backup " TEST_PATH "/pg1/global/pg_control (8KB, [PCT]) checksum [SHA1]\n"
+                "P00 DETAIL: reference pg_data/PG_VERSION to 20191111-192000F\n"
+                "P00 DETAIL: reference pg_data/global/1 to 20191111-192000F_20191111-192140I\n"
+                "P00 DETAIL: reference pg_data/global/2 to 20191111-192000F\n"
+                "P00 DETAIL: reference pg_data/global/pg_control to 20191111-192000F\n"
+                "P00   INFO: execute backup stop and wait for all WAL segments to archive\n"
+                "P00   INFO: backup stop archive = 0000000105DC9B4000000000, lsn = 5dc9b40/100000\n"
+                "P00 DETAIL: wrote 'backup_label' file returned from backup stop function\n"
+                "P00   INFO: check archive for segment(s) 0000000105DC9B4000000000:0000000105DC9B4000000000\n"
+                "P00   INFO: new backup label = 20191111-192000F_20191111-192230I\n"
+                "P00   INFO: incr backup size = [SIZE], file total = 5");
+        }
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("synthetic full backup");
+
+        {
+            // Load options
+            StringList *argList = strLstNew();
+            hrnCfgArgRawZ(argList, cfgOptStanza, "test1");
+            hrnCfgArgRaw(argList, cfgOptRepoPath, repoPath);
+            hrnCfgArgRaw(argList, cfgOptPgPath, pg1Path);
+            hrnCfgArgRawZ(argList, cfgOptRepoRetentionFull, "1");
+            hrnCfgArgRawStrId(argList, cfgOptType, backupTypeFull);
+            hrnCfgArgRawBool(argList, cfgOptSynthetic, true);
+            hrnCfgArgRawZ(argList, cfgOptRepoCipherType, "aes-256-cbc");
+            hrnCfgArgRawZ(argList, cfgOptAnnotation, "synthetic=true");
+            hrnCfgEnvRawZ(cfgOptRepoCipherPass, TEST_CIPHER_PASS);
+            HRN_CFG_LOAD(cfgCmdBackup, argList);
+
+            TEST_ERROR(
+                hrnCmdBackup(), OptionInvalidError,
+                "option 'repo1-bundle' must be enabled to create a synthetic full backup from backup set"
+                " 20191111-192000F_20191111-192230I");
+
+            hrnCfgArgRawBool(argList, cfgOptRepoBundle, true);
+            HRN_CFG_LOAD(cfgCmdBackup, argList);
+
+            // Run backup without accessing the cluster
+            hrnLogReplaceAdd("label = [0-9]{8}-[0-9]{6}F", "[0-9]{8}-[0-9]{6}F", "FULL", true);
+
+            TEST_RESULT_VOID(hrnCmdBackup(), "backup");
+
+            TEST_RESULT_LOG(
+                "P00   INFO: synthetic full backup from backup set 20191111-192000F_20191111-192230I\n"
+                "P00   INFO: new backup label = [FULL-1]\n"
+                "P00   INFO: full backup size = [SIZE], file total = 5");
+
+            // All files are stored in the new backup
+            const InfoBackup *const infoBackup = infoBackupLoadFile(
+                storageRepo(), INFO_BACKUP_PATH_FILE_STR, cipherTypeAes256Cbc, STRDEF(TEST_CIPHER_PASS));
+            const InfoBackupData backupSynthetic = infoBackupData(infoBackup, infoBackupDataTotal(infoBackup) - 1);
+
+            TEST_RESULT_STR_Z(strIdToStr(backupSynthetic.backupType), "full", "backup type");
+            TEST_RESULT_PTR(backupSynthetic.backupReference, NULL, "no references");
+            TEST_RESULT_STR_Z(backupSynthetic.backupArchiveStop, "0000000105DC9B4000000000", "archive stop");
+
+            TEST_RESULT_STR_Z(
+                testBackupValidateP(
+                    storageRepo(), STRDEF(STORAGE_REPO_BACKUP "/latest"), .cipherType = cipherTypeAes256Cbc,
+                    .cipherPass = TEST_CIPHER_PASS),
+                zNewFmt(
+                    ".> {d=%s}\n"
+                    "bundle/1/pg_data/PG_VERSION {s=2, ts=-150}\n"
+                    "bundle/1/pg_data/global/pg_control {s=8192}\n"
+                    "pg_data/backup_label {s=17, ts=+2}\n"
+                    "pg_data/global/1 {s=16384, ckp=[3]}\n"
+                    "pg_data/global/2 {s=16384, ckp=[3]}\n"
+                    "--------\n"
+                    "[backup:target]\n"
+                    "pg_data={\"path\":\"" TEST_PATH "/pg1\",\"type\":\"path\"}\n"
+                    "\n"
+                    "[metadata]\n"
+                    "annotation={\"synthetic\":\"true\"}\n",
+                    strZ(backupSynthetic.backupLabel)),
+                "compare file list");
+        }
     }
 
     FUNCTION_HARNESS_RETURN_VOID();
@@ -0,0 +1,277 @@
+/***********************************************************************************************************************************
+Test Compact Command
+***********************************************************************************************************************************/
+#include "storage/posix/storage.h"
+
+#include "common/harnessConfig.h"
+#include "common/harnessInfo.h"
+#include "common/harnessStorage.h"
+
+/***********************************************************************************************************************************
+Test Run
+***********************************************************************************************************************************/
+static void
+testRun(void)
+{
+    FUNCTION_HARNESS_VOID();
+
+    // *****************************************************************************************************************************
+    if (testBegin("cmdCompact()"))
+    {
+        #define TEST_LABEL_FULL                                     "20191001-000000F"
+        #define TEST_LABEL_INCR1                                    TEST_LABEL_FULL "_20191002-000000I"
+        #define TEST_LABEL_INCR2                                    TEST_LABEL_FULL "_20191003-000000I"
+
+        StringList *argList = strLstNew();
+        hrnCfgArgRawZ(argList, cfgOptRepoPath, TEST_PATH "/repo");
+        hrnCfgArgRawZ(argList, cfgOptStanza, "db");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("error when bundling is disabled");
+
+        HRN_CFG_LOAD(cfgCmdCompact, argList);
+
+        TEST_ERROR(cmdCompact(), OptionInvalidError, "compact command requires option 'repo1-bundle' to be enabled");
+
+        hrnCfgArgRawBool(argList, cfgOptRepoBundle, true);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("write backup.info and manifests");
+
+        #define TEST_BACKUP_INFO_DB                                                                                                \
+            "[db]\n"                                                                                                               \
+            "db-catalog-version=202506291\n"                                                                                       \
+            "db-control-version=1800\n"                                                                                            \
+            "db-id=1\n"                                                                                                            \
+            "db-system-id=6626363367545678089\n"                                                                                   \
+            "db-version=\"18\"\n"                                                                                                  \
+            "\n"
+
+        #define TEST_BACKUP_INFO_BACKUP(label, type, prior, reference, sizeDelta)                                                  \
+            label "={\"backrest-format\":5,\"backrest-version\":\"2.57.0\","                                                       \
+            "\"backup-archive-start\":\"000000010000000000000004\",\"backup-archive-stop\":\"000000010000000000000004\","          \
+            "\"backup-info-repo-size\":21,\"backup-info-repo-size-delta\":" sizeDelta ",\"backup-info-size\":21,"                  \
+            "\"backup-info-size-delta\":" sizeDelta "," prior reference "\"backup-timestamp-start\":1569888000,"                   \
+            "\"backup-timestamp-stop\":1569888001,\"backup-type\":\"" type "\",\"db-id\":1,\"option-archive-check\":true,"         \
+            "\"option-archive-copy\":false,\"option-backup-standby\":false,\"option-checksum-page\":false,"                        \
+            "\"option-compress\":false,\"option-hardlink\":false,\"option-online\":true}\n"
+
+        #define TEST_BACKUP_INFO_HISTORY                                                                                           \
+            "\n"                                                                                                                   \
+            "[db:history]\n"                                                                                                       \
+            "1={\"db-catalog-version\":202506291,\"db-control-version\":1800,\"db-system-id\":6626363367545678089"                 \
+            ",\"db-version\":\"18\"}\n"
+
+        HRN_INFO_PUT(
+            storageRepoWrite(), INFO_BACKUP_PATH_FILE,
+            TEST_BACKUP_INFO_DB
+            "[backup:current]\n"
+            TEST_BACKUP_INFO_BACKUP(TEST_LABEL_FULL, "full", "", "", "15")
+            TEST_BACKUP_INFO_BACKUP(
+                TEST_LABEL_INCR1, "incr", "\"backup-prior\":\"" TEST_LABEL_FULL "\",",
+                "\"backup-reference\":[\"" TEST_LABEL_FULL "\"],", "6")
+            TEST_BACKUP_INFO_BACKUP(
+                TEST_LABEL_INCR2, "incr", "\"backup-prior\":\"" TEST_LABEL_INCR1 "\",",
+                "\"backup-reference\":[\"" TEST_LABEL_FULL "\",\"" TEST_LABEL_INCR1 "\"],", "3")
+            TEST_BACKUP_INFO_HISTORY);
+
+        #define TEST_MANIFEST_HEADER(label, type, reference)                                                                       \
+            "[backup]\n"                                                                                                           \
+            "backup-archive-start=\"000000010000000000000004\"\n"                                                                  \
+            "backup-archive-stop=\"000000010000000000000004\"\n"                                                                   \
+            "backup-bundle=true\n"                                                                                                 \
+            "backup-label=\"" label "\"\n"                                                                                         \
+            "backup-reference=\"" reference "\"\n"                                                                                 \
+            "backup-timestamp-copy-start=1569888000\n"                                                                             \
+            "backup-timestamp-start=1569888000\n"                                                                                  \
+            "backup-timestamp-stop=1569888001\n"                                                                                   \
+            "backup-type=\"" type "\"\n"                                                                                           \
+            "\n"                                                                                                                   \
+            "[backup:db]\n"                                                                                                        \
+            "db-catalog-version=202506291\n"                                                                                       \
+            "db-control-version=1800\n"                                                                                            \
+            "db-id=1\n"                                                                                                            \
+            "db-system-id=6626363367545678089\n"                                                                                   \
+            "db-version=\"18\"\n"                                                                                                  \
+            "\n"                                                                                                                   \
+            "[backup:option]\n"                                                                                                    \
+            "option-archive-check=true\n"                                                                                          \
+            "option-archive-copy=false\n"                                                                                          \
+            "option-checksum-page=false\n"                                                                                         \
+            "option-compress=false\n"                                                                                              \
+            "option-hardlink=false\n"                                                                                              \
+            "option-online=true\n"                                                                                                 \
+            "\n"                                                                                                                   \
+            "[backup:target]\n"                                                                                                    \
+            "pg_data={\"path\":\"/pg\",\"type\":\"path\"}\n"                                                                       \
+            "\n"
+
+        #define TEST_MANIFEST_FOOTER                                                                                               \
+            "\n"                                                                                                                   \
+            "[target:file:default]\n"                                                                                              \
+            "group=\"postgres\"\n"                                                                                                 \
+            "mode=\"0600\"\n"                                                                                                      \
+            "user=\"postgres\"\n"                                                                                                  \
+            "\n"                                                                                                                   \
+            "[target:path]\n"                                                                                                      \
+            "pg_data={}\n"                                                                                                         \
+            "\n"                                                                                                                   \
+            "[target:path:default]\n"                                                                                              \
+            "group=\"postgres\"\n"                                                                                                 \
+            "mode=\"0700\"\n"                                                                                                      \
+            "user=\"postgres\"\n"
+
+        #define TEST_FILE(name, checksum, reference, bundle)                                                                       \
+            "pg_data/" name "={" bundle "\"checksum\":\"" checksum "\",\"rck\":\"" checksum "\"," reference "\"size\":3,"          \
+            "\"timestamp\":1569888000}\n"
+        #define TEST_REFERENCE(label)                                                                                              \
+            "\"reference\":\"" label "\","
+        #define TEST_BUNDLE(id, offset)                                                                                            \
+            "\"bni\":" id ",\"bno\":" offset ","
+
+        #define TEST_SHA1_AAA                                       "7e240de74fb1ed08fa08d38063f6a6a91462a815"
+        #define TEST_SHA1_BBB                                       "5cb138284d431abd6a053a56625ec088bfb88912"
+        #define TEST_SHA1_CCC                                       "f36b4825e5db2cf7dd2d2593b3f5c24c0311d8b2"
+        #define TEST_SHA1_DDD                                       "9c969ddf454079e3d439973bbab63ea6233e4087"
+        #define TEST_SHA1_EEE                                       "637a81ed8e8217bb01c15c67c39b43b0ab4e20f1"
+        #define TEST_SHA1_FFF                                       "f6949a8c7d5b90b4a698660bbfb9431503fbb995"
+        #define TEST_SHA1_GGG                                       "07dcd371560bc43c48f56a2f55739ac66741d59d"
+
+        HRN_INFO_PUT(
+            storageRepoWrite(), STORAGE_REPO_BACKUP "/" TEST_LABEL_FULL "/" BACKUP_MANIFEST_FILE,
+            TEST_MANIFEST_HEADER(TEST_LABEL_FULL, "full", TEST_LABEL_FULL)
+            "[target:file]\n"
+            TEST_FILE("a", TEST_SHA1_AAA, "", TEST_BUNDLE("1", "0"))
+            TEST_FILE("b", TEST_SHA1_BBB, "", TEST_BUNDLE("1", "6"))
+            TEST_FILE("c", TEST_SHA1_CCC, "", TEST_BUNDLE("1", "9"))
+            TEST_FILE("f", TEST_SHA1_FFF, "", "")
+            TEST_MANIFEST_FOOTER);
+
+        // Prior bundles are left in place with a file in the full bundle that is no longer referenced
+        HRN_STORAGE_PUT_Z(storageRepoWrite(), STORAGE_REPO_BACKUP "/" TEST_LABEL_FULL "/bundle/1", "aaaxxxbbbccc");
+        HRN_STORAGE_PUT_Z(storageRepoWrite(), STORAGE_REPO_BACKUP "/" TEST_LABEL_FULL "/pg_data/f", "fff");
+        HRN_STORAGE_PUT_Z(storageRepoWrite(), STORAGE_REPO_BACKUP "/" TEST_LABEL_INCR1 "/bundle/1", "ddd");
+        HRN_STORAGE_PUT_Z(storageRepoWrite(), STORAGE_REPO_BACKUP "/" TEST_LABEL_INCR1 "/bundle/2", "ggg");
+        HRN_STORAGE_PUT_Z(storageRepoWrite(), STORAGE_REPO_BACKUP "/" TEST_LABEL_INCR2 "/bundle/1", "eee");
+
+        HRN_INFO_PUT(
+            storageRepoWrite(), STORAGE_REPO_BACKUP "/" TEST_LABEL_INCR2 "/" BACKUP_MANIFEST_FILE,
+            TEST_MANIFEST_HEADER(TEST_LABEL_INCR2, "incr", TEST_LABEL_FULL "," TEST_LABEL_INCR1 "," TEST_LABEL_INCR2)
+            "[target:file]\n"
+            TEST_FILE("a", TEST_SHA1_AAA, TEST_REFERENCE(TEST_LABEL_FULL), TEST_BUNDLE("1", "0"))
+            TEST_FILE("b", TEST_SHA1_BBB, TEST_REFERENCE(TEST_LABEL_FULL), TEST_BUNDLE("1", "6"))
+            TEST_FILE("c", TEST_SHA1_CCC, TEST_REFERENCE(TEST_LABEL_FULL), TEST_BUNDLE("1", "9"))
+            TEST_FILE("d", TEST_SHA1_DDD, TEST_REFERENCE(TEST_LABEL_INCR1), TEST_BUNDLE("1", "0"))
+            TEST_FILE("e", TEST_SHA1_EEE, "", TEST_BUNDLE("1", "0"))
+            TEST_FILE("f", TEST_SHA1_FFF, TEST_REFERENCE(TEST_LABEL_FULL), "")
+            TEST_FILE("g", TEST_SHA1_GGG, TEST_REFERENCE(TEST_LABEL_INCR1), TEST_BUNDLE("2", "0"))
+            TEST_MANIFEST_FOOTER);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("invalid backup label");
+
+        StringList *argListSet = strLstDup(argList);
+        hrnCfgArgRawZ(argListSet, cfgOptSet, "bogus");
+        HRN_CFG_LOAD(cfgCmdCompact, argListSet);
+
+        TEST_ERROR(cmdCompact(), OptionInvalidValueError, "'bogus' is not a valid backup label format");
+
+        argListSet = strLstDup(argList);
+        hrnCfgArgRawZ(argListSet, cfgOptSet, "20191001-000001F");
+        HRN_CFG_LOAD(cfgCmdCompact, argListSet);
+
+        TEST_ERROR(cmdCompact(), BackupSetInvalidError, "backup set 20191001-000001F is not valid");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("nothing to compact in full backup");
+
+        argListSet = strLstDup(argList);
+        hrnCfgArgRawZ(argListSet, cfgOptSet, TEST_LABEL_FULL);
+        HRN_CFG_LOAD(cfgCmdCompact, argListSet);
+
+        TEST_RESULT_VOID(cmdCompact(), "compact");
+        TEST_RESULT_LOG("P00   INFO: backup set " TEST_LABEL_FULL " has no prior bundles to compact");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("fully referenced bundles are not selected");
+
+        Manifest *manifest = manifestLoadFile(
+            storageRepo(), STRDEF(STORAGE_REPO_BACKUP "/" TEST_LABEL_INCR2 "/" BACKUP_MANIFEST_FILE), cipherTypeNone, NULL);
+        unsigned int bundleTotal = 0;
+
+        TEST_RESULT_UINT(lstSize(compactFileList(manifest, 4, &bundleTotal)), 2, "files");
+        TEST_RESULT_UINT(bundleTotal, 2, "bundles");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("checksum error in prior bundle");
+
+        HRN_STORAGE_PUT_Z(storageRepoWrite(), STORAGE_REPO_BACKUP "/" TEST_LABEL_INCR1 "/bundle/2", "GGG");
+
+        HRN_CFG_LOAD(cfgCmdCompact, argList);
+
+        TEST_ERROR(
+            cmdCompact(), ChecksumError, "invalid checksum for 'pg_data/g' in bundle 2 of backup set " TEST_LABEL_INCR1);
+
+        TEST_RESULT_STR_Z(
+            manifestFileFind(
+                manifestLoadFile(
+                    storageRepo(), STRDEF(STORAGE_REPO_BACKUP "/" TEST_LABEL_INCR2 "/" BACKUP_MANIFEST_FILE), cipherTypeNone,
+                    NULL),
+                STRDEF("pg_data/a")).reference,
+            TEST_LABEL_FULL, "manifest not updated");
+
+        HRN_STORAGE_PUT_Z(storageRepoWrite(), STORAGE_REPO_BACKUP "/" TEST_LABEL_INCR1 "/bundle/2", "ggg");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("compact latest backup");
+
+        TEST_RESULT_VOID(cmdCompact(), "compact");
+        TEST_RESULT_LOG(
+            "P00   INFO: backup set " TEST_LABEL_INCR2 " compacted 5 file(s) from 3 prior bundle(s) into 1 bundle(s) (15B)");
+
+        TEST_STORAGE_GET(storageRepo(), STORAGE_REPO_BACKUP "/" TEST_LABEL_INCR2 "/bundle/2", "aaabbbcccdddggg");
+        TEST_STORAGE_GET(storageRepo(), STORAGE_REPO_BACKUP "/" TEST_LABEL_INCR2 "/bundle/1", "eee");
+        TEST_STORAGE_GET(storageRepo(), STORAGE_REPO_BACKUP "/" TEST_LABEL_FULL "/bundle/1", "aaaxxxbbbccc", .comment = "unchanged");
+
+        manifest = manifestLoadFile(
+            storageRepo(), STRDEF(STORAGE_REPO_BACKUP "/" TEST_LABEL_INCR2 "/" BACKUP_MANIFEST_FILE), cipherTypeNone, NULL);
+
+        ManifestFile file = manifestFileFind(manifest, STRDEF("pg_data/a"));
+        TEST_RESULT_STR(file.reference, NULL, "a reference");
+        TEST_RESULT_UINT(file.bundleId, 2, "a bundle id");
+        TEST_RESULT_UINT(file.bundleOffset, 0, "a bundle offset");
+
+        file = manifestFileFind(manifest, STRDEF("pg_data/c"));
+        TEST_RESULT_STR(file.reference, NULL, "c reference");
+        TEST_RESULT_UINT(file.bundleId, 2, "c bundle id");
+        TEST_RESULT_UINT(file.bundleOffset, 6, "c bundle offset");
+
+        file = manifestFileFind(manifest, STRDEF("pg_data/g"));
+        TEST_RESULT_STR(file.reference, NULL, "g reference");
+        TEST_RESULT_UINT(file.bundleId, 2, "g bundle id");
+        TEST_RESULT_UINT(file.bundleOffset, 12, "g bundle offset");
+
+        file = manifestFileFind(manifest, STRDEF("pg_data/e"));
+        TEST_RESULT_UINT(file.bundleId, 1, "e bundle id");
+
+        file = manifestFileFind(manifest, STRDEF("pg_data/f"));
+        TEST_RESULT_STR_Z(file.reference, TEST_LABEL_FULL, "f reference");
+
+        TEST_RESULT_STR_Z(
+            strLstJoin(manifestReferenceList(manifest), ","), TEST_LABEL_FULL "," TEST_LABEL_INCR1 "," TEST_LABEL_INCR2,
+            "reference list");
+
+        InfoBackup *infoBackup = NULL;
+        TEST_ASSIGN(infoBackup, infoBackupLoadFile(storageRepo(), INFO_BACKUP_PATH_FILE_STR, cipherTypeNone, NULL), "load info");
+        TEST_RESULT_UINT(infoBackupDataByLabel(infoBackup, STRDEF(TEST_LABEL_INCR2))->backupInfoSizeDelta, 18, "size delta");
+        TEST_RESULT_UINT(infoBackupDataByLabel(infoBackup, STRDEF(TEST_LABEL_INCR2))->backupInfoRepoSizeDelta, 18, "repo delta");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("compact again finds nothing to do");
+
+        TEST_RESULT_VOID(cmdCompact(), "compact");
+        TEST_RESULT_LOG("P00   INFO: backup set " TEST_LABEL_INCR2 " has no prior bundles to compact");
+    }
+
+    FUNCTION_HARNESS_RETURN_VOID();
+}
@@ -457,6 +457,67 @@ testRun(void)
     // *****************************************************************************************************************************
     if (testBegin("removeExpiredArchive() & cmdExpire()"))
     {
+        TEST_TITLE("merge and match archive ranges");
+
+        List *archiveRangeList = lstNewP(sizeof(ArchiveRange), .comparator = lstComparatorStr);
+
+        TEST_RESULT_VOID(archiveRangeMerge(archiveRangeList), "merge empty list");
+        TEST_RESULT_UINT(lstSize(archiveRangeList), 0, "check size");
+
+        lstAdd(
+            archiveRangeList,
+            &(ArchiveRange){.start = STRDEF("000000010000000200000010"), .stop = STRDEF("000000010000000200000020")});
+        lstAdd(
+            archiveRangeList,
+            &(ArchiveRange){.start = STRDEF("000000010000000100000001"), .stop = STRDEF("000000010000000100000005")});
+        lstAdd(
+            archiveRangeList,
+            &(ArchiveRange){.start = STRDEF("000000010000000100000003"), .stop = STRDEF("000000010000000100000004")});
+        lstAdd(
+            archiveRangeList,
+            &(ArchiveRange){.start = STRDEF("000000010000000100000004"), .stop = STRDEF("000000010000000100000008")});
+        lstAdd(archiveRangeList, &(ArchiveRange){.start = STRDEF("000000010000000300000001")});
+        lstAdd(
+            archiveRangeList,
+            &(ArchiveRange){.start = STRDEF("000000010000000300000002"), .stop = STRDEF("000000010000000300000003")});
+
+        TEST_RESULT_VOID(archiveRangeMerge(archiveRangeList), "merge list");
+        TEST_RESULT_UINT(lstSize(archiveRangeList), 3, "check size");
+        TEST_RESULT_STR_Z(((ArchiveRange *)lstGet(archiveRangeList, 0))->start, "000000010000000100000001", "check start");
+        TEST_RESULT_STR_Z(((ArchiveRange *)lstGet(archiveRangeList, 0))->stop, "000000010000000100000008", "check stop");
+        TEST_RESULT_STR_Z(((ArchiveRange *)lstGet(archiveRangeList, 1))->start, "000000010000000200000010", "check start");
+        TEST_RESULT_STR_Z(((ArchiveRange *)lstGet(archiveRangeList, 1))->stop, "000000010000000200000020", "check stop");
+        TEST_RESULT_STR_Z(((ArchiveRange *)lstGet(archiveRangeList, 2))->start, "000000010000000300000001", "check start");
+        TEST_RESULT_PTR(((ArchiveRange *)lstGet(archiveRangeList, 2))->stop, NULL, "check stop");
+
+        unsigned int rangeIdx = 0;
+
+        TEST_RESULT_BOOL(
+            archiveRangeMatch(archiveRangeList, &rangeIdx, STRDEF("000000010000000000000001"), 24), false, "before first range");
+        TEST_RESULT_BOOL(
+            archiveRangeMatch(archiveRangeList, &rangeIdx, STRDEF("000000010000000100000008-hash"), 24), true, "end of range");
+        TEST_RESULT_BOOL(
+            archiveRangeMatch(archiveRangeList, &rangeIdx, STRDEF("000000010000000100000009"), 24), false, "between ranges");
+        TEST_RESULT_UINT(rangeIdx, 1, "check range idx");
+        TEST_RESULT_BOOL(
+            archiveRangeMatch(archiveRangeList, &rangeIdx, STRDEF("000000010000000300000005"), 24), true, "open range");
+
+        rangeIdx = 0;
+
+        TEST_RESULT_BOOL(archiveRangeMatch(archiveRangeList, &rangeIdx, STRDEF("0000000100000001"), 16), true, "path in range");
+        TEST_RESULT_BOOL(archiveRangeMatch(archiveRangeList, &rangeIdx, STRDEF("0000000100000002"), 16), true, "path in range");
+
+        lstFree(archiveRangeList);
+        archiveRangeList = lstNewP(sizeof(ArchiveRange), .comparator = lstComparatorStr);
+        lstAdd(
+            archiveRangeList,
+            &(ArchiveRange){.start = STRDEF("000000010000000100000001"), .stop = STRDEF("000000010000000100000005")});
+        rangeIdx = 0;
+
+        TEST_RESULT_BOOL(
+            archiveRangeMatch(archiveRangeList, &rangeIdx, STRDEF("000000010000000200000001"), 24), false, "after last range");
+
+        // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("check stop file");
 
         StringList *argList = strLstDup(argListAvoidWarn);
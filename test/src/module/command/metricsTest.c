@@ -0,0 +1,197 @@
+/***********************************************************************************************************************************
+Test Command Metrics
+***********************************************************************************************************************************/
+#include "storage/posix/storage.h"
+
+#include "common/harnessConfig.h"
+#include "common/harnessStorage.h"
+#include "common/harnessTime.h"
+
+/***********************************************************************************************************************************
+Test Run
+***********************************************************************************************************************************/
+static void
+testRun(void)
+{
+    FUNCTION_HARNESS_VOID();
+
+    // Create default storage object for testing
+    Storage *storageTest = storagePosixNewP(TEST_PATH_STR, .write = true);
+
+    // *****************************************************************************************************************************
+    if (testBegin("cmdMetricsWrite()"))
+    {
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("no metrics file");
+
+        StringList *argList = strLstNew();
+        hrnCfgArgRawZ(argList, cfgOptStanza, "test");
+        hrnCfgArgRawZ(argList, cfgOptPgPath, "/pg1");
+        hrnCfgArgRawZ(argList, cfgOptRepoPath, TEST_PATH "/repo");
+        hrnCfgArgRawZ(argList, cfgOptRepoRetentionFull, "1");
+        HRN_CFG_LOAD(cfgCmdBackup, argList);
+
+        TEST_RESULT_VOID(cmdMetricsWriteP(.force = true), "write metrics");
+        TEST_STORAGE_LIST_EMPTY(storageTest, NULL, .comment = "no metrics written");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("first write");
+
+        hrnCfgArgRawZ(argList, cfgOptMetricsFile, TEST_PATH "/metrics/pgbackrest.prom");
+        HRN_CFG_LOAD(cfgCmdBackup, argList);
+
+        List *queue = lstNewP(sizeof(unsigned int));
+        lstAdd(queue, &(unsigned int){1});
+        lstAdd(queue, &(unsigned int){2});
+
+        List *queueList = lstNewP(sizeof(List *));
+        lstAdd(queueList, &queue);
+
+        hrnTimeMSecSetOne(1700000000000);
+        TEST_RESULT_VOID(
+            cmdMetricsWriteP(.sizeRead = 8192, .sizeWrite = 4096, .fileComplete = 1, .fileTotal = 3, .queueList = queueList),
+            "write metrics");
+        TEST_STORAGE_GET(
+            storageTest, "metrics/pgbackrest-backup.prom",
+            "# HELP pgbackrest_read_bytes_total Bytes read.\n"
+            "# TYPE pgbackrest_read_bytes_total counter\n"
+            "pgbackrest_read_bytes_total{stanza=\"test\",command=\"backup\"} 8192\n"
+            "# HELP pgbackrest_read_bytes_per_second Average bytes read per second.\n"
+            "# TYPE pgbackrest_read_bytes_per_second gauge\n"
+            "pgbackrest_read_bytes_per_second{stanza=\"test\",command=\"backup\"} 0\n"
+            "# HELP pgbackrest_write_bytes_total Bytes written.\n"
+            "# TYPE pgbackrest_write_bytes_total counter\n"
+            "pgbackrest_write_bytes_total{stanza=\"test\",command=\"backup\"} 4096\n"
+            "# HELP pgbackrest_write_bytes_per_second Average bytes written per second.\n"
+            "# TYPE pgbackrest_write_bytes_per_second gauge\n"
+            "pgbackrest_write_bytes_per_second{stanza=\"test\",command=\"backup\"} 0\n"
+            "# HELP pgbackrest_compress_bytes_total Bytes written or read in compressed form.\n"
+            "# TYPE pgbackrest_compress_bytes_total counter\n"
+            "pgbackrest_compress_bytes_total{stanza=\"test\",command=\"backup\"} 0\n"
+            "# HELP pgbackrest_compress_bytes_per_second Average bytes written or read in compressed form per second.\n"
+            "# TYPE pgbackrest_compress_bytes_per_second gauge\n"
+            "pgbackrest_compress_bytes_per_second{stanza=\"test\",command=\"backup\"} 0\n"
+            "# HELP pgbackrest_file_complete Files complete.\n"
+            "# TYPE pgbackrest_file_complete gauge\n"
+            "pgbackrest_file_complete{stanza=\"test\",command=\"backup\"} 1\n"
+            "# HELP pgbackrest_file_queued Files queued or in progress.\n"
+            "# TYPE pgbackrest_file_queued gauge\n"
+            "pgbackrest_file_queued{stanza=\"test\",command=\"backup\"} 2\n"
+            "# HELP pgbackrest_queue_depth Files waiting in each processing queue.\n"
+            "# TYPE pgbackrest_queue_depth gauge\n"
+            "pgbackrest_queue_depth{stanza=\"test\",command=\"backup\",queue=\"0\"} 2\n"
+            "# HELP pgbackrest_http_retry_total HTTP request retries.\n"
+            "# TYPE pgbackrest_http_retry_total counter\n"
+            "pgbackrest_http_retry_total{stanza=\"test\",command=\"backup\"} 0\n"
+            "# HELP pgbackrest_elapsed_seconds Time since the command started reporting.\n"
+            "# TYPE pgbackrest_elapsed_seconds gauge\n"
+            "pgbackrest_elapsed_seconds{stanza=\"test\",command=\"backup\"} 0\n"
+            "# HELP pgbackrest_update_time_seconds Time the metrics were last updated.\n"
+            "# TYPE pgbackrest_update_time_seconds gauge\n"
+            "pgbackrest_update_time_seconds{stanza=\"test\",command=\"backup\"} 1700000000\n",
+            .remove = true);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("skip write before interval");
+
+        hrnTimeMSecSetOne(1700000000500);
+        TEST_RESULT_VOID(cmdMetricsWriteP(.sizeRead = 16384), "write metrics");
+        TEST_STORAGE_LIST_EMPTY(storageTest, "metrics", .comment = "no metrics written");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("write after interval with archive lag");
+
+        statInc(HTTP_STAT_RETRY_STR);
+
+        hrnTimeMSecSetOne(1700000002000);
+        TEST_RESULT_VOID(
+            cmdMetricsWriteP(.sizeRead = 16384, .sizeCompress = 4000, .fileComplete = 3, .archiveTime = 1699999990),
+            "write metrics");
+        TEST_STORAGE_GET(
+            storageTest, "metrics/pgbackrest-backup.prom",
+            "# HELP pgbackrest_read_bytes_total Bytes read.\n"
+            "# TYPE pgbackrest_read_bytes_total counter\n"
+            "pgbackrest_read_bytes_total{stanza=\"test\",command=\"backup\"} 16384\n"
+            "# HELP pgbackrest_read_bytes_per_second Average bytes read per second.\n"
+            "# TYPE pgbackrest_read_bytes_per_second gauge\n"
+            "pgbackrest_read_bytes_per_second{stanza=\"test\",command=\"backup\"} 8192\n"
+            "# HELP pgbackrest_write_bytes_total Bytes written.\n"
+            "# TYPE pgbackrest_write_bytes_total counter\n"
+            "pgbackrest_write_bytes_total{stanza=\"test\",command=\"backup\"} 0\n"
+            "# HELP pgbackrest_write_bytes_per_second Average bytes written per second.\n"
+            "# TYPE pgbackrest_write_bytes_per_second gauge\n"
+            "pgbackrest_write_bytes_per_second{stanza=\"test\",command=\"backup\"} 0\n"
+            "# HELP pgbackrest_compress_bytes_total Bytes written or read in compressed form.\n"
+            "# TYPE pgbackrest_compress_bytes_total counter\n"
+            "pgbackrest_compress_bytes_total{stanza=\"test\",command=\"backup\"} 4000\n"
+            "# HELP pgbackrest_compress_bytes_per_second Average bytes written or read in compressed form per second.\n"
+            "# TYPE pgbackrest_compress_bytes_per_second gauge\n"
+            "pgbackrest_compress_bytes_per_second{stanza=\"test\",command=\"backup\"} 2000\n"
+            "# HELP pgbackrest_file_complete Files complete.\n"
+            "# TYPE pgbackrest_file_complete gauge\n"
+            "pgbackrest_file_complete{stanza=\"test\",command=\"backup\"} 3\n"
+            "# HELP pgbackrest_file_queued Files queued or in progress.\n"
+            "# TYPE pgbackrest_file_queued gauge\n"
+            "pgbackrest_file_queued{stanza=\"test\",command=\"backup\"} 0\n"
+            "# HELP pgbackrest_http_retry_total HTTP request retries.\n"
+            "# TYPE pgbackrest_http_retry_total counter\n"
+            "pgbackrest_http_retry_total{stanza=\"test\",command=\"backup\"} 1\n"
+            "# HELP pgbackrest_archive_lag_seconds Age of the last WAL segment archived.\n"
+            "# TYPE pgbackrest_archive_lag_seconds gauge\n"
+            "pgbackrest_archive_lag_seconds{stanza=\"test\",command=\"backup\"} 12\n"
+            "# HELP pgbackrest_elapsed_seconds Time since the command started reporting.\n"
+            "# TYPE pgbackrest_elapsed_seconds gauge\n"
+            "pgbackrest_elapsed_seconds{stanza=\"test\",command=\"backup\"} 2\n"
+            "# HELP pgbackrest_update_time_seconds Time the metrics were last updated.\n"
+            "# TYPE pgbackrest_update_time_seconds gauge\n"
+            "pgbackrest_update_time_seconds{stanza=\"test\",command=\"backup\"} 1700000002\n",
+            .remove = true);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("forced write before interval");
+
+        hrnTimeMSecSetOne(1700000002001);
+        TEST_RESULT_VOID(cmdMetricsWriteP(.force = true), "write metrics");
+        TEST_STORAGE_EXISTS(storageTest, "metrics/pgbackrest-backup.prom", .remove = true);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("warn once on write error");
+
+        HRN_STORAGE_PUT_EMPTY(storageTest, "file");
+
+        argList = strLstNew();
+        hrnCfgArgRawZ(argList, cfgOptStanza, "test");
+        hrnCfgArgRawZ(argList, cfgOptPgPath, "/pg1");
+        hrnCfgArgRawZ(argList, cfgOptRepoPath, TEST_PATH "/repo");
+        hrnCfgArgRawZ(argList, cfgOptRepoRetentionFull, "1");
+        hrnCfgArgRawZ(argList, cfgOptMetricsFile, TEST_PATH "/file/pgbackrest.prom");
+        HRN_CFG_LOAD(cfgCmdBackup, argList);
+
+        TEST_RESULT_VOID(cmdMetricsWriteP(.force = true), "write metrics");
+        TEST_RESULT_LOG_FMT(
+            "P00   WARN: unable to write metrics: unable to open file '" TEST_PATH "/file/pgbackrest-backup.prom' for write:"
+            " [20] Not a directory");
+
+        TEST_RESULT_VOID(cmdMetricsWriteP(.force = true), "write metrics again");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("async role and file without extension");
+
+        argList = strLstNew();
+        hrnCfgArgRawZ(argList, cfgOptStanza, "test");
+        hrnCfgArgRawZ(argList, cfgOptPgPath, "/pg1");
+        hrnCfgArgRawZ(argList, cfgOptRepoPath, TEST_PATH "/repo");
+        hrnCfgArgRawZ(argList, cfgOptMetricsFile, TEST_PATH "/metrics.d/pgbackrest");
+        HRN_CFG_LOAD(cfgCmdArchivePush, argList, .role = cfgCmdRoleAsync);
+
+        TEST_RESULT_VOID(cmdMetricsWriteP(.force = true, .fileComplete = 1, .fileTotal = 1), "write metrics");
+        TEST_STORAGE_LIST(storageTest, "metrics.d", "pgbackrest-archive-push-async\n", .comment = "command and role in file name");
+        TEST_RESULT_BOOL(
+            strstr(
+                strZ(strNewBuf(storageGetP(storageNewReadP(storageTest, STRDEF("metrics.d/pgbackrest-archive-push-async"))))),
+                "pgbackrest_file_complete{stanza=\"test\",command=\"archive-push:async\"} 1\n") != NULL,
+            true, "role in command label");
+    }
+
+    FUNCTION_HARNESS_RETURN_VOID();
+}
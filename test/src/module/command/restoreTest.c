@@ -263,6 +263,50 @@ testRun(void)
             "    block {no: 0, offset: 6}\n"
             "    block {no: 1, offset: 9}\n",
             "check delta");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("super blocks separated by a gap are fetched with a single read");
+
+        // Write block incremental with one block per super block
+        destination = bufNew(256);
+        write = ioBufferWriteNew(destination);
+
+        ioFilterGroupAdd(
+            ioWriteFilterGroup(write), blockIncrNew(3, 3, 5, 0, 0, 0, NULL, compressFilterP(compressTypeGz, 1, .raw = true), NULL));
+        ioWriteOpen(write);
+        ioWrite(write, BUFSTRDEF("123456789"));
+        ioWriteClose(write);
+
+        mapSize = pckReadU64P(ioFilterGroupResultP(ioWriteFilterGroup(write), BLOCK_INCR_FILTER_TYPE));
+        blockMap = blockMapNewRead(
+            ioBufferReadNewOpen(BUF(bufPtr(destination) + (bufUsed(destination) - (size_t)mapSize), (size_t)mapSize)), 3, 5);
+
+        // Only the middle block matches so the first and last super blocks are required
+        Buffer *const blockChecksum = bufNew(15);
+        memset(bufPtr(blockChecksum), 0, bufSize(blockChecksum));
+        memcpy(bufPtr(blockChecksum) + 5, blockMapGet(blockMap, 1)->checksum, 5);
+        bufUsedSet(blockChecksum, bufSize(blockChecksum));
+
+        blockDelta = blockDeltaNew(blockMap, 3, 5, blockChecksum, cipherTypeNone, NULL, compressTypeGz);
+
+        TEST_RESULT_UINT(blockDeltaReadSize(blockDelta), 1, "single read");
+
+        blockDeltaRead = blockDeltaReadGet(blockDelta, 0);
+        TEST_RESULT_UINT(
+            blockDeltaRead->size, blockMapGet(blockMap, 0)->size + blockMapGet(blockMap, 1)->size + blockMapGet(blockMap, 2)->size,
+            "read size includes gap");
+
+        read = ioBufferReadNewOpen(BUF(bufPtr(destination), (size_t)blockDeltaRead->size));
+
+        const BlockDeltaWrite *deltaWrite = blockDeltaNext(blockDelta, blockDeltaRead, read);
+        TEST_RESULT_STR_Z(strNewBuf(deltaWrite->block), "123", "read block");
+        TEST_RESULT_UINT(deltaWrite->offset, 0, "block offset");
+
+        deltaWrite = blockDeltaNext(blockDelta, blockDeltaRead, read);
+        TEST_RESULT_STR_Z(strNewBuf(deltaWrite->block), "789", "read block after gap");
+        TEST_RESULT_UINT(deltaWrite->offset, 6, "block offset");
+
+        TEST_RESULT_PTR(blockDeltaNext(blockDelta, blockDeltaRead, read), NULL, "no more blocks");
     }
 
     // *****************************************************************************************************************************
@@ -277,6 +321,8 @@ testRun(void)
         hrnCfgArgRawZ(argList, cfgOptStanza, "test1");
         hrnCfgArgRawZ(argList, cfgOptRepoPath, TEST_PATH "/repo");
         hrnCfgArgRawZ(argList, cfgOptPgPath, TEST_PATH "/pg");
+        hrnCfgArgRawZ(argList, cfgOptRateLimitPg, "1TiB");
+        hrnCfgArgRawZ(argList, cfgOptRateLimitRepo, "1TiB");
         HRN_CFG_LOAD(cfgCmdRestore, argList);
 
         // Create the pg path
@@ -309,7 +355,7 @@ testRun(void)
         TEST_ERROR(
             restoreFile(
                 strNewFmt(STORAGE_REPO_BACKUP "/%s/%s.gz", strZ(repoFileReferenceFull), strZ(repoFile1)), repoIdx, compressTypeGz,
-                0, false, false, false, STRDEF("badpass"), NULL, fileList),
+                0, false, false, false, false, false, STRDEF("badpass"), NULL, 0, 0, fileList),
             ChecksumError,
             "error restoring 'normal': actual checksum 'd1cd8a7d11daa26814b93eb604e1d49ab4b43770' does not match expected checksum"
             " 'ffffffffffffffffffffffffffffffffffffffff'");
@@ -2185,15 +2231,21 @@ testRun(void)
         }
         OBJ_NEW_END();
 
+        uint64_t sizeRepoProgress = 0;
+        uint64_t sizeWriteProgress = 0;
+        uint64_t fileComplete = 0;
         unsigned int currentPercentComplete = 4567;
 
         lockInit(TEST_PATH_STR, cfgOptionStr(cfgOptExecId));
         TEST_RESULT_VOID(cmdLockAcquireP(), "acquire restore lock");
 
         TEST_RESULT_UINT(
-            restoreJobResult(manifest, job, NULL, 0, 0,
-                             &currentPercentComplete), 0, "log noop result");
+            restoreJobResult(
+                manifest, job, NULL, 0, 0, &sizeRepoProgress, &sizeWriteProgress, &fileComplete, &currentPercentComplete),
+            0, "log noop result");
         TEST_RESULT_VOID(cmdLockReleaseP(), "release restore lock");
+        TEST_RESULT_UINT(sizeRepoProgress, 0, "nothing read from repo");
+        TEST_RESULT_UINT(sizeWriteProgress, 0, "nothing written");
 
         TEST_RESULT_LOG("P00 DETAIL: restore file pg_data/test (0B, 100.00%)");
     }
@@ -2545,7 +2597,7 @@ testRun(void)
         HRN_STORAGE_PATH_REMOVE(storageRepoIdxWrite(1), NULL, .recurse = true);
 
         // -------------------------------------------------------------------------------------------------------------------------
-        TEST_TITLE("full restore with force");
+        TEST_TITLE("full restore with force, deferred sync, and preallocate");
 
         // Replace percent complete and restore size since they can cause a lot of churn when files are added/removed
         hrnLogReplaceAdd(", [0-9]{1,3}\\.[0-9]{2}%\\)", "[0-9]+\\.[0-9]+%", "PCT", false);
@@ -2558,6 +2610,8 @@ testRun(void)
         hrnCfgArgRawStrId(argList, cfgOptType, CFGOPTVAL_TYPE_PRESERVE);
         hrnCfgArgRawZ(argList, cfgOptSet, "20161219-212741F");
         hrnCfgArgRawBool(argList, cfgOptForce, true);
+        hrnCfgArgRawBool(argList, cfgOptSyncDefer, true);
+        hrnCfgArgRawBool(argList, cfgOptPreallocate, true);
         HRN_CFG_LOAD(cfgCmdRestore, argList);
 
         hrnCmdRestore();
@@ -2579,11 +2633,8 @@ testRun(void)
             "P01 DETAIL: restore file " TEST_PATH "/pg/pg_tblspc/1/16384/PG_VERSION (3B, [PCT])"
             " checksum dd71038f3463f511ee7403dbcbc87195302d891c\n"
             "P00   WARN: recovery type is preserve but recovery file does not exist at '" TEST_PATH "/pg/recovery.conf'\n"
-            "P00 DETAIL: sync path '" TEST_PATH "/pg'\n"
-            "P00 DETAIL: sync path '" TEST_PATH "/pg/pg_tblspc'\n"
-            "P00 DETAIL: sync path '" TEST_PATH "/pg/pg_tblspc/1'\n"
-            "P00 DETAIL: sync path '" TEST_PATH "/pg/pg_tblspc/1/16384'\n"
-            "P00 DETAIL: sync path '" TEST_PATH "/pg/pg_tblspc/1/PG_11_201809051'\n"
+            "P00 DETAIL: sync file system for path '" TEST_PATH "/pg'\n"
+            "P00 DETAIL: sync file system for path '" TEST_PATH "/ts/1'\n"
             "P00   WARN: backup does not contain 'global/pg_control' -- cluster will not start\n"
             "P00 DETAIL: sync path '" TEST_PATH "/pg/global'\n"
             "P00   INFO: restore size = [SIZE], file total = 5");
@@ -3375,6 +3426,98 @@ testRun(void)
             "postgresql.auto.conf\n",
             .level = storageInfoLevelType);
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("restore from multiple repos");
+
+        TEST_RESULT_LOG_EMPTY_OR_CONTAINS("P00   WARN: repo1: [FileMissingError] unable to load info file '/bogus/");
+
+        // Copy the repo so both repos hold an identical copy of the backup set
+        HRN_SYSTEM_FMT("cp -r %s " TEST_PATH "/repo2", strZ(repoPath));
+
+        // Remove all files from pg path
+        HRN_STORAGE_PATH_REMOVE(storagePgWrite(), NULL, .recurse = true);
+
+        argList = strLstNew();
+        hrnCfgArgRawZ(argList, cfgOptStanza, "test1");
+        hrnCfgArgRaw(argList, cfgOptPgPath, pgPath);
+        hrnCfgArgRawZ(argList, cfgOptSpoolPath, TEST_PATH "/spool");
+        hrnCfgArgRawZ(argList, cfgOptProcessMax, "2");
+        hrnCfgArgKeyRaw(argList, cfgOptRepoPath, 1, repoPath);
+        hrnCfgArgKeyRawZ(argList, cfgOptRepoCipherType, 1, "aes-256-cbc");
+        hrnCfgEnvKeyRawZ(cfgOptRepoCipherPass, 1, TEST_CIPHER_PASS);
+        hrnCfgArgKeyRawZ(argList, cfgOptRepoPath, 2, TEST_PATH "/repo2");
+        hrnCfgArgKeyRawZ(argList, cfgOptRepoCipherType, 2, "aes-256-cbc");
+        hrnCfgEnvKeyRawZ(cfgOptRepoCipherPass, 2, TEST_CIPHER_PASS);
+        hrnCfgArgKeyRawZ(argList, cfgOptRepoPath, 3, "/bogus");
+        hrnCfgArgRawBool(argList, cfgOptMultiRepo, true);
+        HRN_CFG_LOAD(cfgCmdRestore, argList);
+
+        hrnLogReplaceAdd("[0-9]{8}-[0-9]{6}F_[0-9]{8}-[0-9]{6}D", NULL, "LABEL", false);
+        harnessLogLevelSet(logLevelInfo);
+
+        TEST_RESULT_VOID(hrnCmdRestore(), "restore");
+        TEST_RESULT_LOG(
+            "P00   INFO: repo1: restore backup set [LABEL]\n"
+            "P00   INFO: repo2: also restore from backup set [LABEL]\n"
+            "P00   INFO: write updated " TEST_PATH "/pg/postgresql.auto.conf\n"
+            "P00   INFO: restore global/pg_control (performed last to ensure aborted restores cannot be started)\n"
+            "P00   INFO: restore size = 280KB, file total = 6");
+
+        TEST_STORAGE_LIST(
+            storagePg(), NULL,
+            "PG_VERSION\n"
+            "base/\n"
+            "base/1/\n"
+            "base/1/2\n"
+            "base/1/3\n"
+            "base/1/44\n"
+            "global/\n"
+            "global/pg_control\n"
+            "postgresql.auto.conf\n",
+            .level = storageInfoLevelType);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("repo missing the backup manifest is not used as a source");
+
+        HRN_SYSTEM("rm " TEST_PATH "/repo2/backup/test1/*D/" BACKUP_MANIFEST_FILE "*");
+        HRN_STORAGE_PATH_REMOVE(storagePgWrite(), NULL, .recurse = true);
+
+        harnessLogLevelSet(logLevelDetail);
+
+        TEST_RESULT_VOID(hrnCmdRestore(), "restore");
+        TEST_RESULT_LOG_EMPTY_OR_CONTAINS("P00 DETAIL: repo2: unable to use as a restore source: [FileMissingError]");
+
+        harnessLogLevelReset();
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("files missing from an additional repo are restored from the selected repo");
+
+        // Copy the repo again but remove the backup files so only the manifests are left
+        HRN_SYSTEM("rm -rf " TEST_PATH "/repo2");
+        HRN_SYSTEM_FMT("cp -r %s " TEST_PATH "/repo2", strZ(repoPath));
+        HRN_SYSTEM("rm -rf " TEST_PATH "/repo2/backup/test1/*/bundle " TEST_PATH "/repo2/backup/test1/*/pg_data");
+        HRN_STORAGE_PATH_REMOVE(storagePgWrite(), NULL, .recurse = true);
+
+        harnessLogLevelSet(logLevelInfo);
+
+        TEST_RESULT_VOID(hrnCmdRestore(), "restore");
+        TEST_RESULT_LOG_EMPTY_OR_CONTAINS("from repo2, retry from repo1: [FileMissingError] unable to open missing file");
+
+        TEST_STORAGE_LIST(
+            storagePg(), NULL,
+            "PG_VERSION\n"
+            "base/\n"
+            "base/1/\n"
+            "base/1/2\n"
+            "base/1/3\n"
+            "base/1/44\n"
+            "global/\n"
+            "global/pg_control\n"
+            "postgresql.auto.conf\n",
+            .level = storageInfoLevelType);
+
+        harnessLogLevelReset();
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("delta restore with block incr");
 
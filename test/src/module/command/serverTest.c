@@ -198,6 +198,136 @@ testRun(void)
             HRN_FORK_PARENT_END();
         }
         HRN_FORK_END();
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("server with worker pool");
+
+        HRN_FORK_BEGIN(.timeout = 15000)
+        {
+            const unsigned int testPort = hrnServerPortNext();
+
+            HRN_FORK_CHILD_BEGIN(.prefix = "client")
+            {
+                StringList *argList = strLstNew();
+                hrnCfgArgRawFmt(argList, cfgOptTlsServerPort, "%u", testPort);
+                strLstAddZ(argList, "127.0.0.1");
+                HRN_CFG_LOAD(cfgCmdServerPing, argList);
+
+                // Connect more times than there are workers so workers must be replaced
+                TEST_RESULT_VOID(cmdServerPing(), "ping 1");
+                TEST_RESULT_VOID(cmdServerPing(), "ping 2");
+                TEST_RESULT_VOID(cmdServerPing(), "ping 3");
+
+                // Notify parent on exit
+                HRN_FORK_CHILD_NOTIFY_PUT();
+            }
+            HRN_FORK_CHILD_END();
+
+            HRN_FORK_PARENT_BEGIN(.prefix = "client control")
+            {
+                HRN_FORK_BEGIN(.timeout = 15000)
+                {
+                    HRN_FORK_CHILD_BEGIN(.prefix = "server")
+                    {
+                        StringList *argList = strLstNew();
+                        hrnCfgArgRawZ(argList, cfgOptTlsServerAddress, "127.0.0.1");
+                        hrnCfgArgRawZ(argList, cfgOptTlsServerCaFile, HRN_SERVER_CA);
+                        hrnCfgArgRawZ(argList, cfgOptTlsServerCertFile, HRN_SERVER_CERT);
+                        hrnCfgArgRawZ(argList, cfgOptTlsServerKeyFile, HRN_SERVER_KEY);
+                        hrnCfgArgRawZ(argList, cfgOptTlsServerAuth, "bogus=*");
+                        hrnCfgArgRawFmt(argList, cfgOptTlsServerPort, "%u", testPort);
+                        hrnCfgArgRawZ(argList, cfgOptTlsServerWorker, "2");
+                        hrnCfgArgRawZ(argList, cfgOptLogLevelStderr, CFGOPTVAL_ARCHIVE_MODE_OFF_Z);
+                        hrnCfgArgRawZ(argList, cfgOptLogLevelFile, CFGOPTVAL_ARCHIVE_MODE_OFF_Z);
+                        HRN_CFG_LOAD(cfgCmdServer, argList);
+
+                        // Init exit signal handlers
+                        exitInit();
+
+                        // No log testing needed
+                        harnessLogLevelSet(logLevelError);
+
+                        // Get pid of this process to identify worker processes later
+                        pid_t pid = getpid();
+
+                        // Add parameters to arg list required for a reload
+                        strLstInsert(argList, 0, cfgBin());
+                        strLstAddZ(argList, CFGCMD_SERVER);
+
+                        TEST_RESULT_VOID(cmdServer(strLstSize(argList), strLstPtr(argList)), "server");
+
+                        // If this is a worker process then exit immediately. Workers exit without serving a connection on SIGHUP.
+                        if (pid != getpid())
+                        {
+                            HRN_FORK_CHILD_NOTIFY_PUT();
+                            exit(0);
+                        }
+                    }
+                    HRN_FORK_CHILD_END();
+
+                    HRN_FORK_PARENT_BEGIN(.prefix = "server control")
+                    {
+                        // Wait for the workers that served connections to exit
+                        HRN_FORK_PARENT_NOTIFY_GET(0);
+                        HRN_FORK_PARENT_NOTIFY_GET(0);
+                        HRN_FORK_PARENT_NOTIFY_GET(0);
+
+                        // Allow time for the pool to be refilled and then reload so both waiting workers exit
+                        sleepMSec(1000);
+                        kill(HRN_FORK_PROCESS_ID(0), SIGHUP);
+
+                        HRN_FORK_PARENT_NOTIFY_GET(0);
+                        HRN_FORK_PARENT_NOTIFY_GET(0);
+
+                        // Send term to server, which will terminate the waiting workers
+                        kill(HRN_FORK_PROCESS_ID(0), SIGTERM);
+                    }
+                    HRN_FORK_PARENT_END();
+                }
+                HRN_FORK_END();
+
+                // Wait for client process to exit
+                HRN_FORK_PARENT_NOTIFY_GET(0);
+            }
+            HRN_FORK_PARENT_END();
+        }
+        HRN_FORK_END();
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("remove workers that exited when the signal was lost");
+
+        StringList *argList = strLstNew();
+        hrnCfgArgRawZ(argList, cfgOptTlsServerAddress, "127.0.0.1");
+        hrnCfgArgRawZ(argList, cfgOptTlsServerCaFile, HRN_SERVER_CA);
+        hrnCfgArgRawZ(argList, cfgOptTlsServerCertFile, HRN_SERVER_CERT);
+        hrnCfgArgRawZ(argList, cfgOptTlsServerKeyFile, HRN_SERVER_KEY);
+        hrnCfgArgRawZ(argList, cfgOptTlsServerAuth, "bogus=*");
+        hrnCfgArgRawFmt(argList, cfgOptTlsServerPort, "%u", hrnServerPortNext());
+        hrnCfgArgRawZ(argList, cfgOptTlsServerWorker, "2");
+        HRN_CFG_LOAD(cfgCmdServer, argList);
+
+        cmdServerInit();
+
+        // The first worker sent the signal, the second worker exited at the same time, and the third worker is still running
+        const pid_t pidExit = INT_MAX - 1;
+        const pid_t pidExitLost = INT_MAX;
+        const pid_t pidRun = getpid();
+
+        lstAdd(serverLocal.processList, &pidExit);
+        lstAdd(serverLocal.processList, &pidExitLost);
+        lstAdd(serverLocal.processList, &pidRun);
+
+        // The handler only sets a flag so the list is not modified while the main loop may be adding to it
+        TEST_RESULT_VOID(cmdServerSigChild(SIGCHLD), "signal");
+        TEST_RESULT_BOOL(serverLocal.sigChild, true, "signal caught");
+        TEST_RESULT_UINT(lstSize(serverLocal.processList), 3, "workers not removed by handler");
+
+        TEST_RESULT_VOID(cmdServerProcessPrune(), "remove workers");
+        TEST_RESULT_BOOL(serverLocal.sigChild, false, "signal reset");
+        TEST_RESULT_UINT(lstSize(serverLocal.processList), 1, "running worker remains");
+        TEST_RESULT_INT(*(pid_t *)lstGet(serverLocal.processList, 0), pidRun, "check running worker");
+
+        lstClear(serverLocal.processList);
     }
 
     // *****************************************************************************************************************************
@@ -3,6 +3,7 @@ Test Verify Command
 ***********************************************************************************************************************************/
 #include "command/backup/protocol.h"
 #include "command/stanza/create.h"
+#include "command/verify/ledger.h"
 #include "common/io/bufferRead.h"
 #include "postgres/interface.h"
 #include "postgres/version.h"
@@ -2375,6 +2376,145 @@ testRun(void)
             "P00 DETAIL: path '11-1/0000000105D944C0' does not contain any valid WAL to be processed\n"
             "P00 DETAIL: path '11-1/0000000105D95D2F' does not contain any valid WAL to be processed\n"
             "P00 DETAIL: archiveId: 11-1, wal start: 0000000105D95D3000000000, wal stop: 0000000105D95D3000000000");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("verify with ledger");
+
+        #define TEST_RESULT_LEDGER                                                                                                 \
+            "stanza: db\n"                                                                                                         \
+            "status: ok\n"                                                                                                         \
+            "  archiveId: 11-1, total WAL checked: 4, total valid WAL: 4\n"                                                        \
+            "    missing: 0, checksum invalid: 0, size invalid: 0, other: 0\n"                                                     \
+            "  backup: 20191002-070640F, status: valid, total files checked: 6, total valid files: 6\n"                            \
+            "    missing: 0, checksum invalid: 0, size invalid: 0, other: 0\n"                                                     \
+            "  backup: 20191002-070640F_20191003-105320D, status: valid, total files checked: 6, total valid files: 6\n"           \
+            "    missing: 0, checksum invalid: 0, size invalid: 0, other: 0"
+
+        #define TEST_RESULT_LEDGER_LOG                                                                                             \
+            "P00 DETAIL: archiveId: 11-1, wal start: 0000000105D944BF000000FF, wal stop: 0000000105D944C000000000\n"              \
+            "P00 DETAIL: archiveId: 11-1, wal start: 0000000105D95D2F000000FF, wal stop: 0000000105D95D3000000000"
+
+        argList = strLstDup(argListBase);
+        hrnCfgArgRawZ(argList, cfgOptOutput, "text");
+        hrnCfgArgRawZ(argList, cfgOptVerbose, "y");
+        hrnCfgArgRawBool(argList, cfgOptVerifyLedger, true);
+        HRN_CFG_LOAD(cfgCmdVerify, argList);
+
+        TEST_RESULT_STR_Z(verifyProcess(cfgOptionBool(cfgOptVerbose)), TEST_RESULT_LEDGER, "verify and create ledger");
+        TEST_RESULT_LOG(
+            "P00 DETAIL: 0 file(s) verified by a prior run were skipped\n"
+            TEST_RESULT_LEDGER_LOG);
+
+        TEST_RESULT_STR_Z(verifyProcess(cfgOptionBool(cfgOptVerbose)), TEST_RESULT_LEDGER, "verify with ledger");
+        TEST_RESULT_LOG(
+            "P00 DETAIL: 14 file(s) verified by a prior run were skipped\n"
+            TEST_RESULT_LEDGER_LOG);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("corrupt WAL is only found by sample");
+
+        const String *const walFile = strNewFmt(
+            STORAGE_REPO_ARCHIVE "/11-1/0000000105D95D30/%s",
+            strZ(strLstGet(storageListP(storageRepo(), STRDEF(STORAGE_REPO_ARCHIVE "/11-1/0000000105D95D30")), 0)));
+        const Buffer *const walBuffer = storageGetP(storageNewReadP(storageRepo(), walFile));
+
+        HRN_STORAGE_PUT_Z(storageRepoWrite(), strZ(walFile), "BOGUS", .comment = "corrupt WAL");
+
+        TEST_RESULT_STR_Z(verifyProcess(cfgOptionBool(cfgOptVerbose)), TEST_RESULT_LEDGER, "corrupt WAL skipped");
+        TEST_RESULT_LOG(
+            "P00 DETAIL: 14 file(s) verified by a prior run were skipped\n"
+            TEST_RESULT_LEDGER_LOG);
+
+        argList = strLstDup(argListBase);
+        hrnCfgArgRawZ(argList, cfgOptOutput, "text");
+        hrnCfgArgRawZ(argList, cfgOptVerbose, "y");
+        hrnCfgArgRawBool(argList, cfgOptVerifyLedger, true);
+        hrnCfgArgRawZ(argList, cfgOptVerifySample, "100");
+        HRN_CFG_LOAD(cfgCmdVerify, argList);
+
+        #define TEST_RESULT_LEDGER_INVALID                                                                                         \
+            "stanza: db\n"                                                                                                         \
+            "status: error\n"                                                                                                      \
+            "  archiveId: 11-1, total WAL checked: 4, total valid WAL: 3\n"                                                        \
+            "    missing: 0, checksum invalid: 1, size invalid: 0, other: 0\n"                                                     \
+            "  backup: 20191002-070640F, status: valid, total files checked: 6, total valid files: 6\n"                            \
+            "    missing: 0, checksum invalid: 0, size invalid: 0, other: 0\n"                                                     \
+            "  backup: 20191002-070640F_20191003-105320D, status: valid, total files checked: 6, total valid files: 6\n"           \
+            "    missing: 0, checksum invalid: 0, size invalid: 0, other: 0"
+
+        TEST_RESULT_STR_Z(verifyProcess(cfgOptionBool(cfgOptVerbose)), TEST_RESULT_LEDGER_INVALID, "corrupt WAL sampled");
+        TEST_RESULT_LOG_FMT(
+            "P01   INFO: invalid checksum '%s'\n"
+            "P00 DETAIL: 0 file(s) verified by a prior run were skipped\n"
+            TEST_RESULT_LEDGER_LOG,
+            strZ(strSub(walFile, sizeof(STORAGE_REPO_ARCHIVE))));
+
+        argList = strLstDup(argListBase);
+        hrnCfgArgRawZ(argList, cfgOptOutput, "text");
+        hrnCfgArgRawZ(argList, cfgOptVerbose, "y");
+        hrnCfgArgRawBool(argList, cfgOptVerifyLedger, true);
+        HRN_CFG_LOAD(cfgCmdVerify, argList);
+
+        TEST_RESULT_STR_Z(
+            verifyProcess(cfgOptionBool(cfgOptVerbose)), TEST_RESULT_LEDGER_INVALID, "corrupt WAL removed from ledger");
+        TEST_RESULT_LOG_FMT(
+            "P01   INFO: invalid checksum '%s'\n"
+            "P00 DETAIL: 13 file(s) verified by a prior run were skipped\n"
+            TEST_RESULT_LEDGER_LOG,
+            strZ(strSub(walFile, sizeof(STORAGE_REPO_ARCHIVE))));
+
+        HRN_STORAGE_PUT(storageRepoWrite(), strZ(walFile), walBuffer, .comment = "restore WAL");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("ledger with checksum mismatch");
+
+        HRN_INFO_PUT(
+            storageRepoWrite(), STORAGE_REPO_BACKUP "/" VERIFY_LEDGER_FILE,
+            zNewFmt(
+                "[ledger:file]\n"
+                "archive%s={\"checksum\":\"bogus\",\"time\":1570000000}\n",
+                strZ(strSub(walFile, sizeof(STORAGE_REPO_ARCHIVE) - 1))),
+            .comment = "ledger with mismatched checksum");
+
+        TEST_RESULT_STR_Z(verifyProcess(cfgOptionBool(cfgOptVerbose)), TEST_RESULT_LEDGER, "verify with mismatched ledger");
+        TEST_RESULT_LOG(
+            "P00 DETAIL: 0 file(s) verified by a prior run were skipped\n"
+            TEST_RESULT_LEDGER_LOG);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("invalid ledger is ignored");
+
+        HRN_STORAGE_PUT_Z(storageRepoWrite(), STORAGE_REPO_BACKUP "/" VERIFY_LEDGER_FILE, "BOGUS", .comment = "invalid ledger");
+
+        TEST_RESULT_STR_Z(verifyProcess(cfgOptionBool(cfgOptVerbose)), TEST_RESULT_LEDGER, "verify with invalid ledger");
+        TEST_RESULT_LOG(
+            "P00   WARN: unable to load verify ledger '" TEST_PATH "/repo/backup/db/verify.ledger', all files will be verified\n"
+            "            key/value found outside of section at line 1: BOGUS\n"
+            "P00 DETAIL: 0 file(s) verified by a prior run were skipped\n"
+            TEST_RESULT_LEDGER_LOG);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("file set more than once is saved once");
+
+        const String *const ledgerFile = STRDEF(STORAGE_REPO_BACKUP "/" VERIFY_LEDGER_FILE);
+        HRN_STORAGE_REMOVE(storageRepoWrite(), strZ(ledgerFile), .comment = "remove ledger");
+
+        VerifyLedger *ledger = NULL;
+        TEST_ASSIGN(ledger, verifyLedgerLoad(ledgerFile, cipherTypeNone, NULL), "load empty ledger");
+        TEST_RESULT_VOID(verifyLedgerSet(ledger, STRDEF("file1"), STRDEF("aaa"), 1570000000), "set file1");
+        TEST_RESULT_VOID(verifyLedgerSet(ledger, STRDEF("file2"), STRDEF("ccc"), 1570000000), "set file2");
+        TEST_RESULT_VOID(verifyLedgerSet(ledger, STRDEF("file1"), STRDEF("bbb"), 1570000001), "set file1 again");
+        TEST_RESULT_VOID(verifyLedgerSave(ledger, ledgerFile, cipherTypeNone, NULL, true), "save ledger");
+
+        const char *const ledgerSection = strstr(
+            strZ(strNewBuf(storageGetP(storageNewReadP(storageRepo(), ledgerFile)))), "[ledger:file]");
+
+        TEST_RESULT_STR_Z(
+            strNewZN(ledgerSection, (size_t)(strstr(ledgerSection, "\n\n") - ledgerSection)),
+            "[ledger:file]\n"
+            "file1={\"checksum\":\"bbb\",\"time\":1570000001}\n"
+            "file2={\"checksum\":\"ccc\",\"time\":1570000000}",
+            "check ledger");
     }
 
     FUNCTION_HARNESS_RETURN_VOID();
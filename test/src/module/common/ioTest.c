@@ -260,7 +260,7 @@ testRun(void)
     }
 
     // *****************************************************************************************************************************
-    if (testBegin("IoRead, IoBufferRead, IoBuffer, IoSize, IoFilter, IoFilterGroup, and ioReadBuf()"))
+    if (testBegin("IoRead, IoBufferRead, IoBuffer, IoSize, IoRate, IoFilter, IoFilterGroup, and ioReadBuf()"))
     {
         IoRead *read = NULL;
         Buffer *buffer = bufNew(2);
@@ -535,6 +535,18 @@ testRun(void)
         TEST_RESULT_UINT(
             pckReadU64P(ioFilterGroupResultP(ioReadFilterGroup(bufferRead), SIZE_FILTER_TYPE)), 20, "check length");
 
+        // Limit read rate
+        // -------------------------------------------------------------------------------------------------------------------------
+        bufferRead = ioBufferReadNew(BUFSTRDEF("a better test string"));
+        ioFilterGroupAdd(ioReadFilterGroup(bufferRead), ioRateNew(100));
+
+        const TimeMSec timeBegin = timeMSec();
+
+        TEST_RESULT_BOOL(ioReadDrain(bufferRead), true, "drain read io");
+        TEST_RESULT_BOOL(timeMSec() - timeBegin >= 150, true, "check rate limited");
+        TEST_RESULT_BOOL(
+            pckReadU64P(ioFilterGroupResultP(ioReadFilterGroup(bufferRead), RATE_FILTER_TYPE)) >= 150, true, "check sleep time");
+
         // Cannot open file
         TEST_ASSIGN(
             read, ioReadNewP(strNewZ("998"), .close = testIoReadClose, .open = testIoReadOpen, .read = testIoRead),
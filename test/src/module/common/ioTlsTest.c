@@ -984,12 +984,14 @@ testRun(void)
                 IoServer *socketServer = sckServerNew(STRDEF("127.0.0.1"), testPort, 5000);
                 IoServer *tlsServer = tlsServerNew(
                     STRDEF("127.0.0.1"), STRDEF(HRN_SERVER_CA), STRDEF(TEST_PATH "/server-root-perm-link"),
-                    STRDEF(TEST_PATH "/server-cn-only.crt"), 5000);
+                    STRDEF(TEST_PATH "/server-cn-only.crt"), 5000, true);
                 IoSession *socketSession = NULL;
 
                 TEST_RESULT_STR(
                     ioServerName(socketServer), strNewFmt("127.0.0.1:%u", testPort), "socket server name");
                 TEST_RESULT_STR_Z(ioServerName(tlsServer), "127.0.0.1", "tls server name");
+                TEST_RESULT_BOOL(ioServerFd(socketServer) >= 0, true, "socket server fd");
+                TEST_RESULT_INT(ioServerFd(tlsServer), -1, "tls server fd");
 
                 // Invalid client cert
                 socketSession = ioServerAccept(socketServer, NULL);
@@ -30,6 +30,47 @@ testRun(void)
 
         TEST_RESULT_STR_Z(
             statToJson(), "{\"http.session\":{\"total\":1},\"tls.client\":{\"total\":2}}", "stat output");
+
+        TEST_RESULT_UINT(statTotal(statTlsClient), 2, "tls.client total");
+        TEST_RESULT_UINT(statTotal(STRDEF("bogus")), 0, "missing stat total");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("timed stats");
+
+        const String *statStorageRead = STRDEF("storage.read");
+
+        TEST_RESULT_VOID(statTime(statStorageRead, 50), "time < 100us");
+        TEST_RESULT_VOID(statTime(statStorageRead, 150), "time < 1ms");
+        TEST_RESULT_VOID(statTime(statStorageRead, 12000), "time < 100ms");
+        TEST_RESULT_VOID(statTime(statStorageRead, 20000000), "time >= 10s");
+
+        TEST_RESULT_STR_Z(
+            statToJson(),
+            "{\"http.session\":{\"total\":1},"
+            "\"storage.read\":{\"histogram\":[1,1,0,1,0,0,1],\"max\":20000,\"time\":20012,\"total\":4},"
+            "\"tls.client\":{\"total\":2}}",
+            "stat output");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("merge stats");
+
+        TEST_RESULT_VOID(
+            statMerge(
+                STRDEF(
+                    "{\"http.client\":{\"total\":1},"
+                    "\"storage.read\":{\"histogram\":[1,0,0,0,0,0,0],\"max\":30000,\"time\":30000,\"total\":1},"
+                    "\"tls.client\":{\"total\":3}}")),
+            "merge");
+        TEST_RESULT_VOID(
+            statMerge(STRDEF("{\"storage.read\":{\"histogram\":[0,1,0,0,0,0,0],\"max\":0,\"time\":0,\"total\":1}}")),
+            "merge with lower max");
+
+        TEST_RESULT_STR_Z(
+            statToJson(),
+            "{\"http.client\":{\"total\":1},\"http.session\":{\"total\":1},"
+            "\"storage.read\":{\"histogram\":[2,2,0,1,0,0,1],\"max\":30000,\"time\":50012,\"total\":6},"
+            "\"tls.client\":{\"total\":5}}",
+            "stat output");
     }
 
     FUNCTION_HARNESS_RETURN_VOID();
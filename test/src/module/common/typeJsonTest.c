@@ -212,6 +212,29 @@ testRun(void)
 
         TEST_RESULT_STR_Z(varStr(jsonToVar(STRDEF("\"test\""))), "test", "var");
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("read unsorted keys");
+
+        TEST_ASSIGN(read, jsonReadNew(STRDEF("{\"b\":[1,2],\"a\":{}}")), "new read");
+
+        TEST_RESULT_VOID(jsonReadObjectBegin(read), "object begin");
+        TEST_RESULT_BOOL(jsonReadMore(read), true, "more keys");
+        TEST_RESULT_STR_Z(jsonReadKey(read), "b", "key b");
+        TEST_RESULT_VOID(jsonReadArrayBegin(read), "array begin");
+        TEST_RESULT_BOOL(jsonReadMore(read), true, "more values");
+        TEST_RESULT_UINT(jsonReadUInt(read), 1, "uint");
+        TEST_RESULT_BOOL(jsonReadMore(read), true, "more values");
+        TEST_RESULT_UINT(jsonReadUInt(read), 2, "uint");
+        TEST_RESULT_BOOL(jsonReadMore(read), false, "no more values");
+        TEST_RESULT_VOID(jsonReadArrayEnd(read), "array end");
+        TEST_RESULT_BOOL(jsonReadMore(read), true, "more keys");
+        TEST_RESULT_STR_Z(jsonReadKey(read), "a", "key a");
+        TEST_RESULT_VOID(jsonReadObjectBegin(read), "object begin");
+        TEST_RESULT_BOOL(jsonReadMore(read), false, "no more keys");
+        TEST_RESULT_VOID(jsonReadObjectEnd(read), "object end");
+        TEST_RESULT_BOOL(jsonReadMore(read), false, "no more keys");
+        TEST_RESULT_VOID(jsonReadObjectEnd(read), "object end");
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("validate");
 
@@ -297,6 +320,16 @@ testRun(void)
             // {uncrustify_on}
             "json result");
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("reset");
+
+        TEST_RESULT_VOID(jsonWriteObjectBegin(jsonWriteReset(write)), "reset and object begin");
+        TEST_RESULT_VOID(jsonWriteKeyZ(write, "a"), "key 'a'");
+        TEST_RESULT_VOID(jsonWriteObjectEnd(jsonWriteBool(write, true)), "bool and object end");
+        TEST_RESULT_STR_Z(jsonWriteResult(write), "{\"a\":true}", "json result");
+
+        TEST_RESULT_STR_Z(jsonWriteResult(jsonWriteStr(jsonWriteReset(write), STRDEF("b"))), "\"b\"", "reset and write scalar");
+
         TEST_RESULT_VOID(jsonWriteFree(write), "free");
 
         // -------------------------------------------------------------------------------------------------------------------------
@@ -42,6 +42,12 @@ testRun(void)
         TEST_RESULT_VOID(FUNCTION_LOG_OBJECT_FORMAT(list, lstToLog, logBuf, sizeof(logBuf)), "bufToLog");
         TEST_RESULT_Z(logBuf, "{size: 0}", "check log");
 
+        TEST_RESULT_VOID(lstAdd(list, &ptr), "add item");
+        TEST_RESULT_VOID(lstAdd(list, &ptr), "add item");
+        TEST_RESULT_VOID(lstRemoveIdx(list, 0), "remove first item so the list pointer is moved");
+        TEST_RESULT_VOID(lstClear(list), "clear list after first item removed");
+        TEST_RESULT_UINT(lstSize(list), 0, "list size");
+
         TEST_RESULT_VOID(lstFree(list), "free list");
         TEST_RESULT_VOID(lstFree(lstNewP(1)), "free empty list");
         TEST_RESULT_VOID(lstFree(NULL), "free null list");
@@ -1,6 +1,33 @@
 /***********************************************************************************************************************************
 Test Xml Types
 ***********************************************************************************************************************************/
+#include "common/io/bufferRead.h"
+#include "common/io/io.h"
+
+/***********************************************************************************************************************************
+Callback to log parse events
+***********************************************************************************************************************************/
+static void
+testXmlParseCallback(void *const callbackData, const unsigned int depth, const String *const name, const String *const content)
+{
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        strCatFmt(
+            (String *)callbackData, "%u %s%s%s\n", depth, content == NULL ? "<" : "/", strZ(name),
+            content == NULL || strEmpty(strTrim(strDup(content))) ? "" : zNewFmt(" = %s", strZ(content)));
+    }
+    MEM_CONTEXT_TEMP_END();
+}
+
+// Callback that errors on the named element
+static void
+testXmlParseCallbackError(void *const callbackData, const unsigned int depth, const String *const name, const String *const content)
+{
+    testXmlParseCallback(callbackData, depth, name, content);
+
+    if (strEqZ(name, "error"))
+        THROW(ProtocolError, "callback error");
+}
 
 /***********************************************************************************************************************************
 Test Run
@@ -193,5 +220,73 @@ testRun(void)
             "get xml");
     }
 
+    // *****************************************************************************************************************************
+    if (testBegin("xmlParse()"))
+    {
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("parse in small chunks");
+
+        ioBufferSizeSet(8);
+
+        IoRead *read = ioBufferReadNew(
+            BUFSTRDEF(
+                "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                "<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">"
+                "    <IsTruncated>false</IsTruncated>"
+                "    <Contents>"
+                "        <Key>path/to/test&amp;file.txt</Key>"
+                "        <Size>787</Size>"
+                "    </Contents>"
+                "    <Empty/>"
+                "</ListBucketResult>"));
+        ioReadOpen(read);
+
+        String *const log = strNew();
+
+        TEST_RESULT_VOID(xmlParse(read, testXmlParseCallback, log), "parse");
+        TEST_RESULT_STR_Z(
+            log,
+            "1 <ListBucketResult\n"
+            "2 <IsTruncated\n"
+            "2 /IsTruncated = false\n"
+            "2 <Contents\n"
+            "3 <Key\n"
+            "3 /Key = path/to/test&file.txt\n"
+            "3 <Size\n"
+            "3 /Size = 787\n"
+            "2 /Contents\n"
+            "2 <Empty\n"
+            "2 /Empty\n"
+            "1 /ListBucketResult\n",
+            "check log");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("invalid xml");
+
+        read = ioBufferReadNew(BUFSTRDEF("<doc><name>text</doc>"));
+        ioReadOpen(read);
+
+        TEST_ERROR(
+            xmlParse(read, testXmlParseCallback, strNew()), FormatError,
+            "invalid xml: Opening and ending tag mismatch: name line 1 and doc");
+
+        read = ioBufferReadNew(BUFSTRDEF(""));
+        ioReadOpen(read);
+
+        TEST_ERROR(
+            xmlParse(read, testXmlParseCallback, strNew()), FormatError, "invalid xml: Extra content at the end of the document");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("error in callback");
+
+        read = ioBufferReadNew(BUFSTRDEF("<doc><name>text</name><error/><after/></doc>"));
+        ioReadOpen(read);
+
+        String *const logError = strNew();
+
+        TEST_ERROR(xmlParse(read, testXmlParseCallbackError, logError), ProtocolError, "callback error");
+        TEST_RESULT_STR_Z(logError, "1 <doc\n2 <name\n2 /name = text\n2 <error\n", "parsing stopped at error");
+    }
+
     FUNCTION_HARNESS_RETURN_VOID();
 }
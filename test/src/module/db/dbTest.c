@@ -13,43 +13,6 @@ Test Database
 #include "common/harnessPostgres.h"
 #include "common/harnessPq.h"
 
-/***********************************************************************************************************************************
-Macro to check that replay is making progress -- this does not seem useful enough to be included in the pq harness header
-***********************************************************************************************************************************/
-#define                                                                                                                            \
-    HRN_PQ_SCRIPT_REPLAY_TARGET_REACHED_PROGRESS(                                                                                  \
-        sessionParam, walNameParam, lsnNameParam, targetLsnParam, targetReachedParam, replayLsnParam, replayLastLsnParam,          \
-        replayProgressParam, sleepParam)                                                                                           \
-    {.session = sessionParam,                                                                                                      \
-        .function = HRN_PQ_SENDQUERY,                                                                                              \
-        .param =                                                                                                                   \
-            "[\"select replayLsn::text,\\n"                                                                                        \
-            "       (replayLsn > '" targetLsnParam "')::bool as targetReached,\\n"                                                 \
-            "       (replayLsn > '" replayLastLsnParam "')::bool as replayProgress\\n"                                             \
-            "  from pg_catalog.pg_last_" walNameParam "_replay_" lsnNameParam "() as replayLsn\"]",                                \
-        .resultInt = 1, .sleep = sleepParam},                                                                                      \
-    {.session = sessionParam, .function = HRN_PQ_CONSUMEINPUT},                                                                    \
-    {.session = sessionParam, .function = HRN_PQ_ISBUSY},                                                                          \
-    {.session = sessionParam, .function = HRN_PQ_GETRESULT},                                                                       \
-    {.session = sessionParam, .function = HRN_PQ_RESULTSTATUS, .resultInt = PGRES_TUPLES_OK},                                      \
-    {.session = sessionParam, .function = HRN_PQ_NTUPLES, .resultInt = 1},                                                         \
-    {.session = sessionParam, .function = HRN_PQ_NFIELDS, .resultInt = 3},                                                         \
-    {.session = sessionParam, .function = HRN_PQ_FTYPE, .param = "[0]", .resultInt = HRN_PQ_TYPE_TEXT},                            \
-    {.session = sessionParam, .function = HRN_PQ_FTYPE, .param = "[1]", .resultInt = HRN_PQ_TYPE_BOOL},                            \
-    {.session = sessionParam, .function = HRN_PQ_FTYPE, .param = "[2]", .resultInt = HRN_PQ_TYPE_BOOL},                            \
-    {.session = sessionParam, .function = HRN_PQ_GETVALUE, .param = "[0,0]", .resultZ = replayLsnParam},                           \
-    {.session = sessionParam, .function = HRN_PQ_GETVALUE, .param = "[0,1]", .resultZ = cvtBoolToConstZ(targetReachedParam)},      \
-    {.session = sessionParam, .function = HRN_PQ_GETVALUE, .param = "[0,2]", .resultZ = cvtBoolToConstZ(replayProgressParam)},     \
-    {.session = sessionParam, .function = HRN_PQ_CLEAR},                                                                           \
-    {.session = sessionParam, .function = HRN_PQ_GETRESULT, .resultNull = true}
-
-#define                                                                                                                            \
-    HRN_PQ_SCRIPT_REPLAY_TARGET_REACHED_PROGRESS_GE_10(                                                                            \
-        sessionParam, targetLsnParam, targetReachedParam, replayLsnParam, replayLastLsnParam, replayProgressParam, sleepParam)     \
-    HRN_PQ_SCRIPT_REPLAY_TARGET_REACHED_PROGRESS(                                                                                  \
-        sessionParam, "wal", "lsn", targetLsnParam, targetReachedParam, replayLsnParam, replayLastLsnParam, replayProgressParam,   \
-        sleepParam)
-
 /***********************************************************************************************************************************
 Test Run
 ***********************************************************************************************************************************/
@@ -237,7 +200,7 @@ testRun(void)
             HRN_PQ_SCRIPT_CLOSE(1));
 
         TEST_ERROR(
-            dbGet(true, true, CFGOPTVAL_BACKUP_STANDBY_N), DbConnectError,
+            dbGet(true, true, CFGOPTVAL_BACKUP_STANDBY_N, false), DbConnectError,
             "unable to find primary cluster - cannot proceed\n"
             "HINT: are all available clusters in recovery?");
 
@@ -256,7 +219,7 @@ testRun(void)
             HRN_PQ_SCRIPT_OPEN(1, "dbname='backupdb' port=5432", PG_VERSION_96, TEST_PATH "/pg1", false, NULL, NULL));
 
         DbGetResult db = {0};
-        TEST_ASSIGN(db, dbGet(true, true, CFGOPTVAL_BACKUP_STANDBY_N), "get primary");
+        TEST_ASSIGN(db, dbGet(true, true, CFGOPTVAL_BACKUP_STANDBY_N, false), "get primary");
 
         // Get start time
         HRN_PQ_SCRIPT_SET(HRN_PQ_SCRIPT_TIME_QUERY(1, 1000));
@@ -332,7 +295,7 @@ testRun(void)
             HRN_PQ_SCRIPT_OPEN(1, "dbname='postgres' port=5432", PG_VERSION_12, TEST_PATH "/pg1", false, NULL, NULL),
             HRN_PQ_SCRIPT_OPEN(2, "dbname='postgres' port=5433", PG_VERSION_12, TEST_PATH "/pg2", true, NULL, NULL));
 
-        TEST_ASSIGN(db, dbGet(false, true, CFGOPTVAL_BACKUP_STANDBY_Y), "get primary and standby");
+        TEST_ASSIGN(db, dbGet(false, true, CFGOPTVAL_BACKUP_STANDBY_Y, false), "get primary and standby");
 
         // Start backup
         HRN_PQ_SCRIPT_SET(
@@ -392,7 +355,7 @@ testRun(void)
             HRN_PQ_SCRIPT_OPEN(1, "dbname='postgres' port=5432", PG_VERSION_10, TEST_PATH "/pg1", false, NULL, NULL),
             HRN_PQ_SCRIPT_OPEN(2, "dbname='postgres' port=5433", PG_VERSION_10, TEST_PATH "/pg2", true, NULL, NULL));
 
-        TEST_ASSIGN(db, dbGet(false, true, CFGOPTVAL_BACKUP_STANDBY_Y), "get primary and standby");
+        TEST_ASSIGN(db, dbGet(false, true, CFGOPTVAL_BACKUP_STANDBY_Y, false), "get primary and standby");
 
         TEST_RESULT_UINT(dbPgControl(db.primary).timeline, 5, "check primary timeline");
         TEST_RESULT_UINT(dbPgControl(db.standby).timeline, 5, "check standby timeline");
@@ -476,6 +439,22 @@ testRun(void)
 
         TEST_RESULT_VOID(dbReplayWait(db.standby, STRDEF("5/5"), dbPgControl(db.primary).timeline, 1000), "sync standby");
 
+        // Check replay without sleeping, as is done when waiting on multiple standbys
+        HRN_PQ_SCRIPT_SET(
+            HRN_PQ_SCRIPT_REPLAY_TARGET_REACHED_GE_10(2, "5/5", false, "5/3"),
+            HRN_PQ_SCRIPT_REPLAY_TARGET_REACHED_PROGRESS_GE_10(2, "5/5", true, "5/5", "5/3", true, 0),
+            HRN_PQ_SCRIPT_CHECKPOINT(2),
+            HRN_PQ_SCRIPT_CHECKPOINT_TARGET_REACHED_GE_10(2, "5/5", true, "X/X", 0));
+
+        DbReplayWait *replayWait = NULL;
+
+        TEST_ASSIGN(
+            replayWait, dbReplayWaitNew(db.standby, STRDEF("5/5"), dbPgControl(db.primary).timeline, 1000), "new replay wait");
+        TEST_RESULT_BOOL(dbReplayWaitCheck(replayWait), false, "replay not reached");
+        TEST_RESULT_VOID(dbReplayWaitMore(replayWait, false), "wait more without sleep");
+        TEST_RESULT_BOOL(dbReplayWaitCheck(replayWait), true, "replay reached");
+        TEST_RESULT_VOID(objFree(replayWait), "free replay wait");
+
         // Update timeline to demonstrate that it is reloaded in dbReplayWait()
         HRN_PG_CONTROL_PUT(storagePgIdxWrite(1), PG_VERSION_10, .timeline = 6, .checkpoint = pgLsnFromStr(STRDEF("5/5")));
 
@@ -518,7 +497,7 @@ testRun(void)
         HRN_PQ_SCRIPT_SET(
             HRN_PQ_SCRIPT_OPEN(1, "dbname='postgres' port=5432", PG_VERSION_14, TEST_PATH "/pg1", false, NULL, NULL));
 
-        TEST_ASSIGN(db, dbGet(true, true, CFGOPTVAL_BACKUP_STANDBY_N), "get primary");
+        TEST_ASSIGN(db, dbGet(true, true, CFGOPTVAL_BACKUP_STANDBY_N, false), "get primary");
 
         // Start backup
         HRN_PQ_SCRIPT_SET(
@@ -550,7 +529,7 @@ testRun(void)
         HRN_PQ_SCRIPT_SET(
             HRN_PQ_SCRIPT_OPEN(1, "dbname='postgres' port=5432", PG_VERSION_15, TEST_PATH "/pg1", false, NULL, NULL));
 
-        TEST_ASSIGN(db, dbGet(true, true, CFGOPTVAL_BACKUP_STANDBY_N), "get primary");
+        TEST_ASSIGN(db, dbGet(true, true, CFGOPTVAL_BACKUP_STANDBY_N, false), "get primary");
 
         // Start backup
         HRN_PQ_SCRIPT_SET(
@@ -602,7 +581,7 @@ testRun(void)
             {.function = HRN_PQ_FINISH});
 
         TEST_ERROR(
-            dbGet(true, true, CFGOPTVAL_BACKUP_STANDBY_N), DbConnectError,
+            dbGet(true, true, CFGOPTVAL_BACKUP_STANDBY_N, false), DbConnectError,
             "unable to find primary cluster - cannot proceed\n"
             "HINT: are all available clusters in recovery?");
         TEST_RESULT_LOG(
@@ -617,7 +596,7 @@ testRun(void)
             HRN_PQ_SCRIPT_CLOSE(1));
 
         TEST_ERROR(
-            dbGet(true, true, CFGOPTVAL_BACKUP_STANDBY_N), DbConnectError,
+            dbGet(true, true, CFGOPTVAL_BACKUP_STANDBY_N, false), DbConnectError,
             "unable to find primary cluster - cannot proceed\n"
             "HINT: are all available clusters in recovery?");
 
@@ -629,7 +608,8 @@ testRun(void)
             HRN_PQ_SCRIPT_CLOSE(1));
 
         TEST_ERROR(
-            dbGet(false, false, CFGOPTVAL_BACKUP_STANDBY_Y), DbConnectError, "unable to find standby cluster - cannot proceed");
+            dbGet(false, false, CFGOPTVAL_BACKUP_STANDBY_Y, false), DbConnectError,
+            "unable to find standby cluster - cannot proceed");
 
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("primary cluster found");
@@ -639,7 +619,7 @@ testRun(void)
                 1, "dbname='postgres' port=5432 user='bob'", PG_VERSION_18, TEST_PATH "/pg1", false, NULL, NULL),
             HRN_PQ_SCRIPT_CLOSE(1));
 
-        TEST_ASSIGN(result, dbGet(true, true, CFGOPTVAL_BACKUP_STANDBY_N), "get primary only");
+        TEST_ASSIGN(result, dbGet(true, true, CFGOPTVAL_BACKUP_STANDBY_N, false), "get primary only");
 
         TEST_RESULT_INT(result.primaryIdx, 0, "check primary id");
         TEST_RESULT_BOOL(result.primary != NULL, true, "check primary");
@@ -671,7 +651,7 @@ testRun(void)
             HRN_PQ_SCRIPT_CLOSE(1),
             HRN_PQ_SCRIPT_CLOSE(8));
 
-        TEST_ERROR(dbGet(true, true, CFGOPTVAL_BACKUP_STANDBY_N), DbConnectError, "more than one primary cluster found");
+        TEST_ERROR(dbGet(true, true, CFGOPTVAL_BACKUP_STANDBY_N, false), DbConnectError, "more than one primary cluster found");
 
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("two standbys found but no primary");
@@ -684,7 +664,7 @@ testRun(void)
             HRN_PQ_SCRIPT_CLOSE(1));
 
         TEST_ERROR(
-            dbGet(false, true, CFGOPTVAL_BACKUP_STANDBY_N), DbConnectError,
+            dbGet(false, true, CFGOPTVAL_BACKUP_STANDBY_N, false), DbConnectError,
             "unable to find primary cluster - cannot proceed\n"
             "HINT: are all available clusters in recovery?");
 
@@ -698,7 +678,7 @@ testRun(void)
             HRN_PQ_SCRIPT_CLOSE(8),
             HRN_PQ_SCRIPT_CLOSE(1));
 
-        TEST_ASSIGN(result, dbGet(false, false, CFGOPTVAL_BACKUP_STANDBY_N), "get standbys");
+        TEST_ASSIGN(result, dbGet(false, false, CFGOPTVAL_BACKUP_STANDBY_N, false), "get standbys");
 
         TEST_RESULT_INT(result.primaryIdx, 0, "check primary id");
         TEST_RESULT_BOOL(result.primary == NULL, true, "check primary");
@@ -707,6 +687,28 @@ testRun(void)
 
         TEST_RESULT_VOID(dbFree(result.standby), "free standby");
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("all standbys returned");
+
+        HRN_PQ_SCRIPT_SET(
+            HRN_PQ_SCRIPT_OPEN(1, "dbname='postgres' port=5432", PG_VERSION_10, TEST_PATH "/pg1", true, NULL, NULL),
+            HRN_PQ_SCRIPT_OPEN(8, "dbname='postgres' port=5433", PG_VERSION_10, TEST_PATH "/pg8", true, NULL, NULL),
+
+            HRN_PQ_SCRIPT_CLOSE(1),
+            HRN_PQ_SCRIPT_CLOSE(8));
+
+        TEST_ASSIGN(result, dbGet(false, false, CFGOPTVAL_BACKUP_STANDBY_Y, true), "get all standbys");
+
+        TEST_RESULT_BOOL(result.primary == NULL, true, "check primary");
+        TEST_RESULT_INT(result.standbyIdx, 0, "check standby id");
+        TEST_RESULT_UINT(lstSize(result.standbyList), 2, "check standby total");
+        TEST_RESULT_BOOL(
+            ((DbGetResultStandby *)lstGet(result.standbyList, 0))->db == result.standby, true, "check first standby");
+        TEST_RESULT_UINT(((DbGetResultStandby *)lstGet(result.standbyList, 1))->idx, 1, "check second standby id");
+
+        TEST_RESULT_VOID(dbFree(((DbGetResultStandby *)lstGet(result.standbyList, 0))->db), "free standby");
+        TEST_RESULT_VOID(dbFree(((DbGetResultStandby *)lstGet(result.standbyList, 1))->db), "free standby");
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("primary and standby found");
 
@@ -740,7 +742,7 @@ testRun(void)
             HRN_PQ_SCRIPT_CLOSE(8),
             HRN_PQ_SCRIPT_CLOSE(1));
 
-        TEST_ASSIGN(result, dbGet(false, true, CFGOPTVAL_BACKUP_STANDBY_N), "get primary and standby");
+        TEST_ASSIGN(result, dbGet(false, true, CFGOPTVAL_BACKUP_STANDBY_N, false), "get primary and standby");
 
         hrnLogReplaceAdd("(could not connect to server|connection to server on socket).*$", NULL, "PG ERROR", false);
         TEST_RESULT_LOG(
@@ -781,7 +783,7 @@ testRun(void)
 
             HRN_PQ_SCRIPT_CLOSE(1));
 
-        TEST_ASSIGN(result, dbGet(false, true, CFGOPTVAL_BACKUP_STANDBY_PREFER), "get primary and try standby");
+        TEST_ASSIGN(result, dbGet(false, true, CFGOPTVAL_BACKUP_STANDBY_PREFER, false), "get primary and try standby");
 
         TEST_RESULT_LOG(
             "P00   WARN: unable to check pg4: [DbConnectError] unable to connect to 'dbname='postgres' port=5433': error");
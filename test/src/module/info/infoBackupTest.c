@@ -483,6 +483,14 @@ testRun(void)
             infoBackupDataAnnotationSet(
                 infoBackup, STRDEF("20190818-084502F_20190820-084502I"), annotationKV), "add annotations");
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("infoBackupDataDeltaAdd()");
+
+        TEST_RESULT_VOID(infoBackupDataDeltaAdd(infoBackup, STRDEF("20190818-084502F_20190820-084502I"), 100, 50), "add delta");
+        TEST_ASSIGN(backupData, infoBackupData(infoBackup, 1), "get backup");
+        TEST_RESULT_UINT(backupData.backupInfoSizeDelta, 12753, "backup size");
+        TEST_RESULT_UINT(backupData.backupInfoRepoSizeDelta, 8607, "repo backup size");
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("infoBackupLoadFileReconstruct - skip/add backups");
 
@@ -1066,7 +1066,7 @@ testRun(void)
         }
         OBJ_NEW_END();
 
-        TEST_RESULT_VOID(manifestBuildIncr(manifest, manifestPrior, backupTypeIncr, NULL), "incremental manifest");
+        TEST_RESULT_VOID(manifestBuildIncr(manifest, manifestPrior, backupTypeIncr, NULL, NULL), "incremental manifest");
 
         Buffer *contentSave = bufNew(0);
         TEST_RESULT_VOID(manifestSave(manifest, ioBufferWriteNew(contentSave)), "save manifest");
@@ -1128,7 +1128,7 @@ testRun(void)
             manifestPrior, .name = MANIFEST_TARGET_PGDATA "/FILE0-normal", .size = 0, .sizeRepo = 0, .timestamp = 1482182860,
             .group = "test", .user = "test", .checksumSha1 = HASH_TYPE_SHA1_ZERO);
 
-        TEST_RESULT_VOID(manifestBuildIncr(manifest, manifestPrior, backupTypeIncr, NULL), "incremental manifest");
+        TEST_RESULT_VOID(manifestBuildIncr(manifest, manifestPrior, backupTypeIncr, NULL, NULL), "incremental manifest");
 
         contentSave = bufNew(0);
         TEST_RESULT_VOID(manifestSave(manifest, ioBufferWriteNew(contentSave)), "save manifest");
@@ -1182,7 +1182,7 @@ testRun(void)
             .checksumPage = true, .checksumPageError = true,
             .checksumPageErrorList = jsonFromVar(varNewVarLst(checksumPageErrorList)));
 
-        TEST_RESULT_VOID(manifestBuildIncr(manifest, manifestPrior, backupTypeIncr, NULL), "incremental manifest");
+        TEST_RESULT_VOID(manifestBuildIncr(manifest, manifestPrior, backupTypeIncr, NULL, NULL), "incremental manifest");
 
         TEST_RESULT_LOG(
             "P00   WARN: file 'FILE1' has timestamp earlier than prior backup (prior 1482182860, current 1482182859), enabling"
@@ -1230,7 +1230,7 @@ testRun(void)
             .checksumSha1 = "ddddddddddbbbbbbbbbbccccccccccaaaaaaaaaa");
 
         TEST_RESULT_VOID(
-            manifestBuildIncr(manifest, manifestPrior, backupTypeIncr, STRDEF("000000040000000400000004")),
+            manifestBuildIncr(manifest, manifestPrior, backupTypeIncr, STRDEF("000000040000000400000004"), NULL),
             "incremental manifest");
 
         TEST_RESULT_LOG(
@@ -1270,7 +1270,8 @@ testRun(void)
         manifest->pub.data.backupOptionDelta = BOOL_FALSE_VAR;
 
         TEST_RESULT_VOID(
-            manifestBuildIncr(manifest, manifestPrior, backupTypeIncr, STRDEF("000000040000000400000004")), "incremental manifest");
+            manifestBuildIncr(manifest, manifestPrior, backupTypeIncr, STRDEF("000000040000000400000004"), NULL),
+            "incremental manifest");
 
         TEST_RESULT_LOG(
             "P00   WARN: a timeline switch has occurred since the 20190101-010101F backup, enabling delta checksum\n"
@@ -1295,7 +1296,8 @@ testRun(void)
             .checksumSha1 = "ddddddddddbbbbbbbbbbccccccccccaaaaaaaaaa");
 
         TEST_RESULT_VOID(
-            manifestBuildIncr(manifest, manifestPrior, backupTypeIncr, STRDEF("000000030000000300000003")), "incremental manifest");
+            manifestBuildIncr(manifest, manifestPrior, backupTypeIncr, STRDEF("000000030000000300000003"), NULL),
+            "incremental manifest");
 
         TEST_RESULT_LOG("P00   WARN: the online option has changed since the 20190101-010101F backup, enabling delta checksum");
 
@@ -1362,7 +1364,8 @@ testRun(void)
             .checksumSha1 = "ddddddddddbbbbbbbbbbccccccccccaaaaaaaaaa");
 
         TEST_RESULT_VOID(
-            manifestBuildIncr(manifest, manifestPrior, backupTypeIncr, STRDEF("000000030000000300000003")), "incremental manifest");
+            manifestBuildIncr(manifest, manifestPrior, backupTypeIncr, STRDEF("000000030000000300000003"), NULL),
+            "incremental manifest");
 
         contentSave = bufNew(0);
         TEST_RESULT_VOID(manifestSave(manifest, ioBufferWriteNew(contentSave)), "save manifest");
@@ -1392,6 +1395,68 @@ testRun(void)
                     TEST_MANIFEST_PATH_DEFAULT)),
             "check manifest");
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("files known to be unchanged are not copied");
+
+        manifest->pub.data.backupOptionDelta = BOOL_FALSE_VAR;
+        lstClear(manifest->pub.fileList);
+        lstClear(manifestPrior->pub.fileList);
+
+        HRN_MANIFEST_FILE_ADD(
+            manifest, .name = MANIFEST_TARGET_PGDATA "/base/1/2", .copy = true, .size = 8192, .timestamp = 1482182861,
+            .group = "test", .user = "test");
+        HRN_MANIFEST_FILE_ADD(
+            manifest, .name = MANIFEST_TARGET_PGDATA "/base/1/3", .copy = true, .size = 8192, .timestamp = 1482182861,
+            .group = "test", .user = "test");
+        HRN_MANIFEST_FILE_ADD(
+            manifest, .name = MANIFEST_TARGET_PGDATA "/base/1/4", .copy = true, .size = 16384, .timestamp = 1482182861,
+            .group = "test", .user = "test");
+
+        HRN_MANIFEST_FILE_ADD(
+            manifestPrior, .name = MANIFEST_TARGET_PGDATA "/base/1/2", .size = 8192, .sizeRepo = 8192, .timestamp = 1482182860,
+            .checksumSha1 = "aaaaaaaaaabbbbbbbbbbccccccccccdddddddddd");
+        HRN_MANIFEST_FILE_ADD(
+            manifestPrior, .name = MANIFEST_TARGET_PGDATA "/base/1/3", .size = 8192, .sizeRepo = 8192, .timestamp = 1482182860,
+            .checksumSha1 = "aaaaaaaaaabbbbbbbbbbccccccccccdddddddddd");
+        HRN_MANIFEST_FILE_ADD(
+            manifestPrior, .name = MANIFEST_TARGET_PGDATA "/base/1/4", .size = 8192, .sizeRepo = 8192, .timestamp = 1482182860,
+            .checksumSha1 = "aaaaaaaaaabbbbbbbbbbccccccccccdddddddddd");
+
+        StringList *const fileSameList = strLstNew();
+        strLstAddZ(fileSameList, MANIFEST_TARGET_PGDATA "/base/1/2");
+        strLstAddZ(fileSameList, MANIFEST_TARGET_PGDATA "/base/1/4");
+
+        TEST_RESULT_VOID(manifestBuildIncr(manifest, manifestPrior, backupTypeIncr, NULL, fileSameList), "incremental manifest");
+
+        ManifestFile file = manifestFileFind(manifest, STRDEF(MANIFEST_TARGET_PGDATA "/base/1/2"));
+        TEST_RESULT_BOOL(file.copy, false, "unchanged file not copied");
+        TEST_RESULT_BOOL(file.delta, false, "unchanged file no delta");
+        TEST_RESULT_STR_Z(file.reference, "20190101-010101F", "unchanged file reference");
+
+        file = manifestFileFind(manifest, STRDEF(MANIFEST_TARGET_PGDATA "/base/1/3"));
+        TEST_RESULT_BOOL(file.copy, true, "possibly changed file copied");
+        TEST_RESULT_BOOL(file.delta, false, "possibly changed file no delta");
+
+        file = manifestFileFind(manifest, STRDEF(MANIFEST_TARGET_PGDATA "/base/1/4"));
+        TEST_RESULT_BOOL(file.copy, true, "unchanged file with different size copied");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("files known to be unchanged are still checked when delta is enabled");
+
+        manifest->pub.data.backupOptionDelta = BOOL_TRUE_VAR;
+        lstClear(manifest->pub.fileList);
+
+        HRN_MANIFEST_FILE_ADD(
+            manifest, .name = MANIFEST_TARGET_PGDATA "/base/1/2", .copy = true, .size = 8192, .timestamp = 1482182861,
+            .group = "test", .user = "test");
+
+        TEST_RESULT_VOID(manifestBuildIncr(manifest, manifestPrior, backupTypeIncr, NULL, fileSameList), "incremental manifest");
+
+        file = manifestFileFind(manifest, STRDEF(MANIFEST_TARGET_PGDATA "/base/1/2"));
+        TEST_RESULT_BOOL(file.copy, true, "unchanged file copied");
+        TEST_RESULT_BOOL(file.delta, true, "unchanged file delta");
+        TEST_RESULT_STR_Z(file.reference, "20190101-010101F", "unchanged file reference");
+
         #undef TEST_MANIFEST_HEADER_PRE
         #undef TEST_MANIFEST_HEADER_MID
         #undef TEST_MANIFEST_HEADER_POST
@@ -1846,6 +1911,25 @@ testRun(void)
             "pg_data/special-@#!$^&*()_+~`{}[]\\:;", "find special file");
         TEST_RESULT_BOOL(manifestFileExists(manifest, STRDEF("bogus")), false, "manifest file does not exist");
 
+        // ManifestFileKey getters
+        ManifestFileKey fileKey = {0};
+        TEST_ASSIGN(
+            fileKey, manifestFileUnpackKey(manifest, manifestFilePackFind(manifest, STRDEF("pg_data/base/16384/PG_VERSION"))),
+            "manifestFileUnpackKey()");
+        TEST_RESULT_STR_Z(fileKey.name, "pg_data/base/16384/PG_VERSION", "check name");
+        TEST_RESULT_UINT(fileKey.size, 4, "check size");
+        TEST_RESULT_INT(fileKey.timestamp, 1565282115, "check timestamp");
+        TEST_RESULT_UINT(fileKey.bundleId, 1, "check bundle id");
+        TEST_RESULT_UINT(fileKey.bundleOffset, 1, "check bundle offset");
+        TEST_RESULT_STR(fileKey.reference, NULL, "check reference");
+
+        TEST_ASSIGN(
+            fileKey, manifestFileUnpackKey(manifest, manifestFilePackFind(manifest, STRDEF("pg_data/base/32768/33000"))),
+            "manifestFileUnpackKey()");
+        TEST_RESULT_UINT(fileKey.size, 1073741824, "check size");
+        TEST_RESULT_UINT(fileKey.bundleId, 0, "check bundle id");
+        TEST_RESULT_STR_Z(fileKey.reference, "20190818-084502F", "check reference");
+
         // Munge the sha1 checksum to be blank
         ManifestFilePack **const fileMungePack = manifestFilePackFindInternal(manifest, STRDEF("pg_data/postgresql.conf"));
         ManifestFile fileMunge = manifestFileUnpack(manifest, *fileMungePack);
@@ -0,0 +1,539 @@
+/***********************************************************************************************************************************
+Backup/Restore Performance
+
+Benchmark end-to-end backup and restore against a synthetic cluster. Each storage target runs the same sequence of full,
+incremental, block incremental, and delta restore so results can be compared between targets and between builds.
+
+Results for each phase are logged as a single line of JSON with throughput (mbPerSec), CPU seconds consumed per GB of cluster data
+(cpuPerGb), and peak RSS in KiB (rssPeak) so they can be extracted by scripts. Throughput is based on the total size of the cluster
+since every phase must at least scan (and for delta restore checksum) all the files. For the object store target the number of
+requests (request) and the request rate (requestPerSec) are also reported. Wall time (time) and CPU time (cpu) are in ms.
+
+Generally speaking, the starting values should be high enough to "blow up" in terms of execution time if there are performance
+problems without taking very long if everything is running smoothly. These starting values can then be scaled up for profiling and
+stress testing as needed.
+***********************************************************************************************************************************/
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "command/backup/backup.h"
+#include "command/backup/common.h"
+#include "command/backup/protocol.h"
+#include "command/restore/protocol.h"
+#include "command/restore/restore.h"
+#include "command/stanza/create.h"
+#include "common/compress/helper.h"
+#include "common/crypto/common.h"
+#include "common/type/json.h"
+#include "postgres/interface.h"
+#include "postgres/version.h"
+#include "protocol/helper.h"
+#include "storage/helper.h"
+#include "storage/posix/storage.h"
+#include "storage/s3/storage.h"
+
+#include "common/harnessBackup.h"
+#include "common/harnessConfig.h"
+#include "common/harnessPostgres.h"
+#include "common/harnessProtocol.h"
+#include "common/harnessRestore.h"
+#include "common/harnessStorage.h"
+
+/***********************************************************************************************************************************
+Benchmark settings
+
+The cluster is made up of relation files with sizes taken from the distribution below. Each file is a multiple of the page size and
+each page is half random data and half zeroes so compression ratios are roughly 2:1. Before each incremental backup and before the
+delta restore a percentage of the files are changed by rewriting a few pages and updating the modification time.
+***********************************************************************************************************************************/
+#define TEST_BENCH_FILE_TOTAL                                       (100 * TEST_SCALE)
+#define TEST_BENCH_CHANGE_PERCENT                                   10
+#define TEST_BENCH_CHANGE_PAGE                                      2
+#define TEST_BENCH_PROCESS_MAX                                      "2"
+
+// Latency injected into each object store request
+#define TEST_BENCH_LATENCY                                          5
+
+// Objects returned per object store list request
+#define TEST_BENCH_LIST_PAGE                                        1000
+
+typedef struct TestBenchSize
+{
+    size_t size;                                                    // File size
+    unsigned int percent;                                           // Percentage of files with this size
+} TestBenchSize;
+
+static const TestBenchSize testBenchSizeList[] =
+{
+    {.size = 8 * 1024, .percent = 50},
+    {.size = 128 * 1024, .percent = 30},
+    {.size = 1024 * 1024, .percent = 15},
+    {.size = 4 * 1024 * 1024, .percent = 5},
+};
+
+/***********************************************************************************************************************************
+Object store stand-in driver
+
+Stores objects in a local path but otherwise behaves like an object store, i.e. no paths, links, or syncs. Each call to the driver
+counts as a request (list counts a request for each page of results) and sleeps for the configured latency. The request total is
+kept in shared memory so requests made by local processes are included.
+***********************************************************************************************************************************/
+#define STORAGE_TEST_PERF_OBJECT_TYPE                               STRID5("object", 0x2832a84f0)
+
+typedef struct StorageTestPerfObject
+{
+    STORAGE_COMMON_MEMBER;
+    void *posix;                                                    // Posix driver used to store the objects
+} StorageTestPerfObject;
+
+static struct
+{
+    TimeMSec latency;                                               // Latency to inject for each request
+    uint64_t *requestTotal;                                         // Total requests (in shared memory)
+} testPerfObject;
+
+static void
+storageTestPerfObjectRequest(const unsigned int requestTotal)
+{
+    __atomic_add_fetch(testPerfObject.requestTotal, requestTotal, __ATOMIC_RELAXED);
+
+    if (testPerfObject.latency != 0)
+        sleepMSec(testPerfObject.latency * requestTotal);
+}
+
+static StorageInfo
+storageTestPerfObjectInfo(THIS_VOID, const String *const file, const StorageInfoLevel level, const StorageInterfaceInfoParam param)
+{
+    THIS(StorageTestPerfObject);
+
+    storageTestPerfObjectRequest(1);
+
+    return STORAGE_COMMON_INTERFACE(this->posix).info(this->posix, file, level, param);
+}
+
+static StorageList *
+storageTestPerfObjectList(
+    THIS_VOID, const String *const path, const StorageInfoLevel level, const StorageInterfaceListParam param)
+{
+    THIS(StorageTestPerfObject);
+
+    StorageList *const result = STORAGE_COMMON_INTERFACE(this->posix).list(this->posix, path, level, param);
+
+    storageTestPerfObjectRequest(1 + (result == NULL ? 0 : storageLstSize(result) / TEST_BENCH_LIST_PAGE));
+
+    return result;
+}
+
+static StorageRead *
+storageTestPerfObjectNewRead(
+    THIS_VOID, const String *const file, const bool ignoreMissing, const StorageInterfaceNewReadParam param)
+{
+    THIS(StorageTestPerfObject);
+
+    storageTestPerfObjectRequest(1);
+
+    return STORAGE_COMMON_INTERFACE(this->posix).newRead(this->posix, file, ignoreMissing, param);
+}
+
+static StorageWrite *
+storageTestPerfObjectNewWrite(THIS_VOID, const String *const file, StorageInterfaceNewWriteParam param)
+{
+    THIS(StorageTestPerfObject);
+
+    storageTestPerfObjectRequest(1);
+
+    // Durability is the responsibility of the object store so there is nothing to sync
+    param.createPath = true;
+    param.syncFile = false;
+    param.syncPath = false;
+
+    return STORAGE_COMMON_INTERFACE(this->posix).newWrite(this->posix, file, param);
+}
+
+static bool
+storageTestPerfObjectPathRemove(
+    THIS_VOID, const String *const path, const bool recurse, const StorageInterfacePathRemoveParam param)
+{
+    THIS(StorageTestPerfObject);
+
+    storageTestPerfObjectRequest(1);
+
+    return STORAGE_COMMON_INTERFACE(this->posix).pathRemove(this->posix, path, recurse, param);
+}
+
+static void
+storageTestPerfObjectRemove(THIS_VOID, const String *const file, const StorageInterfaceRemoveParam param)
+{
+    THIS(StorageTestPerfObject);
+
+    storageTestPerfObjectRequest(1);
+
+    STORAGE_COMMON_INTERFACE(this->posix).remove(this->posix, file, param);
+}
+
+static const StorageInterface storageInterfaceTestPerfObject =
+{
+    .info = storageTestPerfObjectInfo,
+    .list = storageTestPerfObjectList,
+    .newRead = storageTestPerfObjectNewRead,
+    .newWrite = storageTestPerfObjectNewWrite,
+    .pathRemove = storageTestPerfObjectPathRemove,
+    .remove = storageTestPerfObjectRemove,
+};
+
+// Replaces the S3 helper so repo1 is stored in the stand-in when repo1-type=s3
+static Storage *
+storageTestPerfObjectHelper(const unsigned int repoIdx, const bool write, StoragePathExpressionCallback pathExpressionCallback)
+{
+    StorageTestPerfObject *driver = NULL;
+
+    OBJ_NEW_BASE_BEGIN(StorageTestPerfObject, .childQty = MEM_CONTEXT_QTY_MAX)
+    {
+        driver = OBJ_NEW_ALLOC();
+
+        *driver = (StorageTestPerfObject)
+        {
+            .interface = storageInterfaceTestPerfObject,
+            .posix = storageDriver(storagePosixNewP(FSLASH_STR, .write = write)),
+        };
+    }
+    OBJ_NEW_END();
+
+    return storageNew(
+        STORAGE_TEST_PERF_OBJECT_TYPE, cfgOptionIdxStr(cfgOptRepoPath, repoIdx), STORAGE_MODE_FILE_DEFAULT,
+        STORAGE_MODE_PATH_DEFAULT, write, 0, pathExpressionCallback, driver, driver->interface);
+}
+
+static const StorageHelper storageTestPerfObjectHelperList[] =
+{
+    {.type = STORAGE_S3_TYPE, .helper = storageTestPerfObjectHelper},
+    STORAGE_END_HELPER
+};
+
+/***********************************************************************************************************************************
+Generate pages for the synthetic cluster. The generator is seeded so the same cluster is built for each storage target.
+***********************************************************************************************************************************/
+static void
+testBenchPageFill(unsigned char *const page, uint64_t seed)
+{
+    // Seed must not be zero for xorshift
+    seed = seed * 0x9E3779B97F4A7C15 + 1;
+
+    for (size_t pageIdx = 0; pageIdx < pgPageSize8 / 2; pageIdx += sizeof(uint64_t))
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+
+        memcpy(page + pageIdx, &seed, sizeof(uint64_t));
+    }
+
+    memset(page + pgPageSize8 / 2, 0, pgPageSize8 / 2);
+}
+
+// Get the size of a file from the size distribution
+static size_t
+testBenchFileSize(const unsigned int fileIdx)
+{
+    unsigned int fileTotal = 0;
+
+    for (unsigned int sizeIdx = 0; sizeIdx < LENGTH_OF(testBenchSizeList) - 1; sizeIdx++)
+    {
+        fileTotal += TEST_BENCH_FILE_TOTAL * testBenchSizeList[sizeIdx].percent / 100;
+
+        if (fileIdx < fileTotal)
+            return testBenchSizeList[sizeIdx].size;
+    }
+
+    return testBenchSizeList[LENGTH_OF(testBenchSizeList) - 1].size;
+}
+
+static String *
+testBenchFileName(const unsigned int fileIdx)
+{
+    return strNewFmt(PG_PATH_BASE "/1/%u", 16384 + fileIdx);
+}
+
+// Build the cluster and return the total size
+static uint64_t
+testBenchClusterBuild(const time_t timeModified)
+{
+    uint64_t result = 0;
+
+    HRN_STORAGE_PATH_REMOVE(storagePgWrite(), NULL, .recurse = true);
+    HRN_PG_CONTROL_PUT(storagePgWrite(), PG_VERSION_18);
+    HRN_STORAGE_PUT_Z(storagePgWrite(), PG_FILE_PGVERSION, PG_VERSION_18_Z, .timeModified = timeModified);
+
+    for (unsigned int fileIdx = 0; fileIdx < TEST_BENCH_FILE_TOTAL; fileIdx++)
+    {
+        MEM_CONTEXT_TEMP_BEGIN()
+        {
+            const size_t size = testBenchFileSize(fileIdx);
+            Buffer *const file = bufNew(size);
+
+            for (size_t pageIdx = 0; pageIdx < size / pgPageSize8; pageIdx++)
+                testBenchPageFill(bufPtr(file) + pageIdx * pgPageSize8, (uint64_t)fileIdx << 32 | pageIdx);
+
+            bufUsedSet(file, size);
+            storagePutP(storageNewWriteP(storagePgWrite(), testBenchFileName(fileIdx), .timeModified = timeModified), file);
+
+            result += size;
+        }
+        MEM_CONTEXT_TEMP_END();
+    }
+
+    return result;
+}
+
+// Change a percentage of files in the cluster. The files and pages selected vary with each pass.
+static void
+testBenchClusterChange(const unsigned int pass, const time_t timeModified)
+{
+    for (unsigned int fileIdx = 0; fileIdx < TEST_BENCH_FILE_TOTAL; fileIdx++)
+    {
+        if ((fileIdx * 37 + pass * 11) % 100 >= TEST_BENCH_CHANGE_PERCENT)
+            continue;
+
+        MEM_CONTEXT_TEMP_BEGIN()
+        {
+            const String *const fileName = testBenchFileName(fileIdx);
+            Buffer *const file = storageGetP(storageNewReadP(storagePgWrite(), fileName));
+            const size_t pageTotal = bufUsed(file) / pgPageSize8;
+
+            for (unsigned int pageIdx = 0; pageIdx < TEST_BENCH_CHANGE_PAGE; pageIdx++)
+            {
+                const size_t pageChange = (pass * 7 + pageIdx * 13) % pageTotal;
+
+                testBenchPageFill(
+                    bufPtr(file) + pageChange * pgPageSize8, (uint64_t)pass << 56 | (uint64_t)fileIdx << 24 | pageChange);
+            }
+
+            storagePutP(storageNewWriteP(storagePgWrite(), fileName, .timeModified = timeModified), file);
+        }
+        MEM_CONTEXT_TEMP_END();
+    }
+}
+
+/***********************************************************************************************************************************
+Measure and report each phase of the benchmark
+***********************************************************************************************************************************/
+typedef struct TestBenchMark
+{
+    TimeMSec time;                                                  // Wall time at start of phase
+    TimeUSec cpu;                                                   // CPU time (including children) at start of phase
+    uint64_t request;                                               // Object store requests at start of phase
+} TestBenchMark;
+
+// CPU time used by this process and all children that have been waited on
+static TimeUSec
+testBenchCpu(long *const rssPeak)
+{
+    struct rusage usageSelf;
+    struct rusage usageChild;
+
+    THROW_ON_SYS_ERROR(getrusage(RUSAGE_SELF, &usageSelf) == -1, KernelError, "unable to get usage");
+    THROW_ON_SYS_ERROR(getrusage(RUSAGE_CHILDREN, &usageChild) == -1, KernelError, "unable to get child usage");
+
+    if (rssPeak != NULL)
+        *rssPeak = usageSelf.ru_maxrss > usageChild.ru_maxrss ? usageSelf.ru_maxrss : usageChild.ru_maxrss;
+
+    return
+        (TimeUSec)(usageSelf.ru_utime.tv_sec + usageSelf.ru_stime.tv_sec + usageChild.ru_utime.tv_sec +
+                   usageChild.ru_stime.tv_sec) * MSEC_PER_SEC * USEC_PER_MSEC +
+        (TimeUSec)(usageSelf.ru_utime.tv_usec + usageSelf.ru_stime.tv_usec + usageChild.ru_utime.tv_usec +
+                   usageChild.ru_stime.tv_usec);
+}
+
+static TestBenchMark
+testBenchBegin(void)
+{
+    return (TestBenchMark){.time = timeMSec(), .cpu = testBenchCpu(NULL), .request = *testPerfObject.requestTotal};
+}
+
+static void
+testBenchEnd(const char *const storage, const char *const phase, const uint64_t size, const TestBenchMark begin)
+{
+    // Shut down local processes and wait for them to exit so their CPU usage is counted
+    protocolFree();
+
+    while (wait(NULL) != -1)
+        continue;
+
+    // Start time at 1ms just in case something takes 0ms to run
+    const TimeMSec time = timeMSec() - begin.time + 1;
+    long rssPeak;
+    const TimeUSec cpu = testBenchCpu(&rssPeak) - begin.cpu;
+    const uint64_t request = *testPerfObject.requestTotal - begin.request;
+
+    JsonWrite *const json = jsonWriteObjectBegin(jsonWriteNewP());
+
+    jsonWriteUInt64(jsonWriteKeyZ(json, "cpu"), cpu / USEC_PER_MSEC);
+    jsonWriteJson(
+        jsonWriteKeyZ(json, "cpuPerGb"),
+        strNewFmt("%.2f", (double)cpu / (double)(MSEC_PER_SEC * USEC_PER_MSEC) / ((double)size / 1000000000)));
+    jsonWriteJson(jsonWriteKeyZ(json, "mbPerSec"), strNewFmt("%.2f", (double)size / 1000000 / ((double)time / MSEC_PER_SEC)));
+    jsonWriteZ(jsonWriteKeyZ(json, "phase"), phase);
+
+    if (testPerfObject.latency != 0)
+    {
+        jsonWriteUInt64(jsonWriteKeyZ(json, "request"), request);
+        jsonWriteJson(jsonWriteKeyZ(json, "requestPerSec"), strNewFmt("%.2f", (double)request / ((double)time / MSEC_PER_SEC)));
+    }
+
+    jsonWriteUInt64(jsonWriteKeyZ(json, "rssPeak"), (uint64_t)rssPeak);
+    jsonWriteUInt64(jsonWriteKeyZ(json, "size"), size);
+    jsonWriteZ(jsonWriteKeyZ(json, "storage"), storage);
+    jsonWriteUInt64(jsonWriteKeyZ(json, "time"), time);
+
+    TEST_LOG(strZ(jsonWriteResult(jsonWriteObjectEnd(json))));
+}
+
+/***********************************************************************************************************************************
+Run the benchmark against a storage target
+***********************************************************************************************************************************/
+static StringList *
+testBenchArgList(const bool object)
+{
+    StringList *const argList = strLstNew();
+    hrnCfgArgRawZ(argList, cfgOptStanza, "test");
+    hrnCfgArgRawZ(argList, cfgOptPgPath, TEST_PATH "/pg");
+    hrnCfgArgRawZ(argList, cfgOptRepoPath, TEST_PATH "/repo");
+
+    if (object)
+    {
+        hrnCfgArgRawStrId(argList, cfgOptRepoType, STORAGE_S3_TYPE);
+        hrnCfgArgRawZ(argList, cfgOptRepoS3Bucket, "bucket");
+        hrnCfgArgRawZ(argList, cfgOptRepoS3Endpoint, "s3.localhost");
+        hrnCfgArgRawZ(argList, cfgOptRepoS3Region, "local");
+        hrnCfgArgRawZ(argList, cfgOptRepoS3KeyType, "auto");
+    }
+
+    return argList;
+}
+
+static void
+testBenchBackup(
+    const char *const storage, const char *const phase, const uint64_t size, const bool object, const BackupType type,
+    const bool block)
+{
+    StringList *const argList = testBenchArgList(object);
+    hrnCfgArgRawStrId(argList, cfgOptType, type);
+    hrnCfgArgRawBool(argList, cfgOptOnline, false);
+    hrnCfgArgRawZ(argList, cfgOptRepoRetentionFull, "99");
+    hrnCfgArgRawZ(argList, cfgOptProcessMax, TEST_BENCH_PROCESS_MAX);
+
+    if (block)
+    {
+        hrnCfgArgRawBool(argList, cfgOptRepoBundle, true);
+        hrnCfgArgRawBool(argList, cfgOptRepoBlock, true);
+    }
+
+    HRN_CFG_LOAD(cfgCmdBackup, argList);
+
+    const TestBenchMark begin = testBenchBegin();
+
+    TEST_RESULT_VOID(hrnCmdBackup(), zNewFmt("%s backup", phase));
+
+    testBenchEnd(storage, phase, size, begin);
+}
+
+static void
+testBenchRun(const char *const storage, const bool object)
+{
+    testPerfObject.latency = object ? TEST_BENCH_LATENCY : 0;
+
+    // Files are timestamped in the past so they are not considered to be modified during the backup
+    const time_t timeBase = time(NULL) - 3600;
+
+    HRN_STORAGE_PATH_REMOVE(storagePosixNewP(TEST_PATH_STR, .write = true), "repo", .recurse = true);
+
+    // Build the cluster and create the stanza
+    StringList *argList = testBenchArgList(object);
+    hrnCfgArgRawBool(argList, cfgOptOnline, false);
+    HRN_CFG_LOAD(cfgCmdStanzaCreate, argList);
+
+    const uint64_t size = testBenchClusterBuild(timeBase);
+
+    TEST_LOG_FMT(
+        "%s: %u files, %" PRIu64 "MB, %ums latency", storage, (unsigned int)TEST_BENCH_FILE_TOTAL, size / 1000000,
+        (unsigned int)testPerfObject.latency);
+
+    TEST_RESULT_VOID(cmdStanzaCreate(), "stanza create");
+
+    // -----------------------------------------------------------------------------------------------------------------------------
+    testBenchBackup(storage, "full", size, object, backupTypeFull, false);
+
+    testBenchClusterChange(1, timeBase + 1);
+    testBenchBackup(storage, "incr", size, object, backupTypeIncr, false);
+
+    testBenchBackup(storage, "full-block", size, object, backupTypeFull, true);
+
+    testBenchClusterChange(2, timeBase + 2);
+    testBenchBackup(storage, "incr-block", size, object, backupTypeIncr, true);
+
+    // -----------------------------------------------------------------------------------------------------------------------------
+    testBenchClusterChange(3, timeBase + 3);
+
+    argList = testBenchArgList(object);
+    hrnCfgArgRawBool(argList, cfgOptDelta, true);
+    hrnCfgArgRawZ(argList, cfgOptProcessMax, TEST_BENCH_PROCESS_MAX);
+    HRN_CFG_LOAD(cfgCmdRestore, argList);
+
+    const TestBenchMark begin = testBenchBegin();
+
+    TEST_RESULT_VOID(hrnCmdRestore(), "delta restore");
+
+    testBenchEnd(storage, "restore-delta", size, begin);
+}
+
+/***********************************************************************************************************************************
+Test Run
+***********************************************************************************************************************************/
+static void
+testRun(void)
+{
+    FUNCTION_HARNESS_VOID();
+
+    // Install local command handler shim
+    static const ProtocolServerHandler testLocalHandlerList[] =
+    {
+        PROTOCOL_SERVER_HANDLER_BACKUP_LIST
+        PROTOCOL_SERVER_HANDLER_RESTORE_LIST
+    };
+
+    hrnProtocolLocalShimInstall(LSTDEF(testLocalHandlerList));
+
+    // Route repo1-type=s3 to the object store stand-in
+    storageHelperInit(storageTestPerfObjectHelperList);
+
+    // Object store requests are counted in shared memory so local processes can update the total. The memory is backed by a file
+    // since anonymous shared mappings are not available in POSIX.
+    const int fd = open(HRN_PATH "/perf-request", O_RDWR | O_CREAT | O_TRUNC, 0600);
+    THROW_ON_SYS_ERROR(fd == -1, FileOpenError, "unable to open request file");
+    THROW_ON_SYS_ERROR(ftruncate(fd, sizeof(uint64_t)) == -1, FileWriteError, "unable to size request file");
+
+    testPerfObject.requestTotal = mmap(NULL, sizeof(uint64_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    THROW_ON_SYS_ERROR(testPerfObject.requestTotal == MAP_FAILED, KernelError, "unable to map request file");
+
+    close(fd);
+
+    // Only warnings and errors are expected so any that are logged will cause the test to fail
+    harnessLogLevelSet(logLevelWarn);
+
+    // *****************************************************************************************************************************
+    if (testBegin("backup/restore posix"))
+    {
+        testBenchRun("posix", false);
+    }
+
+    // *****************************************************************************************************************************
+    if (testBegin("backup/restore object store"))
+    {
+        testBenchRun("object", true);
+    }
+
+    FUNCTION_HARNESS_RETURN_VOID();
+}
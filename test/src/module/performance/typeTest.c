@@ -34,6 +34,26 @@ testComparator(const void *item1, const void *item2)
     return LST_COMPARATOR_CMP(*(const int *)item1, *(const int *)item2);
 }
 
+/***********************************************************************************************************************************
+Comparator to sort manifest files like the backup/restore queues do
+***********************************************************************************************************************************/
+static const Manifest *testManifestFileComparatorManifest = NULL;
+
+static int
+testManifestFileComparator(const void *item1, const void *item2)
+{
+    const ManifestFileKey file1 = manifestFileUnpackKey(testManifestFileComparatorManifest, *(const ManifestFilePack *const *)item1);
+    const ManifestFileKey file2 = manifestFileUnpackKey(testManifestFileComparatorManifest, *(const ManifestFilePack *const *)item2);
+
+    if (file1.size != file2.size)
+        return LST_COMPARATOR_CMP(file1.size, file2.size);
+
+    if (file1.timestamp != file2.timestamp)
+        return LST_COMPARATOR_CMP(file1.timestamp, file2.timestamp);
+
+    return strCmp(file1.name, file2.name);
+}
+
 /***********************************************************************************************************************************
 Driver to test manifestNewBuild(). Generates files for a valid-looking PostgreSQL cluster that can be scaled to any size.
 ***********************************************************************************************************************************/
@@ -277,7 +297,8 @@ testRun(void)
         MEM_CONTEXT_END();
 
         TEST_LOG_FMT("completed in %ums", (unsigned int)(timeMSec() - timeBegin));
-        // TEST_LOG_FMT("memory used %zu", memContextSize(testContext));
+        TEST_LOG_FMT(
+            "memory used %zu (%zu per file)", memContextSize(testContext), memContextSize(testContext) / manifestFileTotal(manifest));
 
         TEST_RESULT_UINT(manifestFileTotal(manifest), driver->fileTotal, "   check file total");
 
@@ -307,10 +328,28 @@ testRun(void)
         MEM_CONTEXT_END();
 
         TEST_LOG_FMT("completed in %ums", (unsigned int)(timeMSec() - timeBegin));
-        // TEST_LOG_FMT("memory used %zu", memContextSize(testContext));
+        TEST_LOG_FMT(
+            "memory used %zu (%zu per file)", memContextSize(testContext), memContextSize(testContext) / manifestFileTotal(manifest));
 
         TEST_RESULT_UINT(manifestFileTotal(manifest), driver->fileTotal, "   check file total");
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("sort all files");
+
+        List *const fileList = lstNewP(sizeof(ManifestFilePack *), .comparator = testManifestFileComparator);
+        testManifestFileComparatorManifest = manifest;
+
+        for (unsigned int fileIdx = 0; fileIdx < manifestFileTotal(manifest); fileIdx++)
+            lstAdd(fileList, &(const ManifestFilePack *){manifestFilePackGet(manifest, fileIdx)});
+
+        timeBegin = timeMSec();
+
+        lstSort(fileList, sortOrderDesc);
+
+        TEST_LOG_FMT("completed in %ums", (unsigned int)(timeMSec() - timeBegin));
+
+        lstFree(fileList);
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("find all files");
 
@@ -52,6 +52,34 @@ testRun(void)
         TEST_RESULT_BOOL(pgDbIsSystemId(16384), false, "16384 is not system");
     }
 
+    // *****************************************************************************************************************************
+    if (testBegin("crc32cOne() and crc32cUpdate()"))
+    {
+        // Data large enough to be processed in aligned eight byte chunks with unaligned bytes before and after
+        const uint8_t *const data = (const uint8_t *)"0123456789ABCDEF0123456789ABCDEF0123456789ABCDEF";
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("hardware (when supported)");
+
+        TEST_RESULT_UINT(crc32cOne((const uint8_t *)"123456789", 9), 0xE3069283, "check value");
+        TEST_RESULT_UINT(crc32cOne(data + 1, 45), 0xBEC92EF0, "unaligned");
+        TEST_RESULT_UINT(crc32cUpdate(crc32cUpdate(0, data + 1, 13), data + 14, 32), 0xBEC92EF0, "incremental");
+        TEST_RESULT_UINT(crc32cOne(data, 0), 0, "no data");
+
+#if defined(HAVE_CRC32C_SSE42) || defined(HAVE_CRC32C_ARMV8)
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("software");
+
+        crc32cLocal.hardware = false;
+
+        TEST_RESULT_UINT(crc32cOne((const uint8_t *)"123456789", 9), 0xE3069283, "check value");
+        TEST_RESULT_UINT(crc32cOne(data + 1, 45), 0xBEC92EF0, "unaligned");
+        TEST_RESULT_UINT(crc32cUpdate(crc32cUpdate(0, data + 1, 13), data + 14, 32), 0xBEC92EF0, "incremental");
+
+        crc32cLocal.init = false;
+#endif
+    }
+
     // *****************************************************************************************************************************
     if (testBegin("pgControlVersion()"))
     {
@@ -111,7 +139,7 @@ testRun(void)
         // -------------------------------------------------------------------------------------------------------------------------
         HRN_PG_CONTROL_PUT(
             storageTest, PG_VERSION_11, .systemId = 0xFACEFACE, .checkpoint = 0xEEFFEEFFAABBAABB, .timeline = 47,
-            .walSegmentSize = 1024 * 1024);
+            .walSegmentSize = 1024 * 1024, .segmentBlockTotal = 1024);
 
         PgControl info = {0};
         TEST_ASSIGN(info, pgControlFromFile(storageTest, NULL), "get control info v11");
@@ -120,6 +148,7 @@ testRun(void)
         TEST_RESULT_UINT(info.catalogVersion, 201809051, "   check catalog version");
         TEST_RESULT_UINT(info.checkpoint, 0xEEFFEEFFAABBAABB, "check checkpoint");
         TEST_RESULT_UINT(info.timeline, 47, "check timeline");
+        TEST_RESULT_UINT(info.segmentBlockTotal, 1024, "check segment block total");
 
         // -------------------------------------------------------------------------------------------------------------------------
         HRN_PG_CONTROL_PUT(storageTest, PG_VERSION_11, .walSegmentSize = UINT_MAX); // UINT_MAX forces size to 0
@@ -0,0 +1,292 @@
+/***********************************************************************************************************************************
+Test PostgreSQL WAL Record Read
+***********************************************************************************************************************************/
+#include "common/harnessPostgres.h"
+
+/***********************************************************************************************************************************
+Render records as they are decoded
+***********************************************************************************************************************************/
+static void
+testWalRecordCallback(void *const data, const PgWalRecord *const record)
+{
+    String *const result = data;
+
+    strCatFmt(result, "%" PRIX64 " rmgr %u info %02X", record->lsn, record->resourceManagerId, record->info);
+
+    for (unsigned int blockIdx = 0; blockIdx < lstSize(record->blockList); blockIdx++)
+    {
+        const PgWalRecordBlock *const block = lstGet(record->blockList, blockIdx);
+
+        strCatFmt(
+            result, " %u/%u/%u/%u:%u", block->tablespaceId, block->dbId, block->relFileNode, block->fork, block->blockNo);
+    }
+
+    if (record->mainData != NULL)
+        strCatFmt(result, " main %zu:%02X", record->mainDataSize, record->mainData[0]);
+
+    strCatChr(result, '\n');
+}
+
+// Process WAL in small chunks to test records and headers split across calls
+static String *
+testWalRecordRead(const unsigned int pgVersion, const Buffer *const wal, const size_t offset, const size_t chunkSize)
+{
+    String *const result = strNew();
+    PgWalRecordRead *const read = pgWalRecordReadNew(pgVersion, false, testWalRecordCallback, result);
+
+    for (size_t chunkOffset = offset; chunkOffset < bufUsed(wal); chunkOffset += chunkSize)
+    {
+        const size_t size = bufUsed(wal) - chunkOffset < chunkSize ? bufUsed(wal) - chunkOffset : chunkSize;
+
+        pgWalRecordReadProcess(read, BUF(bufPtrConst(wal) + chunkOffset, size));
+    }
+
+    pgWalRecordReadFree(read);
+
+    return result;
+}
+
+/***********************************************************************************************************************************
+Test Run
+***********************************************************************************************************************************/
+static void
+testRun(void)
+{
+    FUNCTION_HARNESS_VOID();
+
+    // *****************************************************************************************************************************
+    if (testBegin("pgWalRecordReadNew() and pgWalRecordReadProcess()"))
+    {
+        const uint64_t lsn = 0x1000000;
+        const size_t pageSize = 1024;
+        const unsigned int segmentSize = 4096;
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("records across pages and segments");
+
+        HrnPgWal *wal = hrnPgWalNew(PG_VERSION_16, lsn, pageSize, segmentSize);
+
+        hrnPgWalRecordP(
+            wal, .resourceManagerId = 10, .blockList = (const PgWalRecordBlock []){{1663, 16384, 16385, 0, 5}}, .blockTotal = 1,
+            .blockDataSize = 10, .mainData = BUFSTRDEF("\001\002\003"));
+        hrnPgWalRecordP(
+            wal, .resourceManagerId = 11, .info = 0x10,
+            .blockList = (const PgWalRecordBlock []){{1663, 16384, 16385, 0, 1}, {1663, 16384, 16385, 1, 2}}, .blockTotal = 2,
+            .blockImage = true, .blockImageInfo = 0x05, .origin = true, .topXid = true);
+        hrnPgWalRecordP(
+            wal, .resourceManagerId = 10, .blockList = (const PgWalRecordBlock []){{1663, 16384, 16386, 0, 131072}},
+            .blockTotal = 1, .blockDataSize = 1500);
+        hrnPgWalRecordP(wal, .resourceManagerId = PG_WAL_RMGR_XLOG, .info = PG_WAL_XLOG_SWITCH);
+        hrnPgWalRecordP(wal, .resourceManagerId = 10, .blockList = (const PgWalRecordBlock []){{1, 2, 3, 0, 4}}, .blockTotal = 1);
+        hrnPgWalSegmentEnd(wal);
+
+        Buffer *mainData = bufNew(300);
+        memset(bufPtr(mainData), 0xAA, bufSize(mainData));
+        bufUsedSet(mainData, bufSize(mainData));
+
+        hrnPgWalRecordP(
+            wal, .resourceManagerId = PG_WAL_RMGR_SMGR, .info = PG_WAL_SMGR_CREATE,
+            .mainData = BUFSTRDEF("0123456789ABCDEF"));
+        hrnPgWalRecordP(wal, .resourceManagerId = PG_WAL_RMGR_DBASE, .mainData = mainData);
+        hrnPgWalRecordP(
+            wal, .resourceManagerId = 10, .blockList = (const PgWalRecordBlock []){{1663, 1, 2, 0, 3}}, .blockTotal = 1,
+            .blockDataSize = 4000);
+        hrnPgWalRecordP(
+            wal, .resourceManagerId = 10, .blockList = (const PgWalRecordBlock []){{1664, 0, 1262, 0, 0}}, .blockTotal = 1);
+        hrnPgWalRecordP(wal, .resourceManagerId = PG_WAL_RMGR_XLOG, .info = PG_WAL_XLOG_SWITCH);
+        hrnPgWalSegmentEnd(wal);
+
+        TEST_RESULT_UINT(bufUsed(wal->buffer), 3 * segmentSize, "three segments");
+        TEST_RESULT_STR_Z(
+            testWalRecordRead(PG_VERSION_16, wal->buffer, 0, 100),
+            "1000028 rmgr 10 info 00 1663/16384/16385/0:5 main 3:01\n"
+            "1000068 rmgr 11 info 10 1663/16384/16385/0:1 1663/16384/16385/1:2\n"
+            "10000D8 rmgr 10 info 00 1663/16384/16386/0:131072\n"
+            "10006F8 rmgr 0 info 40\n"
+            "1001028 rmgr 2 info 10 main 16:30\n"
+            "1001058 rmgr 4 info 00 main 300:AA\n"
+            "10011A8 rmgr 10 info 00 1663/1/2/0:3\n"
+            "10021E8 rmgr 10 info 00 1664/0/1262/0:0\n"
+            "1002218 rmgr 0 info 40\n",
+            "records");
+
+        TEST_RESULT_STR_Z(
+            testWalRecordRead(PG_VERSION_16, wal->buffer, 0, bufUsed(wal->buffer)),
+            "1000028 rmgr 10 info 00 1663/16384/16385/0:5 main 3:01\n"
+            "1000068 rmgr 11 info 10 1663/16384/16385/0:1 1663/16384/16385/1:2\n"
+            "10000D8 rmgr 10 info 00 1663/16384/16386/0:131072\n"
+            "10006F8 rmgr 0 info 40\n"
+            "1001028 rmgr 2 info 10 main 16:30\n"
+            "1001058 rmgr 4 info 00 main 300:AA\n"
+            "10011A8 rmgr 10 info 00 1663/1/2/0:3\n"
+            "10021E8 rmgr 10 info 00 1664/0/1262/0:0\n"
+            "1002218 rmgr 0 info 40\n",
+            "records in one buffer");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("check record CRCs");
+
+        PgWalRecordRead *read = pgWalRecordReadNew(PG_VERSION_16, true, NULL, NULL);
+        TEST_RESULT_VOID(pgWalRecordReadProcess(read, wal->buffer), "records spanning pages and segments are valid");
+
+        Buffer *walError = bufDup(wal->buffer);
+        bufPtr(walError)[segmentSize + 0x1058 - 0x1000 + 100]++;
+
+        read = pgWalRecordReadNew(PG_VERSION_16, true, NULL, NULL);
+        TEST_ERROR(
+            pgWalRecordReadProcess(read, walError), FormatError,
+            "incorrect resource manager data checksum in record at 0/1001058");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("skip record continued from before the stream");
+
+        TEST_RESULT_STR_Z(
+            testWalRecordRead(PG_VERSION_16, wal->buffer, 2 * segmentSize, 333),
+            "10021E8 rmgr 10 info 00 1664/0/1262/0:0\n"
+            "1002218 rmgr 0 info 40\n",
+            "records");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("compressed image with hole before PostgreSQL 15");
+
+        wal = hrnPgWalNew(PG_VERSION_14, lsn, pageSize, segmentSize);
+
+        hrnPgWalRecordP(
+            wal, .resourceManagerId = 10, .blockList = (const PgWalRecordBlock []){{1663, 16384, 16385, 0, 5}}, .blockTotal = 1,
+            .blockImage = true, .blockImageInfo = 0x03);
+        hrnPgWalSegmentEnd(wal);
+
+        TEST_RESULT_STR_Z(
+            testWalRecordRead(PG_VERSION_14, wal->buffer, 0, 4096), "1000028 rmgr 10 info 00 1663/16384/16385/0:5\n", "records");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("discard record that is not continued");
+
+        // Record that spans the first and second pages
+        HrnPgWal *walSpan = hrnPgWalNew(PG_VERSION_16, lsn, pageSize, segmentSize);
+        hrnPgWalRecordP(
+            walSpan, .resourceManagerId = 10, .blockList = (const PgWalRecordBlock []){{1663, 1, 2, 0, 3}}, .blockTotal = 1,
+            .blockDataSize = 2000);
+        hrnPgWalSegmentEnd(walSpan);
+
+        // Record that fills the first page followed by a record on the second page
+        wal = hrnPgWalNew(PG_VERSION_16, lsn, pageSize, segmentSize);
+        hrnPgWalRecordP(
+            wal, .resourceManagerId = 10, .blockList = (const PgWalRecordBlock []){{1663, 1, 2, 0, 3}}, .blockTotal = 1,
+            .blockDataSize = 940);
+        hrnPgWalRecordP(
+            wal, .resourceManagerId = 10, .blockList = (const PgWalRecordBlock []){{1663, 1, 2, 0, 4}}, .blockTotal = 1);
+        hrnPgWalSegmentEnd(wal);
+
+        memcpy(bufPtr(wal->buffer), bufPtrConst(walSpan->buffer), pageSize);
+
+        TEST_RESULT_STR_Z(
+            testWalRecordRead(PG_VERSION_16, wal->buffer, 0, 4096), "1000418 rmgr 10 info 00 1663/1/2/0:4\n", "records");
+
+        read = pgWalRecordReadNew(PG_VERSION_16, true, NULL, NULL);
+        TEST_ERROR(
+            pgWalRecordReadProcess(read, wal->buffer), FormatError,
+            "record at 0/1000028 is not continued in page at 0/1000400");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("discard record overwritten after a crash");
+
+        bufPtr(wal->buffer)[pageSize + 2] |= 0x08;
+
+        read = pgWalRecordReadNew(PG_VERSION_16, true, NULL, NULL);
+        TEST_ERROR(pgWalRecordReadProcess(read, wal->buffer), FormatError, "unexpected zero length record at 0/1000448");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("zeroed page");
+
+        walError = bufDup(walSpan->buffer);
+        memset(bufPtr(walError) + pageSize, 0, pageSize);
+
+        TEST_RESULT_STR_Z(testWalRecordRead(PG_VERSION_16, walError, 0, 4096), "", "no records");
+
+        read = pgWalRecordReadNew(PG_VERSION_16, true, NULL, NULL);
+        TEST_ERROR(pgWalRecordReadProcess(read, walError), FormatError, "unexpected zeroed page at 0/1000400");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("invalid continuation length");
+
+        walError = bufDup(walSpan->buffer);
+        bufPtr(walError)[pageSize + 16]++;
+
+        TEST_ERROR(
+            testWalRecordRead(PG_VERSION_16, walError, 0, 4096), FormatError,
+            "invalid continuation length 1061 in page at 0/1000400");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("invalid page headers");
+
+        TEST_ERROR(
+            testWalRecordRead(PG_VERSION_16, BUF((const uint8_t [40]){0}, 40), 0, 40), FormatError,
+            "first page header in WAL file is expected to be in long format");
+
+        walError = bufDup(walSpan->buffer);
+        bufPtr(walError)[36] = 0xFF;
+
+        TEST_ERROR(
+            testWalRecordRead(PG_VERSION_16, walError, 0, 4096), FormatError,
+            "invalid WAL page size 1279 or segment size 4096");
+
+        walError = bufDup(walSpan->buffer);
+        bufPtr(walError)[8] = 0x01;
+
+        TEST_ERROR(testWalRecordRead(PG_VERSION_16, walError, 0, 4096), FormatError, "WAL must start on a segment boundary");
+
+        walError = bufDup(walSpan->buffer);
+        bufPtr(walError)[pageSize]++;
+
+        TEST_ERROR(
+            testWalRecordRead(PG_VERSION_16, walError, 0, 4096), FormatError, "invalid magic D114 in page at 0/1000400");
+
+        walError = bufDup(walSpan->buffer);
+        bufPtr(walError)[pageSize + 9]++;
+
+        TEST_ERROR(
+            testWalRecordRead(PG_VERSION_16, walError, 0, 4096), FormatError,
+            "unexpected page address 1000500 (expected 0/1000400)");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("invalid records");
+
+        wal = hrnPgWalNew(PG_VERSION_16, lsn, pageSize, segmentSize);
+        hrnPgWalWrite(wal, (const uint8_t []){10, 0, 0, 0}, 4, 0);
+        hrnPgWalSegmentEnd(wal);
+
+        TEST_ERROR(testWalRecordRead(PG_VERSION_16, wal->buffer, 0, 4096), FormatError, "invalid length 10 in record at 0/1000028");
+
+        wal = hrnPgWalNew(PG_VERSION_16, lsn, pageSize, segmentSize);
+        hrnPgWalWrite(wal, (const uint8_t [26]){26, [24] = 0}, 26, 0);
+        hrnPgWalSegmentEnd(wal);
+
+        TEST_ERROR(
+            testWalRecordRead(PG_VERSION_16, wal->buffer, 0, 4096), FormatError, "record at 0/1000028 is too short to decode");
+
+        wal = hrnPgWalNew(PG_VERSION_16, lsn, pageSize, segmentSize);
+        hrnPgWalWrite(wal, (const uint8_t [26]){26, [24] = 100}, 26, 0);
+        hrnPgWalSegmentEnd(wal);
+
+        TEST_ERROR(
+            testWalRecordRead(PG_VERSION_16, wal->buffer, 0, 4096), FormatError, "invalid block id 100 in record at 0/1000028");
+
+        wal = hrnPgWalNew(PG_VERSION_16, lsn, pageSize, segmentSize);
+        hrnPgWalWrite(wal, (const uint8_t [28]){28, [24] = 0, [25] = 0x80}, 28, 0);
+        hrnPgWalSegmentEnd(wal);
+
+        TEST_ERROR(
+            testWalRecordRead(PG_VERSION_16, wal->buffer, 0, 4096), FormatError,
+            "block references same relation without prior in record at 0/1000028");
+
+        wal = hrnPgWalNew(PG_VERSION_16, lsn, pageSize, segmentSize);
+        hrnPgWalWrite(wal, (const uint8_t [26]){26, [24] = 255, [25] = 5}, 26, 0);
+        hrnPgWalSegmentEnd(wal);
+
+        TEST_ERROR(
+            testWalRecordRead(PG_VERSION_16, wal->buffer, 0, 4096), FormatError, "invalid data length in record at 0/1000028");
+    }
+
+    FUNCTION_HARNESS_RETURN_VOID();
+}
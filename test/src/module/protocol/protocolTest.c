@@ -15,6 +15,7 @@ Test Protocol
 #include "common/harnessFork.h"
 #include "common/harnessPack.h"
 #include "common/harnessServer.h"
+#include "common/harnessStorage.h"
 
 /***********************************************************************************************************************************
 Test protocol server command handlers
@@ -955,7 +956,7 @@ testRun(void)
             HRN_FORK_PARENT_BEGIN()
             {
                 IoServer *const tlsServer = tlsServerNew(
-                    STRDEF("127.0.0.1"), STRDEF(HRN_SERVER_CA), STRDEF(HRN_SERVER_KEY), STRDEF(HRN_SERVER_CERT), 5000);
+                    STRDEF("127.0.0.1"), STRDEF(HRN_SERVER_CA), STRDEF(HRN_SERVER_KEY), STRDEF(HRN_SERVER_CERT), 5000, false);
                 IoServer *const socketServer = sckServerNew(STRDEF("127.0.0.1"), testPort, 5000);
                 ProtocolServer *server = NULL;
 
@@ -1250,6 +1251,125 @@ testRun(void)
 
                 TEST_RESULT_VOID(protocolParallelFree(parallel), "free parallel");
 
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("adaptive process zero jobs");
+
+                TEST_ASSIGN(parallel, protocolParallelNew(2000, testParallelJobCallback, &data), "create parallel");
+                TEST_RESULT_VOID(protocolParallelClientAdd(parallel, client[0]), "add client");
+                TEST_RESULT_VOID(protocolParallelClientAdd(parallel, client[1]), "add client");
+
+                TEST_RESULT_VOID(protocolParallelClientMinSet(parallel, 2), "min equal to clients");
+                TEST_RESULT_UINT(parallel->clientMin, 0, "check not adaptive");
+
+                TEST_RESULT_VOID(protocolParallelClientMinSet(parallel, 1), "min less than clients");
+                TEST_RESULT_UINT(parallel->clientMin, 1, "check min");
+                TEST_RESULT_UINT(parallel->clientActive, 1, "check active");
+
+                // Force an adjustment check on the first process
+                parallel->adapt.time = 0;
+
+                TEST_RESULT_VOID(protocolParallelSizeCompleteSet(parallel, 0), "set size complete");
+                TEST_RESULT_INT(protocolParallelProcess(parallel), 0, "process zero jobs");
+                TEST_RESULT_UINT(parallel->adapt.time, 0, "check not adjusted when no jobs completed");
+                TEST_RESULT_UINT(protocolParallelClientActive(parallel), 1, "check active clients");
+
+                TEST_RESULT_VOID(protocolParallelSizeCompleteSet(parallel, 1000), "set size complete");
+                TEST_RESULT_INT(protocolParallelProcess(parallel), 0, "process zero jobs");
+                TEST_RESULT_BOOL(protocolParallelDone(parallel), true, "check done");
+                TEST_RESULT_BOOL(parallel->adapt.time != 0, true, "check adjusted");
+                TEST_RESULT_UINT(parallel->adapt.sizeComplete, 1000, "check size complete");
+
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("cpu idle");
+
+                parallel->adapt.cpuIdle = 0;
+                parallel->adapt.cpuTotal = 0;
+
+                TEST_RESULT_INT(protocolParallelCpuIdle(parallel, STRDEF(TEST_PATH "/missing")), -1, "missing file");
+
+                HRN_STORAGE_PUT_Z(storageTest, "stat-bogus", "bogus\n");
+                TEST_RESULT_INT(protocolParallelCpuIdle(parallel, STRDEF(TEST_PATH "/stat-bogus")), -1, "invalid file");
+
+                HRN_STORAGE_PUT_Z(storageTest, "stat", "cpu  100 0 100 800 0 0 0 0 0 0\ncpu0 100 0 100 800 0 0 0 0 0 0\n");
+                TEST_RESULT_INT(protocolParallelCpuIdle(parallel, STRDEF(TEST_PATH "/stat")), -1, "first sample");
+                TEST_RESULT_UINT(parallel->adapt.cpuTotal, 1000, "check total");
+                TEST_RESULT_UINT(parallel->adapt.cpuIdle, 800, "check idle");
+
+                TEST_RESULT_INT(protocolParallelCpuIdle(parallel, STRDEF(TEST_PATH "/stat")), -1, "no ticks elapsed");
+
+                HRN_STORAGE_PUT_Z(storageTest, "stat", "cpu  500 0 100 850 50 0 0 0\n");
+                TEST_RESULT_INT(protocolParallelCpuIdle(parallel, STRDEF(TEST_PATH "/stat")), 10, "iowait is not idle");
+
+                HRN_STORAGE_PUT_Z(storageTest, "stat", "cpu  500\n");
+                TEST_RESULT_INT(protocolParallelCpuIdle(parallel, STRDEF(TEST_PATH "/stat")), -1, "missing idle");
+
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("adapt");
+
+                parallel->clientActive = 1;
+                parallel->adapt.grow = true;
+                parallel->adapt.throughput = 0;
+
+                TEST_RESULT_UINT(protocolParallelAdapt(parallel, 100, -1), 2, "grow on first interval");
+                parallel->clientActive = 2;
+                TEST_RESULT_UINT(protocolParallelAdapt(parallel, 200, 50), 2, "max clients");
+                TEST_RESULT_BOOL(parallel->adapt.grow, false, "check no grow");
+                TEST_RESULT_UINT(protocolParallelAdapt(parallel, 400, 50), 2, "no grow after max");
+
+                parallel->adapt.grow = true;
+                TEST_RESULT_UINT(protocolParallelAdapt(parallel, 420, 50), 2, "flat throughput");
+                TEST_RESULT_BOOL(parallel->adapt.grow, false, "check no grow");
+
+                parallel->adapt.grow = true;
+                TEST_RESULT_UINT(protocolParallelAdapt(parallel, 300, 50), 1, "worse throughput");
+                TEST_RESULT_BOOL(parallel->adapt.grow, false, "check no grow");
+
+                parallel->clientActive = 1;
+                parallel->adapt.grow = true;
+                TEST_RESULT_UINT(protocolParallelAdapt(parallel, 100, 50), 1, "worse throughput at min");
+
+                parallel->clientActive = 2;
+                TEST_RESULT_UINT(protocolParallelAdapt(parallel, 100, 5), 1, "cpu saturated");
+                TEST_RESULT_BOOL(parallel->adapt.grow, true, "check grow");
+                TEST_RESULT_UINT(parallel->adapt.throughput, 0, "check throughput reset");
+
+                parallel->clientActive = 1;
+                TEST_RESULT_UINT(protocolParallelAdapt(parallel, 100, 5), 1, "cpu saturated at min");
+
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("adapt retry growth");
+
+                parallel->clientActive = 1;
+                parallel->adapt.grow = false;
+                parallel->adapt.retryInterval = 0;
+
+                for (unsigned int intervalIdx = 0; intervalIdx < PROTOCOL_PARALLEL_ADAPT_RETRY - 1; intervalIdx++)
+                    TEST_RESULT_UINT(protocolParallelAdapt(parallel, 100, 50), 1, "no growth");
+
+                TEST_RESULT_UINT(protocolParallelAdapt(parallel, 100, 50), 2, "retry growth");
+                TEST_RESULT_BOOL(parallel->adapt.grow, true, "check grow");
+                TEST_RESULT_BOOL(parallel->adapt.retry, true, "check retry");
+
+                parallel->clientActive = 2;
+                TEST_RESULT_UINT(protocolParallelAdapt(parallel, 105, 50), 1, "remove client when throughput does not improve");
+                TEST_RESULT_BOOL(parallel->adapt.grow, false, "check no grow");
+                TEST_RESULT_BOOL(parallel->adapt.retry, false, "check no retry");
+
+                parallel->clientActive = 1;
+                parallel->adapt.retryInterval = PROTOCOL_PARALLEL_ADAPT_RETRY - 1;
+                TEST_RESULT_UINT(protocolParallelAdapt(parallel, 100, 50), 2, "retry growth");
+
+                parallel->clientActive = 2;
+                TEST_RESULT_UINT(protocolParallelAdapt(parallel, 200, 50), 2, "keep client when throughput improves");
+                TEST_RESULT_BOOL(parallel->adapt.grow, false, "check no grow at max");
+
+                parallel->adapt.retryInterval = PROTOCOL_PARALLEL_ADAPT_RETRY - 1;
+                TEST_RESULT_UINT(protocolParallelAdapt(parallel, 200, 50), 2, "no retry at max");
+                TEST_RESULT_BOOL(parallel->adapt.grow, false, "check no grow");
+                TEST_RESULT_UINT(parallel->adapt.retryInterval, 0, "check retry interval reset");
+
+                TEST_RESULT_VOID(protocolParallelFree(parallel), "free parallel");
+
                 // -----------------------------------------------------------------------------------------------------------------
                 TEST_TITLE("free clients");
 
@@ -1415,6 +1535,7 @@ testRun(void)
 
         TEST_ASSIGN(client, protocolLocalGet(protocolStorageTypeRepo, 0, 1), "get local protocol");
         TEST_RESULT_PTR(protocolLocalGet(protocolStorageTypeRepo, 0, 1), client, "get local cached protocol");
+        TEST_RESULT_VOID(protocolLocalStat(), "merge local stats");
 
         TEST_RESULT_VOID(protocolFree(), "free local and remote protocol objects");
     }
@@ -32,6 +32,7 @@ typedef struct TestRequestParam
     VAR_PARAM_HEADER;
     const char *content;
     const char *blobType;
+    const char *copySource;
     const char *range;
     const char *tag;
 } TestRequestParam;
@@ -95,6 +96,10 @@ testRequest(IoWrite *write, const char *verb, const char *path, TestRequestParam
     if (param.blobType != NULL)
         strCatFmt(request, "x-ms-blob-type:%s\r\n", param.blobType);
 
+    // Add copy source
+    if (param.copySource != NULL)
+        strCatFmt(request, "x-ms-copy-source:%s\r\n", param.copySource);
+
     // Add tags
     if (param.tag != NULL)
         strCatFmt(request, "x-ms-tags:%s\r\n", param.tag);
@@ -658,7 +663,7 @@ testRun(void)
                 TEST_RESULT_BOOL(storageWriteSyncPath(write), true, "path is synced");
                 TEST_RESULT_BOOL(storageWriteTruncate(write), true, "file will be truncated");
 
-                TEST_RESULT_VOID(storageWriteAzureClose(ioWriteDriver(storageWriteIo(write))), "close file again");
+                TEST_RESULT_VOID(storageWriteAzureClose(write->driver), "close file again");
 
                 // -----------------------------------------------------------------------------------------------------------------
                 TEST_TITLE("write zero-length file");
@@ -732,13 +737,13 @@ testRun(void)
                 ioWrite(storageWriteIo(write), BUFSTRDEF("123456789012345678"));
 
                 TEST_RESULT_VOID(
-                    bufResize(((StorageWriteAzure *)ioWriteDriver(storageWriteIo(write)))->blockBuffer, 17),
+                    bufResize(((StorageWriteAzure *)write->driver)->blockBuffer, 17),
                     "resize part buffer to 17");
 
                 ioWrite(storageWriteIo(write), BUFSTRDEF("90"));
 
                 TEST_RESULT_UINT(
-                    ((StorageWriteAzure *)ioWriteDriver(storageWriteIo(write)))->blockSize, 16,
+                    ((StorageWriteAzure *)write->driver)->blockSize, 16,
                     "part buffer reset to 16 (default)");
 
                 ioWriteClose(storageWriteIo(write));
@@ -960,6 +965,50 @@ testRun(void)
                     "test3.txt\n",
                     .level = storageInfoLevelExists, .noRecurse = true, .expression = "^test(1|3)");
 
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("copy file on server");
+
+                const char *const copySource = zNewFmt(
+                    "https://%s:%u/" TEST_ACCOUNT "/" TEST_CONTAINER "/path/file.txt", strZ(hrnServerHost()), testPort);
+
+                testRequestP(service, HTTP_VERB_PUT, "/path/copy.txt", .copySource = copySource);
+                testResponseP(service, .code = 202, .header = "x-ms-copy-status:pending");
+                testRequestP(service, HTTP_VERB_HEAD, "/path/copy.txt");
+                testResponseP(service, .header = "content-length:5\r\nx-ms-copy-status:success");
+
+                TEST_RESULT_BOOL(
+                    storageCopyP(
+                        storageNewReadP(storage, STRDEF("/path/file.txt")), storageNewWriteP(storage, STRDEF("/path/copy.txt")),
+                        .storage = storage),
+                    true, "copy");
+
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("copy file on server fails");
+
+                testRequestP(service, HTTP_VERB_PUT, "/path/copy.txt", .copySource = copySource);
+                testResponseP(
+                    service, .code = 202, .header = "x-ms-copy-status:failed\r\nx-ms-copy-status-description:500 InternalError");
+
+                TEST_ERROR(
+                    storageCopyP(
+                        storageNewReadP(storage, STRDEF("/path/file.txt")), storageNewWriteP(storage, STRDEF("/path/copy.txt")),
+                        .storage = storage),
+                    FileWriteError, "unable to copy '/path/file.txt' to '/path/copy.txt': status 'failed' (500 InternalError)");
+
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("copy file on server times out");
+
+                driver->timeout = 0;
+
+                testRequestP(service, HTTP_VERB_PUT, "/path/copy.txt", .copySource = copySource);
+                testResponseP(service, .code = 202, .header = "x-ms-copy-status:pending");
+
+                TEST_ERROR(
+                    storageCopyP(
+                        storageNewReadP(storage, STRDEF("/path/file.txt")), storageNewWriteP(storage, STRDEF("/path/copy.txt")),
+                        .storage = storage),
+                    FileWriteError, "timeout copying '/path/file.txt' to '/path/copy.txt'");
+
                 // -----------------------------------------------------------------------------------------------------------------
                 TEST_TITLE("switch to SAS auth");
 
@@ -1090,6 +1139,53 @@ testRun(void)
 
                 TEST_RESULT_VOID(storagePathRemoveP(storage, STRDEF("/path"), .recurse = true), "remove");
 
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("copy file on server with SAS on the source");
+
+                testRequestP(
+                    service, HTTP_VERB_PUT, "/path/copy.txt",
+                    .copySource = zNewFmt(
+                        "https://%s:%u/" TEST_ACCOUNT "/" TEST_CONTAINER "/path/file.txt?sig=key", strZ(hrnServerHost()), testPort),
+                    .tag = "%20Key%202=%20Value%202&Key1=Value1");
+                testResponseP(service, .code = 202, .header = "x-ms-copy-status:success");
+
+                TEST_RESULT_BOOL(
+                    storageCopyP(
+                        storageNewReadP(storage, STRDEF("/path/file.txt")), storageNewWriteP(storage, STRDEF("/path/copy.txt")),
+                        .storage = storage),
+                    true, "copy");
+
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("copy missing file");
+
+                testRequestP(
+                    service, HTTP_VERB_PUT, "/path/copy.txt",
+                    .copySource = zNewFmt(
+                        "https://%s:%u/" TEST_ACCOUNT "/" TEST_CONTAINER "/path/missing.txt?sig=key", strZ(hrnServerHost()),
+                        testPort),
+                    .tag = "%20Key%202=%20Value%202&Key1=Value1");
+                testResponseP(service, .code = 404);
+
+                TEST_ERROR(
+                    storageCopyP(
+                        storageNewReadP(storage, STRDEF("/path/missing.txt")), storageNewWriteP(storage, STRDEF("/path/copy.txt")),
+                        .storage = storage),
+                    FileMissingError, "unable to open missing file '/path/missing.txt' for read");
+
+                testRequestP(
+                    service, HTTP_VERB_PUT, "/path/copy.txt",
+                    .copySource = zNewFmt(
+                        "https://%s:%u/" TEST_ACCOUNT "/" TEST_CONTAINER "/path/missing.txt?sig=key", strZ(hrnServerHost()),
+                        testPort),
+                    .tag = "%20Key%202=%20Value%202&Key1=Value1");
+                testResponseP(service, .code = 404);
+
+                TEST_RESULT_BOOL(
+                    storageCopyP(
+                        storageNewReadP(storage, STRDEF("/path/missing.txt"), .ignoreMissing = true),
+                        storageNewWriteP(storage, STRDEF("/path/copy.txt")), .storage = storage),
+                    false, "copy ignore missing");
+
                 // -----------------------------------------------------------------------------------------------------------------
                 TEST_TITLE("switch to time limited");
 
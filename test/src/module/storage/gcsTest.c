@@ -614,7 +614,7 @@ testRun(void)
                 TEST_RESULT_BOOL(storageWriteSyncPath(write), true, "path is synced");
                 TEST_RESULT_BOOL(storageWriteTruncate(write), true, "file will be truncated");
 
-                TEST_RESULT_VOID(storageWriteGcsClose(ioWriteDriver(storageWriteIo(write))), "close file again");
+                TEST_RESULT_VOID(storageWriteGcsClose(write->driver), "close file again");
 
                 // -----------------------------------------------------------------------------------------------------------------
                 TEST_TITLE("write zero-length file");
@@ -734,13 +734,13 @@ testRun(void)
                 ioWrite(storageWriteIo(write), BUFSTRDEF("123456789012345678"));
 
                 TEST_RESULT_VOID(
-                    bufResize(((StorageWriteGcs *)ioWriteDriver(storageWriteIo(write)))->chunkBuffer, 17),
+                    bufResize(((StorageWriteGcs *)write->driver)->chunkBuffer, 17),
                     "resize part buffer to 17");
 
                 ioWrite(storageWriteIo(write), BUFSTRDEF("90"));
 
                 TEST_RESULT_UINT(
-                    ((StorageWriteGcs *)ioWriteDriver(storageWriteIo(write)))->chunkSize, 16, "part buffer reset to 16 (default)");
+                    ((StorageWriteGcs *)write->driver)->chunkSize, 16, "part buffer reset to 16 (default)");
 
                 ioWriteClose(storageWriteIo(write));
                 ioBufferSizeSet(ioBufferSizeDefault);
@@ -1176,6 +1176,96 @@ testRun(void)
 
                 TEST_RESULT_VOID(storagePathRemoveP(storage, STRDEF("/path"), .recurse = true), "remove");
 
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("remove list");
+
+                testRequestP(
+                    service, HTTP_VERB_POST, .path = "/batch/storage/v1", .multiPart = true,
+                    .content =
+                        "\r\n--" HTTP_MULTIPART_BOUNDARY_INIT "\r\n"
+                        "content-type:application/http\r\n"
+                        "content-transfer-encoding:binary\r\n"
+                        "content-id:0\r\n"
+                        "\r\n"
+                        "DELETE /storage/v1/b/bucket/o/path%2Ftest1.txt HTTP/1.1\r\n"
+                        "content-length:0\r\n"
+                        "\r\n"
+                        "\r\n--" HTTP_MULTIPART_BOUNDARY_INIT "\r\n"
+                        "content-type:application/http\r\n"
+                        "content-transfer-encoding:binary\r\n"
+                        "content-id:1\r\n"
+                        "\r\n"
+                        "DELETE /storage/v1/b/bucket/o/path%2Fsub%2Ftest2.txt HTTP/1.1\r\n"
+                        "content-length:0\r\n"
+                        "\r\n"
+                        "\r\n--" HTTP_MULTIPART_BOUNDARY_INIT "--\r\n");
+                testResponseP(
+                    service, .multiPart = true,
+                    .content =
+                        "\r\n--" HTTP_MULTIPART_BOUNDARY_INIT "\r\n"
+                        "content-type:application/http\r\n"
+                        "content-id:response-0\r\n"
+                        "\r\n"
+                        "HTTP/1.1 204 OK\r\n\r\n"
+                        "\r\n--" HTTP_MULTIPART_BOUNDARY_INIT "\r\n"
+                        "content-type:application/http\r\n"
+                        "content-id:response-1\r\n"
+                        "\r\n"
+                        "HTTP/1.1 404 OK\r\n\r\n"
+                        "\r\n--" HTTP_MULTIPART_BOUNDARY_INIT "--\r\n");
+
+                StringList *const fileList = strLstNew();
+                strLstAddZ(fileList, "test1.txt");
+                strLstAddZ(fileList, "sub/test2.txt");
+
+                TEST_RESULT_VOID(storageRemoveListP(storage, STRDEF("/path"), fileList), "remove list");
+
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("copy file on server");
+
+                testRequestP(
+                    service, HTTP_VERB_POST, .path = "/storage/v1/b/bucket/o/path%2Ffile.txt/rewriteTo/b/bucket/o/path%2Fcopy.txt",
+                    .query = "fields=done%2CrewriteToken");
+                testResponseP(service, .content = "{\"done\":false,\"rewriteToken\":\"TOKEN1\"}");
+
+                testRequestP(
+                    service, HTTP_VERB_POST, .path = "/storage/v1/b/bucket/o/path%2Ffile.txt/rewriteTo/b/bucket/o/path%2Fcopy.txt",
+                    .query = "fields=done%2CrewriteToken&rewriteToken=TOKEN1");
+                testResponseP(service, .content = "{\"done\":true}");
+
+                TEST_RESULT_BOOL(
+                    storageCopyP(
+                        storageNewReadP(storage, STRDEF("/path/file.txt")), storageNewWriteP(storage, STRDEF("/path/copy.txt")),
+                        .storage = storage),
+                    true, "copy");
+
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("copy missing file");
+
+                testRequestP(
+                    service, HTTP_VERB_POST,
+                    .path = "/storage/v1/b/bucket/o/path%2Fmissing.txt/rewriteTo/b/bucket/o/path%2Fcopy.txt",
+                    .query = "fields=done%2CrewriteToken");
+                testResponseP(service, .code = 404);
+
+                TEST_ERROR(
+                    storageCopyP(
+                        storageNewReadP(storage, STRDEF("/path/missing.txt")), storageNewWriteP(storage, STRDEF("/path/copy.txt")),
+                        .storage = storage),
+                    FileMissingError, "unable to open missing file '/path/missing.txt' for read");
+
+                testRequestP(
+                    service, HTTP_VERB_POST,
+                    .path = "/storage/v1/b/bucket/o/path%2Fmissing.txt/rewriteTo/b/bucket/o/path%2Fcopy.txt",
+                    .query = "fields=done%2CrewriteToken");
+                testResponseP(service, .code = 404);
+
+                TEST_RESULT_BOOL(
+                    storageCopyP(
+                        storageNewReadP(storage, STRDEF("/path/missing.txt"), .ignoreMissing = true),
+                        storageNewWriteP(storage, STRDEF("/path/copy.txt")), .storage = storage),
+                    false, "copy ignore missing");
+
                 // -----------------------------------------------------------------------------------------------------------------
                 TEST_TITLE("switch to user project");
 
@@ -1,6 +1,7 @@
 /***********************************************************************************************************************************
 Test Posix/CIFS Storage
 ***********************************************************************************************************************************/
+#include "common/io/filter/size.h"
 #include "common/io/io.h"
 #include "common/time.h"
 #include "storage/read.h"
@@ -32,6 +33,51 @@ storageTestPathExpression(const String *expression, const String *path)
     return result;
 }
 
+/***********************************************************************************************************************************
+Get multiple lists one at a time to test parallel iteration
+***********************************************************************************************************************************/
+static unsigned int storageTestListMultiTotal = 0;
+
+static List *
+storageTestListMulti(
+    void *const driver, const StringList *const pathList, const StorageInfoLevel level, const StorageInterfaceListParam param)
+{
+    List *const result = lstNewP(sizeof(StorageList *));
+
+    MEM_CONTEXT_BEGIN(lstMemContext(result))
+    {
+        for (unsigned int pathIdx = 0; pathIdx < strLstSize(pathList); pathIdx++)
+        {
+            StorageList *const list = storageInterfaceListP(
+                driver, strLstGet(pathList, pathIdx), level, .expression = param.expression, .targetTime = param.targetTime);
+
+            lstAdd(result, &list);
+        }
+    }
+    MEM_CONTEXT_END();
+
+    storageTestListMultiTotal++;
+
+    return result;
+}
+
+/***********************************************************************************************************************************
+Copy a file in the driver to test driver copies
+***********************************************************************************************************************************/
+static unsigned int storageTestCopyTotal = 0;
+
+static bool
+storageTestCopy(
+    void *const driver, StorageRead *const source, StorageWrite *const destination, const StorageInterfaceCopyParam param)
+{
+    (void)driver;
+    (void)param;
+
+    storageTestCopyTotal++;
+
+    return storageCopyP(source, destination);
+}
+
 /***********************************************************************************************************************************
 Macro to create a path and file that cannot be accessed
 ***********************************************************************************************************************************/
@@ -519,6 +565,46 @@ testRun(void)
             storageTest, "pg",
             "path/file {s=8, t=1656434296}\n",
             .level = storageInfoLevelBasic, .expression = "\\/file$");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("path - recurse in parallel");
+
+        ((StoragePosix *)storageDriver(storageTest))->interface.listMulti = storageTestListMulti;
+
+        storagePathCreateP(storageTest, STRDEF("pg/zzz/yyy/xxx"), .mode = 0700);
+        storagePathCreateP(storageTest, STRDEF("pg/zzz/yyy/www"), .mode = 0700);
+
+        TEST_STORAGE_LIST(
+            storageTest, "pg",
+            "empty/\n"
+            "file\n"
+            "link>\n"
+            "path/\n"
+            "path/file\n"
+            "pipe*\n"
+            "zzz/\n"
+            "zzz/yyy/\n"
+            "zzz/yyy/www/\n"
+            "zzz/yyy/xxx/\n",
+            .parallel = 2);
+        TEST_RESULT_UINT(storageTestListMultiTotal, 4, "list multi total");
+
+        TEST_STORAGE_LIST(
+            storageTest, "pg",
+            "zzz/yyy/xxx/\n"
+            "zzz/yyy/www/\n"
+            "zzz/yyy/\n"
+            "zzz/\n"
+            "pipe*\n"
+            "path/file\n"
+            "path/\n"
+            "link>\n"
+            "file\n"
+            "empty/\n",
+            .sortOrder = sortOrderDesc, .parallel = 3);
+        TEST_RESULT_UINT(storageTestListMultiTotal, 7, "list multi total");
+
+        ((StoragePosix *)storageDriver(storageTest))->interface.listMulti = NULL;
     }
 
     // *****************************************************************************************************************************
@@ -567,6 +653,40 @@ testRun(void)
         TEST_RESULT_VOID(
             storagePutP(storageNewWriteP(storageTest, STRDEF("bbb.txt")), BUFSTRDEF("bbb")), "write bbb.text");
         TEST_RESULT_STRLST_Z(storageListP(storageTest, NULL, .expression = STRDEF("^bbb")), "bbb.txt\n", "dir list");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("list multi - one at a time");
+
+        HRN_STORAGE_PUT_EMPTY(storageTest, "multi/ccc.txt");
+        HRN_STORAGE_PUT_EMPTY(storageTest, "multi/ddd.txt");
+
+        StringList *const pathList = strLstNew();
+        strLstAddZ(pathList, "multi");
+        strLstAddZ(pathList, BOGUS_STR);
+        const List *listMulti = NULL;
+
+        TEST_ASSIGN(listMulti, storageListMultiP(storageTest, pathList, .expression = STRDEF("^ccc")), "list multi");
+        TEST_RESULT_UINT(lstSize(listMulti), 2, "list total");
+        TEST_RESULT_STRLST_Z(*(StringList **)lstGet(listMulti, 0), "ccc.txt\n", "filtered list");
+        TEST_RESULT_UINT(strLstSize(*(StringList **)lstGet(listMulti, 1)), 0, "empty list for missing dir");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("list multi - concurrent");
+
+        ((StoragePosix *)storageDriver(storageTest))->interface.listMulti = storageTestListMulti;
+        storageTestListMultiTotal = 0;
+
+        TEST_ASSIGN(listMulti, storageListMultiP(storageTest, pathList, .expression = STRDEF("^ccc")), "list multi");
+        TEST_RESULT_UINT(lstSize(listMulti), 2, "list total");
+        TEST_RESULT_STRLST_Z(*(StringList **)lstGet(listMulti, 0), "ccc.txt\n", "filtered list");
+        TEST_RESULT_UINT(strLstSize(*(StringList **)lstGet(listMulti, 1)), 0, "empty list for missing dir");
+
+        TEST_ASSIGN(listMulti, storageListMultiP(storageTest, pathList), "list multi without expression");
+        TEST_RESULT_STRLST_Z(strLstSort(*(StringList **)lstGet(listMulti, 0), sortOrderAsc), "ccc.txt\nddd.txt\n", "list");
+        TEST_RESULT_UINT(storageTestListMultiTotal, 2, "list multi total");
+
+        ((StoragePosix *)storageDriver(storageTest))->interface.listMulti = NULL;
+        HRN_STORAGE_PATH_REMOVE(storageTest, "multi", .recurse = true);
     }
 
     // *****************************************************************************************************************************
@@ -601,6 +721,65 @@ testRun(void)
         TEST_RESULT_BOOL(storageCopyP(source, destination), true, "copy file");
         TEST_RESULT_BOOL(bufEq(expectedBuffer, storageGetP(storageNewReadP(storageTest, destinationFile))), true, "check file");
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("copy - storage without copy support reads and writes the file");
+
+        TEST_RESULT_BOOL(storageCopyServer(storageTest), false, "no copy support");
+
+        source = storageNewReadP(storageTest, sourceFile);
+        destination = storageNewWriteP(storageTest, destinationFile);
+
+        TEST_RESULT_BOOL(storageCopyP(source, destination, .storage = storageTest), true, "copy file");
+        TEST_RESULT_BOOL(bufEq(expectedBuffer, storageGetP(storageNewReadP(storageTest, destinationFile))), true, "check file");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("copy - storage with copy support");
+
+        Storage *const storageHook = storagePosixNewP(TEST_PATH_STR, .write = true);
+        ((StoragePosix *)storageDriver(storageHook))->interface.copy = storageTestCopy;
+        storageHook->pub.interface.copy = storageTestCopy;
+
+        TEST_RESULT_BOOL(storageCopyServer(storageHook), true, "copy support");
+
+        TEST_RESULT_BOOL(
+            storageCopyP(
+                storageNewReadP(storageHook, sourceFile), storageNewWriteP(storageHook, destinationFile), .storage = storageHook),
+            true, "copy file");
+        TEST_RESULT_UINT(storageTestCopyTotal, 1, "copied by driver");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("copy - storage with copy support reads and writes the file when required");
+
+        source = storageNewReadP(storageHook, sourceFile, .offset = 1);
+        TEST_RESULT_BOOL(
+            storageCopyP(source, storageNewWriteP(storageHook, destinationFile), .storage = storageHook), true, "offset");
+
+        source = storageNewReadP(storageHook, sourceFile, .limit = VARUINT64(1));
+        TEST_RESULT_BOOL(
+            storageCopyP(source, storageNewWriteP(storageHook, destinationFile), .storage = storageHook), true, "limit");
+
+        source = storageNewReadP(storageHook, sourceFile);
+        ioFilterGroupAdd(ioReadFilterGroup(storageReadIo(source)), ioSizeNew());
+        TEST_RESULT_BOOL(
+            storageCopyP(source, storageNewWriteP(storageHook, destinationFile), .storage = storageHook), true, "read filter");
+
+        destination = storageNewWriteP(storageHook, destinationFile);
+        ioFilterGroupAdd(ioWriteFilterGroup(storageWriteIo(destination)), ioSizeNew());
+        TEST_RESULT_BOOL(
+            storageCopyP(storageNewReadP(storageHook, sourceFile), destination, .storage = storageHook), true, "write filter");
+
+        TEST_RESULT_BOOL(
+            storageCopyP(
+                storageNewReadP(storageTest, sourceFile), storageNewWriteP(storageHook, destinationFile), .storage = storageHook),
+            true, "source from other storage of the same type");
+        TEST_RESULT_BOOL(
+            storageCopyP(
+                storageNewReadP(storageHook, sourceFile), storageNewWriteP(storageTest, destinationFile), .storage = storageHook),
+            true, "destination from other storage of the same type");
+
+        TEST_RESULT_UINT(storageTestCopyTotal, 1, "not copied by driver");
+        TEST_RESULT_BOOL(bufEq(expectedBuffer, storageGetP(storageNewReadP(storageTest, destinationFile))), true, "check file");
+
         storageRemoveP(storageTest, sourceFile, .errorOnMissing = true);
         storageRemoveP(storageTest, destinationFile, .errorOnMissing = true);
     }
@@ -883,6 +1062,12 @@ testRun(void)
 
         TEST_RESULT_VOID(storagePathCreateP(storageTest, pathName), "create path to sync");
         TEST_RESULT_VOID(storagePathSyncP(storageTest, pathName), "sync path");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("file system sync");
+
+        TEST_RESULT_BOOL(storageFeature(storageTest, storageFeatureFileSystemSync), true, "file system sync feature");
+        TEST_RESULT_VOID(storagePathSyncP(storageTest, pathName, .fileSystem = true), "sync file system");
     }
 
     // *****************************************************************************************************************************
@@ -995,7 +1180,7 @@ testRun(void)
             "new write file (defaults)");
         TEST_RESULT_VOID(ioWriteOpen(storageWriteIo(file)), "open file");
         TEST_RESULT_INT(
-            ioWriteFd(storageWriteIo(file)), ((StorageWritePosix *)ioWriteDriver(storageWriteIo(file)))->fd, "check write fd");
+            ioWriteFd(storageWriteIo(file)), ((StorageWritePosix *)file->driver)->fd, "check write fd");
         TEST_RESULT_VOID(ioWriteClose(storageWriteIo(file)), "close file");
         TEST_RESULT_INT(storageInfoP(storageTest, strPath(fileName)).mode, 0750, "check path mode");
         TEST_RESULT_INT(storageInfoP(storageTest, fileName).mode, 0640, "check file mode");
@@ -1042,7 +1227,7 @@ testRun(void)
             "new write file (set mode)");
         TEST_RESULT_VOID(ioWriteOpen(storageWriteIo(file)), "open file");
         TEST_RESULT_VOID(ioWriteClose(storageWriteIo(file)), "close file");
-        TEST_RESULT_VOID(storageWritePosixClose(ioWriteDriver(storageWriteIo(file))), "close file again");
+        TEST_RESULT_VOID(storageWritePosixClose(file->driver), "close file again");
         TEST_RESULT_INT(storageInfoP(storageTest, strPath(fileName)).mode, 0700, "check path mode");
         TEST_RESULT_INT(storageInfoP(storageTest, fileName).mode, 0600, "check file mode");
     }
@@ -1170,6 +1355,31 @@ testRun(void)
 
         TEST_RESULT_VOID(storageRemoveP(storageTest, fileExists), "remove exists file");
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("remove list");
+
+        HRN_STORAGE_PUT_EMPTY(storageTest, "list/1");
+        HRN_STORAGE_PUT_EMPTY(storageTest, "list/sub/2");
+        HRN_STORAGE_PUT_EMPTY(storageTest, "list/3");
+
+        TEST_RESULT_VOID(storageRemoveListP(storageTest, STRDEF("list"), strLstNew()), "remove empty list");
+
+        StringList *fileList = strLstNew();
+        strLstAddZ(fileList, "1");
+        strLstAddZ(fileList, "missing");
+        strLstAddZ(fileList, "sub/2");
+
+        TEST_RESULT_VOID(storageRemoveListP(storageTest, STRDEF("list"), fileList), "remove list");
+        TEST_STORAGE_LIST(storageTest, "list", "3\nsub/\n", .comment = "check files");
+
+        const Storage *const storageRoot = storagePosixNewP(FSLASH_STR, .write = true);
+
+        fileList = strLstNew();
+        strLstAddFmt(fileList, "%s/list/3", strZ(strSub(TEST_PATH_STR, 1)));
+
+        TEST_RESULT_VOID(storageRemoveListP(storageRoot, FSLASH_STR, fileList), "remove list from root");
+        TEST_STORAGE_LIST(storageTest, "list", "sub/\n", .comment = "check files", .remove = true);
+
 #ifdef TEST_CONTAINER_REQUIRED
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("remove - permission denied");
@@ -1348,25 +1558,25 @@ testRun(void)
         TEST_RESULT_VOID(ioWriteOpen(storageWriteIo(file)), "open file");
 
         // Close the file descriptor so operations will fail
-        close(((StorageWritePosix *)ioWriteDriver(storageWriteIo(file)))->fd);
+        close(((StorageWritePosix *)file->driver)->fd);
         storageRemoveP(storageTest, fileTmp, .errorOnMissing = true);
 
         TEST_ERROR_FMT(
-            storageWritePosix(ioWriteDriver(storageWriteIo(file)), buffer), FileWriteError,
+            storageWritePosix(file->driver, buffer), FileWriteError,
             "unable to write '%s.pgbackrest.tmp': [9] Bad file descriptor", strZ(fileName));
         TEST_ERROR_FMT(
-            storageWritePosixClose(ioWriteDriver(storageWriteIo(file))), FileSyncError,
+            storageWritePosixClose(file->driver), FileSyncError,
             STORAGE_ERROR_WRITE_SYNC ": [9] Bad file descriptor", strZ(fileTmp));
 
         // Disable file sync so close() can be reached
-        ((StorageWritePosix *)ioWriteDriver(storageWriteIo(file)))->interface.syncFile = false;
+        ((StorageWritePosix *)file->driver)->interface.syncFile = false;
 
         TEST_ERROR_FMT(
-            storageWritePosixClose(ioWriteDriver(storageWriteIo(file))), FileCloseError,
+            storageWritePosixClose(file->driver), FileCloseError,
             STORAGE_ERROR_WRITE_CLOSE ": [9] Bad file descriptor", strZ(fileTmp));
 
         // Set file descriptor to -1 so the close on free with not fail
-        ((StorageWritePosix *)ioWriteDriver(storageWriteIo(file)))->fd = -1;
+        ((StorageWritePosix *)file->driver)->fd = -1;
 
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("fail rename in close");
@@ -1383,7 +1593,7 @@ testRun(void)
             strZ(fileTmp), strZ(fileName));
 
         // Set file descriptor to -1 so the close on free with not fail
-        ((StorageWritePosix *)ioWriteDriver(storageWriteIo(file)))->fd = -1;
+        ((StorageWritePosix *)file->driver)->fd = -1;
 
         storageRemoveP(storageTest, fileName, .errorOnMissing = true);
 
@@ -1450,6 +1660,61 @@ testRun(void)
         TEST_STORAGE_GET(storageTest, "no-truncate", "ABC");
         TEST_RESULT_UINT(storageInfoP(storageTest, STRDEF("no-truncate")).mode, 0600, "check mode");
         TEST_RESULT_INT(storageInfoP(storageTest, STRDEF("no-truncate")).timeModified, 77777, "check time");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("sync defer");
+
+        TEST_ASSIGN(
+            file, storageNewWriteP(storageTest, STRDEF("sync-defer"), .noAtomic = true, .syncDefer = true), "new write file");
+        TEST_RESULT_VOID(ioWriteOpen(storageWriteIo(file)), "open file");
+        TEST_RESULT_VOID(ioWrite(storageWriteIo(file), BUFSTRDEF("DEFER")), "write to file");
+        TEST_RESULT_VOID(ioWriteClose(storageWriteIo(file)), "close file");
+
+        TEST_STORAGE_GET(storageTest, "sync-defer", "DEFER", .remove = true);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("preallocate");
+
+        TEST_ASSIGN(
+            file, storageNewWriteP(storageTest, STRDEF("preallocate"), .noAtomic = true, .preallocate = 3), "new write file");
+        TEST_RESULT_VOID(ioWriteOpen(storageWriteIo(file)), "open file");
+        TEST_RESULT_VOID(ioWrite(storageWriteIo(file), BUFSTRDEF("ABC")), "write to file");
+        TEST_RESULT_VOID(ioWriteClose(storageWriteIo(file)), "close file");
+
+        TEST_STORAGE_GET(storageTest, "preallocate", "ABC", .remove = true);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("preallocate and skip zero blocks");
+
+        TEST_ASSIGN(
+            file, storageNewWriteP(storageTest, STRDEF("sparse"), .noAtomic = true, .preallocate = 64, .sparseSize = 4),
+            "new write file");
+        TEST_RESULT_VOID(ioWriteOpen(storageWriteIo(file)), "open file");
+
+        // Write a data block followed by a skipped zero block
+        TEST_RESULT_VOID(ioWrite(storageWriteIo(file), BUF("ABCD\0\0\0\0", 8)), "write data and zero block");
+        TEST_RESULT_VOID(ioWriteFlush(storageWriteIo(file)), "flush");
+
+        // Write a partial zero block, which is written after seeking past the skipped block
+        TEST_RESULT_VOID(ioWrite(storageWriteIo(file), BUF("\0\0", 2)), "write partial zero block");
+        TEST_RESULT_VOID(ioWriteFlush(storageWriteIo(file)), "flush");
+
+        // Complete the partial block, skip a zero block, and write data
+        TEST_RESULT_VOID(ioWrite(storageWriteIo(file), BUF("\0\0\0\0\0\0EF", 8)), "write zero block and data");
+        TEST_RESULT_VOID(ioWriteFlush(storageWriteIo(file)), "flush");
+
+        // End with a skipped zero block
+        TEST_RESULT_VOID(ioWrite(storageWriteIo(file), BUF("\0\0\0\0\0\0", 6)), "write trailing zero block");
+        TEST_RESULT_VOID(ioWriteClose(storageWriteIo(file)), "close file");
+
+        TEST_RESULT_BOOL(
+            bufEq(
+                storageGetP(storageNewReadP(storageTest, STRDEF("sparse"))),
+                BUF("ABCD\0\0\0\0\0\0\0\0\0\0\0\0EF\0\0\0\0\0\0", 24)),
+            true, "check file");
+        TEST_RESULT_UINT(storageInfoP(storageTest, STRDEF("sparse")).size, 24, "check size");
+
+        HRN_STORAGE_REMOVE(storageTest, "sparse");
     }
 
     // *****************************************************************************************************************************
@@ -1706,6 +1971,7 @@ testRun(void)
         TEST_ASSIGN(storage, storageRepoGet(0, true), "get cifs repo storage");
         TEST_RESULT_UINT(storageType(storage), STORAGE_CIFS_TYPE, "check storage type");
         TEST_RESULT_BOOL(storageFeature(storage, storageFeaturePath), true, "check path feature");
+        TEST_RESULT_BOOL(storageFeature(storage, storageFeatureFileSystemSync), false, "check file system sync feature");
 
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("write object path sync false");
@@ -76,6 +76,7 @@ typedef struct TestRequestParam
     const char *accessKey;
     const char *securityToken;
     const char *range;
+    const char *copySource;
     const char *kms;
     const char *sseC;
     const char *ttl;
@@ -124,7 +125,23 @@ testRequest(IoWrite *write, Storage *s3, const char *verb, const char *path, Tes
         if (param.range != NULL)
             strCatZ(request, "range;");
 
-        strCatZ(request, "x-amz-content-sha256;x-amz-date");
+        strCatZ(request, "x-amz-content-sha256;");
+
+        if (param.copySource != NULL)
+        {
+            strCatZ(request, "x-amz-copy-source;");
+
+            if (param.sseC != NULL)
+            {
+                strCatZ(
+                    request,
+                    "x-amz-copy-source-server-side-encryption-customer-algorithm;"
+                    "x-amz-copy-source-server-side-encryption-customer-key;"
+                    "x-amz-copy-source-server-side-encryption-customer-key-md5;");
+            }
+        }
+
+        strCatZ(request, "x-amz-date");
 
         if (param.requesterPays)
             strCatZ(request, ";x-amz-request-payer");
@@ -177,14 +194,30 @@ testRequest(IoWrite *write, Storage *s3, const char *verb, const char *path, Tes
     // Add content checksum and date if s3 service
     if (s3 != NULL)
     {
-        // Add content sha256 and date
+        // Add content sha256
         strCatFmt(
-            request,
-            "x-amz-content-sha256:%s\r\n"
-            "x-amz-date:????????T??????Z" "\r\n",
+            request, "x-amz-content-sha256:%s\r\n",
             param.content == NULL ?
                 HASH_TYPE_SHA256_ZERO : strZ(strNewEncode(encodingHex, cryptoHashOne(hashTypeSha256, BUFSTRZ(param.content)))));
 
+        // Add copy source
+        if (param.copySource != NULL)
+        {
+            strCatFmt(request, "x-amz-copy-source:%s\r\n", param.copySource);
+
+            if (param.sseC != NULL)
+            {
+                strCatZ(request, "x-amz-copy-source-server-side-encryption-customer-algorithm:AES256\r\n");
+                strCatFmt(request, "x-amz-copy-source-server-side-encryption-customer-key:%s\r\n", param.sseC);
+                strCatFmt(
+                    request, "x-amz-copy-source-server-side-encryption-customer-key-md5:%s\r\n",
+                    strZ(strNewEncode(encodingBase64, cryptoHashOne(hashTypeMd5, bufNewDecode(encodingBase64, STR(param.sseC))))));
+            }
+        }
+
+        // Add date
+        strCatZ(request, "x-amz-date:????????T??????Z\r\n");
+
         // Add security token
         if (securityToken != NULL)
             strCatFmt(request, "x-amz-security-token:%s\r\n", securityToken);
@@ -906,7 +939,7 @@ testRun(void)
                 TEST_RESULT_BOOL(storageWriteSyncPath(write), true, "path is synced");
                 TEST_RESULT_BOOL(storageWriteTruncate(write), true, "file will be truncated");
 
-                TEST_RESULT_VOID(storageWriteS3Close(ioWriteDriver(storageWriteIo(write))), "close file again");
+                TEST_RESULT_VOID(storageWriteS3Close(write->driver), "close file again");
 
                 // Check that temp credentials were changed
                 TEST_RESULT_STR_Z(driver->accessKey, "xx", "check access key");
@@ -1077,13 +1110,13 @@ testRun(void)
                 ioWrite(storageWriteIo(write), BUFSTRDEF("123456789012345678"));
 
                 TEST_RESULT_VOID(
-                    bufResize(((StorageWriteS3 *)ioWriteDriver(storageWriteIo(write)))->partBuffer, 17),
+                    bufResize(((StorageWriteS3 *)write->driver)->partBuffer, 17),
                     "resize part buffer to 17");
 
                 ioWrite(storageWriteIo(write), BUFSTRDEF("90"));
 
                 TEST_RESULT_UINT(
-                    ((StorageWriteS3 *)ioWriteDriver(storageWriteIo(write)))->partSize, 16, "part buffer reset to 16 (default)");
+                    ((StorageWriteS3 *)write->driver)->partSize, 16, "part buffer reset to 16 (default)");
 
                 ioWriteClose(storageWriteIo(write));
                 ioBufferSizeSet(ioBufferSizeDefault);
@@ -1096,6 +1129,19 @@ testRun(void)
 
                 TEST_RESULT_BOOL(storageExistsP(s3, STRDEF("BOGUS")), false, "check");
 
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("copy file on server with encryption");
+
+                testRequestP(service, s3, HTTP_VERB_HEAD, "/file.txt", .sseC = "rA1P");
+                testResponseP(service, .header = "content-length:5\r\nLast-Modified: Wed, 21 Oct 2015 07:28:00 GMT");
+                testRequestP(
+                    service, s3, HTTP_VERB_PUT, "/file2.txt", .copySource = "/bucket/file.txt", .kms = "kmskey1", .sseC = "rA1P");
+                testResponseP(service, .content = "<CopyObjectResult><ETag>\"XXX\"</ETag></CopyObjectResult>");
+
+                TEST_RESULT_BOOL(
+                    storageCopyP(storageNewReadP(s3, STRDEF("file.txt")), storageNewWriteP(s3, STRDEF("file2.txt")), .storage = s3),
+                    true, "copy");
+
                 // -----------------------------------------------------------------------------------------------------------------
                 TEST_TITLE("info for / does not exist");
 
@@ -1438,6 +1484,65 @@ testRun(void)
                     "test3.txt\n",
                     .level = storageInfoLevelExists, .noRecurse = true, .expression = "^test(1|3)");
 
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("list subpaths in parallel");
+
+                testRequestP(service, s3, HTTP_VERB_GET, "/?delimiter=%2F&list-type=2&prefix=path%2Fto%2F");
+                testResponseP(
+                    service,
+                    .content =
+                        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                        "<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">"
+                        "    <IsTruncated>false</IsTruncated>"
+                        "    <Contents>"
+                        "        <Key>path/to/test1.txt</Key>"
+                        "    </Contents>"
+                        "   <CommonPrefixes>"
+                        "       <Prefix>path/to/path1/</Prefix>"
+                        "   </CommonPrefixes>"
+                        "   <CommonPrefixes>"
+                        "       <Prefix>path/to/path2/</Prefix>"
+                        "   </CommonPrefixes>"
+                        "</ListBucketResult>");
+
+                // The request for path1 is sent on the existing connection and the request for path2 on a new connection before
+                // either response is read. Close the first connection after responding so the new connection can be accepted.
+                testRequestP(service, s3, HTTP_VERB_GET, "/?delimiter=%2F&list-type=2&prefix=path%2Fto%2Fpath1%2F");
+                testResponseP(
+                    service, .header = "connection:close",
+                    .content =
+                        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                        "<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">"
+                        "    <IsTruncated>false</IsTruncated>"
+                        "    <Contents>"
+                        "        <Key>path/to/path1/test2.txt</Key>"
+                        "    </Contents>"
+                        "</ListBucketResult>");
+
+                hrnServerScriptClose(service);
+                hrnServerScriptAccept(service);
+
+                testRequestP(service, s3, HTTP_VERB_GET, "/?delimiter=%2F&list-type=2&prefix=path%2Fto%2Fpath2%2F");
+                testResponseP(
+                    service,
+                    .content =
+                        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                        "<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">"
+                        "    <IsTruncated>false</IsTruncated>"
+                        "    <Contents>"
+                        "        <Key>path/to/path2/test3.txt</Key>"
+                        "    </Contents>"
+                        "</ListBucketResult>");
+
+                TEST_STORAGE_LIST(
+                    s3, "/path/to",
+                    "path1/\n"
+                    "path1/test2.txt\n"
+                    "path2/\n"
+                    "path2/test3.txt\n"
+                    "test1.txt\n",
+                    .parallel = 2);
+
                 // -----------------------------------------------------------------------------------------------------------------
                 TEST_TITLE("switch to path-style URIs");
 
@@ -1612,6 +1717,116 @@ testRun(void)
 
                 TEST_RESULT_VOID(storageRemoveP(s3, STRDEF("/path/to/test.txt")), "remove");
 
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("remove list");
+
+                testRequestP(
+                    service, s3, HTTP_VERB_POST, "/bucket/?delete=",
+                    .content =
+                        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                        "<Delete><Quiet>true</Quiet>"
+                        "<Object><Key>path/to/test1.txt</Key></Object>"
+                        "<Object><Key>path/to/sub/test2.txt</Key></Object>"
+                        "</Delete>\n");
+                testResponseP(service);
+
+                StringList *const fileList = strLstNew();
+                strLstAddZ(fileList, "test1.txt");
+                strLstAddZ(fileList, "sub/test2.txt");
+
+                TEST_RESULT_VOID(storageRemoveListP(s3, STRDEF("/path/to"), fileList), "remove list");
+
+                testRequestP(
+                    service, s3, HTTP_VERB_POST, "/bucket/?delete=",
+                    .content =
+                        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                        "<Delete><Quiet>true</Quiet>"
+                        "<Object><Key>test1.txt</Key></Object>"
+                        "<Object><Key>sub/test2.txt</Key></Object>"
+                        "</Delete>\n");
+                testResponseP(service);
+
+                TEST_RESULT_VOID(storageRemoveListP(s3, FSLASH_STR, fileList), "remove list from root");
+
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("copy missing file");
+
+                testRequestP(service, s3, HTTP_VERB_HEAD, "/bucket/path/missing.txt");
+                testResponseP(service, .code = 404);
+
+                TEST_ERROR(
+                    storageCopyP(
+                        storageNewReadP(s3, STRDEF("/path/missing.txt")), storageNewWriteP(s3, STRDEF("/path/copy.txt")),
+                        .storage = s3),
+                    FileMissingError, "unable to open missing file '/path/missing.txt' for read");
+
+                testRequestP(service, s3, HTTP_VERB_HEAD, "/bucket/path/missing.txt");
+                testResponseP(service, .code = 404);
+
+                TEST_RESULT_BOOL(
+                    storageCopyP(
+                        storageNewReadP(s3, STRDEF("/path/missing.txt"), .ignoreMissing = true),
+                        storageNewWriteP(s3, STRDEF("/path/copy.txt")), .storage = s3),
+                    false, "copy ignore missing");
+
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("copy file on server");
+
+                testRequestP(service, s3, HTTP_VERB_HEAD, "/bucket/path/file.txt");
+                testResponseP(service, .header = "content-length:5\r\nLast-Modified: Wed, 21 Oct 2015 07:28:00 GMT");
+                testRequestP(service, s3, HTTP_VERB_PUT, "/bucket/path/copy%20file.txt", .copySource = "/bucket/path/file.txt");
+                testResponseP(service, .content = "<CopyObjectResult><ETag>\"XXX\"</ETag></CopyObjectResult>");
+
+                TEST_RESULT_BOOL(
+                    storageCopyP(
+                        storageNewReadP(s3, STRDEF("/path/file.txt")), storageNewWriteP(s3, STRDEF("/path/copy file.txt")),
+                        .storage = s3),
+                    true, "copy");
+
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("error in success response of copy");
+
+                testRequestP(service, s3, HTTP_VERB_HEAD, "/bucket/path/file.txt");
+                testResponseP(service, .header = "content-length:5\r\nLast-Modified: Wed, 21 Oct 2015 07:28:00 GMT");
+                testRequestP(service, s3, HTTP_VERB_PUT, "/bucket/path/copy.txt", .copySource = "/bucket/path/file.txt");
+                testResponseP(service, .content = "<Error><Code>InternalError</Code></Error>");
+
+                TEST_ERROR(
+                    storageCopyP(
+                        storageNewReadP(s3, STRDEF("/path/file.txt")), storageNewWriteP(s3, STRDEF("/path/copy.txt")),
+                        .storage = s3),
+                    ProtocolError,
+                    "HTTP request failed with 200 (OK):\n"
+                    "*** Path/Query ***:\n"
+                    "PUT /bucket/path/copy.txt\n"
+                    "*** Request Headers ***:\n"
+                    "authorization: <redacted>\n"
+                    "content-length: 0\n"
+                    "host: s3.amazonaws.com\n"
+                    "x-amz-content-sha256: e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855\n"
+                    "x-amz-copy-source: /bucket/path/file.txt\n"
+                    "x-amz-date: <redacted>\n"
+                    "*** Response Headers ***:\n"
+                    "content-length: 41\n"
+                    "*** Response Content ***:\n"
+                    "<Error><Code>InternalError</Code></Error>");
+
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("copy file too large for the server through the client");
+
+                testRequestP(service, s3, HTTP_VERB_HEAD, "/bucket/path/file.txt");
+                testResponseP(service, .header = "content-length:5368709121\r\nLast-Modified: Wed, 21 Oct 2015 07:28:00 GMT");
+                testRequestP(service, s3, HTTP_VERB_GET, "/bucket/path/file.txt");
+                testResponseP(service, .content = "12345");
+                testRequestP(service, s3, HTTP_VERB_PUT, "/bucket/path/copy.txt", .content = "12345");
+                testResponseP(service);
+
+                TEST_RESULT_BOOL(
+                    storageCopyP(
+                        storageNewReadP(s3, STRDEF("/path/file.txt")), storageNewWriteP(s3, STRDEF("/path/copy.txt")),
+                        .storage = s3),
+                    true, "copy");
+
                 // -----------------------------------------------------------------------------------------------------------------
                 TEST_TITLE("switch to time limited");
 